@@ -0,0 +1,166 @@
+#include "AStarPlanner.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+const float SQRT2 = 1.41421356f;
+
+// Moves in the order E, W, S, N, SE, SW, NE, NW; diagonals come last.
+const int MOVE_X[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+const int MOVE_Y[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+const float MOVE_COST[8] = { 1.0f, 1.0f, 1.0f, 1.0f, SQRT2, SQRT2, SQRT2, SQRT2 };
+
+inline float octile(int x, int y, int goalX, int goalY) {
+    int dx = std::abs(goalX - x);
+    int dy = std::abs(goalY - y);
+    return static_cast<float>(dx + dy) + (SQRT2 - 2.0f) * static_cast<float>(std::min(dx, dy));
+}
+
+} // namespace
+
+
+template <typename Cell>
+BasicAStarPlanner<Cell>::BasicAStarPlanner(Cell obstacleThreshold)
+    : search(0), sizeX(0), sizeY(0), threshold(obstacleThreshold), expanded(0), pathCost(0.0)
+{
+}
+
+template <typename Cell>
+void BasicAStarPlanner<Cell>::setObstacleThreshold(Cell obstacleThreshold) {
+    threshold = obstacleThreshold;
+}
+
+template <typename Cell>
+Cell BasicAStarPlanner<Cell>::getObstacleThreshold() const {
+    return threshold;
+}
+
+template <typename Cell>
+bool BasicAStarPlanner<Cell>::isFree(const BasicMap<Cell>& map, int x, int y) const {
+    if (x < 0 || y < 0 || x >= map.getNumberX() || y >= map.getNumberY()) {
+        return false;
+    }
+    return map.data()[static_cast<std::size_t>(y) * map.getStride() + x] < threshold;
+}
+
+template <typename Cell>
+void BasicAStarPlanner<Cell>::beginSearch(int mapX, int mapY) {
+    if (mapX != sizeX || mapY != sizeY) {
+        std::size_t cellCount = static_cast<std::size_t>(mapX) * mapY;
+        nodes.assign(cellCount, Node{ 0.0f, 0u });
+        parent.assign(cellCount, 0);
+        sizeX = mapX;
+        sizeY = mapY;
+        search = 0;
+    }
+    ++search;
+    if (search >= 0x7fffffffu) {
+        for (Node& node : nodes) {
+            node.stamp = 0;
+        }
+        search = 1;
+    }
+    openList.clear();
+    expanded = 0;
+    pathCost = 0.0;
+}
+
+template <typename Cell>
+bool BasicAStarPlanner<Cell>::plan(const BasicMap<Cell>& map, int startX, int startY, int goalX, int goalY, GridPath& path) {
+    path.clear();
+    beginSearch(map.getNumberX(), map.getNumberY());
+    if (!isFree(map, startX, startY) || !isFree(map, goalX, goalY)) {
+        return false;
+    }
+
+    const std::uint32_t openStamp = search * 2;
+    const std::uint32_t closedStamp = openStamp + 1;
+    const Cell* cells = map.data();
+    const std::size_t stride = static_cast<std::size_t>(map.getStride());
+    const Cell limit = threshold;
+    const int goal = goalY * sizeX + goalX;
+    // Min-heap on f; equal f prefers the entry closer to the goal.
+    auto later = [](const OpenEntry& a, const OpenEntry& b) {
+        return a.f > b.f || (a.f == b.f && a.h > b.h);
+    };
+
+    int start = startY * sizeX + startX;
+    nodes[start].g = 0.0f;
+    nodes[start].stamp = openStamp;
+    float h0 = octile(startX, startY, goalX, goalY);
+    openList.push_back(OpenEntry{ h0, h0, start });
+
+    while (!openList.empty()) {
+        std::pop_heap(openList.begin(), openList.end(), later);
+        int current = openList.back().index;
+        openList.pop_back();
+        // The open list may hold stale duplicates of a cell already closed.
+        Node& node = nodes[current];
+        if (node.stamp == closedStamp) {
+            continue;
+        }
+        node.stamp = closedStamp;
+        ++expanded;
+
+        if (current == goal) {
+            pathCost = node.g;
+            int x = goalX;
+            int y = goalY;
+            path.push_back(PathCell{ x, y });
+            while (x != startX || y != startY) {
+                int move = parent[y * sizeX + x];
+                x -= MOVE_X[move];
+                y -= MOVE_Y[move];
+                path.push_back(PathCell{ x, y });
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        int x = current % sizeX;
+        int y = current / sizeX;
+        float g = node.g;
+        for (int move = 0; move < 8; ++move) {
+            int nx = x + MOVE_X[move];
+            int ny = y + MOVE_Y[move];
+            if (nx < 0 || ny < 0 || nx >= sizeX || ny >= sizeY || !(cells[ny * stride + nx] < limit)) {
+                continue;
+            }
+            if (move >= 4 && (!(cells[y * stride + nx] < limit) || !(cells[ny * stride + x] < limit))) {
+                continue;
+            }
+            int next = ny * sizeX + nx;
+            Node& neighbour = nodes[next];
+            if (neighbour.stamp == closedStamp) {
+                continue;
+            }
+            float ng = g + MOVE_COST[move];
+            if (neighbour.stamp != openStamp || ng < neighbour.g) {
+                neighbour.g = ng;
+                neighbour.stamp = openStamp;
+                parent[next] = static_cast<std::uint8_t>(move);
+                float h = octile(nx, ny, goalX, goalY);
+                openList.push_back(OpenEntry{ ng + h, h, next });
+                std::push_heap(openList.begin(), openList.end(), later);
+            }
+        }
+    }
+    return false;
+}
+
+template <typename Cell>
+double BasicAStarPlanner<Cell>::getPathCost() const {
+    return pathCost;
+}
+
+template <typename Cell>
+int BasicAStarPlanner<Cell>::getExpandedCount() const {
+    return expanded;
+}
+
+template class BasicAStarPlanner<std::int8_t>;
+template class BasicAStarPlanner<std::uint8_t>;
+template class BasicAStarPlanner<std::int16_t>;
+template class BasicAStarPlanner<int>;
+template class BasicAStarPlanner<float>;
@@ -0,0 +1,142 @@
+/**
+ * @file AStarPlanner.h
+ * @brief Declaration of the AStarPlanner class.
+ */
+
+#ifndef ASTARPLANNER_H
+#define ASTARPLANNER_H
+
+#include <cstdint>
+#include <vector>
+#include "Map.h"
+
+/**
+ * @struct PathCell
+ * @brief Grid coordinates of one cell of a planned path.
+ */
+struct PathCell {
+    int x; ///< Column of the cell
+    int y; ///< Row of the cell
+};
+
+typedef std::vector<PathCell> GridPath; ///< Cells of a path from start to goal, both included
+
+/**
+ * @class BasicAStarPlanner
+ * @brief A* path planner over a BasicMap with 8-connectivity.
+ *
+ * Cells whose value is at least the obstacle threshold are blocked. Straight moves
+ * cost 1 and diagonal moves sqrt(2); a diagonal move is allowed only when both cells
+ * it passes between are free, so paths never cut the corner of an obstacle. The
+ * octile distance is used as heuristic, which is exact on an empty grid, so the
+ * returned paths are shortest paths.
+ *
+ * The cost, state and parent of each cell live in arenas sized to the grid that are
+ * kept between queries. Each query gets a new stamp instead of clearing them, and the
+ * open list keeps the capacity of the largest search, so once warmed up plan()
+ * allocates nothing.
+ */
+template <typename Cell>
+class BasicAStarPlanner {
+private:
+    /**
+     * @struct OpenEntry
+     * @brief Entry of the open list.
+     */
+    struct OpenEntry {
+        float f; ///< Cost from the start plus heuristic
+        float h; ///< Heuristic, breaks ties towards the goal
+        int index; ///< Cell index, y * sizeX + x
+    };
+
+    /**
+     * @struct Node
+     * @brief Search state of one cell, packed so a neighbour check touches one cache line.
+     */
+    struct Node {
+        float g; ///< Cost from the start, valid when the cell is stamped by this search
+        std::uint32_t stamp; ///< 2 * search when opened, 2 * search + 1 when closed
+    };
+
+    std::vector<Node> nodes; ///< Search state of each cell, y * sizeX + x
+    std::vector<std::uint8_t> parent; ///< Move that reached the cell, index into the move tables
+    std::vector<OpenEntry> openList; ///< Binary min-heap ordered by f, then h
+    std::uint32_t search; ///< Number of the current search
+    int sizeX; ///< Number of columns the arenas are sized for
+    int sizeY; ///< Number of rows the arenas are sized for
+    Cell threshold; ///< Smallest cell value that blocks
+    int expanded; ///< Cells expanded by the last query
+    double pathCost; ///< Cost of the last path found
+
+    /**
+     * @brief Sizes the arenas for a grid and starts a new search.
+     *
+     * @param mapX Number of columns of the grid.
+     * @param mapY Number of rows of the grid.
+     */
+    void beginSearch(int mapX, int mapY);
+
+public:
+    /**
+     * @brief Constructs a planner.
+     *
+     * @param obstacleThreshold Smallest cell value that blocks.
+     */
+    explicit BasicAStarPlanner(Cell obstacleThreshold = 1);
+
+    /**
+     * @brief Sets the obstacle threshold.
+     *
+     * @param obstacleThreshold Smallest cell value that blocks.
+     */
+    void setObstacleThreshold(Cell obstacleThreshold);
+
+    /**
+     * @brief Gets the obstacle threshold.
+     *
+     * @return Cell Smallest cell value that blocks.
+     */
+    Cell getObstacleThreshold() const;
+
+    /**
+     * @brief Checks whether a cell can be traversed.
+     *
+     * @param map The map.
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return bool True if the cell is inside the map and below the obstacle threshold.
+     */
+    bool isFree(const BasicMap<Cell>& map, int x, int y) const;
+
+    /**
+     * @brief Plans a shortest path between two cells.
+     *
+     * @param map The map.
+     * @param startX Column of the start cell.
+     * @param startY Row of the start cell.
+     * @param goalX Column of the goal cell.
+     * @param goalY Row of the goal cell.
+     * @param path Receives the path from start to goal; cleared if there is none.
+     * @return bool True if a path was found; false if start or goal is blocked or
+     *         outside the map, or the goal cannot be reached.
+     */
+    bool plan(const BasicMap<Cell>& map, int startX, int startY, int goalX, int goalY, GridPath& path);
+
+    /**
+     * @brief Gets the cost of the last path found.
+     *
+     * @return double The length of the path in cells.
+     */
+    double getPathCost() const;
+
+    /**
+     * @brief Gets the number of cells expanded by the last query.
+     *
+     * @return int The number of expanded cells.
+     */
+    int getExpandedCount() const;
+};
+
+typedef BasicAStarPlanner<int> AStarPlanner; ///< Planner over the default map type
+
+#endif // ASTARPLANNER_H
@@ -0,0 +1,161 @@
+/**
+ * @file AStarPlannerTest.cpp
+ * @brief Test file for the AStarPlanner class.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include "AStarPlanner.h"
+
+/**
+ * @brief Prints a path as a list of cells.
+ *
+ * @param path The path.
+ */
+void printPath(const GridPath& path) {
+    for (size_t i = 0; i < path.size(); ++i) {
+        std::cout << " (" << path[i].x << "," << path[i].y << ")";
+    }
+    std::cout << "\n";
+}
+
+/**
+ * @brief Fills a map with random rectangular obstacles.
+ *
+ * @param map The map.
+ * @param count Number of rectangles.
+ * @param seed Pseudo-random state.
+ */
+void addObstacles(Map& map, int count, std::uint32_t& seed) {
+    for (int i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        int x0 = static_cast<int>((seed >> 8) % map.getNumberX());
+        seed = seed * 1664525u + 1013904223u;
+        int y0 = static_cast<int>((seed >> 8) % map.getNumberY());
+        seed = seed * 1664525u + 1013904223u;
+        int w = 2 + static_cast<int>((seed >> 8) % 40);
+        int h = 2 + static_cast<int>((seed >> 20) % 40);
+        for (int y = y0; y < y0 + h && y < map.getNumberY(); ++y) {
+            for (int x = x0; x < x0 + w && x < map.getNumberX(); ++x) {
+                map.setGrid(x, y, 1);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Picks a random free cell.
+ *
+ * @param planner The planner deciding which cells are free.
+ * @param map The map.
+ * @param seed Pseudo-random state.
+ * @param cell Receives the cell.
+ */
+void randomFreeCell(const AStarPlanner& planner, const Map& map, std::uint32_t& seed, PathCell& cell) {
+    do {
+        seed = seed * 1664525u + 1013904223u;
+        cell.x = static_cast<int>((seed >> 8) % map.getNumberX());
+        seed = seed * 1664525u + 1013904223u;
+        cell.y = static_cast<int>((seed >> 8) % map.getNumberY());
+    } while (!planner.isFree(map, cell.x, cell.y));
+}
+
+/**
+ * @brief Main function to test the AStarPlanner class.
+ *
+ * This function performs various tests on the AStarPlanner class:
+ * - Plans diagonal and straight paths on an empty map.
+ * - Routes around a wall through its gap without cutting obstacle corners.
+ * - Rejects blocked or outside endpoints and unreachable goals.
+ * - Applies the obstacle threshold.
+ * - Measures planning time over random start/goal pairs on a 2000 x 2000 map, with
+ *   the arenas reused and with a new planner per query.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- AStarPlanner Test Start -----\n";
+
+    // 1. Empty map
+    Map open(10, 10);
+    AStarPlanner planner;
+    GridPath path;
+    std::cout << "[Test] Diagonal => " << planner.plan(open, 0, 0, 9, 9, path) << ", cells " << path.size()
+              << ", cost " << planner.getPathCost() << " (12.7279), expanded " << planner.getExpandedCount() << "\n";
+    planner.plan(open, 2, 3, 7, 3, path);
+    std::cout << "[Test] Straight =>";
+    printPath(path);
+    std::cout << "[Test] Start is goal => " << planner.plan(open, 4, 4, 4, 4, path) << ", cells " << path.size() << "\n";
+
+    // 2. Wall with a gap at (5,8)
+    Map walled(10, 10);
+    for (int y = 0; y < 10; ++y) {
+        if (y != 8) {
+            walled.setGrid(5, y, 1);
+        }
+    }
+    planner.plan(walled, 2, 2, 8, 2, path);
+    std::cout << "[Test] Through the gap, cost " << planner.getPathCost() << " =>";
+    printPath(path);
+    Map corners(3, 3);
+    corners.setGrid(1, 0, 1);
+    corners.setGrid(0, 1, 1);
+    std::cout << "[Test] Diagonal between two obstacles => " << planner.plan(corners, 0, 0, 1, 1, path) << " (0)\n";
+
+    // 3. Invalid requests
+    std::cout << "[Test] Blocked start => " << planner.plan(walled, 5, 0, 8, 2, path) << ", outside goal => "
+              << planner.plan(walled, 2, 2, 10, 2, path) << "\n";
+    Map boxed(10, 10);
+    for (int i = 6; i <= 8; ++i) {
+        boxed.setGrid(i, 6, 1);
+        boxed.setGrid(i, 8, 1);
+        boxed.setGrid(6, i, 1);
+        boxed.setGrid(8, i, 1);
+    }
+    std::cout << "[Test] Enclosed goal => " << planner.plan(boxed, 0, 0, 7, 7, path) << ", path cells " << path.size()
+              << ", expanded " << planner.getExpandedCount() << "\n";
+
+    // 4. Obstacle threshold
+    Map costly(10, 1);
+    costly.setGrid(5, 0, 50);
+    std::cout << "[Test] Threshold 1 => " << planner.plan(costly, 0, 0, 9, 0, path);
+    planner.setObstacleThreshold(100);
+    std::cout << ", threshold 100 => " << planner.plan(costly, 0, 0, 9, 0, path) << "\n";
+    planner.setObstacleThreshold(1);
+
+    // 5. Benchmark: 2000 x 2000 map, 100 random start/goal pairs
+    using Clock = std::chrono::steady_clock;
+    Map large(2000, 2000);
+    std::uint32_t seed = 42u;
+    addObstacles(large, 1500, seed);
+    const int queries = 100;
+    PathCell starts[queries], goals[queries];
+    for (int i = 0; i < queries; ++i) {
+        randomFreeCell(planner, large, seed, starts[i]);
+        randomFreeCell(planner, large, seed, goals[i]);
+    }
+    planner.plan(large, starts[0].x, starts[0].y, goals[0].x, goals[0].y, path);
+    int found = 0;
+    long long expandedTotal = 0;
+    double longest = 0.0;
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < queries; ++i) {
+        found += planner.plan(large, starts[i].x, starts[i].y, goals[i].x, goals[i].y, path);
+        expandedTotal += planner.getExpandedCount();
+        longest = std::max(longest, planner.getPathCost());
+    }
+    double reusedMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / queries;
+    t0 = Clock::now();
+    for (int i = 0; i < queries; ++i) {
+        AStarPlanner fresh;
+        fresh.plan(large, starts[i].x, starts[i].y, goals[i].x, goals[i].y, path);
+    }
+    double freshMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / queries;
+    std::cout << "[Bench] 2000 x 2000 map, " << queries << " queries: " << found << " paths found, longest "
+              << longest << " cells, " << expandedTotal / queries << " cells expanded per query\n";
+    std::cout << "[Bench] Per query: reused arenas " << reusedMs << " ms, new planner " << freshMs << " ms\n";
+
+    std::cout << "----- AStarPlanner Test Complete -----\n";
+    return 0;
+}
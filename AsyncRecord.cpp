@@ -0,0 +1,374 @@
+/**
+ * @file AsyncRecord.cpp
+ * @brief Implementation of the AsyncRecord class.
+ */
+
+#include "AsyncRecord.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+std::atomic<std::uint64_t> nextInstanceId(1);
+
+/**
+ * @brief Copies bytes into a ring, wrapping at the end of its storage.
+ *
+ * @param ring Ring storage.
+ * @param mask Capacity minus one.
+ * @param position Logical write position.
+ * @param bytes Bytes to copy.
+ * @param size Number of bytes.
+ */
+void copyIn(char* ring, std::size_t mask, std::uint64_t position, const char* bytes, std::size_t size) {
+    std::size_t at = static_cast<std::size_t>(position) & mask;
+    std::size_t first = std::min(size, mask + 1 - at);
+    std::memcpy(ring + at, bytes, first);
+    if (first < size) {
+        std::memcpy(ring, bytes + first, size - first);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Constructs a closed recorder.
+ *
+ * @param ringBytes Capacity of each producer's ring, rounded up to a power of two.
+ */
+AsyncRecord::AsyncRecord(std::size_t ringBytes)
+    : bufferBytes(64), instanceId(nextInstanceId.fetch_add(1)), appendedBytes(0), writtenBytes(0),
+      droppedBytes(0), lostBytes(0), producers(0), writeFailed(false), syncIntervalMs(0), running(false)
+{
+    while (bufferBytes < ringBytes) {
+        bufferBytes <<= 1;
+    }
+}
+
+/**
+ * @brief Destructor. Writes what is queued and closes the file.
+ */
+AsyncRecord::~AsyncRecord() {
+    closeFile();
+    for (std::size_t i = 0; i < buffers.size(); ++i) {
+        delete[] buffers[i]->data;
+        delete buffers[i];
+    }
+}
+
+/**
+ * @brief Opens a file and starts the writer thread.
+ *
+ * @param filename The name of the file to open.
+ * @param mode The mode in which to open the file; std::ios::out is added.
+ * @return bool Returns true if the file is successfully opened, false otherwise.
+ */
+bool AsyncRecord::openFile(const std::string& filename, std::ios::openmode mode) {
+    closeFile();
+    if (!file.openFile(filename, mode | std::ios::out)) {
+        return false;
+    }
+    writeFailed.store(false);
+    running.store(true);
+    writer = std::thread(&AsyncRecord::run, this);
+    return true;
+}
+
+/**
+ * @brief Writes what is queued, stops the writer thread and closes the file.
+ */
+void AsyncRecord::closeFile() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    if (writer.joinable()) {
+        writer.join();
+    }
+    file.closeFile();
+}
+
+/**
+ * @brief Checks whether a file is open.
+ *
+ * @return bool True if open.
+ */
+bool AsyncRecord::isOpen() const {
+    return running.load();
+}
+
+/**
+ * @brief Gets the ring of the calling thread, creating it on first use.
+ *
+ * The last ring used by the thread is cached in thread-local storage, so the lookup
+ * only takes the lock the first time a thread writes to this recorder.
+ *
+ * @return ProducerBuffer* The ring.
+ */
+AsyncRecord::ProducerBuffer* AsyncRecord::localBuffer() {
+    static thread_local std::uint64_t cachedId = 0;
+    static thread_local ProducerBuffer* cachedBuffer = nullptr;
+    if (cachedId == instanceId) {
+        return cachedBuffer;
+    }
+
+    std::thread::id self = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    ProducerBuffer* buffer = nullptr;
+    for (std::size_t i = 0; i < buffers.size() && !buffer; ++i) {
+        if (buffers[i]->owner == self) {
+            buffer = buffers[i];
+        }
+    }
+    if (!buffer) {
+        buffer = new ProducerBuffer;
+        buffer->data = new char[bufferBytes];
+        // Touch the pages now rather than on the first writes of the producer.
+        std::memset(buffer->data, 0, bufferBytes);
+        buffer->mask = bufferBytes - 1;
+        buffer->head.store(0);
+        buffer->tail.store(0);
+        buffer->owner = self;
+        buffers.push_back(buffer);
+    }
+    cachedId = instanceId;
+    cachedBuffer = buffer;
+    return buffer;
+}
+
+/**
+ * @brief Queues one entry made of two pieces into the calling thread's ring.
+ *
+ * @param first First piece.
+ * @param firstSize Size of the first piece.
+ * @param second Second piece, or nullptr.
+ * @param secondSize Size of the second piece.
+ * @return bool True if the entry was queued, false if it was dropped.
+ */
+bool AsyncRecord::append(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize) {
+    std::size_t size = firstSize + secondSize;
+    // Announce the call before checking running; closeFile() clears running and then
+    // waits for producers to reach zero before the last drain, so an entry accepted
+    // here is always written. Both sides use sequentially consistent operations.
+    producers.fetch_add(1);
+    if (!running.load() || writeFailed.load(std::memory_order_relaxed)) {
+        producers.fetch_sub(1);
+        droppedBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+        return false;
+    }
+    ProducerBuffer* buffer = localBuffer();
+    std::uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    std::uint64_t tail = buffer->tail.load(std::memory_order_acquire);
+    if (size > bufferBytes - static_cast<std::size_t>(head - tail)) {
+        producers.fetch_sub(1);
+        droppedBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+        return false;
+    }
+    copyIn(buffer->data, buffer->mask, head, first, firstSize);
+    if (secondSize > 0) {
+        copyIn(buffer->data, buffer->mask, head + firstSize, second, secondSize);
+    }
+    appendedBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    buffer->head.store(head + size, std::memory_order_release);
+    producers.fetch_sub(1);
+    return true;
+}
+
+/**
+ * @brief Queues a line; a newline is appended.
+ *
+ * @param line The line to write.
+ * @return bool True if the line was queued, false if it was dropped.
+ */
+bool AsyncRecord::writeLine(const std::string& line) {
+    return append(line.data(), line.size(), "\n", 1);
+}
+
+/**
+ * @brief Queues raw bytes.
+ *
+ * @param data Pointer to the bytes to write.
+ * @param size Number of bytes.
+ * @return bool True if the bytes were queued, false if they were dropped.
+ */
+bool AsyncRecord::writeBytes(const void* data, std::size_t size) {
+    return append(static_cast<const char*>(data), size, nullptr, 0);
+}
+
+/**
+ * @brief Blocks until everything the calling thread queued before the call has been written.
+ *
+ * The head of every ring is recorded at the call, and the call returns once the writer
+ * thread has drained each ring up to it. Entries other threads queue later are not
+ * waited for.
+ *
+ * @return bool True if it was written, false if a write to the file failed or the
+ *         file was closed first.
+ */
+bool AsyncRecord::flush() {
+    std::vector<std::pair<ProducerBuffer*, std::uint64_t> > targets;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        targets.reserve(buffers.size());
+        for (std::size_t i = 0; i < buffers.size(); ++i) {
+            targets.push_back(std::make_pair(buffers[i], buffers[i]->head.load(std::memory_order_acquire)));
+        }
+    }
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+        while (targets[i].first->tail.load(std::memory_order_acquire) < targets[i].second) {
+            if (!running.load()) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    return !writeFailed.load();
+}
+
+/**
+ * @brief Checks whether a write to the file failed since openFile().
+ *
+ * After a failure every queued and new entry is discarded.
+ *
+ * @return bool True if a write failed.
+ */
+bool AsyncRecord::hasWriteError() const {
+    return writeFailed.load();
+}
+
+/**
+ * @brief Sets how often the writer thread syncs the file to disk.
+ *
+ * Several drains are batched into one sync. The default, 0, never syncs
+ * explicitly and leaves it to the operating system.
+ *
+ * @param milliseconds Minimum time between syncs, 0 to disable.
+ */
+void AsyncRecord::setSyncInterval(int milliseconds) {
+    syncIntervalMs.store(milliseconds > 0 ? milliseconds : 0);
+}
+
+/**
+ * @brief Writes everything currently in the rings to the file.
+ *
+ * Each ring is written with at most two writes, one per side of the wrap-around.
+ * After a failed write the rest of the rings is discarded instead: it is counted as
+ * lost rather than written, and the tails still advance so flush() does not wait
+ * for bytes that will never reach the file.
+ *
+ * @return std::size_t Number of bytes taken from the rings.
+ */
+std::size_t AsyncRecord::drain() {
+    std::size_t count;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        count = buffers.size();
+    }
+    std::size_t total = 0;
+    std::size_t written = 0;
+    bool failed = writeFailed.load();
+    for (std::size_t i = 0; i < count; ++i) {
+        ProducerBuffer* buffer;
+        {
+            std::lock_guard<std::mutex> lock(bufferMutex);
+            buffer = buffers[i];
+        }
+        std::uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+        std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+        while (tail < head) {
+            std::size_t at = static_cast<std::size_t>(tail) & buffer->mask;
+            std::size_t span = std::min(static_cast<std::size_t>(head - tail), buffer->mask + 1 - at);
+            if (!failed && file.writeBytes(buffer->data + at, span)) {
+                written += span;
+            } else {
+                failed = true;
+            }
+            tail += span;
+            total += span;
+        }
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+    if (written > 0 && !file.flush()) {
+        failed = true;
+    }
+    if (failed) {
+        writeFailed.store(true);
+    }
+    writtenBytes.fetch_add(static_cast<long long>(written));
+    lostBytes.fetch_add(static_cast<long long>(total - written));
+    return total;
+}
+
+/**
+ * @brief Main loop of the writer thread.
+ *
+ * Drains the rings, then sleeps for a millisecond when there was nothing to write.
+ * Syncs to disk are batched: at most one per sync interval, and only after new data.
+ * The rings are drained one last time after closeFile() is called, once every append()
+ * that saw the file open has finished.
+ */
+void AsyncRecord::run() {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point lastSync = Clock::now();
+    bool unsynced = false;
+    while (running.load()) {
+        if (drain() > 0) {
+            unsynced = true;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        int interval = syncIntervalMs.load();
+        if (unsynced && interval > 0 && Clock::now() - lastSync >= std::chrono::milliseconds(interval)) {
+            file.sync();
+            lastSync = Clock::now();
+            unsynced = false;
+        }
+    }
+    while (producers.load() > 0) {
+        std::this_thread::yield();
+    }
+    if (drain() > 0) {
+        unsynced = true;
+    }
+    if (unsynced && syncIntervalMs.load() > 0) {
+        file.sync();
+    }
+}
+
+/**
+ * @brief Gets the number of bytes waiting in the rings.
+ *
+ * @return long long The queued bytes.
+ */
+long long AsyncRecord::getQueuedBytes() const {
+    return appendedBytes.load() - writtenBytes.load() - lostBytes.load();
+}
+
+/**
+ * @brief Gets the number of bytes written to the file since construction.
+ *
+ * @return long long The written bytes.
+ */
+long long AsyncRecord::getWrittenBytes() const {
+    return writtenBytes.load();
+}
+
+/**
+ * @brief Gets the number of bytes dropped because a ring was full, the file was closed
+ *        or a write had failed.
+ *
+ * @return long long The dropped bytes.
+ */
+long long AsyncRecord::getDroppedBytes() const {
+    return droppedBytes.load();
+}
+
+/**
+ * @brief Gets the number of bytes that were queued but discarded because a write
+ *        to the file failed.
+ *
+ * @return long long The lost bytes.
+ */
+long long AsyncRecord::getLostBytes() const {
+    return lostBytes.load();
+}
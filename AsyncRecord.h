@@ -0,0 +1,205 @@
+/**
+ * @file AsyncRecord.h
+ * @brief Declaration of the AsyncRecord class.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Record.h"
+
+/**
+ * @class AsyncRecord
+ * @brief Writes lines and bytes to a Record file from a background thread.
+ *
+ * Each producer thread appends into its own lock-free ring buffer, so writeLine() and
+ * writeBytes() only copy memory and never wait for the disk or for other producers.
+ * A writer thread drains the rings through Record in large sequential writes and, if
+ * enabled, syncs the file to disk at most once per sync interval. An entry is always
+ * written whole; entries from different threads are interleaved at entry boundaries.
+ * When a producer's ring is full the entry is dropped and counted instead of blocking.
+ *
+ * Every byte offered, newlines included, is counted once: as dropped, queued, written
+ * or lost. Once producers are idle, the queued, written and lost bytes add up to the
+ * bytes accepted, and adding the dropped bytes gives the bytes offered.
+ */
+class AsyncRecord {
+private:
+    /**
+     * @struct ProducerBuffer
+     * @brief Single-producer, single-consumer byte ring of one producer thread.
+     */
+    struct ProducerBuffer {
+        char* data; ///< Ring storage
+        std::size_t mask; ///< Capacity minus one; the capacity is a power of two
+        std::atomic<std::uint64_t> head; ///< Bytes appended, written by the producer
+        std::atomic<std::uint64_t> tail; ///< Bytes drained, written by the writer thread
+        std::thread::id owner; ///< Producer thread
+    };
+
+    Record file; ///< Output file
+    std::vector<ProducerBuffer*> buffers; ///< One ring per producer thread
+    std::mutex bufferMutex; ///< Guards the list of rings
+    std::size_t bufferBytes; ///< Capacity of each ring
+    std::uint64_t instanceId; ///< Identifies this object in the producers' thread-local cache
+    std::atomic<long long> appendedBytes; ///< Bytes accepted from producers
+    std::atomic<long long> writtenBytes; ///< Bytes handed to the file
+    std::atomic<long long> droppedBytes; ///< Bytes rejected because a ring was full
+    std::atomic<long long> lostBytes; ///< Bytes accepted but discarded after a failed write
+    std::atomic<int> producers; ///< append() calls between their check of running and their update of head
+    std::atomic<bool> writeFailed; ///< Whether a write to the file failed since openFile()
+    std::atomic<int> syncIntervalMs; ///< Minimum time between disk syncs, 0 to never sync
+    std::atomic<bool> running; ///< Whether the writer thread should keep running
+    std::thread writer; ///< Writer thread
+
+    AsyncRecord(const AsyncRecord&);
+    AsyncRecord& operator=(const AsyncRecord&);
+
+    /**
+     * @brief Gets the ring of the calling thread, creating it on first use.
+     *
+     * @return ProducerBuffer* The ring.
+     */
+    ProducerBuffer* localBuffer();
+
+    /**
+     * @brief Queues one entry made of two pieces into the calling thread's ring.
+     *
+     * @param first First piece.
+     * @param firstSize Size of the first piece.
+     * @param second Second piece, or nullptr.
+     * @param secondSize Size of the second piece.
+     * @return bool True if the entry was queued, false if it was dropped.
+     */
+    bool append(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize);
+
+    /**
+     * @brief Writes everything currently in the rings to the file.
+     *
+     * After a failed write the rest of the rings is discarded instead.
+     *
+     * @return std::size_t Number of bytes taken from the rings.
+     */
+    std::size_t drain();
+
+    /**
+     * @brief Main loop of the writer thread.
+     */
+    void run();
+
+public:
+    /**
+     * @brief Constructs a closed recorder.
+     *
+     * @param ringBytes Capacity of each producer's ring, rounded up to a power of two.
+     */
+    AsyncRecord(std::size_t ringBytes = 1 << 20);
+
+    /**
+     * @brief Destructor. Writes what is queued and closes the file.
+     */
+    ~AsyncRecord();
+
+    /**
+     * @brief Opens a file and starts the writer thread.
+     *
+     * @param filename The name of the file to open.
+     * @param mode The mode in which to open the file; std::ios::out is added.
+     * @return bool Returns true if the file is successfully opened, false otherwise.
+     */
+    bool openFile(const std::string& filename, std::ios::openmode mode = std::ios::out | std::ios::binary);
+
+    /**
+     * @brief Writes what is queued, stops the writer thread and closes the file.
+     */
+    void closeFile();
+
+    /**
+     * @brief Checks whether a file is open.
+     *
+     * @return bool True if open.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Queues a line; a newline is appended.
+     *
+     * @param line The line to write.
+     * @return bool True if the line was queued, false if it was dropped.
+     */
+    bool writeLine(const std::string& line);
+
+    /**
+     * @brief Queues raw bytes.
+     *
+     * @param data Pointer to the bytes to write.
+     * @param size Number of bytes.
+     * @return bool True if the bytes were queued, false if they were dropped.
+     */
+    bool writeBytes(const void* data, std::size_t size);
+
+    /**
+     * @brief Blocks until everything the calling thread queued before the call has been written.
+     *
+     * Entries other threads queue later are not waited for.
+     *
+     * @return bool True if it was written, false if a write to the file failed or the
+     *         file was closed first.
+     */
+    bool flush();
+
+    /**
+     * @brief Checks whether a write to the file failed since openFile().
+     *
+     * After a failure every queued and new entry is discarded.
+     *
+     * @return bool True if a write failed.
+     */
+    bool hasWriteError() const;
+
+    /**
+     * @brief Sets how often the writer thread syncs the file to disk.
+     *
+     * Several drains are batched into one sync. The default, 0, never syncs
+     * explicitly and leaves it to the operating system.
+     *
+     * @param milliseconds Minimum time between syncs, 0 to disable.
+     */
+    void setSyncInterval(int milliseconds);
+
+    /**
+     * @brief Gets the number of bytes waiting in the rings.
+     *
+     * @return long long The queued bytes.
+     */
+    long long getQueuedBytes() const;
+
+    /**
+     * @brief Gets the number of bytes written to the file since construction.
+     *
+     * @return long long The written bytes.
+     */
+    long long getWrittenBytes() const;
+
+    /**
+     * @brief Gets the number of bytes dropped because a ring was full, the file was closed
+     *        or a write had failed.
+     *
+     * @return long long The dropped bytes.
+     */
+    long long getDroppedBytes() const;
+
+    /**
+     * @brief Gets the number of bytes that were queued but discarded because a write
+     *        to the file failed.
+     *
+     * @return long long The lost bytes.
+     */
+    long long getLostBytes() const;
+};
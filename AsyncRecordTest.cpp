@@ -0,0 +1,198 @@
+/**
+ * @file AsyncRecordTest.cpp
+ * @brief Test file for the AsyncRecord class.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AsyncRecord.h"
+
+/**
+ * @brief Builds the log line of one control loop iteration.
+ *
+ * @param producer Producer thread number.
+ * @param i Iteration number.
+ * @return std::string The line.
+ */
+std::string makeLine(int producer, int i) {
+    std::ostringstream line;
+    line << "producer " << producer << " iteration " << i << " pose 1.25 2.50 0.75";
+    return line.str();
+}
+
+/**
+ * @brief Prints percentiles of per-call latencies.
+ *
+ * @param label Name of the measurement.
+ * @param samples Latencies in nanoseconds; sorted in place.
+ */
+void printLatency(const char* label, std::vector<long long>& samples) {
+    std::sort(samples.begin(), samples.end());
+    std::cout << "[Bench] " << label << ": p50 " << samples[samples.size() / 2] << " ns, p99 "
+              << samples[samples.size() * 99 / 100] << " ns, max " << samples.back() << " ns\n";
+}
+
+/**
+ * @brief Main function to test the AsyncRecord class.
+ *
+ * This function performs various tests on the AsyncRecord class:
+ * - Writes lines from four threads and checks every line arrives whole.
+ * - Fills a small ring and checks the dropped byte counter.
+ * - Closes the file while producers write and checks every accepted line was written
+ *   to it and none leaked into the next file.
+ * - Writes to a full device (Linux only), checks that flush() reports the failure and
+ *   that every byte offered is counted as dropped, queued, written or lost.
+ * - Compares the per-line latency of Record with a flush per line and of AsyncRecord
+ *   with batched disk syncs.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- AsyncRecord Test Start -----\n";
+
+    // 1. Four producers
+    const int producers = 4;
+    const int lines = 50000;
+    AsyncRecord async;
+    async.openFile("testAsyncRecord.txt");
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.push_back(std::thread([&async, p]() {
+            for (int i = 0; i < lines; ++i) {
+                while (!async.writeLine(makeLine(p, i))) {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (std::size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+    bool flushed = async.flush();
+    std::cout << "[Test] flush() => " << flushed << ", queued after flush => " << async.getQueuedBytes() << "\n";
+    async.closeFile();
+
+    std::ifstream in("testAsyncRecord.txt");
+    std::vector<int> next(producers, 0);
+    std::string line;
+    int total = 0;
+    bool ordered = true;
+    while (std::getline(in, line)) {
+        int p = line[9] - '0';
+        ordered = ordered && p >= 0 && p < producers && line == makeLine(p, next[p]);
+        if (p >= 0 && p < producers) {
+            ++next[p];
+        }
+        ++total;
+    }
+    std::cout << "[Test] Lines read => " << total << " (" << producers * lines << "), whole and in order => "
+              << ordered << "\n";
+    std::cout << "[Test] Written bytes => " << async.getWrittenBytes() << ", dropped => " << async.getDroppedBytes() << "\n";
+
+    // 2. Drops when the ring is full
+    AsyncRecord small(64);
+    small.openFile("testAsyncRecordSmall.txt");
+    std::string big(100, 'x');
+    std::cout << "[Test] Entry larger than ring queued => " << small.writeLine(big)
+              << ", dropped => " << small.getDroppedBytes() << " (101)\n";
+    small.closeFile();
+    std::cout << "[Test] Write after close queued => " << small.writeLine("late") << "\n";
+
+    // 3. Closing while producers write
+    std::atomic<bool> producing(true);
+    std::atomic<int> accepted(0);
+    AsyncRecord racing;
+    racing.openFile("testAsyncRecordClose.txt");
+    threads.clear();
+    for (int p = 0; p < producers; ++p) {
+        threads.push_back(std::thread([&racing, &producing, &accepted, p]() {
+            for (int i = 0; producing.load(); ++i) {
+                if (racing.writeLine(makeLine(p, i))) {
+                    ++accepted;
+                }
+            }
+        }));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    racing.closeFile();
+    producing = false;
+    for (std::size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+    long long queuedAfterClose = racing.getQueuedBytes();
+    racing.openFile("testAsyncRecordReopen.txt");
+    racing.flush();
+    racing.closeFile();
+    int closedLines = 0;
+    std::ifstream closedIn("testAsyncRecordClose.txt");
+    while (std::getline(closedIn, line)) {
+        ++closedLines;
+    }
+    std::ifstream reopened("testAsyncRecordReopen.txt", std::ios::binary | std::ios::ate);
+    std::cout << "[Test] Lines accepted => " << accepted.load() << ", written => " << closedLines
+              << ", queued after close => " << queuedAfterClose << " (0), bytes in the next file => "
+              << static_cast<long long>(reopened.tellg()) << " (0)\n";
+
+    // 4. Write failures
+#if defined(__linux__)
+    AsyncRecord full;
+    full.openFile("/dev/full");
+    for (int i = 0; i < 100000; ++i) {
+        full.writeLine(makeLine(0, i));
+    }
+    bool fullFlushed = full.flush();
+    std::cout << "[Test] flush() on a full device => " << fullFlushed << " (0), write error => "
+              << full.hasWriteError() << ", queued => " << full.getQueuedBytes() << " (0), write after error queued => "
+              << full.writeLine("late") << "\n";
+    long long offered = 0;
+    for (int i = 0; i < 100000; ++i) {
+        offered += static_cast<long long>(makeLine(0, i).size()) + 1;
+    }
+    offered += 5;
+    std::cout << "[Test] Dropped + queued + written + lost => "
+              << full.getDroppedBytes() + full.getQueuedBytes() + full.getWrittenBytes() + full.getLostBytes()
+              << " (" << offered << "), lost => " << (full.getLostBytes() > 0) << "\n";
+    full.closeFile();
+#endif
+
+    // 5. Latency of a 1 kHz-style logging call
+    const int samples = 20000;
+    std::vector<long long> syncLatency, asyncLatency;
+    syncLatency.reserve(samples);
+    asyncLatency.reserve(samples);
+    typedef std::chrono::steady_clock Clock;
+
+    Record record;
+    record.openFile("testAsyncRecordSync.txt", std::ios::out | std::ios::trunc);
+    for (int i = 0; i < samples; ++i) {
+        std::string text = makeLine(0, i);
+        Clock::time_point t0 = Clock::now();
+        record.writeLine(text);
+        record.flush();
+        syncLatency.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+    }
+    record.closeFile();
+
+    AsyncRecord logger;
+    logger.setSyncInterval(50);
+    logger.openFile("testAsyncRecordAsync.txt");
+    for (int i = 0; i < samples; ++i) {
+        std::string text = makeLine(0, i);
+        Clock::time_point t0 = Clock::now();
+        logger.writeLine(text);
+        asyncLatency.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+    }
+    logger.closeFile();
+    printLatency("Record writeLine + flush", syncLatency);
+    printLatency("AsyncRecord writeLine (fsync every 50 ms)", asyncLatency);
+
+    std::cout << "----- AsyncRecord Test Complete -----\n";
+    return 0;
+}
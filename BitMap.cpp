@@ -0,0 +1,303 @@
+#include "BitMap.h"
+#include "Map.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#include <intrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define BITMAP_USE_SSE2 1
+#endif
+
+
+namespace {
+
+inline int popcount64(std::uint64_t word) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+    return static_cast<int>(__popcnt64(word));
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Mask of the bits [from, to) of a word, 0 <= from < to <= 64.
+inline std::uint64_t bitRange(int from, int to) {
+    std::uint64_t high = (to >= 64) ? ~0ULL : ((1ULL << to) - 1);
+    return high & ~((1ULL << from) - 1);
+}
+
+}
+
+
+std::uint64_t* BitMap::allocate(int sizeX, int sizeY, int& rowStride)
+{
+    const int wordsPerLine = CACHE_LINE_SIZE / static_cast<int>(sizeof(std::uint64_t));
+    long long rows = std::max(sizeY, 0);
+    long long rowWords = (static_cast<long long>(std::max(sizeX, 0)) + CELLS_PER_WORD - 1) / CELLS_PER_WORD;
+    long long padded = (rowWords + wordsPerLine - 1) / wordsPerLine * wordsPerLine;
+    if (padded > INT_MAX || (rows > 0 && padded > INT_MAX / rows)) {
+        throw std::bad_alloc();
+    }
+    rowStride = static_cast<int>(padded);
+    size_t bytes = static_cast<size_t>(padded * rows) * sizeof(std::uint64_t);
+    if (bytes == 0) {
+        return nullptr;
+    }
+    void* buffer = nullptr;
+#if defined(_MSC_VER)
+    buffer = _aligned_malloc(bytes, CACHE_LINE_SIZE);
+#else
+    if (posix_memalign(&buffer, CACHE_LINE_SIZE, bytes) != 0) {
+        buffer = nullptr;
+    }
+#endif
+    if (!buffer) {
+        throw std::bad_alloc();
+    }
+    std::memset(buffer, 0, bytes);
+    return static_cast<std::uint64_t*>(buffer);
+}
+
+void BitMap::release(std::uint64_t* buffer)
+{
+#if defined(_MSC_VER)
+    _aligned_free(buffer);
+#else
+    std::free(buffer);
+#endif
+}
+
+size_t BitMap::wordCount() const {
+    return static_cast<size_t>(stride) * static_cast<size_t>(std::max(dimY, 0));
+}
+
+BitMap::BitMap(int sizeX, int sizeY)
+    : words(nullptr), dimX(sizeX), dimY(sizeY), stride(0), version(newMapVersionBase())
+{
+    words = allocate(dimX, dimY, stride);
+}
+
+BitMap::BitMap(const BitMap& other)
+    : words(nullptr), dimX(other.dimX), dimY(other.dimY), stride(0), version(newMapVersionBase())
+{
+    words = allocate(dimX, dimY, stride);
+    if (words) {
+        std::memcpy(words, other.words, wordCount() * sizeof(std::uint64_t));
+    }
+}
+
+BitMap& BitMap::operator=(const BitMap& other) {
+    if (this != &other) {
+        BitMap copy(other);
+        std::swap(words, copy.words);
+        std::swap(dimX, copy.dimX);
+        std::swap(dimY, copy.dimY);
+        std::swap(stride, copy.stride);
+        std::swap(version, copy.version);
+    }
+    return *this;
+}
+
+BitMap::~BitMap() {
+    release(words);
+}
+
+void BitMap::clearMap() {
+    ++version;
+    size_t count = wordCount();
+#if defined(BITMAP_USE_SSE2)
+    // Rows are padded to whole cache lines, so the word count is a multiple of 8.
+    const __m128i zero = _mm_setzero_si128();
+    for (size_t i = 0; i < count; i += 2) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(words + i), zero);
+    }
+#else
+    if (words) {
+        std::memset(words, 0, count * sizeof(std::uint64_t));
+    }
+#endif
+}
+
+void BitMap::insertPoint(const Point& point) {
+    if (point.getX() >= 0 && point.getX() < dimX &&
+        point.getY() >= 0 && point.getY() < dimY)
+    {
+        setGrid(static_cast<int>(point.getX()), static_cast<int>(point.getY()), 1);
+    }
+}
+
+int BitMap::getGrid(int x, int y) const {
+    if (x >= 0 && x < dimX && y >= 0 && y < dimY) {
+        return static_cast<int>((words[static_cast<size_t>(y) * stride + (x >> 6)] >> (x & 63)) & 1ULL);
+    }
+    return -1;
+}
+
+void BitMap::setGrid(int x, int y, int value) {
+    if (x >= 0 && x < dimX && y >= 0 && y < dimY) {
+        std::uint64_t& word = words[static_cast<size_t>(y) * stride + (x >> 6)];
+        std::uint64_t bit = 1ULL << (x & 63);
+        if (value != 0) {
+            word |= bit;
+        } else {
+            word &= ~bit;
+        }
+        ++version;
+    }
+}
+
+int BitMap::getNumberX() const {
+    return dimX;
+}
+
+int BitMap::getNumberY() const {
+    return dimY;
+}
+
+int BitMap::getStride() const {
+    return stride;
+}
+
+std::uint64_t BitMap::getVersion() const {
+    return version;
+}
+
+const std::uint64_t* BitMap::rowWords(int y) const {
+    return words + static_cast<size_t>(y) * stride;
+}
+
+void BitMap::addGridSize(int deltaX, int deltaY) {
+    setGridSize(dimX + deltaX, dimY + deltaY);
+}
+
+void BitMap::setGridSize(int sizeX, int sizeY) {
+    int newStride = 0;
+    std::uint64_t* resized = allocate(sizeX, sizeY, newStride);
+    int copyX = std::min(dimX, sizeX);
+    int copyY = std::min(dimY, sizeY);
+    if (copyX > 0) {
+        int fullWords = copyX / CELLS_PER_WORD;
+        int tailBits = copyX % CELLS_PER_WORD;
+        for (int y = 0; y < copyY; ++y) {
+            std::uint64_t* dst = resized + static_cast<size_t>(y) * newStride;
+            const std::uint64_t* src = words + static_cast<size_t>(y) * stride;
+            std::memcpy(dst, src, fullWords * sizeof(std::uint64_t));
+            if (tailBits) {
+                // Drop cells beyond the new width so padding bits stay zero.
+                dst[fullWords] = src[fullWords] & bitRange(0, tailBits);
+            }
+        }
+    }
+    release(words);
+    words = resized;
+    stride = newStride;
+    dimX = sizeX;
+    dimY = sizeY;
+    ++version;
+}
+
+bool BitMap::mergeOr(const BitMap& other) {
+    if (dimX != other.dimX || dimY != other.dimY) {
+        return false;
+    }
+    ++version;
+    size_t count = wordCount();
+#if defined(BITMAP_USE_SSE2)
+    for (size_t i = 0; i < count; i += 2) {
+        __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(words + i));
+        __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(other.words + i));
+        _mm_store_si128(reinterpret_cast<__m128i*>(words + i), _mm_or_si128(a, b));
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        words[i] |= other.words[i];
+    }
+#endif
+    return true;
+}
+
+bool BitMap::mergeAnd(const BitMap& other) {
+    if (dimX != other.dimX || dimY != other.dimY) {
+        return false;
+    }
+    ++version;
+    size_t count = wordCount();
+#if defined(BITMAP_USE_SSE2)
+    for (size_t i = 0; i < count; i += 2) {
+        __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(words + i));
+        __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(other.words + i));
+        _mm_store_si128(reinterpret_cast<__m128i*>(words + i), _mm_and_si128(a, b));
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        words[i] &= other.words[i];
+    }
+#endif
+    return true;
+}
+
+long long BitMap::countOccupied() const {
+    // Padding bits are always zero, so the whole buffer can be counted at once.
+    size_t count = wordCount();
+    long long total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += popcount64(words[i]);
+    }
+    return total;
+}
+
+long long BitMap::countOccupied(int x0, int y0, int x1, int y1) const {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, dimX - 1);
+    y1 = std::min(y1, dimY - 1);
+    if (x0 > x1 || y0 > y1) {
+        return 0;
+    }
+    int firstWord = x0 >> 6;
+    int lastWord = x1 >> 6;
+    std::uint64_t firstMask = bitRange(x0 & 63, 64);
+    std::uint64_t lastMask = bitRange(0, (x1 & 63) + 1);
+    long long total = 0;
+    for (int y = y0; y <= y1; ++y) {
+        const std::uint64_t* row = rowWords(y);
+        if (firstWord == lastWord) {
+            total += popcount64(row[firstWord] & firstMask & lastMask);
+            continue;
+        }
+        total += popcount64(row[firstWord] & firstMask);
+        for (int w = firstWord + 1; w < lastWord; ++w) {
+            total += popcount64(row[w]);
+        }
+        total += popcount64(row[lastWord] & lastMask);
+    }
+    return total;
+}
+
+size_t BitMap::getMemoryUsage() const {
+    return wordCount() * sizeof(std::uint64_t);
+}
+
+void BitMap::printInfo() const {
+    std::cout << "Grid dimensions: " << dimX << " x " << dimY
+              << " (bit-packed, " << getMemoryUsage() << " bytes)" << std::endl;
+}
+
+void BitMap::showMap() const {
+    for (int y = 0; y < dimY; ++y) {
+        for (int x = 0; x < dimX; ++x) {
+            std::cout << (getGrid(x, y) == 0 ? '.' : 'x') << " ";
+        }
+        std::cout << std::endl;
+    }
+}
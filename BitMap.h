@@ -0,0 +1,243 @@
+/**
+ * @file BitMap.h
+ * @brief Declaration of the BitMap class.
+ */
+
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <iostream>
+#include <cstdint>
+#include "Point.h"
+
+/**
+ * @class BitMap
+ * @brief Manages a bit-packed binary occupancy grid.
+ *
+ * This class offers the same interface as Map but stores one bit per cell, 64 cells
+ * per word. Rows are padded to a whole number of cache lines and the buffer is
+ * cache-aligned, so full-map operations (clear, merge, popcount) run over contiguous
+ * words and are vectorized where SSE2 is available.
+ */
+class BitMap {
+private:
+    std::uint64_t* words; ///< Cache-aligned row-major word buffer
+    int dimX; ///< Number of columns in the grid
+    int dimY; ///< Number of rows in the grid
+    int stride; ///< Number of words between the starts of two consecutive rows
+    std::uint64_t version; ///< Changes whenever a cell may have changed
+
+    /**
+     * @brief Allocates a zeroed word buffer for the given dimensions.
+     *
+     * @param sizeX Number of columns.
+     * @param sizeY Number of rows.
+     * @param rowStride Receives the padded row stride in words.
+     * @return std::uint64_t* The allocated buffer, or nullptr for an empty grid.
+     * @throws std::bad_alloc If the padded grid holds more than INT_MAX words or the
+     *         memory cannot be allocated.
+     */
+    static std::uint64_t* allocate(int sizeX, int sizeY, int& rowStride);
+
+    /**
+     * @brief Releases a buffer obtained from allocate().
+     *
+     * @param buffer The buffer to release.
+     */
+    static void release(std::uint64_t* buffer);
+
+    /**
+     * @brief Gets the total number of words in the buffer, padding included.
+     *
+     * @return size_t The number of words.
+     */
+    size_t wordCount() const;
+
+public:
+    static const int CELLS_PER_WORD = 64; ///< Number of cells packed into one word
+    static const int CACHE_LINE_SIZE = 64; ///< Alignment of the buffer and of each row in bytes
+
+    /**
+     * @brief Constructs a BitMap object with specified dimensions.
+     *
+     * Initializes the grid with the given dimensions, defaulting to 10x10. All cells are free.
+     *
+     * @param sizeX Number of columns in the grid.
+     * @param sizeY Number of rows in the grid.
+     */
+    BitMap(int sizeX = 10, int sizeY = 10);
+
+    /**
+     * @brief Copy constructor. Duplicates the word buffer.
+     *
+     * @param other The map to copy.
+     */
+    BitMap(const BitMap& other);
+
+    /**
+     * @brief Copy assignment operator. Duplicates the word buffer.
+     *
+     * @param other The map to copy.
+     * @return BitMap& This map.
+     */
+    BitMap& operator=(const BitMap& other);
+
+    /**
+     * @brief Destructor. Releases the word buffer.
+     */
+    ~BitMap();
+
+    /**
+     * @brief Clears the map by setting all cells to 0.
+     */
+    void clearMap();
+
+    /**
+     * @brief Inserts a point into the map.
+     *
+     * Sets the cell at the point's coordinates to 1.
+     *
+     * @param point The point to be inserted.
+     */
+    void insertPoint(const Point& point);
+
+    /**
+     * @brief Gets the value at the specified grid coordinates.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return int 0 or 1, or -1 if out of bounds.
+     */
+    int getGrid(int x, int y) const;
+
+    /**
+     * @brief Sets the value at the specified grid coordinates.
+     *
+     * Any non-zero value marks the cell as occupied.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @param value The value to set at the specified coordinates.
+     */
+    void setGrid(int x, int y, int value);
+
+    /**
+     * @brief Gets the number of columns in the grid.
+     *
+     * @return int The number of columns.
+     */
+    int getNumberX() const;
+
+    /**
+     * @brief Gets the number of rows in the grid.
+     *
+     * @return int The number of rows.
+     */
+    int getNumberY() const;
+
+    /**
+     * @brief Gets the row stride of the word buffer.
+     *
+     * @return int The number of words between the starts of two consecutive rows.
+     */
+    int getStride() const;
+
+    /**
+     * @brief Gets the version of the map contents.
+     *
+     * The version changes whenever a cell may have changed, and never repeats the
+     * version of another map object, BitMap or Map, so (map, version) identifies the contents.
+     *
+     * @return std::uint64_t The version.
+     */
+    std::uint64_t getVersion() const;
+
+    /**
+     * @brief Gets the words of the specified row.
+     *
+     * Cell x of the row is bit (x % 64) of word (x / 64). The row index is not bounds checked.
+     *
+     * @param y The row index.
+     * @return const std::uint64_t* Pointer to the first word of the row.
+     */
+    const std::uint64_t* rowWords(int y) const;
+
+    /**
+     * @brief Adds to the grid size.
+     *
+     * @param deltaX The number of columns to add.
+     * @param deltaY The number of rows to add.
+     */
+    void addGridSize(int deltaX, int deltaY);
+
+    /**
+     * @brief Sets the grid size.
+     *
+     * Cells inside both the old and the new dimensions keep their values; new cells are free.
+     *
+     * @param sizeX The new number of columns.
+     * @param sizeY The new number of rows.
+     */
+    void setGridSize(int sizeX, int sizeY);
+
+    /**
+     * @brief Marks every cell occupied in either map as occupied (bitwise OR).
+     *
+     * Both maps must have the same dimensions.
+     *
+     * @param other The map to merge.
+     * @return bool True if the maps were merged, false if the dimensions differ.
+     */
+    bool mergeOr(const BitMap& other);
+
+    /**
+     * @brief Keeps only the cells occupied in both maps (bitwise AND).
+     *
+     * Both maps must have the same dimensions.
+     *
+     * @param other The map to intersect with.
+     * @return bool True if the maps were merged, false if the dimensions differ.
+     */
+    bool mergeAnd(const BitMap& other);
+
+    /**
+     * @brief Counts the occupied cells in the whole map.
+     *
+     * @return long long The number of occupied cells.
+     */
+    long long countOccupied() const;
+
+    /**
+     * @brief Counts the occupied cells in a rectangular region.
+     *
+     * The region spans [x0, x1] x [y0, y1] inclusive and is clipped to the grid.
+     *
+     * @param x0 First column of the region.
+     * @param y0 First row of the region.
+     * @param x1 Last column of the region.
+     * @param y1 Last row of the region.
+     * @return long long The number of occupied cells in the region.
+     */
+    long long countOccupied(int x0, int y0, int x1, int y1) const;
+
+    /**
+     * @brief Gets the size of the word buffer in bytes.
+     *
+     * @return size_t The number of bytes used by the cells.
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Prints information about the map.
+     */
+    void printInfo() const;
+
+    /**
+     * @brief Displays the map.
+     *
+     * Outputs the grid to the console.
+     */
+    void showMap() const;
+};
+
+#endif // BITMAP_H
@@ -0,0 +1,116 @@
+/**
+ * @file BitMapTest.cpp
+ * @brief Test file for the BitMap class.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <climits>
+#include <new>
+#include "BitMap.h"
+#include "Map.h"
+
+/**
+ * @brief Main function to test the BitMap class.
+ *
+ * This function performs various tests on the BitMap class:
+ * - Inserts points and reads them back through getGrid.
+ * - Counts occupied cells in the whole map and in a region.
+ * - Merges two maps with OR and AND.
+ * - Resizes the map and checks that existing cells are kept.
+ * - Checks that a grid too large to index throws std::bad_alloc.
+ * - Checks that a BitMap and a Map never report the same version.
+ * - Compares memory use and full-map operation timings with Map.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- BitMap Test Start -----\n";
+
+    // 1. Insert and read back
+    BitMap bits(130, 4);
+    bits.printInfo();
+    bits.insertPoint(Point(2.0, 1.0));
+    bits.insertPoint(Point(64.0, 1.0));
+    bits.setGrid(129, 3, 5);
+    std::cout << "[Test] Grid(2,1) => " << bits.getGrid(2, 1)
+              << ", Grid(64,1) => " << bits.getGrid(64, 1)
+              << ", Grid(129,3) => " << bits.getGrid(129, 3)
+              << ", Grid(130,3) => " << bits.getGrid(130, 3) << "\n";
+
+    // 2. Popcount queries
+    std::cout << "[Test] Occupied total => " << bits.countOccupied()
+              << ", region (0,0)-(63,3) => " << bits.countOccupied(0, 0, 63, 3)
+              << ", region (60,1)-(129,3) => " << bits.countOccupied(60, 1, 129, 3) << "\n";
+
+    // 3. OR / AND merge
+    BitMap other(130, 4);
+    other.setGrid(2, 1, 1);
+    other.setGrid(100, 0, 1);
+    BitMap merged = bits;
+    merged.mergeOr(other);
+    std::cout << "[Test] After mergeOr occupied => " << merged.countOccupied() << "\n";
+    merged.mergeAnd(other);
+    std::cout << "[Test] After mergeAnd occupied => " << merged.countOccupied() << "\n";
+    BitMap wrongSize(10, 10);
+    std::cout << "[Test] Merge with different size => " << (merged.mergeOr(wrongSize) ? "merged" : "rejected") << "\n";
+
+    // 4. Resize keeps cells and drops cut-off ones
+    bits.setGridSize(100, 4);
+    std::cout << "[Test] After setGridSize(100,4): Grid(64,1) => " << bits.getGrid(64, 1)
+              << ", occupied => " << bits.countOccupied() << "\n";
+    bits.clearMap();
+    std::cout << "[Test] After clearMap occupied => " << bits.countOccupied() << "\n";
+    bool thrown = false;
+    try {
+        BitMap huge(INT_MAX, INT_MAX);
+    } catch (const std::bad_alloc&) {
+        thrown = true;
+    }
+    std::cout << "[Test] INT_MAX x INT_MAX grid throws => " << thrown << "\n";
+    Map sameSize(100, 4);
+    BitMap fresh(100, 4);
+    std::cout << "[Test] Versions of a BitMap and a Map differ => "
+              << (sameSize.getVersion() != fresh.getVersion() && bits.getVersion() != sameSize.getVersion()) << "\n";
+
+    // 5. Memory use and full-map operations against Map
+    using Clock = std::chrono::steady_clock;
+    const int dim = 4000;
+    Map dense(dim, dim);
+    BitMap packed(dim, dim);
+    for (int i = 0; i < dim; ++i) {
+        dense.setGrid(i, i, 1);
+        packed.setGrid(i, i, 1);
+    }
+    std::cout << "[Bench] Memory: Map " << static_cast<size_t>(dense.getStride()) * dim * sizeof(Map::CellType)
+              << " bytes, BitMap " << packed.getMemoryUsage() << " bytes\n";
+
+    Clock::time_point t0 = Clock::now();
+    long long denseCount = 0;
+    for (int y = 0; y < dim; ++y) {
+        for (int c : dense.row(y)) {
+            denseCount += (c != 0);
+        }
+    }
+    Clock::time_point t1 = Clock::now();
+    long long packedCount = packed.countOccupied();
+    Clock::time_point t2 = Clock::now();
+    BitMap copy = packed;
+    packed.mergeOr(copy);
+    Clock::time_point t3 = Clock::now();
+    dense.clearMap();
+    Clock::time_point t4 = Clock::now();
+    packed.clearMap();
+    Clock::time_point t5 = Clock::now();
+
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    std::cout << "[Bench] Count: Map " << ms(t0, t1) << " ms (" << denseCount << "), BitMap "
+              << ms(t1, t2) << " ms (" << packedCount << ")\n";
+    std::cout << "[Bench] BitMap mergeOr " << ms(t2, t3) << " ms\n";
+    std::cout << "[Bench] Clear: Map " << ms(t3, t4) << " ms, BitMap " << ms(t4, t5) << " ms\n";
+
+    std::cout << "----- BitMap Test Complete -----\n";
+    return 0;
+}
@@ -0,0 +1,308 @@
+#include "DStarLitePlanner.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+
+// Costs are integers so that keys which tie exactly also compare equal; rounding
+// would leave cells on the optimal path unexpanded. 8119 / 5741 is sqrt(2) to 1e-8.
+// They are 64-bit, since a path of a few hundred thousand cells exceeds int32.
+const std::int64_t STRAIGHT = 5741;
+const std::int64_t DIAGONAL = 8119;
+const std::int64_t INF = std::numeric_limits<std::int64_t>::max();
+
+// Same move order as the A* planner; diagonals come last.
+const int MOVE_X[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+const int MOVE_Y[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+const std::int64_t MOVE_COST[8] = { STRAIGHT, STRAIGHT, STRAIGHT, STRAIGHT, DIAGONAL, DIAGONAL, DIAGONAL, DIAGONAL };
+
+inline std::int64_t octile(int x, int y, int toX, int toY) {
+    std::int64_t dx = std::abs(toX - x);
+    std::int64_t dy = std::abs(toY - y);
+    return STRAIGHT * (dx + dy) + (DIAGONAL - 2 * STRAIGHT) * std::min(dx, dy);
+}
+
+inline std::int64_t addCost(std::int64_t cost, std::int64_t g) {
+    return g == INF ? INF : cost + g;
+}
+
+template <typename Entry>
+inline bool keyLess(const Entry& a, const Entry& b) {
+    return a.key1 < b.key1 || (a.key1 == b.key1 && a.key2 < b.key2);
+}
+
+// Min-heap order for std::push_heap and std::pop_heap.
+template <typename Entry>
+inline bool keyLater(const Entry& a, const Entry& b) {
+    return keyLess(b, a);
+}
+
+} // namespace
+
+
+template <typename Cell>
+BasicDStarLitePlanner<Cell>::BasicDStarLitePlanner(Cell obstacleThreshold)
+    : map(nullptr), search(0), sizeX(0), sizeY(0), threshold(obstacleThreshold), startX(0), startY(0),
+      goalX(0), goalY(0), keyOffset(0), expanded(0), pathCost(0.0)
+{
+}
+
+template <typename Cell>
+void BasicDStarLitePlanner<Cell>::setObstacleThreshold(Cell obstacleThreshold) {
+    threshold = obstacleThreshold;
+}
+
+template <typename Cell>
+bool BasicDStarLitePlanner<Cell>::isFree(int x, int y) const {
+    if (x < 0 || y < 0 || x >= sizeX || y >= sizeY) {
+        return false;
+    }
+    return map->data()[static_cast<std::size_t>(y) * map->getStride() + x] < threshold;
+}
+
+template <typename Cell>
+std::int64_t BasicDStarLitePlanner<Cell>::getG(int index) const {
+    return nodes[index].stamp == search ? nodes[index].g : INF;
+}
+
+template <typename Cell>
+std::int64_t BasicDStarLitePlanner<Cell>::getRhs(int index) const {
+    return nodes[index].stamp == search ? nodes[index].rhs : INF;
+}
+
+template <typename Cell>
+typename BasicDStarLitePlanner<Cell>::Node& BasicDStarLitePlanner<Cell>::touch(int index) {
+    Node& node = nodes[index];
+    if (node.stamp != search) {
+        node.g = INF;
+        node.rhs = INF;
+        node.stamp = search;
+    }
+    return node;
+}
+
+template <typename Cell>
+typename BasicDStarLitePlanner<Cell>::OpenEntry BasicDStarLitePlanner<Cell>::makeEntry(int index) const {
+    std::int64_t best = std::min(getG(index), getRhs(index));
+    OpenEntry entry;
+    entry.key1 = best == INF ? INF : best + octile(index % sizeX, index / sizeX, startX, startY) + keyOffset;
+    entry.key2 = best;
+    entry.index = index;
+    return entry;
+}
+
+template <typename Cell>
+void BasicDStarLitePlanner<Cell>::updateVertex(int x, int y) {
+    if (x < 0 || y < 0 || x >= sizeX || y >= sizeY || (x == goalX && y == goalY)) {
+        return;
+    }
+    std::int64_t rhs = INF;
+    if (isFree(x, y)) {
+        for (int move = 0; move < 8; ++move) {
+            int nx = x + MOVE_X[move];
+            int ny = y + MOVE_Y[move];
+            if (!isFree(nx, ny) || (move >= 4 && (!isFree(nx, y) || !isFree(x, ny)))) {
+                continue;
+            }
+            rhs = std::min(rhs, addCost(MOVE_COST[move], getG(ny * sizeX + nx)));
+        }
+    }
+    int index = y * sizeX + x;
+    Node& node = touch(index);
+    node.rhs = rhs;
+    if (node.g != node.rhs) {
+        openList.push_back(makeEntry(index));
+        std::push_heap(openList.begin(), openList.end(), keyLater<OpenEntry>);
+    }
+}
+
+template <typename Cell>
+void BasicDStarLitePlanner<Cell>::computeShortestPath() {
+    const int start = startY * sizeX + startX;
+    while (!openList.empty()) {
+        OpenEntry top = openList.front();
+        int index = top.index;
+        Node& node = touch(index);
+        // A consistent cell, or an entry above the current key, was left behind by an
+        // update that queued the cell again; the current entry is still in the list.
+        OpenEntry current = makeEntry(index);
+        if (node.g == node.rhs || keyLess(current, top)) {
+            std::pop_heap(openList.begin(), openList.end(), keyLater<OpenEntry>);
+            openList.pop_back();
+            continue;
+        }
+        if (!keyLess(top, makeEntry(start)) && getRhs(start) == getG(start)) {
+            break;
+        }
+        std::pop_heap(openList.begin(), openList.end(), keyLater<OpenEntry>);
+        openList.pop_back();
+        if (keyLess(top, current)) {
+            // The start moved since the cell was queued.
+            openList.push_back(current);
+            std::push_heap(openList.begin(), openList.end(), keyLater<OpenEntry>);
+            continue;
+        }
+
+        ++expanded;
+        int x = index % sizeX;
+        int y = index / sizeX;
+        if (node.g > node.rhs) {
+            node.g = node.rhs;
+            // Lowering g can only lower the rhs of the neighbours.
+            for (int move = 0; move < 8; ++move) {
+                int nx = x + MOVE_X[move];
+                int ny = y + MOVE_Y[move];
+                if (!isFree(nx, ny) || (move >= 4 && (!isFree(nx, y) || !isFree(x, ny))) ||
+                    (nx == goalX && ny == goalY)) {
+                    continue;
+                }
+                int next = ny * sizeX + nx;
+                Node& neighbour = touch(next);
+                std::int64_t candidate = node.g + MOVE_COST[move];
+                if (candidate < neighbour.rhs) {
+                    neighbour.rhs = candidate;
+                    if (neighbour.g != neighbour.rhs) {
+                        openList.push_back(makeEntry(next));
+                        std::push_heap(openList.begin(), openList.end(), keyLater<OpenEntry>);
+                    }
+                }
+            }
+        } else {
+            node.g = INF;
+            updateVertex(x, y);
+            for (int move = 0; move < 8; ++move) {
+                updateVertex(x + MOVE_X[move], y + MOVE_Y[move]);
+            }
+        }
+    }
+}
+
+template <typename Cell>
+bool BasicDStarLitePlanner<Cell>::initialize(const BasicMap<Cell>& grid, int fromX, int fromY, int toX, int toY) {
+    map = &grid;
+    if (grid.getNumberX() != sizeX || grid.getNumberY() != sizeY) {
+        sizeX = grid.getNumberX();
+        sizeY = grid.getNumberY();
+        Node unreached = { INF, INF, 0u };
+        nodes.assign(static_cast<std::size_t>(sizeX) * sizeY, unreached);
+        search = 0;
+    }
+    ++search;
+    if (search == 0xffffffffu) {
+        for (Node& node : nodes) {
+            node.stamp = 0;
+        }
+        search = 1;
+    }
+    openList.clear();
+    startX = fromX;
+    startY = fromY;
+    goalX = toX;
+    goalY = toY;
+    keyOffset = 0;
+    expanded = 0;
+    pathCost = 0.0;
+    if (toX < 0 || toY < 0 || toX >= sizeX || toY >= sizeY) {
+        return false;
+    }
+    int goal = toY * sizeX + toX;
+    touch(goal).rhs = 0;
+    openList.push_back(makeEntry(goal));
+    return true;
+}
+
+template <typename Cell>
+void BasicDStarLitePlanner<Cell>::moveStart(int x, int y) {
+    keyOffset += octile(startX, startY, x, y);
+    startX = x;
+    startY = y;
+}
+
+template <typename Cell>
+void BasicDStarLitePlanner<Cell>::updateCells(const std::vector<PathCell>& cells) {
+    if (!map || map->getNumberX() != sizeX || map->getNumberY() != sizeY) {
+        return; // replan() starts a new search on the resized map
+    }
+    // A cell takes part in the edges of its 3 x 3 block only, diagonals it blocks included.
+    for (const PathCell& cell : cells) {
+        if (cell.x < 0 || cell.y < 0 || cell.x >= sizeX || cell.y >= sizeY) {
+            continue;
+        }
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                updateVertex(cell.x + dx, cell.y + dy);
+            }
+        }
+    }
+}
+
+template <typename Cell>
+bool BasicDStarLitePlanner<Cell>::replan(GridPath& path) {
+    path.clear();
+    if (map && (map->getNumberX() != sizeX || map->getNumberY() != sizeY)) {
+        initialize(*map, startX, startY, goalX, goalY);
+    }
+    expanded = 0;
+    pathCost = 0.0;
+    if (!map || nodes.empty() || !isFree(startX, startY) || !isFree(goalX, goalY)) {
+        return false;
+    }
+    computeShortestPath();
+    if (getG(startY * sizeX + startX) == INF) {
+        return false;
+    }
+
+    int x = startX;
+    int y = startY;
+    path.push_back(PathCell{ x, y });
+    std::size_t limit = nodes.size();
+    while ((x != goalX || y != goalY) && path.size() <= limit) {
+        int bestMove = -1;
+        std::int64_t best = INF;
+        for (int move = 0; move < 8; ++move) {
+            int nx = x + MOVE_X[move];
+            int ny = y + MOVE_Y[move];
+            if (!isFree(nx, ny) || (move >= 4 && (!isFree(nx, y) || !isFree(x, ny)))) {
+                continue;
+            }
+            std::int64_t cost = addCost(MOVE_COST[move], getG(ny * sizeX + nx));
+            if (cost < best) {
+                best = cost;
+                bestMove = move;
+            }
+        }
+        if (bestMove < 0) {
+            path.clear();
+            pathCost = 0.0;
+            return false;
+        }
+        x += MOVE_X[bestMove];
+        y += MOVE_Y[bestMove];
+        pathCost += MOVE_COST[bestMove] == STRAIGHT ? 1.0 : 1.4142135623730951;
+        path.push_back(PathCell{ x, y });
+    }
+    if (x != goalX || y != goalY) {
+        path.clear();
+        pathCost = 0.0;
+        return false;
+    }
+    return true;
+}
+
+template <typename Cell>
+double BasicDStarLitePlanner<Cell>::getPathCost() const {
+    return pathCost;
+}
+
+template <typename Cell>
+int BasicDStarLitePlanner<Cell>::getExpandedCount() const {
+    return expanded;
+}
+
+template class BasicDStarLitePlanner<std::int8_t>;
+template class BasicDStarLitePlanner<std::uint8_t>;
+template class BasicDStarLitePlanner<std::int16_t>;
+template class BasicDStarLitePlanner<int>;
+template class BasicDStarLitePlanner<float>;
@@ -0,0 +1,199 @@
+/**
+ * @file DStarLitePlanner.h
+ * @brief Declaration of the DStarLitePlanner class.
+ */
+
+#ifndef DSTARLITEPLANNER_H
+#define DSTARLITEPLANNER_H
+
+#include <cstdint>
+#include <vector>
+#include "AStarPlanner.h"
+#include "Map.h"
+
+/**
+ * @class BasicDStarLitePlanner
+ * @brief Incremental path planner (D* Lite) over a BasicMap.
+ *
+ * The planner searches backwards from the goal and keeps the cost-to-goal of every
+ * cell it has visited. When cells of the map change, updateCells() re-examines only
+ * those cells and their neighbours, and the next replan() repairs the previous
+ * solution from there, so its cost grows with the size of the change and not with
+ * the map. The robot may move along the path with moveStart() without invalidating
+ * the search.
+ *
+ * Moves, costs and the obstacle threshold are those of BasicAStarPlanner, so both
+ * planners return paths of the same cost. Costs are kept as 64-bit integers
+ * internally, so that equal keys compare equal and long paths cannot overflow. The
+ * map is read during replan(); every cell changed since the previous replan() must be
+ * passed to updateCells() first. If the map was resized, replan() starts a new search
+ * instead.
+ */
+template <typename Cell>
+class BasicDStarLitePlanner {
+private:
+    /**
+     * @struct OpenEntry
+     * @brief Entry of the open list. Entries left behind by a key change are skipped
+     *        when popped.
+     */
+    struct OpenEntry {
+        std::int64_t key1; ///< min(g, rhs) + heuristic to the start + keyOffset
+        std::int64_t key2; ///< min(g, rhs)
+        int index; ///< Cell index, y * sizeX + x
+    };
+
+    /**
+     * @struct Node
+     * @brief Search state of one cell.
+     */
+    struct Node {
+        std::int64_t g; ///< Cost to the goal at the last expansion
+        std::int64_t rhs; ///< Cost to the goal through the best neighbour
+        std::uint32_t stamp; ///< Search the values belong to; other cells are at infinity
+    };
+
+    std::vector<Node> nodes; ///< Search state of each cell, y * sizeX + x
+    std::vector<OpenEntry> openList; ///< Binary min-heap ordered by key1, then key2
+    const BasicMap<Cell>* map; ///< Map being planned over
+    std::uint32_t search; ///< Number of the current search
+    int sizeX; ///< Number of columns the arenas are sized for
+    int sizeY; ///< Number of rows the arenas are sized for
+    Cell threshold; ///< Smallest cell value that blocks
+    int startX; ///< Column of the start cell
+    int startY; ///< Row of the start cell
+    int goalX; ///< Column of the goal cell
+    int goalY; ///< Row of the goal cell
+    std::int64_t keyOffset; ///< Heuristic distance the start has moved since the search began
+    int expanded; ///< Cells expanded by the last replan
+    double pathCost; ///< Cost of the last path found
+
+    /**
+     * @brief Checks whether a cell can be traversed.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return bool True if the cell is inside the map and below the obstacle threshold.
+     */
+    bool isFree(int x, int y) const;
+
+    /**
+     * @brief Gets the g value of a cell.
+     *
+     * @param index Cell index.
+     * @return std::int64_t The value, infinite if the search has not reached the cell.
+     */
+    std::int64_t getG(int index) const;
+
+    /**
+     * @brief Gets the rhs value of a cell.
+     *
+     * @param index Cell index.
+     * @return std::int64_t The value, infinite if the search has not reached the cell.
+     */
+    std::int64_t getRhs(int index) const;
+
+    /**
+     * @brief Gets the node of a cell, setting it to infinity on first use in this search.
+     *
+     * @param index Cell index.
+     * @return Node& The node.
+     */
+    Node& touch(int index);
+
+    /**
+     * @brief Recomputes the rhs value of a cell and queues it if it is inconsistent.
+     *
+     * @param x Column of the cell.
+     * @param y Row of the cell.
+     */
+    void updateVertex(int x, int y);
+
+    /**
+     * @brief Computes the key of a cell from its g and rhs values.
+     *
+     * @param index Cell index.
+     * @return OpenEntry The entry to queue.
+     */
+    OpenEntry makeEntry(int index) const;
+
+    /**
+     * @brief Expands cells until the start is consistent and no queued key is smaller.
+     */
+    void computeShortestPath();
+
+public:
+    /**
+     * @brief Constructs a planner.
+     *
+     * @param obstacleThreshold Smallest cell value that blocks.
+     */
+    explicit BasicDStarLitePlanner(Cell obstacleThreshold = 1);
+
+    /**
+     * @brief Sets the obstacle threshold. Takes effect at the next initialize().
+     *
+     * @param obstacleThreshold Smallest cell value that blocks.
+     */
+    void setObstacleThreshold(Cell obstacleThreshold);
+
+    /**
+     * @brief Starts a new search on a map.
+     *
+     * The planner keeps a pointer to the map, which must outlive it or be replaced by
+     * another initialize().
+     *
+     * @param grid The map.
+     * @param fromX Column of the start cell.
+     * @param fromY Row of the start cell.
+     * @param toX Column of the goal cell.
+     * @param toY Row of the goal cell.
+     * @return bool True if the goal is inside the map. The path is computed by replan().
+     */
+    bool initialize(const BasicMap<Cell>& grid, int fromX, int fromY, int toX, int toY);
+
+    /**
+     * @brief Moves the start, typically to the cell the robot has reached.
+     *
+     * @param x Column of the new start cell.
+     * @param y Row of the new start cell.
+     */
+    void moveStart(int x, int y);
+
+    /**
+     * @brief Tells the planner that cells of the map have changed.
+     *
+     * @param cells The changed cells; cells outside the map are ignored, and so are all
+     *              cells once the map has been resized since initialize().
+     */
+    void updateCells(const std::vector<PathCell>& cells);
+
+    /**
+     * @brief Repairs the search after the latest changes and extracts the path.
+     *
+     * If the map was resized since initialize(), the search is started again on the
+     * new size with the same start and goal.
+     *
+     * @param path Receives the path from start to goal; cleared if there is none.
+     * @return bool True if a path was found.
+     */
+    bool replan(GridPath& path);
+
+    /**
+     * @brief Gets the cost of the last path found.
+     *
+     * @return double The length of the path in cells.
+     */
+    double getPathCost() const;
+
+    /**
+     * @brief Gets the number of cells expanded by the last replan().
+     *
+     * @return int The number of expanded cells.
+     */
+    int getExpandedCount() const;
+};
+
+typedef BasicDStarLitePlanner<int> DStarLitePlanner; ///< Incremental planner over the default map type
+
+#endif // DSTARLITEPLANNER_H
@@ -0,0 +1,193 @@
+/**
+ * @file DStarLitePlannerTest.cpp
+ * @brief Test file for the DStarLitePlanner class.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include "DStarLitePlanner.h"
+#include "Mapper.h"
+
+/**
+ * @brief Main function to test the DStarLitePlanner class.
+ *
+ * This function performs various tests on the DStarLitePlanner class:
+ * - Plans the same cost as A* on a fixed map.
+ * - Repairs the plan when an obstacle appears on the path and when it disappears.
+ * - Keeps the search while the start moves along the path.
+ * - Replans from the cells a Mapper scan changed.
+ * - Starts a new search when the map is resized between plans.
+ * - Plans a path too long for 32-bit costs.
+ * - Compares incremental repair with planning from scratch on a 2000 x 2000 map
+ *   while the robot drives and each scan adds a small obstacle ahead of it.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- DStarLitePlanner Test Start -----\n";
+
+    // 1. Same cost as A*
+    Map map(40, 30);
+    for (int y = 0; y < 25; ++y) {
+        map.setGrid(20, y, 1);
+    }
+    DStarLitePlanner planner;
+    AStarPlanner reference;
+    GridPath path, expected;
+    planner.initialize(map, 2, 2, 37, 2);
+    std::cout << "[Test] Initial plan => " << planner.replan(path) << ", cost " << planner.getPathCost()
+              << ", expanded " << planner.getExpandedCount();
+    reference.plan(map, 2, 2, 37, 2, expected);
+    std::cout << "; A* cost " << reference.getPathCost() << "\n";
+
+    // 2. An obstacle appears on the path, then disappears
+    std::vector<PathCell> changed;
+    for (int y = 24; y < 30; ++y) {
+        map.setGrid(20, y, 1);
+        changed.push_back(PathCell{ 20, y });
+    }
+    map.setGrid(20, 29, 0);
+    planner.updateCells(changed);
+    planner.replan(path);
+    reference.plan(map, 2, 2, 37, 2, expected);
+    std::cout << "[Test] Gap narrowed => cost " << planner.getPathCost() << ", expanded " << planner.getExpandedCount()
+              << "; A* cost " << reference.getPathCost() << ", expanded " << reference.getExpandedCount() << "\n";
+    map.setGrid(20, 29, 1);
+    planner.updateCells(std::vector<PathCell>(1, PathCell{ 20, 29 }));
+    std::cout << "[Test] Wall closed => " << planner.replan(path) << ", path cells " << path.size() << "\n";
+    for (int y = 10; y < 14; ++y) {
+        map.setGrid(20, y, 0);
+    }
+    changed.clear();
+    for (int y = 10; y < 14; ++y) {
+        changed.push_back(PathCell{ 20, y });
+    }
+    planner.updateCells(changed);
+    planner.replan(path);
+    reference.plan(map, 2, 2, 37, 2, expected);
+    std::cout << "[Test] Door opened => cost " << planner.getPathCost() << ", A* cost " << reference.getPathCost()
+              << ", expanded " << planner.getExpandedCount() << "\n";
+
+    // 3. Moving start
+    PathCell step = path[path.size() / 2];
+    planner.moveStart(step.x, step.y);
+    map.setGrid(30, 4, 1);
+    map.setGrid(31, 3, 1);
+    changed.assign(1, PathCell{ 30, 4 });
+    changed.push_back(PathCell{ 31, 3 });
+    planner.updateCells(changed);
+    planner.replan(path);
+    reference.plan(map, step.x, step.y, 37, 2, expected);
+    std::cout << "[Test] From (" << step.x << "," << step.y << ") => cost " << planner.getPathCost() << ", A* cost "
+              << reference.getPathCost() << ", starts at (" << path[0].x << "," << path[0].y << ")\n";
+
+    // 4. Cells changed by a Mapper scan
+    Mapper mapper(20, 20, 10, 10);
+    DStarLitePlanner robotPlanner;
+    robotPlanner.initialize(mapper.getLocalMap(), 10, 10, 18, 10);
+    robotPlanner.replan(path);
+    std::cout << "[Test] Mapper plan cost " << robotPlanner.getPathCost();
+    mapper.updateMap({{4, 0}, {4, 10}, {4, 350}, {4, 0}});
+    robotPlanner.updateCells(mapper.getChangedCells());
+    robotPlanner.replan(path);
+    std::cout << ", scan changed " << mapper.getChangedCells().size() << " cells, new cost "
+              << robotPlanner.getPathCost() << "\n";
+
+    // 5. The map is resized between plans
+    Map resizable(40, 30);
+    DStarLitePlanner resizing;
+    resizing.initialize(resizable, 2, 2, 37, 2);
+    resizing.replan(path);
+    resizable.setGridSize(20, 10);
+    resizable.setGrid(15, 5, 1);
+    resizing.updateCells(std::vector<PathCell>(1, PathCell{ 15, 5 }));
+    std::cout << "[Test] Shrunk past the goal => " << resizing.replan(path);
+    resizable.setGridSize(50, 30);
+    resizing.replan(path);
+    reference.plan(resizable, 2, 2, 37, 2, expected);
+    std::cout << ", grown again => cost " << resizing.getPathCost() << ", A* cost " << reference.getPathCost() << "\n";
+
+    // 6. A path long enough to overflow 32-bit costs: 200 corridors of 2000 cells
+    Map serpentine(2000, 400);
+    for (int y = 1; y < 400; y += 2) {
+        for (int x = 0; x < 2000; ++x) {
+            serpentine.setGrid(x, y, 1);
+        }
+        serpentine.setGrid(y % 4 == 1 ? 1999 : 0, y, 0);
+    }
+    DStarLitePlanner longPlanner;
+    longPlanner.initialize(serpentine, 0, 0, 0, 398);
+    bool found = longPlanner.replan(path);
+    reference.plan(serpentine, 0, 0, 0, 398, expected);
+    std::cout << "[Test] Long path => " << found << ", cells " << path.size() << ", cost " << longPlanner.getPathCost()
+              << ", A* cost " << reference.getPathCost() << "\n";
+
+    // 7. Benchmark: drive across a 2000 x 2000 map, a small obstacle appears ahead after each scan
+    using Clock = std::chrono::steady_clock;
+    Map large(2000, 2000);
+    std::uint32_t seed = 11u;
+    for (int i = 0; i < 1500; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        int x0 = static_cast<int>((seed >> 8) % 2000);
+        seed = seed * 1664525u + 1013904223u;
+        int y0 = static_cast<int>((seed >> 8) % 2000);
+        for (int y = y0; y < y0 + 20 && y < 2000; ++y) {
+            for (int x = x0; x < x0 + 20 && x < 2000; ++x) {
+                large.setGrid(x, y, 1);
+            }
+        }
+    }
+    for (int y = 95; y < 106; ++y) {
+        for (int x = 95; x < 106; ++x) {
+            large.setGrid(x, y, 0);
+            large.setGrid(1800 + x, 1800 + y, 0);
+        }
+    }
+    DStarLitePlanner incremental;
+    Clock::time_point t0 = Clock::now();
+    incremental.initialize(large, 100, 100, 1900, 1900);
+    incremental.replan(path);
+    double initialMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    int initialExpanded = incremental.getExpandedCount();
+    double repairMs = 0.0, scratchMs = 0.0;
+    long long repairExpanded = 0, scratchExpanded = 0;
+    int rounds = 0, mismatches = 0;
+    for (; rounds < 100 && path.size() > 60; ++rounds) {
+        PathCell robot = path[20];
+        PathCell ahead = path[40];
+        changed.clear();
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                int x = ahead.x + dx;
+                int y = ahead.y + dy;
+                if (std::abs(x - robot.x) > 2 || std::abs(y - robot.y) > 2) {
+                    large.setGrid(x, y, 1);
+                    changed.push_back(PathCell{ x, y });
+                }
+            }
+        }
+        t0 = Clock::now();
+        incremental.moveStart(robot.x, robot.y);
+        incremental.updateCells(changed);
+        incremental.replan(path);
+        repairMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        repairExpanded += incremental.getExpandedCount();
+        t0 = Clock::now();
+        reference.plan(large, robot.x, robot.y, 1900, 1900, expected);
+        scratchMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        scratchExpanded += reference.getExpandedCount();
+        // A* sums float costs, which drift by a few hundredths over thousands of moves.
+        if (std::fabs(incremental.getPathCost() - reference.getPathCost()) > 1e-4 * reference.getPathCost()) {
+            ++mismatches;
+        }
+    }
+    std::cout << "[Bench] Initial D* Lite plan " << initialMs << " ms, " << initialExpanded << " cells expanded\n";
+    std::cout << "[Bench] " << rounds << " scans, per replan: D* Lite repair " << repairMs / rounds << " ms ("
+              << repairExpanded / rounds << " cells), A* from scratch " << scratchMs / rounds << " ms ("
+              << scratchExpanded / rounds << " cells); cost mismatches => " << mismatches << "\n";
+
+    std::cout << "----- DStarLitePlanner Test Complete -----\n";
+    return 0;
+}
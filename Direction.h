@@ -0,0 +1,21 @@
+/**
+ * @file Direction.h
+ * @brief Declaration of the DIRECTION enum used by the robot backends.
+ */
+
+#pragma once
+
+#if defined(_WIN32)
+#include "FestoRobotAPI.h"
+#else
+/**
+ * @enum DIRECTION
+ * @brief Motion directions, as declared by FestoRobotAPI.h on Windows.
+ */
+enum DIRECTION {
+    FORWARD = 0,
+    BACKWARD,
+    LEFT,
+    RIGHT
+};
+#endif
@@ -0,0 +1,317 @@
+#include "DistanceField.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace {
+
+// Column distance of a cell with no obstacle in its column.
+const int NO_OBSTACLE = std::numeric_limits<int>::max();
+// Squared distance of a cell in a map with no obstacle. Squared distances are 64-bit,
+// since they pass the int32 range once the sides of a map reach 32768 cells.
+const std::int64_t FAR_AWAY = std::numeric_limits<std::int64_t>::max();
+
+// Fewer rows or columns than this per thread are not worth starting a thread for.
+const int MIN_SHARE = 64;
+
+} // namespace
+
+
+template <typename Cell>
+const std::uint8_t BasicDistanceField<Cell>::LETHAL_COST;
+
+template <typename Cell>
+const std::uint8_t BasicDistanceField<Cell>::INSCRIBED_COST;
+
+template <typename Cell>
+BasicDistanceField<Cell>::BasicDistanceField(Cell obstacleThreshold, int threadCount)
+    : map(nullptr), costs(0, 0), sizeX(0), sizeY(0), threshold(obstacleThreshold),
+      threads(threadCount > 0 ? threadCount : static_cast<int>(std::thread::hardware_concurrency())),
+      robotRadius(0.0f), inflationRadius(0.0f)
+{
+    threads = std::max(threads, 1);
+    buildCostTable();
+}
+
+template <typename Cell>
+void BasicDistanceField<Cell>::setObstacleThreshold(Cell obstacleThreshold) {
+    threshold = obstacleThreshold;
+}
+
+template <typename Cell>
+template <typename Work>
+int BasicDistanceField<Cell>::parallelFor(int count, const Work& work) const {
+    int shares = std::max(1, std::min(threads, count / MIN_SHARE));
+    std::vector<std::thread> workers;
+    for (int share = 1; share < shares; ++share) {
+        int begin = static_cast<int>(static_cast<long long>(count) * share / shares);
+        int end = static_cast<int>(static_cast<long long>(count) * (share + 1) / shares);
+        workers.emplace_back([&work, share, begin, end]() { work(share, begin, end); });
+    }
+    work(0, 0, static_cast<int>(static_cast<long long>(count) / shares));
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return shares;
+}
+
+template <typename Cell>
+void BasicDistanceField<Cell>::buildCostTable() {
+    // Squared distances are integers, so one entry per value up to the inflation radius.
+    int last = static_cast<int>(std::floor(inflationRadius * inflationRadius));
+    costTable.assign(last + 1, 0);
+    costTable[0] = LETHAL_COST;
+    for (int squared = 1; squared <= last; ++squared) {
+        float distance = std::sqrt(static_cast<float>(squared));
+        if (distance <= robotRadius) {
+            costTable[squared] = INSCRIBED_COST;
+        } else if (inflationRadius > robotRadius) {
+            float share = (inflationRadius - distance) / (inflationRadius - robotRadius);
+            costTable[squared] = static_cast<std::uint8_t>(std::lround((INSCRIBED_COST - 1) * share));
+        }
+    }
+}
+
+template <typename Cell>
+std::uint8_t BasicDistanceField<Cell>::costOf(std::int64_t squared) const {
+    return squared < static_cast<std::int64_t>(costTable.size()) ? costTable[squared] : 0;
+}
+
+template <typename Cell>
+void BasicDistanceField<Cell>::computeColumns(int minX, int maxX) {
+    const Cell* cells = map->data();
+    const std::size_t stride = static_cast<std::size_t>(map->getStride());
+    // Down then up the columns, one row at a time so the inner loop runs along memory.
+    for (int y = 0; y < sizeY; ++y) {
+        const Cell* row = cells + y * stride;
+        int* distances = columnDistances.data() + static_cast<std::size_t>(y) * sizeX;
+        for (int x = minX; x < maxX; ++x) {
+            if (!(row[x] < threshold)) {
+                distances[x] = 0;
+            } else {
+                int above = y > 0 ? distances[x - sizeX] : NO_OBSTACLE;
+                distances[x] = above == NO_OBSTACLE ? NO_OBSTACLE : above + 1;
+            }
+        }
+    }
+    for (int y = sizeY - 2; y >= 0; --y) {
+        int* distances = columnDistances.data() + static_cast<std::size_t>(y) * sizeX;
+        const int* below = distances + sizeX;
+        for (int x = minX; x < maxX; ++x) {
+            if (below[x] != NO_OBSTACLE && below[x] + 1 < distances[x]) {
+                distances[x] = below[x] + 1;
+            }
+        }
+    }
+}
+
+template <typename Cell>
+void BasicDistanceField<Cell>::computeRow(int y, int* sites, double* bounds, std::vector<int>* changed) {
+    const int* column = columnDistances.data() + static_cast<std::size_t>(y) * sizeX;
+    std::int64_t* squared = squaredDistances.data() + static_cast<std::size_t>(y) * sizeX;
+    std::uint8_t* cost = costs.data() + static_cast<std::size_t>(y) * costs.getStride();
+
+    // Lower envelope of the parabolas (x - q)^2 + column[q]^2; parabola k is the lowest
+    // between bounds[k] and bounds[k + 1].
+    int k = -1;
+    for (int q = 0; q < sizeX; ++q) {
+        if (column[q] == NO_OBSTACLE) {
+            continue;
+        }
+        double fq = static_cast<double>(column[q]) * column[q] + static_cast<double>(q) * q;
+        double s = 0.0;
+        while (k >= 0) {
+            int p = sites[k];
+            double fp = static_cast<double>(column[p]) * column[p] + static_cast<double>(p) * p;
+            s = (fq - fp) / (2.0 * (q - p));
+            if (s > bounds[k]) {
+                break;
+            }
+            --k;
+        }
+        ++k;
+        sites[k] = q;
+        bounds[k] = k == 0 ? -std::numeric_limits<double>::infinity() : s;
+    }
+
+    for (int x = 0, j = 0; x < sizeX; ++x) {
+        std::int64_t value = FAR_AWAY;
+        if (k >= 0) {
+            while (j < k && bounds[j + 1] < x) {
+                ++j;
+            }
+            std::int64_t dx = x - sites[j];
+            std::int64_t dy = column[sites[j]];
+            value = dx * dx + dy * dy;
+        }
+        squared[x] = value;
+        std::uint8_t next = costOf(value);
+        if (cost[x] != next) {
+            cost[x] = next;
+            if (changed) {
+                changed->push_back(x);
+            }
+        }
+    }
+}
+
+template <typename Cell>
+void BasicDistanceField<Cell>::setInflation(float robotCells, float inflationCells) {
+    robotRadius = std::max(robotCells, 0.0f);
+    inflationRadius = std::max(inflationCells, robotRadius);
+    buildCostTable();
+    if (!map) {
+        return;
+    }
+    parallelFor(sizeY, [this](int, int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            const std::int64_t* squared = squaredDistances.data() + static_cast<std::size_t>(y) * sizeX;
+            std::uint8_t* cost = costs.data() + static_cast<std::size_t>(y) * costs.getStride();
+            for (int x = 0; x < sizeX; ++x) {
+                cost[x] = costOf(squared[x]);
+            }
+        }
+    });
+    costs.markAllDirty();
+    changedCells.clear();
+}
+
+template <typename Cell>
+void BasicDistanceField<Cell>::compute(const BasicMap<Cell>& grid) {
+    map = &grid;
+    sizeX = grid.getNumberX();
+    sizeY = grid.getNumberY();
+    std::size_t cellCount = static_cast<std::size_t>(sizeX) * sizeY;
+    columnDistances.resize(cellCount);
+    squaredDistances.resize(cellCount);
+    rowMarks.assign(sizeY, 0);
+    if (costs.getNumberX() != sizeX || costs.getNumberY() != sizeY) {
+        costs.setGridSize(sizeX, sizeY);
+    }
+    changedCells.clear();
+
+    // Columns are independent, and so are rows once the columns are done.
+    parallelFor(sizeX, [this](int, int begin, int end) {
+        computeColumns(begin, end);
+    });
+    parallelFor(sizeY, [this](int, int begin, int end) {
+        std::vector<int> sites(sizeX);
+        std::vector<double> bounds(sizeX + 1);
+        for (int y = begin; y < end; ++y) {
+            computeRow(y, sites.data(), bounds.data(), nullptr);
+        }
+    });
+    costs.markAllDirty();
+    dirtyRows.resize(sizeY);
+    for (int y = 0; y < sizeY; ++y) {
+        dirtyRows[y] = y;
+    }
+}
+
+template <typename Cell>
+void BasicDistanceField<Cell>::update(const std::vector<PathCell>& cells) {
+    changedCells.clear();
+    dirtyRows.clear();
+    if (!map) {
+        return;
+    }
+    std::vector<int> columns;
+    for (const PathCell& cell : cells) {
+        if (cell.x >= 0 && cell.y >= 0 && cell.x < sizeX && cell.y < sizeY) {
+            columns.push_back(cell.x);
+        }
+    }
+    std::sort(columns.begin(), columns.end());
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+
+    // A changed cell only moves the column distances of its own column, and only
+    // between the obstacles above and below it; those rows are recomputed.
+    std::vector<int> before(sizeY);
+    for (int x : columns) {
+        for (int y = 0; y < sizeY; ++y) {
+            before[y] = columnDistances[static_cast<std::size_t>(y) * sizeX + x];
+        }
+        computeColumns(x, x + 1);
+        for (int y = 0; y < sizeY; ++y) {
+            if (before[y] != columnDistances[static_cast<std::size_t>(y) * sizeX + x] && !rowMarks[y]) {
+                rowMarks[y] = 1;
+                dirtyRows.push_back(y);
+            }
+        }
+    }
+    for (int y : dirtyRows) {
+        rowMarks[y] = 0;
+    }
+
+    std::vector<std::vector<int> > changed(threads);
+    std::vector<std::vector<int> > changedRows(threads);
+    int shares = parallelFor(static_cast<int>(dirtyRows.size()), [&](int share, int begin, int end) {
+        std::vector<int> sites(sizeX);
+        std::vector<double> bounds(sizeX + 1);
+        for (int i = begin; i < end; ++i) {
+            std::size_t first = changed[share].size();
+            computeRow(dirtyRows[i], sites.data(), bounds.data(), &changed[share]);
+            changedRows[share].push_back(static_cast<int>(changed[share].size() - first));
+        }
+    });
+    for (int share = 0; share < shares; ++share) {
+        int begin = static_cast<int>(static_cast<long long>(dirtyRows.size()) * share / shares);
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < changedRows[share].size(); ++i) {
+            int y = dirtyRows[begin + i];
+            for (int n = 0; n < changedRows[share][i]; ++n, ++next) {
+                int x = changed[share][next];
+                changedCells.push_back(PathCell{ x, y });
+                costs.markDirty(x, y);
+            }
+        }
+    }
+}
+
+template <typename Cell>
+float BasicDistanceField<Cell>::getDistance(int x, int y) const {
+    if (x < 0 || y < 0 || x >= sizeX || y >= sizeY) {
+        return 0.0f;
+    }
+    std::int64_t squared = squaredDistances[static_cast<std::size_t>(y) * sizeX + x];
+    return squared == FAR_AWAY ? std::numeric_limits<float>::infinity() : std::sqrt(static_cast<float>(squared));
+}
+
+template <typename Cell>
+bool BasicDistanceField<Cell>::hasClearance(int x, int y, float clearance) const {
+    if (x < 0 || y < 0 || x >= sizeX || y >= sizeY) {
+        return false;
+    }
+    std::int64_t squared = squaredDistances[static_cast<std::size_t>(y) * sizeX + x];
+    return squared == FAR_AWAY || static_cast<double>(squared) >= static_cast<double>(clearance) * clearance;
+}
+
+template <typename Cell>
+std::uint8_t BasicDistanceField<Cell>::getCost(int x, int y) const {
+    if (x < 0 || y < 0 || x >= sizeX || y >= sizeY) {
+        return LETHAL_COST;
+    }
+    return costs.data()[static_cast<std::size_t>(y) * costs.getStride() + x];
+}
+
+template <typename Cell>
+const BasicMap<std::uint8_t>& BasicDistanceField<Cell>::getCostMap() const {
+    return costs;
+}
+
+template <typename Cell>
+const GridPath& BasicDistanceField<Cell>::getChangedCells() const {
+    return changedCells;
+}
+
+template <typename Cell>
+int BasicDistanceField<Cell>::getUpdatedRowCount() const {
+    return static_cast<int>(dirtyRows.size());
+}
+
+template class BasicDistanceField<std::int8_t>;
+template class BasicDistanceField<std::uint8_t>;
+template class BasicDistanceField<std::int16_t>;
+template class BasicDistanceField<int>;
+template class BasicDistanceField<float>;
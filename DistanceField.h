@@ -0,0 +1,196 @@
+/**
+ * @file DistanceField.h
+ * @brief Declaration of the DistanceField class.
+ */
+
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+#include <cstdint>
+#include <vector>
+#include "AStarPlanner.h"
+#include "Map.h"
+
+/**
+ * @class BasicDistanceField
+ * @brief Euclidean distance transform of a map and obstacle inflation layer.
+ *
+ * For every cell the field holds the exact Euclidean distance to the nearest blocked
+ * cell, computed with the separable algorithm of Felzenszwalb and Huttenlocher in
+ * linear time: a pass along each column finds the nearest obstacle in the column,
+ * then a pass along each row takes the lower envelope of the parabolas those
+ * distances define. Columns and rows are split across worker threads.
+ *
+ * The distances are mapped to an inflated cost layer for the robot radius, kept as a
+ * BasicMap<std::uint8_t>, so the planners can search it directly with an obstacle
+ * threshold of INSCRIBED_COST. After cells of the map change, update() recomputes
+ * only the columns containing them and the rows whose column distances changed; the
+ * result is identical to compute().
+ */
+template <typename Cell>
+class BasicDistanceField {
+public:
+    static const std::uint8_t LETHAL_COST = 254; ///< Cost of a blocked cell
+    static const std::uint8_t INSCRIBED_COST = 253; ///< Cost of a cell closer to an obstacle than the robot radius
+
+private:
+    const BasicMap<Cell>* map; ///< Map the field was computed from
+    std::vector<int> columnDistances; ///< Distance to the nearest obstacle in the same column
+    std::vector<std::int64_t> squaredDistances; ///< Squared distance to the nearest obstacle
+    std::vector<std::uint8_t> costTable; ///< Cost by squared distance, up to the inflation radius
+    BasicMap<std::uint8_t> costs; ///< Inflated cost layer
+    GridPath changedCells; ///< Cells whose cost changed in the last update
+    std::vector<int> dirtyRows; ///< Rows recomputed by the last update
+    std::vector<std::uint8_t> rowMarks; ///< Rows to recompute, one flag per row
+    int sizeX; ///< Number of columns
+    int sizeY; ///< Number of rows
+    Cell threshold; ///< Smallest cell value that blocks
+    int threads; ///< Number of worker threads
+    float robotRadius; ///< Robot radius in cells
+    float inflationRadius; ///< Distance in cells at which the cost drops to 0
+
+    /**
+     * @brief Rebuilds the table mapping squared distances to costs.
+     */
+    void buildCostTable();
+
+    /**
+     * @brief Gets the cost of a squared distance.
+     *
+     * @param squared The squared distance in cells.
+     * @return std::uint8_t The cost.
+     */
+    std::uint8_t costOf(std::int64_t squared) const;
+
+    /**
+     * @brief Recomputes the column distances of a range of columns.
+     *
+     * @param minX First column.
+     * @param maxX One past the last column.
+     */
+    void computeColumns(int minX, int maxX);
+
+    /**
+     * @brief Recomputes the squared distances and costs of one row.
+     *
+     * @param y The row.
+     * @param sites Scratch buffer of at least sizeX entries for the envelope columns.
+     * @param bounds Scratch buffer of at least sizeX + 1 entries for the envelope bounds.
+     * @param changed Receives the columns whose cost changed, if not null.
+     */
+    void computeRow(int y, int* sites, double* bounds, std::vector<int>* changed);
+
+    /**
+     * @brief Splits [0, count) across the worker threads.
+     *
+     * @param count Number of items.
+     * @param work Called as work(share, begin, end) once per share; share 0 runs on the
+     *        calling thread.
+     * @return int The number of shares.
+     */
+    template <typename Work>
+    int parallelFor(int count, const Work& work) const;
+
+public:
+    /**
+     * @brief Constructs an empty field.
+     *
+     * @param obstacleThreshold Smallest cell value that blocks.
+     * @param threadCount Number of worker threads; 0 uses one per hardware thread.
+     */
+    explicit BasicDistanceField(Cell obstacleThreshold = 1, int threadCount = 0);
+
+    /**
+     * @brief Sets the obstacle threshold. Takes effect at the next compute().
+     *
+     * @param obstacleThreshold Smallest cell value that blocks.
+     */
+    void setObstacleThreshold(Cell obstacleThreshold);
+
+    /**
+     * @brief Sets the radii of the cost layer and recomputes it.
+     *
+     * Cells closer to an obstacle than the robot radius cost INSCRIBED_COST; beyond
+     * it the cost falls linearly to 0 at the inflation radius.
+     *
+     * @param robotCells Robot radius in cells.
+     * @param inflationCells Inflation radius in cells, at least the robot radius.
+     */
+    void setInflation(float robotCells, float inflationCells);
+
+    /**
+     * @brief Computes the field of a whole map.
+     *
+     * The field keeps a pointer to the map, which must outlive it or be replaced by
+     * another compute().
+     *
+     * @param grid The map.
+     */
+    void compute(const BasicMap<Cell>& grid);
+
+    /**
+     * @brief Updates the field after cells of the map changed.
+     *
+     * @param cells The changed cells; cells outside the map are ignored.
+     */
+    void update(const std::vector<PathCell>& cells);
+
+    /**
+     * @brief Gets the distance from a cell to the nearest obstacle.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return float The distance in cells; 0 outside the map, infinity if the map has
+     *         no obstacle.
+     */
+    float getDistance(int x, int y) const;
+
+    /**
+     * @brief Checks whether a cell is at least a given distance from every obstacle.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @param clearance The distance in cells.
+     * @return bool True if the cell is inside the map and clear.
+     */
+    bool hasClearance(int x, int y, float clearance) const;
+
+    /**
+     * @brief Gets the inflated cost of a cell.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return std::uint8_t The cost; LETHAL_COST outside the map.
+     */
+    std::uint8_t getCost(int x, int y) const;
+
+    /**
+     * @brief Gets the inflated cost layer.
+     *
+     * Plan on it with an obstacle threshold of INSCRIBED_COST to keep the robot off
+     * obstacles. Its version changes with every update that changes a cost.
+     *
+     * @return const BasicMap<std::uint8_t>& The cost layer.
+     */
+    const BasicMap<std::uint8_t>& getCostMap() const;
+
+    /**
+     * @brief Gets the cells whose cost changed in the last update().
+     *
+     * Feed them to the planners' updateCells() when they search the cost layer.
+     *
+     * @return const GridPath& The changed cells.
+     */
+    const GridPath& getChangedCells() const;
+
+    /**
+     * @brief Gets the number of rows recomputed by the last compute() or update().
+     *
+     * @return int The number of rows.
+     */
+    int getUpdatedRowCount() const;
+};
+
+typedef BasicDistanceField<int> DistanceField; ///< Distance field over the default map type
+
+#endif // DISTANCEFIELD_H
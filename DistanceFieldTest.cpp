@@ -0,0 +1,213 @@
+/**
+ * @file DistanceFieldTest.cpp
+ * @brief Test file for the DistanceField class.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include "DistanceField.h"
+
+namespace {
+
+// Counts cells whose distance differs from a brute-force search over all obstacles.
+int countBruteForceMismatches(const Map& map, const DistanceField& field) {
+    int mismatches = 0;
+    for (int y = 0; y < map.getNumberY(); ++y) {
+        for (int x = 0; x < map.getNumberX(); ++x) {
+            long long best = std::numeric_limits<long long>::max();
+            for (int oy = 0; oy < map.getNumberY(); ++oy) {
+                for (int ox = 0; ox < map.getNumberX(); ++ox) {
+                    if (map.getGrid(ox, oy) != 0) {
+                        best = std::min(best, static_cast<long long>(ox - x) * (ox - x) + static_cast<long long>(oy - y) * (oy - y));
+                    }
+                }
+            }
+            float expected = best == std::numeric_limits<long long>::max() ? std::numeric_limits<float>::infinity()
+                                                                          : std::sqrt(static_cast<float>(best));
+            if (field.getDistance(x, y) != expected) {
+                ++mismatches;
+            }
+        }
+    }
+    return mismatches;
+}
+
+// Counts cells whose distance or cost differs between two fields.
+int countMismatches(const DistanceField& a, const DistanceField& b, int sizeX, int sizeY) {
+    int mismatches = 0;
+    for (int y = 0; y < sizeY; ++y) {
+        for (int x = 0; x < sizeX; ++x) {
+            if (a.getDistance(x, y) != b.getDistance(x, y) || a.getCost(x, y) != b.getCost(x, y)) {
+                ++mismatches;
+            }
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+/**
+ * @brief Main function to test the DistanceField class.
+ *
+ * This function performs various tests on the DistanceField class:
+ * - Computes exact distances around one obstacle, on random maps against brute force
+ *   and along a corridor too long for 32-bit squared distances.
+ * - Builds the inflated cost layer for a robot radius.
+ * - Updates the field around changed cells and compares with a full computation.
+ * - Plans on the cost layer so the path keeps the robot radius clear.
+ * - Benchmarks the full transform on one and on several threads, and an update.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- DistanceField Test Start -----\n";
+
+    // 1. Exact distances
+    Map map(20, 12);
+    DistanceField field;
+    field.compute(map);
+    std::cout << "[Test] Empty map => " << field.getDistance(5, 5) << "\n";
+    map.setGrid(4, 3, 1);
+    field.compute(map);
+    std::cout << "[Test] Distance (4,3) => " << field.getDistance(4, 3) << ", (7,7) => " << field.getDistance(7, 7)
+              << ", (19,3) => " << field.getDistance(19, 3) << ", outside => " << field.getDistance(-1, 0) << "\n";
+    std::uint32_t seed = 3u;
+    auto next = [&seed](int range) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<int>((seed >> 8) % static_cast<std::uint32_t>(range));
+    };
+    int mismatches = 0;
+    for (int trial = 0; trial < 20; ++trial) {
+        Map random(5 + next(60), 5 + next(40));
+        int obstacles = next(30);
+        for (int i = 0; i < obstacles; ++i) {
+            random.setGrid(next(random.getNumberX()), next(random.getNumberY()), 1);
+        }
+        DistanceField randomField(1, 1 + next(4));
+        randomField.compute(random);
+        mismatches += countBruteForceMismatches(random, randomField);
+    }
+    std::cout << "[Test] Random maps against brute force => " << mismatches << " mismatches\n";
+    Map longRow(50000, 1);
+    longRow.setGrid(0, 0, 1);
+    DistanceField longRowField;
+    longRowField.compute(longRow);
+    std::cout << "[Test] 50000-cell corridor => distance at the far end " << longRowField.getDistance(49999, 0)
+              << " (49999)\n";
+
+    // 2. Inflated costs
+    field.setInflation(2.0f, 5.0f);
+    std::cout << "[Test] Costs at distance 0, 1, 2, 3, 4, 5, 6 =>";
+    for (int x = 4; x <= 10; ++x) {
+        std::cout << " " << static_cast<int>(field.getCost(x, 3));
+    }
+    std::cout << "; clearance 2 at (6,3) => " << field.hasClearance(6, 3, 2.0f)
+              << ", 2.5 => " << field.hasClearance(6, 3, 2.5f) << "\n";
+
+    // 3. Incremental update against a full computation
+    Map world(300, 200);
+    for (int i = 0; i < 60; ++i) {
+        int x0 = next(300), y0 = next(200);
+        for (int y = y0; y < y0 + 8 && y < 200; ++y) {
+            for (int x = x0; x < x0 + 8 && x < 300; ++x) {
+                world.setGrid(x, y, 1);
+            }
+        }
+    }
+    DistanceField incremental;
+    incremental.setInflation(3.0f, 8.0f);
+    incremental.compute(world);
+    DistanceField full;
+    full.setInflation(3.0f, 8.0f);
+    mismatches = 0;
+    long long rows = 0, changedCosts = 0;
+    for (int round = 0; round < 50; ++round) {
+        std::vector<PathCell> changed;
+        int x0 = next(300), y0 = next(200);
+        int value = next(2);
+        for (int i = 0; i < 12; ++i) {
+            int x = std::min(299, x0 + next(6));
+            int y = std::min(199, y0 + next(6));
+            world.setGrid(x, y, value);
+            changed.push_back(PathCell{ x, y });
+        }
+        incremental.update(changed);
+        rows += incremental.getUpdatedRowCount();
+        changedCosts += incremental.getChangedCells().size();
+        full.compute(world);
+        mismatches += countMismatches(incremental, full, 300, 200);
+    }
+    std::cout << "[Test] 50 updates => " << mismatches << " mismatches, " << rows / 50 << " of 200 rows and "
+              << changedCosts / 50 << " costs changed per update\n";
+
+    // 4. Planning on the cost layer
+    Map corridor(60, 20);
+    for (int x = 0; x < 60; ++x) {
+        corridor.setGrid(x, 0, 1);
+        corridor.setGrid(x, 19, 1);
+    }
+    for (int y = 0; y < 12; ++y) {
+        corridor.setGrid(30, y, 1);
+    }
+    DistanceField corridorField;
+    corridorField.setInflation(2.0f, 4.0f);
+    corridorField.compute(corridor);
+    BasicAStarPlanner<std::uint8_t> costPlanner(DistanceField::INSCRIBED_COST);
+    GridPath path;
+    bool found = costPlanner.plan(corridorField.getCostMap(), 5, 5, 55, 5, path);
+    float closest = std::numeric_limits<float>::infinity();
+    for (const PathCell& cell : path) {
+        closest = std::min(closest, corridorField.getDistance(cell.x, cell.y));
+    }
+    std::cout << "[Test] Plan on the cost layer => " << found << ", cost " << costPlanner.getPathCost()
+              << ", closest obstacle " << closest << " cells\n";
+
+    // 5. Benchmark on a 2000 x 2000 map
+    using Clock = std::chrono::steady_clock;
+    Map large(2000, 2000);
+    seed = 11u;
+    for (int i = 0; i < 1500; ++i) {
+        int x0 = next(2000);
+        int y0 = next(2000);
+        for (int y = y0; y < y0 + 20 && y < 2000; ++y) {
+            for (int x = x0; x < x0 + 20 && x < 2000; ++x) {
+                large.setGrid(x, y, 1);
+            }
+        }
+    }
+    DistanceField single(1, 1);
+    DistanceField parallel(1, 4);
+    single.setInflation(5.0f, 15.0f);
+    parallel.setInflation(5.0f, 15.0f);
+    single.compute(large);
+    parallel.compute(large);
+    Clock::time_point t0 = Clock::now();
+    single.compute(large);
+    Clock::time_point t1 = Clock::now();
+    parallel.compute(large);
+    Clock::time_point t2 = Clock::now();
+    std::vector<PathCell> changed;
+    for (int x = 1000; x < 1010; ++x) {
+        large.setGrid(x, 1000, 1);
+        changed.push_back(PathCell{ x, 1000 });
+    }
+    parallel.update(changed);
+    Clock::time_point t3 = Clock::now();
+    single.compute(large);
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    std::cout << "[Bench] Full transform: 1 thread " << ms(t0, t1) << " ms, 4 threads " << ms(t1, t2) << " ms ("
+              << std::thread::hardware_concurrency() << " hardware threads)\n";
+    std::cout << "[Bench] Update of " << changed.size() << " cells " << ms(t2, t3) << " ms ("
+              << parallel.getUpdatedRowCount() << " rows, " << parallel.getChangedCells().size()
+              << " costs changed); matches full => " << (countMismatches(parallel, single, 2000, 2000) == 0) << "\n";
+
+    std::cout << "----- DistanceField Test Complete -----\n";
+    return 0;
+}
@@ -0,0 +1,563 @@
+#include "HierarchicalPlanner.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+namespace {
+
+const float SQRT2 = 1.41421356f;
+const float UNREACHED = std::numeric_limits<float>::max();
+
+// Openings at least this long get a transition at each end instead of one in the middle.
+const int LONG_ENTRANCE = 6;
+
+// Same move order as the A* planner; diagonals come last.
+const int MOVE_X[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+const int MOVE_Y[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+const float MOVE_COST[8] = { 1.0f, 1.0f, 1.0f, 1.0f, SQRT2, SQRT2, SQRT2, SQRT2 };
+
+inline float octile(int x, int y, int goalX, int goalY) {
+    int dx = std::abs(goalX - x);
+    int dy = std::abs(goalY - y);
+    return static_cast<float>(dx + dy) + (SQRT2 - 2.0f) * static_cast<float>(std::min(dx, dy));
+}
+
+// Min-heap order on f; equal f prefers the entry closer to the goal.
+template <typename Entry>
+inline bool later(const Entry& a, const Entry& b) {
+    return a.f > b.f || (a.f == b.f && a.h > b.h);
+}
+
+} // namespace
+
+
+template <typename Cell>
+BasicHierarchicalPlanner<Cell>::BasicHierarchicalPlanner(int clusterCells, Cell obstacleThreshold)
+    : map(nullptr), localSearch(0), search(0), clusterSize(std::max(clusterCells, 2)), clustersX(0), clustersY(0),
+      sizeX(0), sizeY(0), threshold(obstacleThreshold), expanded(0), rebuilt(0), pathCost(0.0)
+{
+}
+
+template <typename Cell>
+void BasicHierarchicalPlanner<Cell>::setObstacleThreshold(Cell obstacleThreshold) {
+    threshold = obstacleThreshold;
+}
+
+template <typename Cell>
+bool BasicHierarchicalPlanner<Cell>::isFree(int x, int y) const {
+    if (x < 0 || y < 0 || x >= sizeX || y >= sizeY) {
+        return false;
+    }
+    return map->data()[static_cast<std::size_t>(y) * map->getStride() + x] < threshold;
+}
+
+template <typename Cell>
+void BasicHierarchicalPlanner<Cell>::buildBorder(bool vertical, int index) {
+    const Cluster& first = clusters[index];
+    std::vector<int>& pairs = vertical ? verticalBorders[index] : horizontalBorders[index];
+    pairs.clear();
+    // Walk along the border; (x, y) is on the first cluster, (x + dx, y + dy) across it.
+    int from = vertical ? first.minY : first.minX;
+    int to = vertical ? first.maxY : first.maxX;
+    int dx = vertical ? 1 : 0;
+    int dy = vertical ? 0 : 1;
+    auto cellAt = [&](int position) {
+        return vertical ? position * sizeX + first.maxX : first.maxY * sizeX + position;
+    };
+    auto open = [&](int position) {
+        int x = vertical ? first.maxX : position;
+        int y = vertical ? position : first.maxY;
+        return isFree(x, y) && isFree(x + dx, y + dy);
+    };
+    auto addPair = [&](int position) {
+        int cell = cellAt(position);
+        pairs.push_back(cell);
+        pairs.push_back(cell + dx + dy * sizeX);
+    };
+    for (int position = from; position <= to; ) {
+        if (!open(position)) {
+            ++position;
+            continue;
+        }
+        int end = position;
+        while (end + 1 <= to && open(end + 1)) {
+            ++end;
+        }
+        if (end - position + 1 < LONG_ENTRANCE) {
+            addPair((position + end) / 2);
+        } else {
+            addPair(position);
+            addPair(end);
+        }
+        position = end + 1;
+    }
+}
+
+template <typename Cell>
+int BasicHierarchicalPlanner<Cell>::findNode(int index, int cell) const {
+    const std::vector<int>& cells = clusters[index].cells;
+    std::vector<int>::const_iterator found = std::find(cells.begin(), cells.end(), cell);
+    return found == cells.end() ? -1 : static_cast<int>(found - cells.begin());
+}
+
+template <typename Cell>
+void BasicHierarchicalPlanner<Cell>::buildCluster(int index) {
+    Cluster& cluster = clusters[index];
+    int cx = index % clustersX;
+    int cy = index / clustersX;
+    cluster.cells.clear();
+    // Each border lists (upper or left cell, lower or right cell) pairs.
+    const std::vector<int>* borders[4] = {
+        cx > 0 ? &verticalBorders[index - 1] : nullptr, cx + 1 < clustersX ? &verticalBorders[index] : nullptr,
+        cy > 0 ? &horizontalBorders[index - clustersX] : nullptr, cy + 1 < clustersY ? &horizontalBorders[index] : nullptr
+    };
+    const int side[4] = { 1, 0, 1, 0 };
+    for (int b = 0; b < 4; ++b) {
+        if (!borders[b]) {
+            continue;
+        }
+        const std::vector<int>& pairs = *borders[b];
+        for (std::size_t i = side[b]; i < pairs.size(); i += 2) {
+            if (findNode(index, pairs[i]) < 0) {
+                cluster.cells.push_back(pairs[i]);
+            }
+        }
+    }
+
+    std::size_t count = cluster.cells.size();
+    cluster.distances.assign(count * count, UNREACHED);
+    for (std::size_t i = 0; i < count; ++i) {
+        cluster.distances[i * count + i] = 0.0f;
+        if (i + 1 == count) {
+            break;
+        }
+        exploreCluster(index, cluster.cells[i], cluster.cells.data() + i + 1, static_cast<int>(count - i - 1));
+        for (std::size_t j = i + 1; j < count; ++j) {
+            float distance = localDistance(index, cluster.cells[j]);
+            if (distance >= 0.0f) {
+                cluster.distances[i * count + j] = distance;
+                cluster.distances[j * count + i] = distance;
+            }
+        }
+    }
+    cluster.states.assign(count, NodeState{ 0.0f, 0u, -1, -1 });
+    cluster.dirty = false;
+}
+
+template <typename Cell>
+void BasicHierarchicalPlanner<Cell>::buildLinks(int index) {
+    Cluster& cluster = clusters[index];
+    int cx = index % clustersX;
+    int cy = index / clustersX;
+    cluster.links.clear();
+    const std::vector<int>* borders[4] = {
+        cx > 0 ? &verticalBorders[index - 1] : nullptr, cx + 1 < clustersX ? &verticalBorders[index] : nullptr,
+        cy > 0 ? &horizontalBorders[index - clustersX] : nullptr, cy + 1 < clustersY ? &horizontalBorders[index] : nullptr
+    };
+    const int neighbour[4] = { index - 1, index + 1, index - clustersX, index + clustersX };
+    const int side[4] = { 1, 0, 1, 0 };
+    for (int b = 0; b < 4; ++b) {
+        if (!borders[b]) {
+            continue;
+        }
+        const std::vector<int>& pairs = *borders[b];
+        for (std::size_t i = 0; i < pairs.size(); i += 2) {
+            Link link;
+            link.node = findNode(index, pairs[i + side[b]]);
+            link.cluster = neighbour[b];
+            link.target = findNode(neighbour[b], pairs[i + 1 - side[b]]);
+            cluster.links.push_back(link);
+        }
+    }
+}
+
+template <typename Cell>
+void BasicHierarchicalPlanner<Cell>::rebuildDirty() {
+    int count = clustersX * clustersY;
+    for (int index = 0; index < count; ++index) {
+        if (verticalDirty[index]) {
+            buildBorder(true, index);
+            verticalDirty[index] = 0;
+        }
+        if (horizontalDirty[index]) {
+            buildBorder(false, index);
+            horizontalDirty[index] = 0;
+        }
+    }
+    // Node numbers of a rebuilt cluster change, so the links of its neighbours too.
+    std::vector<std::uint8_t> relink(count, 0);
+    rebuilt = 0;
+    for (int index = 0; index < count; ++index) {
+        if (!clusters[index].dirty) {
+            continue;
+        }
+        buildCluster(index);
+        ++rebuilt;
+        int cx = index % clustersX;
+        int cy = index / clustersX;
+        relink[index] = 1;
+        if (cx > 0) {
+            relink[index - 1] = 1;
+        }
+        if (cx + 1 < clustersX) {
+            relink[index + 1] = 1;
+        }
+        if (cy > 0) {
+            relink[index - clustersX] = 1;
+        }
+        if (cy + 1 < clustersY) {
+            relink[index + clustersX] = 1;
+        }
+    }
+    for (int index = 0; index < count; ++index) {
+        if (relink[index]) {
+            buildLinks(index);
+        }
+    }
+}
+
+template <typename Cell>
+void BasicHierarchicalPlanner<Cell>::exploreCluster(int index, int cell, const int* targets, int targetCount) {
+    const Cluster& cluster = clusters[index];
+    ++localSearch;
+    if (localSearch >= 0x7fffffffu) {
+        for (LocalNode& node : localNodes) {
+            node.stamp = 0;
+            node.wanted = 0;
+        }
+        localSearch = 1;
+    }
+    const std::uint32_t openStamp = localSearch * 2;
+    const std::uint32_t closedStamp = openStamp + 1;
+    localOpen.clear();
+    int remaining = 0;
+    for (int i = 0; i < targetCount; ++i) {
+        LocalNode& node = localNodes[(targets[i] / sizeX - cluster.minY) * clusterSize + targets[i] % sizeX - cluster.minX];
+        if (node.wanted != localSearch) {
+            node.wanted = localSearch;
+            ++remaining;
+        }
+    }
+    // A single target is searched with the octile heuristic; several need exact distances.
+    const bool guided = targetCount == 1;
+    const int goalX = guided ? targets[0] % sizeX : 0;
+    const int goalY = guided ? targets[0] / sizeX : 0;
+
+    int start = (cell / sizeX - cluster.minY) * clusterSize + cell % sizeX - cluster.minX;
+    localNodes[start].g = 0.0f;
+    localNodes[start].stamp = openStamp;
+    localOpen.push_back(OpenEntry{ 0.0f, 0.0f, 0, start });
+    while (!localOpen.empty()) {
+        std::pop_heap(localOpen.begin(), localOpen.end(), later<OpenEntry>);
+        int current = localOpen.back().index;
+        localOpen.pop_back();
+        LocalNode& node = localNodes[current];
+        if (node.stamp == closedStamp) {
+            continue;
+        }
+        node.stamp = closedStamp;
+        if (node.wanted == localSearch && --remaining == 0) {
+            return;
+        }
+        int x = cluster.minX + current % clusterSize;
+        int y = cluster.minY + current / clusterSize;
+        for (int move = 0; move < 8; ++move) {
+            int nx = x + MOVE_X[move];
+            int ny = y + MOVE_Y[move];
+            if (nx < cluster.minX || ny < cluster.minY || nx > cluster.maxX || ny > cluster.maxY ||
+                !isFree(nx, ny) || (move >= 4 && (!isFree(nx, y) || !isFree(x, ny)))) {
+                continue;
+            }
+            int next = (ny - cluster.minY) * clusterSize + nx - cluster.minX;
+            LocalNode& neighbour = localNodes[next];
+            if (neighbour.stamp == closedStamp) {
+                continue;
+            }
+            float g = node.g + MOVE_COST[move];
+            if (neighbour.stamp != openStamp || g < neighbour.g) {
+                neighbour.g = g;
+                neighbour.stamp = openStamp;
+                neighbour.move = static_cast<std::uint8_t>(move);
+                float h = guided ? octile(nx, ny, goalX, goalY) : 0.0f;
+                localOpen.push_back(OpenEntry{ g + h, h, 0, next });
+                std::push_heap(localOpen.begin(), localOpen.end(), later<OpenEntry>);
+            }
+        }
+    }
+}
+
+template <typename Cell>
+float BasicHierarchicalPlanner<Cell>::localDistance(int index, int cell) const {
+    const Cluster& cluster = clusters[index];
+    const LocalNode& node = localNodes[(cell / sizeX - cluster.minY) * clusterSize + cell % sizeX - cluster.minX];
+    return node.stamp == localSearch * 2 + 1 ? node.g : -1.0f;
+}
+
+template <typename Cell>
+void BasicHierarchicalPlanner<Cell>::appendLocalPath(int index, int cell, GridPath& path) {
+    const Cluster& cluster = clusters[index];
+    std::size_t first = path.size();
+    int x = cell % sizeX;
+    int y = cell / sizeX;
+    for (;;) {
+        const LocalNode& node = localNodes[(y - cluster.minY) * clusterSize + x - cluster.minX];
+        if (node.g == 0.0f) {
+            break;
+        }
+        path.push_back(PathCell{ x, y });
+        x -= MOVE_X[node.move];
+        y -= MOVE_Y[node.move];
+    }
+    std::reverse(path.begin() + first, path.end());
+}
+
+template <typename Cell>
+void BasicHierarchicalPlanner<Cell>::build(const BasicMap<Cell>& grid) {
+    map = &grid;
+    sizeX = grid.getNumberX();
+    sizeY = grid.getNumberY();
+    clustersX = (sizeX + clusterSize - 1) / clusterSize;
+    clustersY = (sizeY + clusterSize - 1) / clusterSize;
+    int count = clustersX * clustersY;
+    clusters.assign(count, Cluster());
+    for (int index = 0; index < count; ++index) {
+        Cluster& cluster = clusters[index];
+        cluster.minX = (index % clustersX) * clusterSize;
+        cluster.minY = (index / clustersX) * clusterSize;
+        cluster.maxX = std::min(cluster.minX + clusterSize, sizeX) - 1;
+        cluster.maxY = std::min(cluster.minY + clusterSize, sizeY) - 1;
+        cluster.dirty = true;
+    }
+    verticalBorders.assign(count, std::vector<int>());
+    horizontalBorders.assign(count, std::vector<int>());
+    verticalDirty.assign(count, 0);
+    horizontalDirty.assign(count, 0);
+    for (int index = 0; index < count; ++index) {
+        verticalDirty[index] = (index % clustersX) + 1 < clustersX;
+        horizontalDirty[index] = (index / clustersX) + 1 < clustersY;
+    }
+    localNodes.assign(static_cast<std::size_t>(clusterSize) * clusterSize, LocalNode{ 0.0f, 0u, 0u, 0 });
+    localSearch = 0;
+    search = 0;
+    rebuildDirty();
+}
+
+template <typename Cell>
+void BasicHierarchicalPlanner<Cell>::updateCells(const std::vector<PathCell>& cells) {
+    if (!map) {
+        return;
+    }
+    for (const PathCell& cell : cells) {
+        if (cell.x < 0 || cell.y < 0 || cell.x >= sizeX || cell.y >= sizeY) {
+            continue;
+        }
+        int cx = cell.x / clusterSize;
+        int cy = cell.y / clusterSize;
+        int index = cy * clustersX + cx;
+        const Cluster& cluster = clusters[index];
+        clusters[index].dirty = true;
+        // A cell on the edge of its cluster may open or close an entrance of the border.
+        if (cell.x == cluster.minX && cx > 0) {
+            verticalDirty[index - 1] = 1;
+            clusters[index - 1].dirty = true;
+        }
+        if (cell.x == cluster.maxX && cx + 1 < clustersX) {
+            verticalDirty[index] = 1;
+            clusters[index + 1].dirty = true;
+        }
+        if (cell.y == cluster.minY && cy > 0) {
+            horizontalDirty[index - clustersX] = 1;
+            clusters[index - clustersX].dirty = true;
+        }
+        if (cell.y == cluster.maxY && cy + 1 < clustersY) {
+            horizontalDirty[index] = 1;
+            clusters[index + clustersX].dirty = true;
+        }
+    }
+    rebuildDirty();
+}
+
+template <typename Cell>
+bool BasicHierarchicalPlanner<Cell>::plan(int startX, int startY, int goalX, int goalY, GridPath& path) {
+    path.clear();
+    expanded = 0;
+    pathCost = 0.0;
+    if (!map || !isFree(startX, startY) || !isFree(goalX, goalY)) {
+        return false;
+    }
+    ++search;
+    if (search >= 0x7fffffffu) {
+        for (Cluster& cluster : clusters) {
+            for (NodeState& state : cluster.states) {
+                state.stamp = 0;
+            }
+        }
+        search = 1;
+    }
+    const std::uint32_t openStamp = search * 2;
+    const std::uint32_t closedStamp = openStamp + 1;
+    const int startCell = startY * sizeX + startX;
+    const int goalCell = goalY * sizeX + goalX;
+    const int startCluster = (startY / clusterSize) * clustersX + startX / clusterSize;
+    const int goalCluster = (goalY / clusterSize) * clustersX + goalX / clusterSize;
+    openList.clear();
+
+    // Connect the goal to the nodes of its cluster; paths are symmetric.
+    const Cluster& last = clusters[goalCluster];
+    exploreCluster(goalCluster, goalCell, last.cells.data(), static_cast<int>(last.cells.size()));
+    goalDistances.resize(last.cells.size());
+    for (std::size_t j = 0; j < last.cells.size(); ++j) {
+        goalDistances[j] = localDistance(goalCluster, last.cells[j]);
+    }
+
+    // Connect the start, and try the direct path when both share a cluster.
+    float best = UNREACHED;
+    int bestCluster = -1;
+    int bestNode = -1;
+    Cluster& first = clusters[startCluster];
+    exploreCluster(startCluster, startCell, nullptr, 0);
+    if (startCluster == goalCluster && localDistance(startCluster, goalCell) >= 0.0f) {
+        best = localDistance(startCluster, goalCell);
+        openList.push_back(OpenEntry{ best, 0.0f, -1, -1 });
+    }
+    for (std::size_t i = 0; i < first.cells.size(); ++i) {
+        float g = localDistance(startCluster, first.cells[i]);
+        if (g < 0.0f) {
+            continue;
+        }
+        NodeState& state = first.states[i];
+        state.g = g;
+        state.stamp = openStamp;
+        state.parentCluster = -1;
+        state.parentNode = -1;
+        int cell = first.cells[i];
+        float h = octile(cell % sizeX, cell / sizeX, goalX, goalY);
+        openList.push_back(OpenEntry{ g + h, h, startCluster, static_cast<int>(i) });
+    }
+    std::make_heap(openList.begin(), openList.end(), later<OpenEntry>);
+
+    bool found = false;
+    while (!openList.empty()) {
+        std::pop_heap(openList.begin(), openList.end(), later<OpenEntry>);
+        OpenEntry top = openList.back();
+        openList.pop_back();
+        if (top.cluster < 0) {
+            // The goal entry with the best cost comes out before any larger one.
+            found = true;
+            break;
+        }
+        Cluster& cluster = clusters[top.cluster];
+        NodeState& state = cluster.states[top.index];
+        if (state.stamp == closedStamp) {
+            continue;
+        }
+        state.stamp = closedStamp;
+        ++expanded;
+        float g = state.g;
+
+        if (top.cluster == goalCluster && goalDistances[top.index] >= 0.0f && g + goalDistances[top.index] < best) {
+            best = g + goalDistances[top.index];
+            bestCluster = top.cluster;
+            bestNode = top.index;
+            openList.push_back(OpenEntry{ best, 0.0f, -1, -1 });
+            std::push_heap(openList.begin(), openList.end(), later<OpenEntry>);
+        }
+
+        auto relax = [&](int index, int node, float cost) {
+            NodeState& next = clusters[index].states[node];
+            if (next.stamp == closedStamp) {
+                return;
+            }
+            float ng = g + cost;
+            if (next.stamp != openStamp || ng < next.g) {
+                next.g = ng;
+                next.stamp = openStamp;
+                next.parentCluster = top.cluster;
+                next.parentNode = top.index;
+                int cell = clusters[index].cells[node];
+                float h = octile(cell % sizeX, cell / sizeX, goalX, goalY);
+                openList.push_back(OpenEntry{ ng + h, h, index, node });
+                std::push_heap(openList.begin(), openList.end(), later<OpenEntry>);
+            }
+        };
+        std::size_t count = cluster.cells.size();
+        const float* distances = cluster.distances.data() + top.index * count;
+        for (std::size_t j = 0; j < count; ++j) {
+            if (distances[j] != UNREACHED && static_cast<int>(j) != top.index) {
+                relax(top.cluster, static_cast<int>(j), distances[j]);
+            }
+        }
+        for (const Link& link : cluster.links) {
+            if (link.node == top.index) {
+                relax(link.cluster, link.target, 1.0f);
+            }
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    // Refine: every abstract edge inside a cluster becomes a search limited to it.
+    std::vector<std::pair<int, int> > chain;
+    for (int index = bestCluster, node = bestNode; index >= 0; ) {
+        chain.push_back(std::make_pair(index, node));
+        const NodeState& state = clusters[index].states[node];
+        index = state.parentCluster;
+        node = state.parentNode;
+    }
+    std::reverse(chain.begin(), chain.end());
+    path.push_back(PathCell{ startX, startY });
+    int cell = startCell;
+    int index = startCluster;
+    for (const std::pair<int, int>& step : chain) {
+        int next = clusters[step.first].cells[step.second];
+        if (step.first == index) {
+            exploreCluster(index, cell, &next, 1);
+            appendLocalPath(index, next, path);
+        } else {
+            path.push_back(PathCell{ next % sizeX, next / sizeX });
+        }
+        cell = next;
+        index = step.first;
+    }
+    exploreCluster(index, cell, &goalCell, 1);
+    appendLocalPath(index, goalCell, path);
+
+    int diagonal = 0;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        diagonal += path[i].x != path[i - 1].x && path[i].y != path[i - 1].y;
+    }
+    pathCost = static_cast<double>(path.size() - 1 - diagonal) + diagonal * 1.4142135623730951;
+    return true;
+}
+
+template <typename Cell>
+double BasicHierarchicalPlanner<Cell>::getPathCost() const {
+    return pathCost;
+}
+
+template <typename Cell>
+int BasicHierarchicalPlanner<Cell>::getExpandedCount() const {
+    return expanded;
+}
+
+template <typename Cell>
+int BasicHierarchicalPlanner<Cell>::getNodeCount() const {
+    int count = 0;
+    for (const Cluster& cluster : clusters) {
+        count += static_cast<int>(cluster.cells.size());
+    }
+    return count;
+}
+
+template <typename Cell>
+int BasicHierarchicalPlanner<Cell>::getRebuiltClusterCount() const {
+    return rebuilt;
+}
+
+template class BasicHierarchicalPlanner<std::int8_t>;
+template class BasicHierarchicalPlanner<std::uint8_t>;
+template class BasicHierarchicalPlanner<std::int16_t>;
+template class BasicHierarchicalPlanner<int>;
+template class BasicHierarchicalPlanner<float>;
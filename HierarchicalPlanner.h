@@ -0,0 +1,270 @@
+/**
+ * @file HierarchicalPlanner.h
+ * @brief Declaration of the HierarchicalPlanner class.
+ */
+
+#ifndef HIERARCHICALPLANNER_H
+#define HIERARCHICALPLANNER_H
+
+#include <cstdint>
+#include <vector>
+#include "AStarPlanner.h"
+#include "Map.h"
+
+/**
+ * @class BasicHierarchicalPlanner
+ * @brief Hierarchical path planner (HPA*) for large maps.
+ *
+ * The map is split into square clusters. Wherever free cells face each other across
+ * the border of two clusters, an entrance is placed: one transition in the middle of
+ * a short opening, one at each end of a long one. The transition cells are the nodes
+ * of an abstract graph, joined by unit-cost edges across borders and, inside each
+ * cluster, by the length of the shortest path between them within the cluster.
+ *
+ * A query connects start and goal to the nodes of their clusters, searches the small
+ * abstract graph, and refines each abstract edge with a search limited to one
+ * cluster. Moves, costs and the obstacle threshold are those of BasicAStarPlanner;
+ * long paths typically stay within a few percent of the shortest path. The map is
+ * read during plan(); after cells change, updateCells() rebuilds the clusters they
+ * belong to, and the neighbours of border cells, and nothing else.
+ */
+template <typename Cell>
+class BasicHierarchicalPlanner {
+private:
+    /**
+     * @struct Link
+     * @brief Unit-cost edge from an abstract node to a node of a neighbouring cluster.
+     */
+    struct Link {
+        int node; ///< Node of this cluster
+        int cluster; ///< Neighbouring cluster
+        int target; ///< Node of the neighbouring cluster
+    };
+
+    /**
+     * @struct NodeState
+     * @brief Search state of one abstract node.
+     */
+    struct NodeState {
+        float g; ///< Cost from the start, valid when the node is stamped by this search
+        std::uint32_t stamp; ///< 2 * search when opened, 2 * search + 1 when closed
+        int parentCluster; ///< Cluster of the node reached from, -1 for the start
+        int parentNode; ///< Node reached from
+    };
+
+    /**
+     * @struct Cluster
+     * @brief One square block of the map and its abstract nodes.
+     */
+    struct Cluster {
+        int minX; ///< First column
+        int minY; ///< First row
+        int maxX; ///< Last column
+        int maxY; ///< Last row
+        std::vector<int> cells; ///< Map cell of each node, y * sizeX + x
+        std::vector<float> distances; ///< Shortest path inside the cluster between each pair of nodes
+        std::vector<Link> links; ///< Edges to nodes of neighbouring clusters
+        std::vector<NodeState> states; ///< Search state of each node
+        bool dirty; ///< Nodes or distances must be rebuilt
+    };
+
+    /**
+     * @struct OpenEntry
+     * @brief Entry of an open list; abstract entries carry a cluster, local ones do not.
+     */
+    struct OpenEntry {
+        float f; ///< Cost from the start plus heuristic
+        float h; ///< Heuristic, breaks ties towards the goal
+        int cluster; ///< Cluster of the node, -1 for the goal
+        int index; ///< Node of the cluster, or local cell index
+    };
+
+    /**
+     * @struct LocalNode
+     * @brief Search state of one cell in a search limited to a cluster.
+     */
+    struct LocalNode {
+        float g; ///< Cost from the source, valid when the cell is stamped by this search
+        std::uint32_t stamp; ///< 2 * search when opened, 2 * search + 1 when closed
+        std::uint32_t wanted; ///< Search the cell is a target of
+        std::uint8_t move; ///< Move that reached the cell
+    };
+
+    const BasicMap<Cell>* map; ///< Map being planned over
+    std::vector<Cluster> clusters; ///< Clusters row by row
+    std::vector<std::vector<int> > verticalBorders; ///< Transition cell pairs between a cluster and its right neighbour
+    std::vector<std::vector<int> > horizontalBorders; ///< Transition cell pairs between a cluster and the one below
+    std::vector<std::uint8_t> verticalDirty; ///< Vertical borders to rebuild
+    std::vector<std::uint8_t> horizontalDirty; ///< Horizontal borders to rebuild
+    std::vector<LocalNode> localNodes; ///< Arena of the cluster-limited search
+    std::vector<OpenEntry> localOpen; ///< Open list of the cluster-limited search
+    std::vector<OpenEntry> openList; ///< Open list of the abstract search
+    std::vector<float> goalDistances; ///< Distance from each node of the goal cluster to the goal
+    std::uint32_t localSearch; ///< Number of the current cluster-limited search
+    std::uint32_t search; ///< Number of the current abstract search
+    int clusterSize; ///< Side of a cluster in cells
+    int clustersX; ///< Number of cluster columns
+    int clustersY; ///< Number of cluster rows
+    int sizeX; ///< Number of columns of the map
+    int sizeY; ///< Number of rows of the map
+    Cell threshold; ///< Smallest cell value that blocks
+    int expanded; ///< Abstract nodes expanded by the last query
+    int rebuilt; ///< Clusters rebuilt by the last build or update
+    double pathCost; ///< Cost of the last path found
+
+    /**
+     * @brief Checks whether a cell can be traversed.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return bool True if the cell is inside the map and below the obstacle threshold.
+     */
+    bool isFree(int x, int y) const;
+
+    /**
+     * @brief Places the transitions of one border between two clusters.
+     *
+     * @param vertical True for the border between a cluster and its right neighbour.
+     * @param index Border index, the index of the left or upper cluster.
+     */
+    void buildBorder(bool vertical, int index);
+
+    /**
+     * @brief Collects the nodes of a cluster from its borders and computes their distances.
+     *
+     * @param index Cluster index.
+     */
+    void buildCluster(int index);
+
+    /**
+     * @brief Rebuilds the edges from a cluster to its neighbours.
+     *
+     * @param index Cluster index.
+     */
+    void buildLinks(int index);
+
+    /**
+     * @brief Rebuilds every dirty border and cluster.
+     */
+    void rebuildDirty();
+
+    /**
+     * @brief Gets the node of a cluster placed on a cell.
+     *
+     * @param index Cluster index.
+     * @param cell Map cell, y * sizeX + x.
+     * @return int The node, or -1 if the cell is not a node.
+     */
+    int findNode(int index, int cell) const;
+
+    /**
+     * @brief Searches from a cell without leaving its cluster.
+     *
+     * Runs Dijkstra until every target is reached, or A* towards a single target.
+     *
+     * @param index Cluster index.
+     * @param cell Map cell to start from.
+     * @param targets Map cells to reach.
+     * @param targetCount Number of targets; 0 reaches the whole cluster.
+     */
+    void exploreCluster(int index, int cell, const int* targets, int targetCount);
+
+    /**
+     * @brief Gets the distance found by the last exploreCluster() to a cell.
+     *
+     * @param index Cluster index.
+     * @param cell Map cell.
+     * @return float The distance, or a negative value if the cell was not reached.
+     */
+    float localDistance(int index, int cell) const;
+
+    /**
+     * @brief Appends the cells of the last exploreCluster() path to a cell, source excluded.
+     *
+     * @param index Cluster index.
+     * @param cell Map cell reached by the search.
+     * @param path Receives the cells.
+     */
+    void appendLocalPath(int index, int cell, GridPath& path);
+
+public:
+    /**
+     * @brief Constructs a planner.
+     *
+     * @param clusterCells Side of a cluster in cells.
+     * @param obstacleThreshold Smallest cell value that blocks.
+     */
+    explicit BasicHierarchicalPlanner(int clusterCells = 32, Cell obstacleThreshold = 1);
+
+    /**
+     * @brief Sets the obstacle threshold. Takes effect at the next build().
+     *
+     * @param obstacleThreshold Smallest cell value that blocks.
+     */
+    void setObstacleThreshold(Cell obstacleThreshold);
+
+    /**
+     * @brief Builds the abstract graph of a map.
+     *
+     * The planner keeps a pointer to the map, which must outlive it or be replaced by
+     * another build().
+     *
+     * @param grid The map.
+     */
+    void build(const BasicMap<Cell>& grid);
+
+    /**
+     * @brief Tells the planner that cells of the map have changed.
+     *
+     * Rebuilds the clusters containing the cells, and the neighbouring clusters across
+     * the borders the cells lie on.
+     *
+     * @param cells The changed cells; cells outside the map are ignored.
+     */
+    void updateCells(const std::vector<PathCell>& cells);
+
+    /**
+     * @brief Plans a path between two cells.
+     *
+     * @param startX Column of the start cell.
+     * @param startY Row of the start cell.
+     * @param goalX Column of the goal cell.
+     * @param goalY Row of the goal cell.
+     * @param path Receives the path from start to goal; cleared if there is none.
+     * @return bool True if a path was found; false if start or goal is blocked or
+     *         outside the map, or the goal cannot be reached.
+     */
+    bool plan(int startX, int startY, int goalX, int goalY, GridPath& path);
+
+    /**
+     * @brief Gets the cost of the last path found.
+     *
+     * @return double The length of the path in cells.
+     */
+    double getPathCost() const;
+
+    /**
+     * @brief Gets the number of abstract nodes expanded by the last plan().
+     *
+     * @return int The number of expanded nodes.
+     */
+    int getExpandedCount() const;
+
+    /**
+     * @brief Gets the number of nodes of the abstract graph.
+     *
+     * @return int The number of nodes.
+     */
+    int getNodeCount() const;
+
+    /**
+     * @brief Gets the number of clusters rebuilt by the last build() or updateCells().
+     *
+     * @return int The number of clusters.
+     */
+    int getRebuiltClusterCount() const;
+};
+
+typedef BasicHierarchicalPlanner<int> HierarchicalPlanner; ///< Hierarchical planner over the default map type
+
+#endif // HIERARCHICALPLANNER_H
@@ -0,0 +1,194 @@
+/**
+ * @file HierarchicalPlannerTest.cpp
+ * @brief Test file for the HierarchicalPlanner class.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include "HierarchicalPlanner.h"
+
+namespace {
+
+// Checks that consecutive cells are neighbours, free, and that diagonals do not cut corners.
+bool isConnected(const Map& map, const GridPath& path) {
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        if (map.getGrid(path[i].x, path[i].y) != 0) {
+            return false;
+        }
+        if (i == 0) {
+            continue;
+        }
+        int dx = path[i].x - path[i - 1].x;
+        int dy = path[i].y - path[i - 1].y;
+        if (std::abs(dx) > 1 || std::abs(dy) > 1 || (dx == 0 && dy == 0)) {
+            return false;
+        }
+        if (dx != 0 && dy != 0 &&
+            (map.getGrid(path[i - 1].x + dx, path[i - 1].y) != 0 || map.getGrid(path[i - 1].x, path[i - 1].y + dy) != 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Main function to test the HierarchicalPlanner class.
+ *
+ * This function performs various tests on the HierarchicalPlanner class:
+ * - Plans around a wall that crosses several clusters and compares with A*.
+ * - Finds the same reachable goals as A* on random maps, with paths close in cost.
+ * - Rebuilds only the clusters around changed cells and follows a closed door.
+ * - Compares query times with A* on a 2000 x 2000 map and times a local rebuild.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- HierarchicalPlanner Test Start -----\n";
+
+    // 1. Around a wall crossing several clusters
+    Map map(100, 60);
+    for (int y = 0; y < 50; ++y) {
+        map.setGrid(50, y, 1);
+    }
+    HierarchicalPlanner planner(16);
+    AStarPlanner reference;
+    GridPath path, expected;
+    planner.build(map);
+    std::cout << "[Test] Built " << planner.getRebuiltClusterCount() << " clusters, " << planner.getNodeCount()
+              << " abstract nodes\n";
+    std::cout << "[Test] Around the wall => " << planner.plan(5, 5, 95, 5, path) << ", cost " << planner.getPathCost()
+              << ", expanded " << planner.getExpandedCount();
+    reference.plan(map, 5, 5, 95, 5, expected);
+    std::cout << "; A* cost " << reference.getPathCost() << ", expanded " << reference.getExpandedCount() << "\n";
+    std::cout << "[Test] Path cells " << path.size() << ", connected => " << isConnected(map, path)
+              << ", same cluster => " << planner.plan(3, 3, 10, 12, path) << ", cost " << planner.getPathCost() << "\n";
+    std::cout << "[Test] Blocked goal => " << planner.plan(5, 5, 50, 5, path)
+              << ", outside => " << planner.plan(5, 5, 100, 5, path) << "\n";
+
+    // 2. Random maps against A*
+    std::uint32_t seed = 5u;
+    auto next = [&seed](int range) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<int>((seed >> 8) % static_cast<std::uint32_t>(range));
+    };
+    int queries = 0, reachMismatches = 0, broken = 0;
+    double ratio = 0.0, worst = 1.0;
+    int found = 0;
+    for (int trial = 0; trial < 100; ++trial) {
+        int sizeX = 30 + next(150);
+        int sizeY = 30 + next(100);
+        Map random(sizeX, sizeY);
+        int density = 5 + next(30);
+        for (int y = 0; y < sizeY; ++y) {
+            for (int x = 0; x < sizeX; ++x) {
+                if (next(100) < density) {
+                    random.setGrid(x, y, 1);
+                }
+            }
+        }
+        HierarchicalPlanner randomPlanner(8 + next(24));
+        randomPlanner.build(random);
+        for (int query = 0; query < 10; ++query) {
+            int sx = next(sizeX), sy = next(sizeY), gx = next(sizeX), gy = next(sizeY);
+            bool ok = randomPlanner.plan(sx, sy, gx, gy, path);
+            bool okReference = reference.plan(random, sx, sy, gx, gy, expected);
+            ++queries;
+            if (ok != okReference) {
+                ++reachMismatches;
+            }
+            if (ok && okReference) {
+                if (!isConnected(random, path) || path.front().x != sx || path.front().y != sy ||
+                    path.back().x != gx || path.back().y != gy) {
+                    ++broken;
+                }
+                if (reference.getPathCost() > 0.0) {
+                    double r = randomPlanner.getPathCost() / reference.getPathCost();
+                    ratio += r;
+                    worst = std::max(worst, r);
+                    ++found;
+                }
+            }
+        }
+    }
+    std::cout << "[Test] " << queries << " random queries: reachability mismatches => " << reachMismatches
+              << ", broken paths => " << broken << ", cost / A* mean " << ratio / found << ", worst " << worst << "\n";
+
+    // 3. Local rebuild after cells change
+    std::vector<PathCell> changed;
+    for (int y = 50; y < 60; ++y) {
+        map.setGrid(50, y, 1);
+        changed.push_back(PathCell{ 50, y });
+    }
+    planner.updateCells(changed);
+    std::cout << "[Test] Door closed => rebuilt " << planner.getRebuiltClusterCount() << " clusters, path "
+              << planner.plan(5, 5, 95, 5, path);
+    map.setGrid(50, 20, 0);
+    planner.updateCells(std::vector<PathCell>(1, PathCell{ 50, 20 }));
+    planner.plan(5, 5, 95, 5, path);
+    reference.plan(map, 5, 5, 95, 5, expected);
+    std::cout << "; gap opened => rebuilt " << planner.getRebuiltClusterCount() << ", cost " << planner.getPathCost()
+              << ", A* cost " << reference.getPathCost() << "\n";
+    map.setGrid(8, 8, 1);
+    planner.updateCells(std::vector<PathCell>(1, PathCell{ 8, 8 }));
+    std::cout << "[Test] Interior cell => rebuilt " << planner.getRebuiltClusterCount() << " cluster\n";
+
+    // 4. Benchmark against A* on 2000 x 2000 with 20 x 20 obstacles
+    using Clock = std::chrono::steady_clock;
+    Map large(2000, 2000);
+    seed = 11u;
+    for (int i = 0; i < 1500; ++i) {
+        int x0 = next(2000);
+        int y0 = next(2000);
+        for (int y = y0; y < y0 + 20 && y < 2000; ++y) {
+            for (int x = x0; x < x0 + 20 && x < 2000; ++x) {
+                large.setGrid(x, y, 1);
+            }
+        }
+    }
+    HierarchicalPlanner hierarchy;
+    Clock::time_point t0 = Clock::now();
+    hierarchy.build(large);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    double aStarMs = 0.0, hierarchyMs = 0.0;
+    long long aStarExpanded = 0, hierarchyExpanded = 0;
+    int rounds = 0;
+    ratio = 0.0;
+    while (rounds < 20) {
+        int sx = next(2000), sy = next(2000), gx = next(2000), gy = next(2000);
+        t0 = Clock::now();
+        bool ok = reference.plan(large, sx, sy, gx, gy, expected);
+        aStarMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        if (!ok) {
+            continue;
+        }
+        ++rounds;
+        aStarExpanded += reference.getExpandedCount();
+        t0 = Clock::now();
+        hierarchy.plan(sx, sy, gx, gy, path);
+        hierarchyMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        hierarchyExpanded += hierarchy.getExpandedCount();
+        ratio += hierarchy.getPathCost() / reference.getPathCost();
+    }
+    changed.clear();
+    for (int x = 1000; x < 1010; ++x) {
+        large.setGrid(x, 1000, 1);
+        changed.push_back(PathCell{ x, 1000 });
+    }
+    t0 = Clock::now();
+    hierarchy.updateCells(changed);
+    double updateMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    std::cout << "[Bench] Build " << buildMs << " ms, " << hierarchy.getNodeCount() << " abstract nodes; update of "
+              << changed.size() << " cells " << updateMs << " ms (" << hierarchy.getRebuiltClusterCount()
+              << " clusters)\n";
+    std::cout << "[Bench] " << rounds << " queries, per query: A* " << aStarMs / rounds << " ms (" << aStarExpanded / rounds
+              << " cells), HPA* " << hierarchyMs / rounds << " ms (" << hierarchyExpanded / rounds
+              << " abstract nodes); cost / A* " << ratio / rounds << "\n";
+
+    std::cout << "----- HierarchicalPlanner Test Complete -----\n";
+    return 0;
+}
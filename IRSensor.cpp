@@ -4,13 +4,15 @@
  */
 
 #include "IRSensor.h"
+#include "ReplayRobotAPI.h"
 
 /**
  * @brief Default constructor for the IRSensor class.
  * 
  * Initializes the robot interface to nullptr and sets all IR sensor readings to 0.0.
  */
-IRSensor::IRSensor() : robotInterface(nullptr)
+template <typename Api>
+BasicIRSensor<Api>::BasicIRSensor() : robotInterface(nullptr)
 {
     for (int i = 0; i < 9; ++i) {
         readings[i] = 0.0;
@@ -20,11 +22,12 @@ IRSensor::IRSensor() : robotInterface(nullptr)
 /**
  * @brief Parameterized constructor for the IRSensor class.
  * 
- * Initializes the robot interface with the provided FestoRobotAPI pointer and sets all IR sensor readings to 0.0.
+ * Initializes the robot interface with the provided backend pointer and sets all IR sensor readings to 0.0.
  * 
- * @param api Pointer to the FestoRobotAPI object.
+ * @param api Pointer to the backend object.
  */
-IRSensor::IRSensor(FestoRobotAPI* api) : robotInterface(api)
+template <typename Api>
+BasicIRSensor<Api>::BasicIRSensor(Api* api) : robotInterface(api)
 {
     for (int i = 0; i < 9; ++i) {
         readings[i] = 0.0;
@@ -37,7 +40,8 @@ IRSensor::IRSensor(FestoRobotAPI* api) : robotInterface(api)
  * This function updates the readings array with the latest IR sensor values from the robot interface.
  * If the robot interface is not set, the function returns without updating the readings.
  */
-void IRSensor::update() {
+template <typename Api>
+void BasicIRSensor<Api>::update() {
     if (!robotInterface) return;
     for (int i = 0; i < 9; ++i) {
         readings[i] = robotInterface->getIRRange(i);
@@ -53,7 +57,8 @@ void IRSensor::update() {
  * @param index The index of the IR sensor reading to retrieve.
  * @return double The IR sensor reading at the specified index, or -1.0 if the index is out of bounds.
  */
-double IRSensor::getRange(int index) const {
+template <typename Api>
+double BasicIRSensor<Api>::getRange(int index) const {
     if (index >= 0 && index < 9) {
         return readings[index];
     }
@@ -68,6 +73,14 @@ double IRSensor::getRange(int index) const {
  * @param i The index of the IR sensor reading to retrieve.
  * @return double The IR sensor reading at the specified index.
  */
-double IRSensor::operator[](int i) const {
+template <typename Api>
+double BasicIRSensor<Api>::operator[](int i) const {
     return getRange(i);
-}
\ No newline at end of file
+}
+
+#if defined(_WIN32)
+template class BasicIRSensor<FestoRobotAPI>;
+#endif
+template class BasicIRSensor<SimulatedRobotAPI>;
+template class BasicIRSensor<ReplayRobotAPI>;
+template class BasicIRSensor<RobotBackend>;
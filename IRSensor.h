@@ -5,17 +5,22 @@
 
 #pragma once
 
-#include "FestoRobotAPI.h"
+#include "RobotBackend.h"
 
 /**
- * @class IRSensor
+ * @class BasicIRSensor
  * @brief Manages the IR sensor readings from the robot.
  * 
  * This class provides methods to update and retrieve IR sensor readings from the robot.
+ * The backend type is a template parameter, so update() calls the backend directly; use
+ * RobotBackend as the parameter to choose the backend at runtime instead.
+ *
+ * @tparam Api Backend type: FestoRobotAPI, SimulatedRobotAPI, ReplayRobotAPI or RobotBackend.
  */
-class IRSensor {
+template <typename Api>
+class BasicIRSensor {
 private:
-    FestoRobotAPI* robotInterface; ///< Pointer to the robot interface for accessing sensor data
+    Api* robotInterface; ///< Pointer to the robot interface for accessing sensor data
     double readings[9]; ///< Array to store the IR sensor readings
 
 public:
@@ -24,16 +29,16 @@ public:
      * 
      * Initializes the robot interface to nullptr and sets all IR sensor readings to 0.0.
      */
-    IRSensor();
+    BasicIRSensor();
 
     /**
      * @brief Parameterized constructor for the IRSensor class.
      * 
-     * Initializes the robot interface with the provided FestoRobotAPI pointer and sets all IR sensor readings to 0.0.
+     * Initializes the robot interface with the provided backend pointer and sets all IR sensor readings to 0.0.
      * 
-     * @param api Pointer to the FestoRobotAPI object.
+     * @param api Pointer to the backend object.
      */
-    IRSensor(FestoRobotAPI* api);
+    BasicIRSensor(Api* api);
 
     /**
      * @brief Updates the IR sensor readings.
@@ -63,4 +68,9 @@ public:
      * @return double The IR sensor reading at the specified index.
      */
     double operator[](int i) const;
-};
\ No newline at end of file
+};
+
+/**
+ * @brief IR sensor bound to the backend selected at compile time.
+ */
+typedef BasicIRSensor<RobotApi> IRSensor;
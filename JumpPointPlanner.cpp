@@ -0,0 +1,406 @@
+#include "JumpPointPlanner.h"
+#include <algorithm>
+#include <cstdlib>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+const float SQRT2 = 1.41421356f;
+
+// Directions in the order E, W, S, N, SE, SW, NE, NW, as in the A* planner.
+const int MOVE_X[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+const int MOVE_Y[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+
+inline float octile(int x, int y, int goalX, int goalY) {
+    int dx = std::abs(goalX - x);
+    int dy = std::abs(goalY - y);
+    return static_cast<float>(dx + dy) + (SQRT2 - 2.0f) * static_cast<float>(std::min(dx, dy));
+}
+
+inline int sign(int value) {
+    return (value > 0) - (value < 0);
+}
+
+// Index of the lowest set bit; word must not be 0.
+inline int lowestBit(std::uint64_t word) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while (!(word & 1ULL)) {
+        word >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+// Index of the highest set bit; word must not be 0.
+inline int highestBit(std::uint64_t word) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(word);
+#else
+    int index = 63;
+    while (!(word >> 63)) {
+        word <<= 1;
+        --index;
+    }
+    return index;
+#endif
+}
+
+} // namespace
+
+
+template <typename Cell>
+BasicJumpPointPlanner<Cell>::BasicJumpPointPlanner(Cell obstacleThreshold)
+    : cachedMap(nullptr), cachedBitMap(false), cachedVersion(0), cachedThreshold(obstacleThreshold), gridBuilds(0),
+      rowStride(0), columnStride(0), paddedX(0), paddedY(0), search(0), threshold(obstacleThreshold),
+      goalX(0), goalY(0), expanded(0), pathCost(0.0)
+{
+}
+
+template <typename Cell>
+void BasicJumpPointPlanner<Cell>::setObstacleThreshold(Cell obstacleThreshold) {
+    threshold = obstacleThreshold;
+}
+
+template <typename Cell>
+Cell BasicJumpPointPlanner<Cell>::getObstacleThreshold() const {
+    return threshold;
+}
+
+template <typename Cell>
+void BasicJumpPointPlanner<Cell>::beginGrid(int mapX, int mapY) {
+    int sizeX = std::max(mapX, 0) + 2;
+    int sizeY = std::max(mapY, 0) + 2;
+    if (sizeX != paddedX || sizeY != paddedY) {
+        std::size_t cellCount = static_cast<std::size_t>(sizeX) * sizeY;
+        nodes.assign(cellCount, Node{ 0.0f, 0u });
+        parent.assign(cellCount, 0);
+        paddedX = sizeX;
+        paddedY = sizeY;
+        search = 0;
+    }
+    rowStride = (paddedX + 63) / 64;
+    columnStride = (paddedY + 63) / 64;
+    rows.assign(static_cast<std::size_t>(rowStride) * paddedY, 0);
+
+    // Blocked border: the first and last row, the first column and every bit from the
+    // last column to the end of the row, so scans always stop inside the grid.
+    std::fill(rows.begin(), rows.begin() + rowStride, ~0ULL);
+    std::fill(rows.end() - rowStride, rows.end(), ~0ULL);
+    int lastWord = (paddedX - 1) >> 6;
+    std::uint64_t lastBits = ~0ULL << ((paddedX - 1) & 63);
+    for (int y = 1; y < paddedY - 1; ++y) {
+        std::uint64_t* row = rows.data() + static_cast<std::size_t>(y) * rowStride;
+        row[0] |= 1ULL;
+        row[lastWord] |= lastBits;
+    }
+}
+
+template <typename Cell>
+void BasicJumpPointPlanner<Cell>::buildColumns() {
+    columns.assign(static_cast<std::size_t>(columnStride) * paddedX, 0);
+    for (int y = 0; y < paddedY; ++y) {
+        const std::uint64_t* row = rows.data() + static_cast<std::size_t>(y) * rowStride;
+        std::uint64_t bit = 1ULL << (y & 63);
+        int word = y >> 6;
+        for (int w = 0; w < rowStride; ++w) {
+            for (std::uint64_t bits = row[w]; bits; bits &= bits - 1) {
+                int x = w * 64 + lowestBit(bits);
+                if (x < paddedX) {
+                    columns[static_cast<std::size_t>(x) * columnStride + word] |= bit;
+                }
+            }
+        }
+    }
+    int lastWord = (paddedY - 1) >> 6;
+    std::uint64_t lastBits = ~0ULL << ((paddedY - 1) & 63);
+    for (int x = 0; x < paddedX; ++x) {
+        columns[static_cast<std::size_t>(x) * columnStride + lastWord] |= lastBits;
+    }
+    ++gridBuilds;
+}
+
+template <typename Cell>
+bool BasicJumpPointPlanner<Cell>::isBlocked(int x, int y) const {
+    return (rows[static_cast<std::size_t>(y) * rowStride + (x >> 6)] >> (x & 63)) & 1ULL;
+}
+
+template <typename Cell>
+int BasicJumpPointPlanner<Cell>::jumpLine(const std::uint64_t* grid, int stride, int line, int from, int step,
+                                          int target) const {
+    const std::uint64_t* left = grid + static_cast<std::size_t>(line - 1) * stride;
+    const std::uint64_t* here = left + stride;
+    const std::uint64_t* right = here + stride;
+    // A free cell next to the line whose predecessor along the line is blocked can
+    // only be reached through the current cell, which makes the cell a jump point.
+    // The first such cell or obstacle ends the jump; the border guarantees one.
+    int found;
+    if (step > 0) {
+        int pos = from + 1;
+        int w = pos >> 6;
+        std::uint64_t mask = ~0ULL << (pos & 63);
+        for (;; ++w, mask = ~0ULL) {
+            std::uint64_t leftBefore = (left[w] << 1) | (w > 0 ? left[w - 1] >> 63 : 0);
+            std::uint64_t rightBefore = (right[w] << 1) | (w > 0 ? right[w - 1] >> 63 : 0);
+            std::uint64_t events = (here[w] | (~left[w] & leftBefore) | (~right[w] & rightBefore)) & mask;
+            if (events) {
+                found = w * 64 + lowestBit(events);
+                break;
+            }
+        }
+        if (target > from && target <= found) {
+            return target;
+        }
+    } else {
+        int pos = from - 1;
+        int w = pos >> 6;
+        std::uint64_t mask = ~0ULL >> (63 - (pos & 63));
+        for (;; --w, mask = ~0ULL) {
+            std::uint64_t leftBefore = (left[w] >> 1) | (w + 1 < stride ? left[w + 1] << 63 : 0);
+            std::uint64_t rightBefore = (right[w] >> 1) | (w + 1 < stride ? right[w + 1] << 63 : 0);
+            std::uint64_t events = (here[w] | (~left[w] & leftBefore) | (~right[w] & rightBefore)) & mask;
+            if (events) {
+                found = w * 64 + highestBit(events);
+                break;
+            }
+        }
+        if (target >= 0 && target < from && target >= found) {
+            return target;
+        }
+    }
+    return ((here[found >> 6] >> (found & 63)) & 1ULL) ? -1 : found;
+}
+
+template <typename Cell>
+int BasicJumpPointPlanner<Cell>::jump(int x, int y, int dx, int dy) const {
+    if (dy == 0) {
+        int found = jumpLine(rows.data(), rowStride, y, x, dx, y == goalY ? goalX : -1);
+        return found < 0 ? -1 : y * paddedX + found;
+    }
+    if (dx == 0) {
+        int found = jumpLine(columns.data(), columnStride, x, y, dy, x == goalX ? goalY : -1);
+        return found < 0 ? -1 : found * paddedX + x;
+    }
+    // Diagonal steps never cut a corner; every cell is checked for a straight jump
+    // point along the two directions the diagonal is made of.
+    for (;;) {
+        if (isBlocked(x + dx, y + dy) || isBlocked(x + dx, y) || isBlocked(x, y + dy)) {
+            return -1;
+        }
+        x += dx;
+        y += dy;
+        if ((x == goalX && y == goalY) ||
+            jumpLine(rows.data(), rowStride, y, x, dx, y == goalY ? goalX : -1) >= 0 ||
+            jumpLine(columns.data(), columnStride, x, y, dy, x == goalX ? goalY : -1) >= 0) {
+            return y * paddedX + x;
+        }
+    }
+}
+
+template <typename Cell>
+bool BasicJumpPointPlanner<Cell>::findPath(int startX, int startY, int toX, int toY, GridPath& path) {
+    int mapX = paddedX - 2;
+    int mapY = paddedY - 2;
+    if (startX < 0 || startY < 0 || startX >= mapX || startY >= mapY ||
+        toX < 0 || toY < 0 || toX >= mapX || toY >= mapY ||
+        isBlocked(startX + 1, startY + 1) || isBlocked(toX + 1, toY + 1)) {
+        return false;
+    }
+    ++search;
+    if (search >= 0x7fffffffu) {
+        for (Node& node : nodes) {
+            node.stamp = 0;
+        }
+        search = 1;
+    }
+    const std::uint32_t openStamp = search * 2;
+    const std::uint32_t closedStamp = openStamp + 1;
+    goalX = toX + 1;
+    goalY = toY + 1;
+    const int goal = goalY * paddedX + goalX;
+    auto later = [](const OpenEntry& a, const OpenEntry& b) {
+        return a.f > b.f || (a.f == b.f && a.h > b.h);
+    };
+
+    int start = (startY + 1) * paddedX + startX + 1;
+    nodes[start].g = 0.0f;
+    nodes[start].stamp = openStamp;
+    parent[start] = start;
+    float h0 = octile(startX + 1, startY + 1, goalX, goalY);
+    openList.push_back(OpenEntry{ h0, h0, start });
+
+    while (!openList.empty()) {
+        std::pop_heap(openList.begin(), openList.end(), later);
+        int current = openList.back().index;
+        openList.pop_back();
+        Node& node = nodes[current];
+        if (node.stamp == closedStamp) {
+            continue;
+        }
+        node.stamp = closedStamp;
+        ++expanded;
+
+        if (current == goal) {
+            // Jump points are joined by straight or diagonal segments; list every cell.
+            GridPath points;
+            for (int index = goal; ; index = parent[index]) {
+                points.push_back(PathCell{ index % paddedX - 1, index / paddedX - 1 });
+                if (index == start) {
+                    break;
+                }
+            }
+            int straight = 0;
+            int diagonal = 0;
+            path.push_back(points.back());
+            for (std::size_t i = points.size() - 1; i > 0; --i) {
+                PathCell cell = points[i];
+                const PathCell& to = points[i - 1];
+                int dx = sign(to.x - cell.x);
+                int dy = sign(to.y - cell.y);
+                while (cell.x != to.x || cell.y != to.y) {
+                    cell.x += dx;
+                    cell.y += dy;
+                    path.push_back(cell);
+                }
+                int length = std::max(std::abs(to.x - points[i].x), std::abs(to.y - points[i].y));
+                (dx != 0 && dy != 0 ? diagonal : straight) += length;
+            }
+            pathCost = straight + diagonal * 1.4142135623730951;
+            return true;
+        }
+
+        int x = current % paddedX;
+        int y = current / paddedX;
+        int from = parent[current];
+        int px = sign(x - from % paddedX);
+        int py = sign(y - from / paddedX);
+        float g = node.g;
+        for (int move = 0; move < 8; ++move) {
+            int dx = MOVE_X[move];
+            int dy = MOVE_Y[move];
+            // Prune directions that a path through the parent reaches at least as cheaply:
+            // after a diagonal keep its two components, after a straight move drop the
+            // three directions pointing back.
+            if (current != start &&
+                ((px != 0 && py != 0) ? ((dx != 0 && dx != px) || (dy != 0 && dy != py))
+                                      : dx * px + dy * py < 0)) {
+                continue;
+            }
+            int next = jump(x, y, dx, dy);
+            if (next < 0) {
+                continue;
+            }
+            Node& neighbour = nodes[next];
+            if (neighbour.stamp == closedStamp) {
+                continue;
+            }
+            int nx = next % paddedX;
+            int ny = next / paddedX;
+            float ng = g + octile(x, y, nx, ny);
+            if (neighbour.stamp != openStamp || ng < neighbour.g) {
+                neighbour.g = ng;
+                neighbour.stamp = openStamp;
+                parent[next] = current;
+                float h = octile(nx, ny, goalX, goalY);
+                openList.push_back(OpenEntry{ ng + h, h, next });
+                std::push_heap(openList.begin(), openList.end(), later);
+            }
+        }
+    }
+    return false;
+}
+
+template <typename Cell>
+bool BasicJumpPointPlanner<Cell>::plan(const BasicMap<Cell>& map, int startX, int startY, int goalX, int goalY,
+                                       GridPath& path) {
+    path.clear();
+    openList.clear();
+    expanded = 0;
+    pathCost = 0.0;
+    if (cachedMap != &map || cachedBitMap || cachedVersion != map.getVersion() || cachedThreshold != threshold ||
+        paddedX != map.getNumberX() + 2 || paddedY != map.getNumberY() + 2) {
+        beginGrid(map.getNumberX(), map.getNumberY());
+        const std::size_t stride = static_cast<std::size_t>(map.getStride());
+        for (int y = 0; y < map.getNumberY(); ++y) {
+            const Cell* cells = map.data() + y * stride;
+            std::uint64_t* row = rows.data() + static_cast<std::size_t>(y + 1) * rowStride;
+            for (int x = 0; x < map.getNumberX(); ++x) {
+                if (!(cells[x] < threshold)) {
+                    row[(x + 1) >> 6] |= 1ULL << ((x + 1) & 63);
+                }
+            }
+        }
+        buildColumns();
+        cachedMap = &map;
+        cachedBitMap = false;
+        cachedVersion = map.getVersion();
+        cachedThreshold = threshold;
+    }
+    return findPath(startX, startY, goalX, goalY, path);
+}
+
+template <typename Cell>
+bool BasicJumpPointPlanner<Cell>::plan(const BitMap& map, int startX, int startY, int goalX, int goalY,
+                                       GridPath& path) {
+    path.clear();
+    openList.clear();
+    expanded = 0;
+    pathCost = 0.0;
+    if (cachedMap != &map || !cachedBitMap || cachedVersion != map.getVersion() ||
+        paddedX != map.getNumberX() + 2 || paddedY != map.getNumberY() + 2) {
+        beginGrid(map.getNumberX(), map.getNumberY());
+        // Shift each row one bit up to make room for the border column.
+        int mapWords = (std::max(map.getNumberX(), 0) + BitMap::CELLS_PER_WORD - 1) / BitMap::CELLS_PER_WORD;
+        for (int y = 0; y < map.getNumberY(); ++y) {
+            const std::uint64_t* source = map.rowWords(y);
+            std::uint64_t* row = rows.data() + static_cast<std::size_t>(y + 1) * rowStride;
+            std::uint64_t carry = 0;
+            for (int w = 0; w < mapWords; ++w) {
+                row[w] |= (source[w] << 1) | carry;
+                carry = source[w] >> 63;
+            }
+            if (mapWords < rowStride) {
+                row[mapWords] |= carry;
+            }
+        }
+        buildColumns();
+        cachedMap = &map;
+        cachedBitMap = true;
+        cachedVersion = map.getVersion();
+    }
+    return findPath(startX, startY, goalX, goalY, path);
+}
+
+template <typename Cell>
+double BasicJumpPointPlanner<Cell>::getPathCost() const {
+    return pathCost;
+}
+
+template <typename Cell>
+int BasicJumpPointPlanner<Cell>::getExpandedCount() const {
+    return expanded;
+}
+
+template <typename Cell>
+int BasicJumpPointPlanner<Cell>::getGridBuildCount() const {
+    return gridBuilds;
+}
+
+template class BasicJumpPointPlanner<std::int8_t>;
+template class BasicJumpPointPlanner<std::uint8_t>;
+template class BasicJumpPointPlanner<std::int16_t>;
+template class BasicJumpPointPlanner<int>;
+template class BasicJumpPointPlanner<float>;
@@ -0,0 +1,207 @@
+/**
+ * @file JumpPointPlanner.h
+ * @brief Declaration of the JumpPointPlanner class.
+ */
+
+#ifndef JUMPPOINTPLANNER_H
+#define JUMPPOINTPLANNER_H
+
+#include <cstdint>
+#include <vector>
+#include "AStarPlanner.h"
+#include "BitMap.h"
+#include "Map.h"
+
+/**
+ * @class BasicJumpPointPlanner
+ * @brief Jump Point Search planner for uniform-cost grids.
+ *
+ * Moves, costs and the obstacle threshold are those of BasicAStarPlanner, and the
+ * returned paths have the same cost and list every cell, so both planners can be
+ * used interchangeably. Instead of expanding each cell, the search jumps along
+ * straight and diagonal lines and only stops at cells where an obstacle forces a
+ * turn, so open areas cost a few expansions.
+ *
+ * The planner keeps a copy of the blocked cells packed into bits, by rows and by
+ * columns, with a blocked border around the map. Straight jumps scan these words 64
+ * cells at a time in both directions. The copy is cached per map and map version,
+ * so repeated queries on an unchanged map skip rebuilding it; a BitMap is copied
+ * word by word.
+ */
+template <typename Cell>
+class BasicJumpPointPlanner {
+private:
+    /**
+     * @struct OpenEntry
+     * @brief Entry of the open list.
+     */
+    struct OpenEntry {
+        float f; ///< Cost from the start plus heuristic
+        float h; ///< Heuristic, breaks ties towards the goal
+        int index; ///< Padded cell index, (y + 1) * paddedX + x + 1
+    };
+
+    /**
+     * @struct Node
+     * @brief Search state of one cell.
+     */
+    struct Node {
+        float g; ///< Cost from the start, valid when the cell is stamped by this search
+        std::uint32_t stamp; ///< 2 * search when opened, 2 * search + 1 when closed
+    };
+
+    std::vector<std::uint64_t> rows; ///< Blocked bits by row, border included
+    std::vector<std::uint64_t> columns; ///< Blocked bits by column, border included
+    std::vector<Node> nodes; ///< Search state of each padded cell
+    std::vector<int> parent; ///< Jump point the cell was reached from
+    std::vector<OpenEntry> openList; ///< Binary min-heap ordered by f, then h
+    const void* cachedMap; ///< Map the bit grids were built from
+    bool cachedBitMap; ///< True if the cached map is a BitMap
+    std::uint64_t cachedVersion; ///< Version of the cached map
+    Cell cachedThreshold; ///< Obstacle threshold the bit grids were built with
+    int gridBuilds; ///< Number of times the bit grids were built
+    int rowStride; ///< Words per row of the row grid
+    int columnStride; ///< Words per column of the column grid
+    int paddedX; ///< Number of columns, border included
+    int paddedY; ///< Number of rows, border included
+    std::uint32_t search; ///< Number of the current search
+    Cell threshold; ///< Smallest cell value that blocks
+    int goalX; ///< Padded column of the goal
+    int goalY; ///< Padded row of the goal
+    int expanded; ///< Jump points expanded by the last query
+    double pathCost; ///< Cost of the last path found
+
+    /**
+     * @brief Sizes the bit grids for a map and fills the border.
+     *
+     * @param mapX Number of columns of the map.
+     * @param mapY Number of rows of the map.
+     */
+    void beginGrid(int mapX, int mapY);
+
+    /**
+     * @brief Builds the column grid from the row grid.
+     */
+    void buildColumns();
+
+    /**
+     * @brief Checks whether a padded cell is blocked.
+     *
+     * @param x Padded column.
+     * @param y Padded row.
+     * @return bool True if the cell is an obstacle or on the border.
+     */
+    bool isBlocked(int x, int y) const;
+
+    /**
+     * @brief Jumps along one line of a bit grid.
+     *
+     * @param grid The row or column grid.
+     * @param stride Words per line of the grid.
+     * @param line The line moved along; its neighbouring lines are checked for forced turns.
+     * @param from Position the jump starts from.
+     * @param step +1 or -1.
+     * @param target Position of the goal on the line, or -1.
+     * @return int Position of the jump point, or -1 if an obstacle comes first.
+     */
+    int jumpLine(const std::uint64_t* grid, int stride, int line, int from, int step, int target) const;
+
+    /**
+     * @brief Jumps from a cell in one of the eight directions.
+     *
+     * @param x Padded column of the cell.
+     * @param y Padded row of the cell.
+     * @param dx Column step, -1, 0 or 1.
+     * @param dy Row step, -1, 0 or 1.
+     * @return int Padded index of the jump point, or -1 if there is none.
+     */
+    int jump(int x, int y, int dx, int dy) const;
+
+    /**
+     * @brief Searches the cached bit grids.
+     *
+     * @param startX Column of the start cell.
+     * @param startY Row of the start cell.
+     * @param toX Column of the goal cell.
+     * @param toY Row of the goal cell.
+     * @param path Receives the path from start to goal.
+     * @return bool True if a path was found.
+     */
+    bool findPath(int startX, int startY, int toX, int toY, GridPath& path);
+
+public:
+    /**
+     * @brief Constructs a planner.
+     *
+     * @param obstacleThreshold Smallest cell value that blocks.
+     */
+    explicit BasicJumpPointPlanner(Cell obstacleThreshold = 1);
+
+    /**
+     * @brief Sets the obstacle threshold.
+     *
+     * @param obstacleThreshold Smallest cell value that blocks.
+     */
+    void setObstacleThreshold(Cell obstacleThreshold);
+
+    /**
+     * @brief Gets the obstacle threshold.
+     *
+     * @return Cell Smallest cell value that blocks.
+     */
+    Cell getObstacleThreshold() const;
+
+    /**
+     * @brief Plans a shortest path between two cells of a map.
+     *
+     * @param map The map.
+     * @param startX Column of the start cell.
+     * @param startY Row of the start cell.
+     * @param goalX Column of the goal cell.
+     * @param goalY Row of the goal cell.
+     * @param path Receives the path from start to goal; cleared if there is none.
+     * @return bool True if a path was found; false if start or goal is blocked or
+     *         outside the map, or the goal cannot be reached.
+     */
+    bool plan(const BasicMap<Cell>& map, int startX, int startY, int goalX, int goalY, GridPath& path);
+
+    /**
+     * @brief Plans a shortest path between two cells of a bit-packed map.
+     *
+     * Occupied cells are blocked; the obstacle threshold is not used.
+     *
+     * @param map The map.
+     * @param startX Column of the start cell.
+     * @param startY Row of the start cell.
+     * @param goalX Column of the goal cell.
+     * @param goalY Row of the goal cell.
+     * @param path Receives the path from start to goal; cleared if there is none.
+     * @return bool True if a path was found.
+     */
+    bool plan(const BitMap& map, int startX, int startY, int goalX, int goalY, GridPath& path);
+
+    /**
+     * @brief Gets the cost of the last path found.
+     *
+     * @return double The length of the path in cells.
+     */
+    double getPathCost() const;
+
+    /**
+     * @brief Gets the number of jump points expanded by the last query.
+     *
+     * @return int The number of expanded jump points.
+     */
+    int getExpandedCount() const;
+
+    /**
+     * @brief Gets the number of times the cached bit grids were built.
+     *
+     * @return int The number of builds.
+     */
+    int getGridBuildCount() const;
+};
+
+typedef BasicJumpPointPlanner<int> JumpPointPlanner; ///< Jump point planner over the default map type
+
+#endif // JUMPPOINTPLANNER_H
@@ -0,0 +1,185 @@
+/**
+ * @file JumpPointPlannerTest.cpp
+ * @brief Test file for the JumpPointPlanner class.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include "JumpPointPlanner.h"
+
+namespace {
+
+// Checks that consecutive cells are neighbours, free, and that diagonals do not cut corners.
+bool isConnected(const Map& map, const GridPath& path) {
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        if (map.getGrid(path[i].x, path[i].y) != 0) {
+            return false;
+        }
+        if (i == 0) {
+            continue;
+        }
+        int dx = path[i].x - path[i - 1].x;
+        int dy = path[i].y - path[i - 1].y;
+        if (std::abs(dx) > 1 || std::abs(dy) > 1 || (dx == 0 && dy == 0)) {
+            return false;
+        }
+        if (dx != 0 && dy != 0 &&
+            (map.getGrid(path[i - 1].x + dx, path[i - 1].y) != 0 || map.getGrid(path[i - 1].x, path[i - 1].y + dy) != 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Main function to test the JumpPointPlanner class.
+ *
+ * This function performs various tests on the JumpPointPlanner class:
+ * - Plans the same cost as A* around a wall and returns every cell of the path.
+ * - Compares costs with A* on random maps, on Map and on BitMap input.
+ * - Reuses the cached bit grids until the map version changes.
+ * - Compares query times with A* on a 2000 x 2000 map.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- JumpPointPlanner Test Start -----\n";
+
+    // 1. Same cost as A* around a wall
+    Map map(40, 30);
+    for (int y = 0; y < 25; ++y) {
+        map.setGrid(20, y, 1);
+    }
+    JumpPointPlanner planner;
+    AStarPlanner reference;
+    GridPath path, expected;
+    std::cout << "[Test] Around the wall => " << planner.plan(map, 2, 2, 37, 2, path) << ", cost "
+              << planner.getPathCost() << ", expanded " << planner.getExpandedCount();
+    reference.plan(map, 2, 2, 37, 2, expected);
+    std::cout << "; A* cost " << reference.getPathCost() << ", expanded " << reference.getExpandedCount() << "\n";
+    std::cout << "[Test] Path cells " << path.size() << ", connected => " << isConnected(map, path) << "\n";
+    std::cout << "[Test] Blocked goal => " << planner.plan(map, 2, 2, 20, 2, path)
+              << ", outside => " << planner.plan(map, 2, 2, 40, 2, path) << "\n";
+
+    // 2. Random maps, Map and BitMap input
+    std::uint32_t seed = 7u;
+    auto next = [&seed](int range) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<int>((seed >> 8) % static_cast<std::uint32_t>(range));
+    };
+    int queries = 0, mismatches = 0, bitMismatches = 0, broken = 0;
+    for (int trial = 0; trial < 300; ++trial) {
+        int sizeX = 20 + next(120);
+        int sizeY = 10 + next(60);
+        Map random(sizeX, sizeY);
+        BitMap bits(sizeX, sizeY);
+        int density = 10 + next(35);
+        for (int y = 0; y < sizeY; ++y) {
+            for (int x = 0; x < sizeX; ++x) {
+                if (next(100) < density) {
+                    random.setGrid(x, y, 1);
+                    bits.setGrid(x, y, 1);
+                }
+            }
+        }
+        for (int query = 0; query < 5; ++query) {
+            int sx = next(sizeX), sy = next(sizeY), gx = next(sizeX), gy = next(sizeY);
+            bool found = planner.plan(random, sx, sy, gx, gy, path);
+            bool foundReference = reference.plan(random, sx, sy, gx, gy, expected);
+            ++queries;
+            if (found != foundReference || std::fabs(planner.getPathCost() - reference.getPathCost()) > 1e-3) {
+                ++mismatches;
+            }
+            if (found && (!isConnected(random, path) || path.front().x != sx || path.front().y != sy ||
+                          path.back().x != gx || path.back().y != gy)) {
+                ++broken;
+            }
+            double cost = planner.getPathCost();
+            if (planner.plan(bits, sx, sy, gx, gy, path) != found || std::fabs(planner.getPathCost() - cost) > 1e-9) {
+                ++bitMismatches;
+            }
+        }
+    }
+    std::cout << "[Test] " << queries << " random queries: cost mismatches with A* => " << mismatches
+              << ", BitMap mismatches => " << bitMismatches << ", broken paths => " << broken << "\n";
+
+    // 3. Grid cache follows the map version
+    int builds = planner.getGridBuildCount();
+    planner.plan(map, 2, 2, 37, 2, path);
+    planner.plan(map, 2, 28, 37, 28, path);
+    std::cout << "[Test] Two queries on one map => " << planner.getGridBuildCount() - builds << " grid build";
+    map.setGrid(20, 27, 1);
+    planner.plan(map, 2, 28, 37, 28, path);
+    reference.plan(map, 2, 28, 37, 28, expected);
+    std::cout << ", after setGrid => " << planner.getGridBuildCount() - builds << " builds, cost "
+              << planner.getPathCost() << ", A* cost " << reference.getPathCost() << "\n";
+
+    // 4. Benchmark against A* on 2000 x 2000 with 20 x 20 obstacles
+    using Clock = std::chrono::steady_clock;
+    Map large(2000, 2000);
+    BitMap largeBits(2000, 2000);
+    seed = 11u;
+    for (int i = 0; i < 1500; ++i) {
+        int x0 = next(2000);
+        int y0 = next(2000);
+        for (int y = y0; y < y0 + 20 && y < 2000; ++y) {
+            for (int x = x0; x < x0 + 20 && x < 2000; ++x) {
+                large.setGrid(x, y, 1);
+                largeBits.setGrid(x, y, 1);
+            }
+        }
+    }
+    JumpPointPlanner fast;
+    fast.plan(largeBits, 0, 0, 0, 0, path);
+    Clock::time_point t0 = Clock::now();
+    fast.plan(large, 0, 0, 0, 0, path);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    t0 = Clock::now();
+    fast.plan(largeBits, 0, 0, 0, 0, path);
+    double bitBuildMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    fast.plan(large, 0, 0, 0, 0, path);
+    double aStarMs = 0.0, jumpMs = 0.0, bitJumpMs = 0.0;
+    long long aStarExpanded = 0, jumpExpanded = 0;
+    std::vector<PathCell> ends;
+    int rounds = 0;
+    mismatches = 0;
+    while (rounds < 20) {
+        int sx = next(2000), sy = next(2000), gx = next(2000), gy = next(2000);
+        t0 = Clock::now();
+        bool found = reference.plan(large, sx, sy, gx, gy, expected);
+        aStarMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        if (!found) {
+            continue;
+        }
+        ++rounds;
+        ends.push_back(PathCell{ sx, sy });
+        ends.push_back(PathCell{ gx, gy });
+        aStarExpanded += reference.getExpandedCount();
+        t0 = Clock::now();
+        fast.plan(large, sx, sy, gx, gy, path);
+        jumpMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        jumpExpanded += fast.getExpandedCount();
+        if (std::fabs(fast.getPathCost() - reference.getPathCost()) > 1e-4 * reference.getPathCost()) {
+            ++mismatches;
+        }
+    }
+    fast.plan(largeBits, 0, 0, 0, 0, path);
+    for (std::size_t i = 0; i < ends.size(); i += 2) {
+        t0 = Clock::now();
+        fast.plan(largeBits, ends[i].x, ends[i].y, ends[i + 1].x, ends[i + 1].y, path);
+        bitJumpMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+    std::cout << "[Bench] Bit grid build: from Map " << buildMs << " ms, from BitMap " << bitBuildMs << " ms\n";
+    std::cout << "[Bench] " << rounds << " queries, per query: A* " << aStarMs / rounds << " ms ("
+              << aStarExpanded / rounds << " cells), JPS " << jumpMs / rounds << " ms ("
+              << jumpExpanded / rounds << " jump points), JPS on BitMap " << bitJumpMs / rounds
+              << " ms; cost mismatches => " << mismatches << "\n";
+
+    std::cout << "----- JumpPointPlanner Test Complete -----\n";
+    return 0;
+}
@@ -4,53 +4,206 @@
  */
 
 #include "LidarSensor.h"
+#include "ReplayRobotAPI.h"
 #include <stdexcept>
 #include <limits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <algorithm>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define LIDAR_USE_SSE2 1
+#endif
 #undef max
+#undef min
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+const size_t SCAN_ALIGNMENT = 64; ///< Alignment of the scan buffer in bytes
+
+float* allocateScan(int count) {
+    size_t bytes = static_cast<size_t>(std::max(count, 1)) * sizeof(float);
+    void* buffer = nullptr;
+#if defined(_MSC_VER)
+    buffer = _aligned_malloc(bytes, SCAN_ALIGNMENT);
+#else
+    if (posix_memalign(&buffer, SCAN_ALIGNMENT, bytes) != 0) {
+        buffer = nullptr;
+    }
+#endif
+    if (!buffer) {
+        throw std::bad_alloc();
+    }
+    std::memset(buffer, 0, bytes);
+    return static_cast<float*>(buffer);
+}
+
+void releaseScan(float* buffer) {
+#if defined(_MSC_VER)
+    _aligned_free(buffer);
+#else
+    std::free(buffer);
+#endif
+}
+
+inline bool isValidRange(float r) {
+    // NaN fails both comparisons.
+    return r > 0.0f && r < std::numeric_limits<float>::infinity();
+}
+
+/**
+ * @brief Divides and rounds towards positive infinity.
+ *
+ * @param numerator Any value.
+ * @param denominator A positive value.
+ * @return long long The quotient rounded up.
+ */
+inline long long ceilDiv(long long numerator, long long denominator) {
+    // Division truncates towards zero, which already rounds negative quotients up.
+    return numerator > 0 ? (numerator + denominator - 1) / denominator : numerator / denominator;
+}
+
+/**
+ * @brief Finds the smallest valid range in [begin, end) of a scan.
+ *
+ * Within the range the lowest index wins ties. Leaves minimum and index untouched when
+ * the range holds nothing smaller than the current minimum.
+ */
+void minRange(const float* ranges, int begin, int end, float& minimum, int& index) {
+    int i = begin;
+#if defined(LIDAR_USE_SSE2)
+    if (end - begin >= 8) {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+        __m128 best = inf;
+        __m128i bestIdx = _mm_set1_epi32(-1);
+        __m128i idx = _mm_setr_epi32(i, i + 1, i + 2, i + 3);
+        const __m128i four = _mm_set1_epi32(4);
+        for (; i + 4 <= end; i += 4) {
+            __m128 v = _mm_loadu_ps(ranges + i);
+            __m128 valid = _mm_and_ps(_mm_cmpgt_ps(v, zero), _mm_cmplt_ps(v, inf));
+            v = _mm_or_ps(_mm_and_ps(valid, v), _mm_andnot_ps(valid, inf));
+            __m128 less = _mm_cmplt_ps(v, best);
+            best = _mm_or_ps(_mm_and_ps(less, v), _mm_andnot_ps(less, best));
+            __m128i lessI = _mm_castps_si128(less);
+            bestIdx = _mm_or_si128(_mm_and_si128(lessI, idx), _mm_andnot_si128(lessI, bestIdx));
+            idx = _mm_add_epi32(idx, four);
+        }
+        float lane[4];
+        int laneIdx[4];
+        _mm_storeu_ps(lane, best);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(laneIdx), bestIdx);
+        float vecMin = minimum;
+        int vecIdx = -1;
+        for (int k = 0; k < 4; ++k) {
+            if (laneIdx[k] >= 0 && (lane[k] < vecMin || (lane[k] == vecMin && vecIdx >= 0 && laneIdx[k] < vecIdx))) {
+                vecMin = lane[k];
+                vecIdx = laneIdx[k];
+            }
+        }
+        if (vecIdx >= 0 && vecMin < minimum) {
+            minimum = vecMin;
+            index = vecIdx;
+        }
+    }
+#endif
+    for (; i < end; ++i) {
+        if (isValidRange(ranges[i]) && ranges[i] < minimum) {
+            minimum = ranges[i];
+            index = i;
+        }
+    }
+}
+
+}
 
 /**
  * @brief Constructs a LidarSensor object.
  * 
- * Initializes the LidarSensor with a pointer to the FestoRobotAPI object and the number of ranges.
- * Allocates memory for the data array and initializes all values to 0.0.
+ * Initializes the LidarSensor with a pointer to the backend object and the number of ranges.
+ * Allocates memory for the data array and initializes all values to 0.0, and builds the
+ * beam angle and direction tables. The beams are spread evenly over the field of view.
+ * The data array is large enough for the scan size reported by getLidarRangeNumber(),
+ * so that the API can fill it in a single call.
  * 
- * @param api Pointer to the FestoRobotAPI object.
- * @param numRanges Number of ranges to be stored in the data array.
+ * @param api Pointer to the backend object.
+ * @param numRanges Number of ranges to be stored in the data array; if not positive,
+ *                  the number reported by the API is used.
+ * @param startAngle Angle of the first beam in degrees.
+ * @param fieldOfView Angle covered by all beams in degrees.
  */
-LidarSensor::LidarSensor(FestoRobotAPI* api, int numRanges)
-    : robotInterface(api), dataCount(numRanges)
+template <typename Api>
+BasicLidarSensor<Api>::BasicLidarSensor(Api* api, int numRanges, double startAngle, double fieldOfView)
+    : dataCount(numRanges), capacity(numRanges), robotInterface(api), angleMin(startAngle), angleStep(0.0),
+      scanRing(nullptr)
 {
-    data = new double[dataCount];
+    int apiCount = robotInterface ? robotInterface->getLidarRangeNumber() : 0;
+    if (dataCount <= 0) {
+        dataCount = std::max(apiCount, 0);
+    }
+    // getLidarRange() writes a full scan, so the buffer must hold what the API reports.
+    capacity = std::max(dataCount, apiCount);
+    angleStep = dataCount > 0 ? fieldOfView / dataCount : 0.0;
+
+    data = allocateScan(capacity);
+    cosTable = new float[dataCount];
+    sinTable = new float[dataCount];
     for (int i = 0; i < dataCount; i++) {
-        data[i] = 0.0;
+        double rad = getAngle(i) * M_PI / 180.0;
+        cosTable[i] = static_cast<float>(std::cos(rad));
+        sinTable[i] = static_cast<float>(std::sin(rad));
     }
 }
 
 /**
  * @brief Destructor for the LidarSensor class.
  * 
- * Deallocates the memory allocated for the data array.
+ * Deallocates the memory allocated for the data array and the beam tables.
  */
-LidarSensor::~LidarSensor() {
-    delete[] data;
+template <typename Api>
+BasicLidarSensor<Api>::~BasicLidarSensor() {
+    releaseScan(data);
+    delete[] cosTable;
+    delete[] sinTable;
 }
 
 /**
  * @brief Updates the Lidar sensor readings.
  * 
  * This function updates the data array with the latest Lidar sensor values from the robot interface.
- * If the robot interface is not set, the function throws a runtime error.
+ * The whole scan is read with a single getLidarRange() call straight into the data array,
+ * without any allocation unless the API now reports more beams than the array holds;
+ * the array then grows first, which invalidates earlier scan views. If a scan ring is
+ * set, the scan is then published to it with the current monotonic time. If the robot
+ * interface is not set, the function throws a runtime error.
  * 
  * @throws std::runtime_error if the robot interface is not available.
  */
-void LidarSensor::update() {
+template <typename Api>
+void BasicLidarSensor<Api>::update() {
     if (!robotInterface) {
         throw std::runtime_error("No API available for LidarSensor.");
     }
-    float tempVal = 0.0f;
-    for (int i = 0; i < dataCount; ++i) {
-        robotInterface->getLidarRange(&tempVal);
-        data[i] = static_cast<double>(tempVal);
+    // The scan size may change after construction, e.g. when a replay log is opened.
+    int apiCount = robotInterface->getLidarRangeNumber();
+    if (apiCount > capacity) {
+        float* grown = allocateScan(apiCount);
+        releaseScan(data);
+        data = grown;
+        capacity = apiCount;
+    }
+    robotInterface->getLidarRange(data);
+    if (scanRing) {
+        scanRing->publish(data, dataCount);
     }
 }
 
@@ -64,29 +217,193 @@ void LidarSensor::update() {
  * @return double The Lidar sensor reading at the specified index.
  * @throws std::out_of_range if the index is out of bounds.
  */
-double LidarSensor::getRange(int index) const {
+template <typename Api>
+double BasicLidarSensor<Api>::getRange(int index) const {
     if (index < 0 || index >= dataCount) {
         throw std::out_of_range("Invalid index in LidarSensor::getRange");
     }
-    return data[index];
+    return static_cast<double>(data[index]);
 }
 
 /**
  * @brief Gets the minimum Lidar sensor reading and its index.
  * 
  * This function iterates through the data array to find the minimum Lidar sensor reading and its index.
+ * Invalid readings (zero, negative, infinite or NaN) are ignored.
+ * 
+ * @param index Reference to an integer where the index of the minimum reading will be stored, -1 if none is valid.
+ * @return double The minimum Lidar sensor reading, or infinity if none is valid.
+ */
+template <typename Api>
+double BasicLidarSensor<Api>::getMin(int& index) const {
+    float minimum = std::numeric_limits<float>::infinity();
+    index = -1;
+    minRange(data, 0, dataCount, minimum, index);
+    return index < 0 ? std::numeric_limits<double>::infinity() : static_cast<double>(minimum);
+}
+
+/**
+ * @brief Gets the maximum Lidar sensor reading and its index.
+ * 
+ * This function iterates through the data array to find the maximum Lidar sensor reading and its index.
+ * Invalid readings (zero, negative, infinite or NaN) are ignored.
  * 
- * @param index Reference to an integer where the index of the minimum reading will be stored.
- * @return double The minimum Lidar sensor reading.
+ * @param index Reference to an integer where the index of the maximum reading will be stored, -1 if none is valid.
+ * @return double The maximum Lidar sensor reading, or 0.0 if none is valid.
  */
-double LidarSensor::getMin(int& index) const {
-    double minimum = std::numeric_limits<double>::infinity();
+template <typename Api>
+double BasicLidarSensor<Api>::getMax(int& index) const {
+    float maximum = 0.0f;
     index = -1;
     for (int i = 0; i < dataCount; i++) {
-        if (data[i] < minimum) {
-            minimum = data[i];
+        if (isValidRange(data[i]) && data[i] > maximum) {
+            maximum = data[i];
             index = i;
         }
     }
-    return minimum;
-}
\ No newline at end of file
+    return static_cast<double>(maximum);
+}
+
+/**
+ * @brief Gets the minimum range of every angular sector in one sweep.
+ * 
+ * The scan is split into sectorCount sectors of equal width. Sector k is centred on
+ * the angle of beam k * getRangeNumber() / sectorCount, so with the default beam layout
+ * sector 0 is straight ahead and the sectors follow counter-clockwise (front, front-left,
+ * left, ...). Invalid readings (zero, negative, infinite or NaN) are ignored. The
+ * min/argmin kernel uses SSE2 where available.
+ * 
+ * @param sectorCount Number of sectors.
+ * @param minima Output array of sectorCount minimum ranges; infinity for sectors without a valid reading.
+ * @param indices Optional output array of sectorCount beam indices of the minima, -1 when none is valid.
+ */
+template <typename Api>
+void BasicLidarSensor<Api>::getSectorMin(int sectorCount, float* minima, int* indices) const {
+    if (sectorCount <= 0 || !minima) {
+        return;
+    }
+    for (int k = 0; k < sectorCount; ++k) {
+        // Sector k spans [centre - width / 2, centre + width / 2), wrapping around the scan.
+        // Both bounds round up, so the bound shared by two sectors falls on the same beam
+        // and every beam belongs to exactly one sector.
+        long long first = ceilDiv(static_cast<long long>(2 * k - 1) * dataCount, 2LL * sectorCount);
+        long long last = ceilDiv(static_cast<long long>(2 * k + 1) * dataCount, 2LL * sectorCount);
+        float minimum = std::numeric_limits<float>::infinity();
+        int index = -1;
+        if (first < 0) {
+            minRange(data, static_cast<int>(first + dataCount), dataCount, minimum, index);
+            first = 0;
+        }
+        minRange(data, static_cast<int>(first), static_cast<int>(last), minimum, index);
+        minima[k] = minimum;
+        if (indices) {
+            indices[k] = index;
+        }
+    }
+}
+
+/**
+ * @brief Overloaded subscript operator to get the Lidar sensor reading at the specified index.
+ * 
+ * This function returns the Lidar sensor reading at the given index using the subscript operator.
+ * 
+ * @param i The index of the Lidar sensor reading to retrieve.
+ * @return double The Lidar sensor reading at the specified index.
+ */
+template <typename Api>
+double BasicLidarSensor<Api>::operator[](int i) const {
+    return getRange(i);
+}
+
+/**
+ * @brief Gets the angle corresponding to the specified index.
+ * 
+ * This function returns the angle in degrees corresponding to the given index.
+ * 
+ * @param i The index for which to retrieve the angle.
+ * @return double The angle in degrees corresponding to the specified index.
+ */
+template <typename Api>
+double BasicLidarSensor<Api>::getAngle(int i) const {
+    return angleMin + i * angleStep;
+}
+
+/**
+ * @brief Gets a zero-copy view of the latest scan.
+ * 
+ * @return ScanView View of getRangeNumber() ranges, valid until the next update().
+ */
+template <typename Api>
+ScanView BasicLidarSensor<Api>::getScan() const {
+    return ScanView(data, dataCount);
+}
+
+/**
+ * @brief Sets the ring every new scan is published to.
+ * 
+ * Consumers on other threads should read scans from the ring rather than from the
+ * sensor, which is only safe to read from the thread calling update().
+ * 
+ * @param ring The ring, or nullptr to stop publishing. The ring must outlive the sensor.
+ */
+template <typename Api>
+void BasicLidarSensor<Api>::setScanRing(ScanRing* ring) {
+    scanRing = ring;
+}
+
+/**
+ * @brief Gets the number of ranges in a scan.
+ * 
+ * @return int The number of ranges.
+ */
+template <typename Api>
+int BasicLidarSensor<Api>::getRangeNumber() const {
+    return dataCount;
+}
+
+/**
+ * @brief Gets the cosine of every beam angle.
+ * 
+ * @return const float* Table of getRangeNumber() values.
+ */
+template <typename Api>
+const float* BasicLidarSensor<Api>::getDirectionX() const {
+    return cosTable;
+}
+
+/**
+ * @brief Gets the sine of every beam angle.
+ * 
+ * @return const float* Table of getRangeNumber() values.
+ */
+template <typename Api>
+const float* BasicLidarSensor<Api>::getDirectionY() const {
+    return sinTable;
+}
+
+/**
+ * @brief Converts the current scan to Cartesian points in the sensor frame.
+ * 
+ * Each point is the range multiplied by the precomputed beam direction, so the loop is
+ * a plain multiply over contiguous arrays that the compiler can vectorize.
+ * 
+ * @param xs Output array of getRangeNumber() x-coordinates.
+ * @param ys Output array of getRangeNumber() y-coordinates.
+ */
+template <typename Api>
+void BasicLidarSensor<Api>::toCartesian(float* xs, float* ys) const {
+    const float* ranges = data;
+    const float* cx = cosTable;
+    const float* cy = sinTable;
+    for (int i = 0; i < dataCount; ++i) {
+        xs[i] = ranges[i] * cx[i];
+        ys[i] = ranges[i] * cy[i];
+    }
+}
+
+#if defined(_WIN32)
+template class BasicLidarSensor<FestoRobotAPI>;
+#endif
+template class BasicLidarSensor<SimulatedRobotAPI>;
+template class BasicLidarSensor<ReplayRobotAPI>;
+template class BasicLidarSensor<RobotBackend>;
@@ -4,44 +4,129 @@
  */
 
 #pragma once
-#include "FestoRobotAPI.h"
+#include "RobotBackend.h"
+#include "ScanRing.h"
 
 /**
- * @class LidarSensor
+ * @class ScanView
+ * @brief Non-owning view of the ranges of one Lidar scan.
+ *
+ * The view points directly into the sensor's buffer; it stays valid until the next
+ * update() of the sensor it came from.
+ */
+class ScanView {
+private:
+    const float* ranges; ///< First range of the scan
+    int count; ///< Number of ranges in the scan
+
+public:
+    /**
+     * @brief Constructs a view over the given ranges.
+     *
+     * @param scanRanges Pointer to the first range.
+     * @param scanCount Number of ranges.
+     */
+    ScanView(const float* scanRanges, int scanCount) : ranges(scanRanges), count(scanCount) {}
+
+    /**
+     * @brief Gets the number of ranges.
+     *
+     * @return int The number of ranges.
+     */
+    int size() const { return count; }
+
+    /**
+     * @brief Gets a pointer to the first range.
+     *
+     * @return const float* Pointer to the ranges.
+     */
+    const float* data() const { return ranges; }
+
+    /**
+     * @brief Gets the range at the specified index without bounds checking.
+     *
+     * @param i The beam index.
+     * @return float The range in metres.
+     */
+    float operator[](int i) const { return ranges[i]; }
+
+    /**
+     * @brief Gets an iterator to the first range.
+     *
+     * @return const float* Pointer to the first range.
+     */
+    const float* begin() const { return ranges; }
+
+    /**
+     * @brief Gets an iterator past the last range.
+     *
+     * @return const float* Pointer past the last range.
+     */
+    const float* end() const { return ranges + count; }
+};
+
+/**
+ * @class BasicLidarSensor
  * @brief Manages the Lidar sensor readings from the robot.
  * 
  * This class provides methods to update and retrieve Lidar sensor readings from the robot.
+ * The beam angles are fixed for a given number of ranges, so the angle of each beam and
+ * its unit direction vector are computed once at construction and kept in contiguous
+ * tables. The backend type is a template parameter, so update() calls the backend
+ * directly; use RobotBackend as the parameter to choose the backend at runtime instead.
+ *
+ * @tparam Api Backend type: FestoRobotAPI, SimulatedRobotAPI, ReplayRobotAPI or RobotBackend.
  */
-class LidarSensor {
+template <typename Api>
+class BasicLidarSensor {
 private:
-    double* data; ///< Array to store the Lidar sensor readings
+    float* data; ///< Cache-aligned array filled by one bulk read per scan
     int dataCount; ///< Number of ranges in the data array
-    FestoRobotAPI* robotInterface; ///< Pointer to the robot interface for accessing sensor data
+    int capacity; ///< Number of floats allocated for the data array
+    Api* robotInterface; ///< Pointer to the robot interface for accessing sensor data
+    double angleMin; ///< Angle of the first beam in degrees
+    double angleStep; ///< Angle between consecutive beams in degrees
+    float* cosTable; ///< Cosine of each beam angle
+    float* sinTable; ///< Sine of each beam angle
+    ScanRing* scanRing; ///< Ring each new scan is published to, or nullptr
+
+    BasicLidarSensor(const BasicLidarSensor&);
+    BasicLidarSensor& operator=(const BasicLidarSensor&);
 
 public:
     /**
      * @brief Constructs a LidarSensor object.
      * 
-     * Initializes the LidarSensor with a pointer to the FestoRobotAPI object and the number of ranges.
-     * Allocates memory for the data array and initializes all values to 0.0.
+     * Initializes the LidarSensor with a pointer to the backend object and the number of ranges.
+     * Allocates memory for the data array and initializes all values to 0.0, and builds the
+     * beam angle and direction tables. The beams are spread evenly over the field of view.
+     * The data array is large enough for the scan size reported by getLidarRangeNumber(),
+     * so that the API can fill it in a single call.
      * 
-     * @param api Pointer to the FestoRobotAPI object.
-     * @param numRanges Number of ranges to be stored in the data array.
+     * @param api Pointer to the backend object.
+     * @param numRanges Number of ranges to be stored in the data array; if not positive,
+     *                  the number reported by the API is used.
+     * @param startAngle Angle of the first beam in degrees.
+     * @param fieldOfView Angle covered by all beams in degrees.
      */
-    LidarSensor(FestoRobotAPI* api, int numRanges);
+    BasicLidarSensor(Api* api, int numRanges = 0, double startAngle = 0.0, double fieldOfView = 360.0);
 
     /**
      * @brief Destructor for the LidarSensor class.
      * 
-     * Deallocates the memory allocated for the data array.
+     * Deallocates the memory allocated for the data array and the beam tables.
      */
-    ~LidarSensor();
+    ~BasicLidarSensor();
 
     /**
      * @brief Updates the Lidar sensor readings.
      * 
      * This function updates the data array with the latest Lidar sensor values from the robot interface.
-     * If the robot interface is not set, the function throws a runtime error.
+     * The whole scan is read with a single getLidarRange() call straight into the data array,
+     * without any allocation unless the API now reports more beams than the array holds;
+     * the array then grows first, which invalidates earlier scan views. If a scan ring is
+     * set, the scan is then published to it with the current monotonic time. If the robot
+     * interface is not set, the function throws a runtime error.
      * 
      * @throws std::runtime_error if the robot interface is not available.
      */
@@ -63,9 +148,10 @@ public:
      * @brief Gets the minimum Lidar sensor reading and its index.
      * 
      * This function iterates through the data array to find the minimum Lidar sensor reading and its index.
+     * Invalid readings (zero, negative, infinite or NaN) are ignored.
      * 
-     * @param index Reference to an integer where the index of the minimum reading will be stored.
-     * @return double The minimum Lidar sensor reading.
+     * @param index Reference to an integer where the index of the minimum reading will be stored, -1 if none is valid.
+     * @return double The minimum Lidar sensor reading, or infinity if none is valid.
      */
     double getMin(int& index) const;
 
@@ -73,12 +159,28 @@ public:
      * @brief Gets the maximum Lidar sensor reading and its index.
      * 
      * This function iterates through the data array to find the maximum Lidar sensor reading and its index.
+     * Invalid readings (zero, negative, infinite or NaN) are ignored.
      * 
-     * @param index Reference to an integer where the index of the maximum reading will be stored.
-     * @return double The maximum Lidar sensor reading.
+     * @param index Reference to an integer where the index of the maximum reading will be stored, -1 if none is valid.
+     * @return double The maximum Lidar sensor reading, or 0.0 if none is valid.
      */
     double getMax(int& index) const;
 
+    /**
+     * @brief Gets the minimum range of every angular sector in one sweep.
+     * 
+     * The scan is split into sectorCount sectors of equal width. Sector k is centred on
+     * the angle of beam k * getRangeNumber() / sectorCount, so with the default beam layout
+     * sector 0 is straight ahead and the sectors follow counter-clockwise (front, front-left,
+     * left, ...). Invalid readings (zero, negative, infinite or NaN) are ignored. The
+     * min/argmin kernel uses SSE2 where available.
+     * 
+     * @param sectorCount Number of sectors.
+     * @param minima Output array of sectorCount minimum ranges; infinity for sectors without a valid reading.
+     * @param indices Optional output array of sectorCount beam indices of the minima, -1 when none is valid.
+     */
+    void getSectorMin(int sectorCount, float* minima, int* indices = nullptr) const;
+
     /**
      * @brief Overloaded subscript operator to get the Lidar sensor reading at the specified index.
      * 
@@ -98,4 +200,58 @@ public:
      * @return double The angle in degrees corresponding to the specified index.
      */
     double getAngle(int i) const;
-};
\ No newline at end of file
+
+    /**
+     * @brief Gets a zero-copy view of the latest scan.
+     * 
+     * @return ScanView View of getRangeNumber() ranges, valid until the next update().
+     */
+    ScanView getScan() const;
+
+    /**
+     * @brief Sets the ring every new scan is published to.
+     * 
+     * Consumers on other threads should read scans from the ring rather than from the
+     * sensor, which is only safe to read from the thread calling update().
+     * 
+     * @param ring The ring, or nullptr to stop publishing. The ring must outlive the sensor.
+     */
+    void setScanRing(ScanRing* ring);
+
+    /**
+     * @brief Gets the number of ranges in a scan.
+     * 
+     * @return int The number of ranges.
+     */
+    int getRangeNumber() const;
+
+    /**
+     * @brief Gets the cosine of every beam angle.
+     * 
+     * @return const float* Table of getRangeNumber() values.
+     */
+    const float* getDirectionX() const;
+
+    /**
+     * @brief Gets the sine of every beam angle.
+     * 
+     * @return const float* Table of getRangeNumber() values.
+     */
+    const float* getDirectionY() const;
+
+    /**
+     * @brief Converts the current scan to Cartesian points in the sensor frame.
+     * 
+     * Each point is the range multiplied by the precomputed beam direction, so the loop is
+     * a plain multiply over contiguous arrays that the compiler can vectorize.
+     * 
+     * @param xs Output array of getRangeNumber() x-coordinates.
+     * @param ys Output array of getRangeNumber() y-coordinates.
+     */
+    void toCartesian(float* xs, float* ys) const;
+};
+
+/**
+ * @brief Lidar sensor bound to the backend selected at compile time.
+ */
+typedef BasicLidarSensor<RobotApi> LidarSensor;
@@ -4,18 +4,126 @@
  */
 
 #include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <limits>
 #include "LidarSensor.h"
-#include "FestoRobotAPI.h"
+
+/**
+ * @brief Scalar reference for LidarSensor::getSectorMin.
+ *
+ * @param scan The scan to search.
+ * @param sectorCount Number of sectors.
+ * @param minima Output array of sectorCount minimum ranges.
+ */
+void scalarSectorMin(const ScanView& scan, int sectorCount, float* minima) {
+    int n = scan.size();
+    for (int k = 0; k < sectorCount; ++k) {
+        minima[k] = std::numeric_limits<float>::infinity();
+    }
+    for (int i = 0; i < n; ++i) {
+        // Sector of beam i when sectors are centred on beam k * n / sectorCount.
+        int sector = static_cast<int>(((2LL * i * sectorCount + n) / (2LL * n)) % sectorCount);
+        float r = scan[i];
+        if (r > 0.0f && std::isfinite(r) && r < minima[sector]) {
+            minima[sector] = r;
+        }
+    }
+}
+
+/**
+ * @class SingleBeamBackend
+ * @brief Test stub whose Lidar scans hold one valid beam, all others reading infinity.
+ */
+class SingleBeamBackend : public RobotBackend {
+private:
+    int beams; ///< Number of Lidar beams
+    int lit; ///< Beam that reads 1 m
+
+public:
+    SingleBeamBackend(int beamCount) : beams(beamCount), lit(0) {}
+
+    void setLitBeam(int beam) { lit = beam; }
+
+    void connect() {}
+    void disconnect() {}
+    void move(DIRECTION) {}
+    void rotate(DIRECTION) {}
+    void stop() {}
+    double getIRRange(int) { return 0.0; }
+    void getXYTh(double& X, double& Y, double& TH) { X = Y = TH = 0.0; }
+    int getLidarRangeNumber() { return beams; }
+    void getLidarRange(float* ranges) {
+        for (int i = 0; i < beams; ++i) {
+            ranges[i] = i == lit ? 1.0f : std::numeric_limits<float>::infinity();
+        }
+    }
+};
+
+/**
+ * @brief Scalar reference for the sector of a beam in LidarSensor::getSectorMin.
+ *
+ * @param beam Beam index.
+ * @param beams Number of beams.
+ * @param sectorCount Number of sectors.
+ * @return int The sector whose centre, beam k * beams / sectorCount, is nearest.
+ */
+int referenceSector(int beam, int beams, int sectorCount) {
+    return static_cast<int>(((2LL * beam * sectorCount + beams) / (2LL * beams)) % sectorCount);
+}
+
+/**
+ * @brief Benchmarks the sector query against the scalar reference.
+ *
+ * @param api The API to read scans from.
+ * @param beams Number of beams per scan.
+ */
+void benchmarkSectors(RobotApi* api, int beams) {
+    using Clock = std::chrono::steady_clock;
+    LidarSensor sensor(api, beams);
+    sensor.update();
+    const int sectors = 16;
+    const int runs = 20000;
+    float fast[sectors], slow[sectors];
+    int idx[sectors];
+
+    Clock::time_point t0 = Clock::now();
+    for (int r = 0; r < runs; ++r) {
+        scalarSectorMin(sensor.getScan(), sectors, slow);
+    }
+    Clock::time_point t1 = Clock::now();
+    for (int r = 0; r < runs; ++r) {
+        sensor.getSectorMin(sectors, fast, idx);
+    }
+    Clock::time_point t2 = Clock::now();
+    bool same = true;
+    for (int k = 0; k < sectors; ++k) {
+        same = same && (fast[k] == slow[k]);
+    }
+    std::cout << "[Bench] " << beams << " beams, " << sectors << " sectors: scalar "
+              << std::chrono::duration<double, std::micro>(t1 - t0).count() / runs << " us, getSectorMin "
+              << std::chrono::duration<double, std::micro>(t2 - t1).count() / runs << " us, results match: "
+              << same << "\n";
+}
 
 /**
  * @brief Main function to test the LidarSensor class.
  * 
- * This function performs various tests on the LidarSensor class:
- * - Tests the constructor with a FestoRobotAPI object and update method.
+ * This function performs various tests on the LidarSensor class, on the default
+ * backend of createRobotApi() (the simulator outside Windows):
+ * - Tests the constructor with the backend object and update method.
  * - Retrieves and prints Lidar sensor readings.
  * - Tests edge cases for invalid index access.
  * - Retrieves and prints the minimum and maximum Lidar sensor readings and their indices.
  * - Demonstrates the getAngle method.
+ * - Reads the latest scan through the zero-copy ScanView and sizes a sensor from the API.
+ * - Queries the minimum range of eight sectors and benchmarks sector queries at 360 and 1080 beams.
+ * - Checks that every beam falls in exactly one sector of getSectorMin, the one of the
+ *   scalar reference, for beam and sector counts that do not divide evenly.
+ * - Converts the scan to Cartesian points and benchmarks the table-based conversion
+ *   against calling cos/sin for every beam.
+ * - Reads a scan after the API switched to more beams than the sensor was built for.
  * 
  * @return int Returns 0 upon successful completion.
  */
@@ -23,7 +131,8 @@ int main() {
     std::cout << "----- LidarSensor Test Start -----\n";
 
     // 1. Create instance with API
-    FestoRobotAPI* testApi = new FestoRobotAPI();
+    RobotApi* testApi = createRobotApi();
+    testApi->connect();
     LidarSensor lidar(testApi, 360); // Assuming 360 ranges for a full circle
     std::cout << "[Test] LidarSensor constructed with API.\n";
 
@@ -56,6 +165,96 @@ int main() {
         std::cout << " Angle for i=" << i << ": " << lidar.getAngle(i) << " deg\n";
     }
 
+    // 6. Zero-copy scan view and API-sized sensor
+    ScanView scan = lidar.getScan();
+    float sum = 0.0f;
+    for (float r : scan) {
+        sum += r;
+    }
+    std::cout << "[Test] ScanView size: " << scan.size() << ", sum of ranges: " << sum << "\n";
+    LidarSensor autoSized(testApi);
+    std::cout << "[Test] Sensor sized from API: " << autoSized.getRangeNumber()
+              << " ranges (API reports " << testApi->getLidarRangeNumber() << ")\n";
+
+    // 7. Sector minima
+    const char* sectorNames[8] = { "front", "front-left", "left", "rear-left", "rear", "rear-right", "right", "front-right" };
+    float sectorMin[8];
+    int sectorIdx[8];
+    lidar.getSectorMin(8, sectorMin, sectorIdx);
+    for (int k = 0; k < 8; ++k) {
+        std::cout << " Sector " << sectorNames[k] << ": " << sectorMin[k] << " at index " << sectorIdx[k] << "\n";
+    }
+    benchmarkSectors(testApi, 360);
+    benchmarkSectors(testApi, 1080);
+
+    // 8. Every beam belongs to exactly one sector
+    const int beamCounts[4] = { 100, 360, 1080, 7 };
+    int uncovered = 0, misplaced = 0, checked = 0;
+    for (int b = 0; b < 4; ++b) {
+        SingleBeamBackend single(beamCounts[b]);
+        BasicLidarSensor<RobotBackend> singleLidar(&single);
+        for (int sectors = 1; sectors <= 32; ++sectors) {
+            std::vector<float> minima(sectors), reference(sectors);
+            std::vector<int> indices(sectors);
+            for (int beam = 0; beam < beamCounts[b]; ++beam) {
+                single.setLitBeam(beam);
+                singleLidar.update();
+                singleLidar.getSectorMin(sectors, minima.data(), indices.data());
+                scalarSectorMin(singleLidar.getScan(), sectors, reference.data());
+                int found = 0;
+                for (int k = 0; k < sectors; ++k) {
+                    if (indices[k] == beam) {
+                        ++found;
+                    }
+                    if (minima[k] != reference[k]) {
+                        ++misplaced;
+                    }
+                }
+                if (found != 1) {
+                    ++uncovered;
+                }
+                ++checked;
+            }
+        }
+    }
+    std::cout << "[Test] Sector coverage over " << checked << " beam layouts: not in exactly one sector => "
+              << uncovered << ", sectors differing from the reference => " << misplaced << "\n";
+
+    // 9. Cartesian conversion with the beam tables vs per-beam libm calls
+    using Clock = std::chrono::steady_clock;
+    const int scans = 10000;
+    const int beams = lidar.getRangeNumber();
+    std::vector<float> xs(beams), ys(beams);
+    lidar.toCartesian(xs.data(), ys.data());
+    std::cout << "[Test] Beam 90 => (" << xs[90] << ", " << ys[90] << ")\n";
+
+    Clock::time_point t0 = Clock::now();
+    for (int s = 0; s < scans; ++s) {
+        for (int i = 0; i < beams; ++i) {
+            double rad = lidar.getAngle(i) * 3.14159265358979323846 / 180.0;
+            xs[i] = static_cast<float>(lidar[i] * std::cos(rad));
+            ys[i] = static_cast<float>(lidar[i] * std::sin(rad));
+        }
+    }
+    Clock::time_point t1 = Clock::now();
+    for (int s = 0; s < scans; ++s) {
+        lidar.toCartesian(xs.data(), ys.data());
+    }
+    Clock::time_point t2 = Clock::now();
+    std::cout << "[Bench] " << beams << "-beam scan to Cartesian: libm "
+              << std::chrono::duration<double, std::micro>(t1 - t0).count() / scans << " us, tables "
+              << std::chrono::duration<double, std::micro>(t2 - t1).count() / scans << " us\n";
+
+    // 10. The API reports more beams after construction
+    SimulatedRobotAPI sim;
+    sim.setLidarRangeNumber(4);
+    BasicLidarSensor<SimulatedRobotAPI> resized(&sim);
+    sim.setLidarRangeNumber(1080);
+    resized.update();
+    std::cout << "[Test] Update after the API grew from 4 to 1080 beams: ranges " << resized.getRangeNumber()
+              << " (4), first range " << resized.getRange(0) << "\n";
+
+    testApi->disconnect();
     delete testApi;
     std::cout << "----- LidarSensor Test Complete -----\n";
     return 0;
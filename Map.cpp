@@ -1,71 +1,457 @@
 #include "Map.h"
+#include "Record.h"
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
 
+namespace {
 
-Map::Map(int sizeX, int sizeY) : dimX(sizeX), dimY(sizeY)
+const char MAP_MAGIC[4] = { 'G', 'M', 'A', 'P' };
+const std::uint32_t MAP_VERSION = 1;
+
+/**
+ * @brief Code stored in a map file for each supported cell type.
+ */
+template <typename Cell> struct CellTypeCode;
+template <> struct CellTypeCode<std::int8_t> { static const std::uint32_t value = 1; };
+template <> struct CellTypeCode<std::uint8_t> { static const std::uint32_t value = 2; };
+template <> struct CellTypeCode<std::int16_t> { static const std::uint32_t value = 3; };
+template <> struct CellTypeCode<int> { static const std::uint32_t value = 4; };
+template <> struct CellTypeCode<float> { static const std::uint32_t value = 5; };
+
+/**
+ * @brief Computes the padded layout of a grid, checking that it can be indexed.
+ *
+ * Rows are padded to a whole number of cache lines. Cells are addressed as
+ * y * stride + x in an int, so the padded grid must hold at most INT_MAX cells;
+ * that also keeps its size in bytes within size_t.
+ *
+ * @param sizeX Number of columns; negative counts as 0.
+ * @param sizeY Number of rows; negative counts as 0.
+ * @param cellsPerLine Cells in one cache line.
+ * @param cellSize Size of one cell in bytes.
+ * @param rowStride Receives the padded row stride in cells.
+ * @param bytes Receives the size of the buffer in bytes.
+ * @return bool True if the layout fits, false if the padded size overflows.
+ */
+bool paddedLayout(int sizeX, int sizeY, int cellsPerLine, size_t cellSize, int& rowStride, size_t& bytes) {
+    long long columns = std::max(sizeX, 0);
+    long long rows = std::max(sizeY, 0);
+    long long padded = (columns + cellsPerLine - 1) / cellsPerLine * cellsPerLine;
+    if (padded > INT_MAX || (rows > 0 && padded > INT_MAX / rows)) {
+        return false;
+    }
+    rowStride = static_cast<int>(padded);
+    bytes = static_cast<size_t>(padded * rows) * cellSize;
+    return true;
+}
+
+} // namespace
+
+
+std::uint64_t newMapVersionBase() {
+    static std::atomic<std::uint64_t> maps(0);
+    return (maps.fetch_add(1) + 1) << 32;
+}
+
+
+template <typename Cell>
+Cell* BasicMap<Cell>::allocate(int sizeX, int sizeY, int& rowStride)
+{
+    size_t bytes = 0;
+    if (!paddedLayout(sizeX, sizeY, CACHE_LINE_SIZE / static_cast<int>(sizeof(Cell)), sizeof(Cell), rowStride, bytes)) {
+        throw std::bad_alloc();
+    }
+    if (bytes == 0) {
+        return nullptr;
+    }
+    void* buffer = nullptr;
+#if defined(_MSC_VER)
+    buffer = _aligned_malloc(bytes, CACHE_LINE_SIZE);
+#else
+    if (posix_memalign(&buffer, CACHE_LINE_SIZE, bytes) != 0) {
+        buffer = nullptr;
+    }
+#endif
+    if (!buffer) {
+        throw std::bad_alloc();
+    }
+    std::memset(buffer, 0, bytes);
+    return static_cast<Cell*>(buffer);
+}
+
+template <typename Cell>
+void BasicMap<Cell>::release(Cell* buffer)
+{
+#if defined(_MSC_VER)
+    _aligned_free(buffer);
+#else
+    std::free(buffer);
+#endif
+}
+
+template <typename Cell>
+BasicMap<Cell>::BasicMap(int sizeX, int sizeY)
+    : cells(nullptr), dimX(sizeX), dimY(sizeY), stride(0), tilesX(0), tilesY(0), version(newMapVersionBase()),
+      versionSeen(false)
+{
+    cells = allocate(dimX, dimY, stride);
+    resetDirty();
+}
+
+template <typename Cell>
+BasicMap<Cell>::BasicMap(const BasicMap& other)
+    : cells(nullptr), dimX(other.dimX), dimY(other.dimY), stride(0), tilesX(other.tilesX), tilesY(other.tilesY),
+      dirtyBits(other.dirtyBits), version(newMapVersionBase()), versionSeen(false)
 {
-    grid.resize(dimY, std::vector<int>(dimX, 0));
+    cells = allocate(dimX, dimY, stride);
+    if (cells) {
+        std::memcpy(cells, other.cells, static_cast<size_t>(stride) * dimY * sizeof(Cell));
+    }
 }
 
-void Map::clearMap() {
-    for (auto& row : grid) {
-        std::fill(row.begin(), row.end(), 0);
+template <typename Cell>
+BasicMap<Cell>& BasicMap<Cell>::operator=(const BasicMap& other) {
+    if (this != &other) {
+        BasicMap copy(other);
+        std::swap(cells, copy.cells);
+        std::swap(dimX, copy.dimX);
+        std::swap(dimY, copy.dimY);
+        std::swap(stride, copy.stride);
+        std::swap(tilesX, copy.tilesX);
+        std::swap(tilesY, copy.tilesY);
+        dirtyBits.swap(copy.dirtyBits);
+        std::swap(version, copy.version);
+        std::swap(versionSeen, copy.versionSeen);
     }
+    return *this;
 }
 
-void Map::insertPoint(const Point& point) {
+template <typename Cell>
+BasicMap<Cell>::~BasicMap() {
+    release(cells);
+}
+
+template <typename Cell>
+void BasicMap<Cell>::clearMap() {
+    if (cells) {
+        // All supported cell types represent 0 as all-zero bits.
+        std::memset(cells, 0, static_cast<size_t>(stride) * dimY * sizeof(Cell));
+    }
+    markAllDirty();
+}
+
+template <typename Cell>
+inline void BasicMap<Cell>::touch(int x, int y) {
+    int tile = (y >> DIRTY_TILE_SHIFT) * tilesX + (x >> DIRTY_TILE_SHIFT);
+    std::uint64_t bit = 1ULL << (tile & 63);
+    std::uint64_t& word = dirtyBits[tile >> 6];
+    // Repeated writes to a dirty tile with an unread version only load the bitmap word.
+    if (!(word & bit)) {
+        word |= bit;
+    }
+    if (versionSeen) {
+        ++version;
+        versionSeen = false;
+    }
+}
+
+template <typename Cell>
+void BasicMap<Cell>::insertPoint(const Point& point) {
     if (point.getX() >= 0 && point.getX() < dimX &&
         point.getY() >= 0 && point.getY() < dimY)
     {
-        grid[static_cast<int>(point.getY())][static_cast<int>(point.getX())] = 1;
+        cells[static_cast<int>(point.getY()) * stride + static_cast<int>(point.getX())] = static_cast<Cell>(1);
+        touch(static_cast<int>(point.getX()), static_cast<int>(point.getY()));
     }
 }
 
-int Map::getGrid(int x, int y) const {
+template <typename Cell>
+int BasicMap<Cell>::getGrid(int x, int y) const {
     if (x >= 0 && x < dimX && y >= 0 && y < dimY) {
-        return grid[y][x];
+        return static_cast<int>(cells[y * stride + x]);
     }
     return -1;
 }
 
-void Map::setGrid(int x, int y, int value) {
+template <typename Cell>
+void BasicMap<Cell>::setGrid(int x, int y, int value) {
     if (x >= 0 && x < dimX && y >= 0 && y < dimY) {
-        grid[y][x] = value;
+        cells[y * stride + x] = static_cast<Cell>(value);
+        touch(x, y);
     }
 }
 
-int Map::getNumberX() const {
+template <typename Cell>
+int BasicMap<Cell>::getNumberX() const {
     return dimX;
 }
 
-int Map::getNumberY() const {
+template <typename Cell>
+int BasicMap<Cell>::getNumberY() const {
     return dimY;
 }
 
-void Map::addGridSize(int deltaX, int deltaY) {
-    dimX += deltaX;
-    dimY += deltaY;
-    grid.resize(dimY, std::vector<int>(dimX, 0));
-    for (auto& row : grid) {
-        row.resize(dimX, 0);
-    }
+template <typename Cell>
+int BasicMap<Cell>::getStride() const {
+    return stride;
+}
+
+template <typename Cell>
+MapRowView<Cell> BasicMap<Cell>::row(int y) {
+    return MapRowView<Cell>(cells + static_cast<size_t>(y) * stride, dimX);
 }
 
-void Map::setGridSize(int sizeX, int sizeY) {
+template <typename Cell>
+MapRowView<const Cell> BasicMap<Cell>::row(int y) const {
+    return MapRowView<const Cell>(cells + static_cast<size_t>(y) * stride, dimX);
+}
+
+template <typename Cell>
+Cell* BasicMap<Cell>::data() {
+    return cells;
+}
+
+template <typename Cell>
+const Cell* BasicMap<Cell>::data() const {
+    return cells;
+}
+
+template <typename Cell>
+void BasicMap<Cell>::addGridSize(int deltaX, int deltaY) {
+    setGridSize(dimX + deltaX, dimY + deltaY);
+}
+
+template <typename Cell>
+void BasicMap<Cell>::setGridSize(int sizeX, int sizeY) {
+    int newStride = 0;
+    Cell* resized = allocate(sizeX, sizeY, newStride);
+    int copyX = std::min(dimX, sizeX);
+    int copyY = std::min(dimY, sizeY);
+    if (copyX > 0) {
+        for (int y = 0; y < copyY; ++y) {
+            std::memcpy(resized + static_cast<size_t>(y) * newStride,
+                        cells + static_cast<size_t>(y) * stride,
+                        copyX * sizeof(Cell));
+        }
+    }
+    release(cells);
+    cells = resized;
+    stride = newStride;
     dimX = sizeX;
     dimY = sizeY;
-    grid.resize(dimY, std::vector<int>(dimX, 0));
+    resetDirty();
+}
+
+template <typename Cell>
+std::uint32_t BasicMap<Cell>::getCellTypeCode() {
+    return CellTypeCode<Cell>::value;
 }
 
-void Map::printInfo() const {
+template <typename Cell>
+void BasicMap<Cell>::resetDirty() {
+    tilesX = (std::max(dimX, 0) + DIRTY_TILE_SIZE - 1) >> DIRTY_TILE_SHIFT;
+    tilesY = (std::max(dimY, 0) + DIRTY_TILE_SIZE - 1) >> DIRTY_TILE_SHIFT;
+    dirtyBits.assign((static_cast<size_t>(tilesX) * tilesY + 63) / 64, 0);
+    markAllDirty();
+}
+
+template <typename Cell>
+void BasicMap<Cell>::markDirty(int x, int y) {
+    if (x >= 0 && x < dimX && y >= 0 && y < dimY) {
+        touch(x, y);
+    }
+}
+
+template <typename Cell>
+void BasicMap<Cell>::markDirtyRect(int minX, int minY, int maxX, int maxY) {
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, dimX - 1);
+    maxY = std::min(maxY, dimY - 1);
+    ++version;
+    versionSeen = false;
+    for (int ty = minY >> DIRTY_TILE_SHIFT; minX <= maxX && ty <= maxY >> DIRTY_TILE_SHIFT; ++ty) {
+        for (int tx = minX >> DIRTY_TILE_SHIFT; tx <= maxX >> DIRTY_TILE_SHIFT; ++tx) {
+            int tile = ty * tilesX + tx;
+            dirtyBits[tile >> 6] |= 1ULL << (tile & 63);
+        }
+    }
+}
+
+template <typename Cell>
+void BasicMap<Cell>::markAllDirty() {
+    size_t tiles = static_cast<size_t>(tilesX) * tilesY;
+    ++version;
+    versionSeen = false;
+    std::fill(dirtyBits.begin(), dirtyBits.end(), ~0ULL);
+    if (tiles % 64) {
+        // Bits past the last tile stay clear so getDirtyTiles() never reports them.
+        dirtyBits.back() = (1ULL << (tiles % 64)) - 1;
+    }
+}
+
+template <typename Cell>
+void BasicMap<Cell>::clearDirty() {
+    std::fill(dirtyBits.begin(), dirtyBits.end(), 0);
+}
+
+template <typename Cell>
+bool BasicMap<Cell>::isTileDirty(int tileX, int tileY) const {
+    if (tileX < 0 || tileX >= tilesX || tileY < 0 || tileY >= tilesY) {
+        return false;
+    }
+    int tile = tileY * tilesX + tileX;
+    return (dirtyBits[tile >> 6] >> (tile & 63)) & 1;
+}
+
+template <typename Cell>
+int BasicMap<Cell>::getDirtyTiles(std::vector<int>& tiles) const {
+    tiles.clear();
+    for (size_t w = 0; w < dirtyBits.size(); ++w) {
+        std::uint64_t word = dirtyBits[w];
+        while (word) {
+            int bit = 0;
+            while (!((word >> bit) & 1)) {
+                ++bit;
+            }
+            tiles.push_back(static_cast<int>(w * 64) + bit);
+            word &= word - 1;
+        }
+    }
+    return static_cast<int>(tiles.size());
+}
+
+template <typename Cell>
+std::uint64_t BasicMap<Cell>::getVersion() const {
+    versionSeen = true;
+    return version;
+}
+
+template <typename Cell>
+int BasicMap<Cell>::getTileCountX() const {
+    return tilesX;
+}
+
+template <typename Cell>
+int BasicMap<Cell>::getTileCountY() const {
+    return tilesY;
+}
+
+template <typename Cell>
+bool BasicMap<Cell>::saveFile(const std::string& filename, const MapFileInfo& info) const {
+    MapFileHeader header;
+    std::memcpy(header.magic, MAP_MAGIC, sizeof(header.magic));
+    header.version = MAP_VERSION;
+    header.cellType = getCellTypeCode();
+    header.cellSize = sizeof(Cell);
+    header.sizeX = dimX;
+    header.sizeY = dimY;
+    header.stride = stride;
+    header.reserved = 0;
+    header.resolution = info.resolution;
+    header.originX = info.originX;
+    header.originY = info.originY;
+    header.dataSize = static_cast<std::uint64_t>(stride) * std::max(dimY, 0) * sizeof(Cell);
+
+    Record file;
+    if (!file.openFile(filename, std::ios::out | std::ios::binary | std::ios::trunc)) {
+        return false;
+    }
+    bool ok = file.writeBytes(&header, sizeof(header)) &&
+              (header.dataSize == 0 || file.writeBytes(cells, static_cast<size_t>(header.dataSize))) && file.flush();
+    file.closeFile();
+    return ok;
+}
+
+template <typename Cell>
+bool BasicMap<Cell>::loadFile(const std::string& filename, MapFileInfo* info) {
+    Record file;
+    if (!file.mapFile(filename)) {
+        return false;
+    }
+    const char* bytes = file.getMappedData();
+    const size_t size = file.getMappedSize();
+    const MapFileHeader* header = reinterpret_cast<const MapFileHeader*>(bytes);
+    if (size < sizeof(MapFileHeader) || std::memcmp(header->magic, MAP_MAGIC, sizeof(MAP_MAGIC)) != 0 ||
+        header->version != MAP_VERSION || header->cellType != getCellTypeCode() ||
+        header->cellSize != sizeof(Cell) || header->sizeX <= 0 || header->sizeY <= 0 || header->stride < header->sizeX ||
+        header->dataSize != static_cast<std::uint64_t>(header->stride) * header->sizeY * sizeof(Cell) ||
+        header->dataSize > size - sizeof(MapFileHeader)) {
+        return false;
+    }
+    int newStride = 0;
+    size_t newBytes = 0;
+    if (!paddedLayout(header->sizeX, header->sizeY, CACHE_LINE_SIZE / static_cast<int>(sizeof(Cell)), sizeof(Cell),
+                      newStride, newBytes)) {
+        return false;
+    }
+
+    Cell* loaded = allocate(header->sizeX, header->sizeY, newStride);
+    const Cell* source = reinterpret_cast<const Cell*>(bytes + sizeof(MapFileHeader));
+    if (newStride == header->stride) {
+        std::memcpy(loaded, source, static_cast<size_t>(header->dataSize));
+    } else {
+        for (int y = 0; y < header->sizeY; ++y) {
+            std::memcpy(loaded + static_cast<size_t>(y) * newStride, source + static_cast<size_t>(y) * header->stride,
+                        header->sizeX * sizeof(Cell));
+        }
+    }
+    release(cells);
+    cells = loaded;
+    stride = newStride;
+    dimX = header->sizeX;
+    dimY = header->sizeY;
+    resetDirty();
+    if (info) {
+        *info = MapFileInfo(header->resolution, header->originX, header->originY);
+    }
+    return true;
+}
+
+template <typename Cell>
+bool BasicMap<Cell>::savePGM(const std::string& filename) const {
+    Record file;
+    if (!file.openFile(filename, std::ios::out | std::ios::binary | std::ios::trunc)) {
+        return false;
+    }
+    std::string header = "P5\n" + std::to_string(std::max(dimX, 0)) + " " + std::to_string(std::max(dimY, 0)) + "\n255\n";
+    std::vector<unsigned char> pixels(static_cast<size_t>(std::max(dimX, 0)) * std::max(dimY, 0));
+    unsigned char* out = pixels.data();
+    for (int y = dimY - 1; y >= 0; --y) {
+        for (auto cell : row(y)) {
+            *out++ = cell == 0 ? 254 : (cell > 0 ? 0 : 205);
+        }
+    }
+    bool ok = file.writeBytes(header.data(), header.size()) &&
+              (pixels.empty() || file.writeBytes(pixels.data(), pixels.size())) && file.flush();
+    file.closeFile();
+    return ok;
+}
+
+template <typename Cell>
+void BasicMap<Cell>::printInfo() const {
     std::cout << "Grid dimensions: " << dimX << " x " << dimY << std::endl;
 }
 
-void Map::showMap() const {
-    for (const auto& row : grid) {
-        for (auto cell : row) {
+template <typename Cell>
+void BasicMap<Cell>::showMap() const {
+    for (int y = 0; y < dimY; ++y) {
+        for (auto cell : row(y)) {
             std::cout << (cell == 0 ? '.' : 'x') << " ";
         }
         std::cout << std::endl;
     }
 }
+
+template class BasicMap<std::int8_t>;
+template class BasicMap<std::uint8_t>;
+template class BasicMap<std::int16_t>;
+template class BasicMap<int>;
+template class BasicMap<float>;
@@ -8,30 +8,228 @@
 
 #include <vector>
 #include <iostream>
+#include <cstdint>
+#include <string>
 #include "Point.h"
 
 /**
- * @class Map
+ * @brief Gets the first version of a new map object.
+ *
+ * Every map object, whatever its class, starts its versions at a fresh multiple of
+ * 2^32 drawn from one counter, so two maps never report the same version.
+ *
+ * @return std::uint64_t The first version.
+ */
+std::uint64_t newMapVersionBase();
+
+/**
+ * @struct MapFileInfo
+ * @brief World placement of a map stored in a file.
+ */
+struct MapFileInfo {
+    double resolution; ///< Size of one grid cell in metres
+    double originX; ///< World x-coordinate of the corner of cell (0, 0) in metres
+    double originY; ///< World y-coordinate of the corner of cell (0, 0) in metres
+
+    /**
+     * @brief Constructs a placement.
+     *
+     * @param metersPerCell Size of one grid cell in metres.
+     * @param worldX World x-coordinate of the corner of cell (0, 0) in metres.
+     * @param worldY World y-coordinate of the corner of cell (0, 0) in metres.
+     */
+    MapFileInfo(double metersPerCell = 1.0, double worldX = 0.0, double worldY = 0.0)
+        : resolution(metersPerCell), originX(worldX), originY(worldY) {}
+};
+
+/**
+ * @struct MapFileHeader
+ * @brief Header of a binary map file, followed by the padded row-major cell buffer.
+ *
+ * The header is one cache line long, so the cells of a mapped file start on a
+ * cache-line boundary, as they do in memory.
+ */
+struct MapFileHeader {
+    char magic[4]; ///< "GMAP"
+    std::uint32_t version; ///< Format version
+    std::uint32_t cellType; ///< Cell type code, see BasicMap::saveFile()
+    std::uint32_t cellSize; ///< Size of one cell in bytes
+    std::int32_t sizeX; ///< Number of columns
+    std::int32_t sizeY; ///< Number of rows
+    std::int32_t stride; ///< Cells between the starts of two consecutive rows
+    std::uint32_t reserved; ///< Zero
+    double resolution; ///< Size of one grid cell in metres
+    double originX; ///< World x-coordinate of the corner of cell (0, 0) in metres
+    double originY; ///< World y-coordinate of the corner of cell (0, 0) in metres
+    std::uint64_t dataSize; ///< Size of the cell buffer in bytes
+};
+
+/**
+ * @class MapRowView
+ * @brief Non-owning view of one row of a map's cell buffer.
+ *
+ * Row views give direct pointer access to a row so tight loops can walk cells
+ * without the bounds checks of getGrid/setGrid.
+ */
+template <typename Cell>
+class MapRowView {
+private:
+    Cell* cells; ///< First cell of the row
+    int width; ///< Number of valid cells in the row
+
+public:
+    /**
+     * @brief Constructs a row view over the given cells.
+     *
+     * @param rowCells Pointer to the first cell of the row.
+     * @param rowWidth Number of valid cells in the row.
+     */
+    MapRowView(Cell* rowCells, int rowWidth) : cells(rowCells), width(rowWidth) {}
+
+    /**
+     * @brief Gets the number of cells in the row.
+     *
+     * @return int The number of cells.
+     */
+    int size() const { return width; }
+
+    /**
+     * @brief Gets a pointer to the first cell of the row.
+     *
+     * @return Cell* Pointer to the row data.
+     */
+    Cell* data() const { return cells; }
+
+    /**
+     * @brief Gets the cell at the specified column without bounds checking.
+     *
+     * @param x The column index.
+     * @return Cell& Reference to the cell.
+     */
+    Cell& operator[](int x) const { return cells[x]; }
+
+    /**
+     * @brief Gets an iterator to the first cell of the row.
+     *
+     * @return Cell* Pointer to the first cell.
+     */
+    Cell* begin() const { return cells; }
+
+    /**
+     * @brief Gets an iterator past the last cell of the row.
+     *
+     * @return Cell* Pointer past the last cell.
+     */
+    Cell* end() const { return cells + width; }
+};
+
+/**
+ * @class BasicMap
  * @brief Manages a 2D grid map.
- * 
- * This class provides methods to manipulate and query a 2D grid map.
+ *
+ * This class provides methods to manipulate and query a 2D grid map. The grid is
+ * stored in a single cache-aligned row-major buffer; each row is padded to a whole
+ * number of cache lines so that every row starts on a cache-line boundary.
+ * The cell type is configurable (int8_t, uint8_t, int16_t, int or float).
+ *
+ * The map records which square tiles of DIRTY_TILE_SIZE cells have changed since
+ * clearDirty(), one bit per tile, so persistence can write only what changed.
+ * setGrid() and insertPoint() mark tiles themselves; code that writes through row()
+ * or data() must call markDirty() or markDirtyRect(). A mark only stores to the
+ * bitmap when the tile was clean. Marks also change the map version, which lets
+ * planners cache data derived from the map; the version is advanced by the first
+ * mark after getVersion() returned it, not by every write.
  */
-class Map {
+template <typename Cell>
+class BasicMap {
 private:
-    std::vector<std::vector <int> > grid; ///< 2D grid representing the map
+    Cell* cells; ///< Cache-aligned row-major cell buffer
     int dimX; ///< Number of columns in the grid
     int dimY; ///< Number of rows in the grid
+    int stride; ///< Number of cells between the starts of two consecutive rows
+    int tilesX; ///< Number of dirty-tracking tile columns
+    int tilesY; ///< Number of dirty-tracking tile rows
+    std::vector<std::uint64_t> dirtyBits; ///< One bit per tile, set when a cell of the tile changes
+    std::uint64_t version; ///< Changes whenever a tile is marked dirty after it was read
+    mutable bool versionSeen; ///< Whether getVersion() returned version since it last changed
+
+    /**
+     * @brief Sizes the dirty bits for the current dimensions and marks every tile dirty.
+     */
+    void resetDirty();
+
+    /**
+     * @brief Marks the tile holding a cell inside the grid as changed.
+     *
+     * The write path of setGrid(), insertPoint() and markDirty().
+     *
+     * @param x The x-coordinate, inside the grid.
+     * @param y The y-coordinate, inside the grid.
+     */
+    void touch(int x, int y);
+
+    /**
+     * @brief Allocates a zeroed buffer for the given dimensions.
+     *
+     * @param sizeX Number of columns.
+     * @param sizeY Number of rows.
+     * @param rowStride Receives the padded row stride in cells.
+     * @return Cell* The allocated buffer, or nullptr for an empty grid.
+     * @throws std::bad_alloc If the padded grid holds more than INT_MAX cells or the
+     *         memory cannot be allocated.
+     */
+    static Cell* allocate(int sizeX, int sizeY, int& rowStride);
+
+    /**
+     * @brief Releases a buffer obtained from allocate().
+     *
+     * @param buffer The buffer to release.
+     */
+    static void release(Cell* buffer);
 
 public:
+    typedef Cell CellType; ///< Type stored in each grid cell
+
+    static const int CACHE_LINE_SIZE = 64; ///< Alignment of the buffer and of each row in bytes
+    static const int DIRTY_TILE_SHIFT = 6; ///< log2 of DIRTY_TILE_SIZE
+    static const int DIRTY_TILE_SIZE = 1 << DIRTY_TILE_SHIFT; ///< Side of a dirty-tracking tile in cells
+
+    /**
+     * @brief Gets the code stored in map files for this cell type.
+     *
+     * @return std::uint32_t 1 for int8_t, 2 for uint8_t, 3 for int16_t, 4 for int, 5 for float.
+     */
+    static std::uint32_t getCellTypeCode();
+
     /**
      * @brief Constructs a Map object with specified dimensions.
-     * 
+     *
      * Initializes the grid with the given dimensions, defaulting to 10x10.
-     * 
+     *
      * @param sizeX Number of columns in the grid.
      * @param sizeY Number of rows in the grid.
      */
-    Map(int sizeX = 10, int sizeY = 10);
+    BasicMap(int sizeX = 10, int sizeY = 10);
+
+    /**
+     * @brief Copy constructor. Duplicates the cell buffer.
+     *
+     * @param other The map to copy.
+     */
+    BasicMap(const BasicMap& other);
+
+    /**
+     * @brief Copy assignment operator. Duplicates the cell buffer.
+     *
+     * @param other The map to copy.
+     * @return BasicMap& This map.
+     */
+    BasicMap& operator=(const BasicMap& other);
+
+    /**
+     * @brief Destructor. Releases the cell buffer.
+     */
+    ~BasicMap();
 
     /**
      * @brief Clears the map by setting all grid values to 0.
@@ -40,25 +238,25 @@ public:
 
     /**
      * @brief Inserts a point into the map.
-     * 
+     *
      * Sets the grid value at the point's coordinates to 1.
-     * 
+     *
      * @param point The point to be inserted.
      */
     void insertPoint(const Point& point);
 
     /**
      * @brief Gets the value at the specified grid coordinates.
-     * 
+     *
      * @param x The x-coordinate.
      * @param y The y-coordinate.
-     * @return int The value at the specified coordinates.
+     * @return int The value at the specified coordinates, or -1 if out of bounds.
      */
     int getGrid(int x, int y) const;
 
     /**
      * @brief Sets the value at the specified grid coordinates.
-     * 
+     *
      * @param x The x-coordinate.
      * @param y The y-coordinate.
      * @param value The value to set at the specified coordinates.
@@ -67,23 +265,66 @@ public:
 
     /**
      * @brief Gets the number of columns in the grid.
-     * 
+     *
      * @return int The number of columns.
      */
     int getNumberX() const;
 
     /**
      * @brief Gets the number of rows in the grid.
-     * 
+     *
      * @return int The number of rows.
      */
     int getNumberY() const;
 
+    /**
+     * @brief Gets the row stride of the cell buffer.
+     *
+     * @return int The number of cells between the starts of two consecutive rows.
+     */
+    int getStride() const;
+
+    /**
+     * @brief Gets a view of the specified row.
+     *
+     * The row index is not bounds checked.
+     *
+     * @param y The row index.
+     * @return MapRowView<Cell> View of the row.
+     */
+    MapRowView<Cell> row(int y);
+
+    /**
+     * @brief Gets a read-only view of the specified row.
+     *
+     * The row index is not bounds checked.
+     *
+     * @param y The row index.
+     * @return MapRowView<const Cell> View of the row.
+     */
+    MapRowView<const Cell> row(int y) const;
+
+    /**
+     * @brief Gets the raw cell buffer.
+     *
+     * Cell (x, y) is located at data()[y * getStride() + x].
+     *
+     * @return Cell* Pointer to the first cell.
+     */
+    Cell* data();
+
+    /**
+     * @brief Gets the raw cell buffer.
+     *
+     * @return const Cell* Pointer to the first cell.
+     */
+    const Cell* data() const;
+
     /**
      * @brief Adds to the grid size.
-     * 
+     *
      * Increases the grid dimensions by the specified deltas.
-     * 
+     *
      * @param deltaX The number of columns to add.
      * @param deltaY The number of rows to add.
      */
@@ -91,14 +332,127 @@ public:
 
     /**
      * @brief Sets the grid size.
-     * 
-     * Resizes the grid to the specified dimensions.
-     * 
+     *
+     * Resizes the grid to the specified dimensions. Cells inside both the old and
+     * the new dimensions keep their values; new cells are set to 0. Every tile is
+     * marked as changed.
+     *
      * @param sizeX The new number of columns.
      * @param sizeY The new number of rows.
      */
     void setGridSize(int sizeX, int sizeY);
 
+    /**
+     * @brief Marks the tile holding a cell as changed.
+     *
+     * @param x The x-coordinate; cells outside the grid are ignored.
+     * @param y The y-coordinate.
+     */
+    void markDirty(int x, int y);
+
+    /**
+     * @brief Marks every tile overlapping a rectangle of cells as changed.
+     *
+     * @param minX First column of the rectangle; the rectangle is clipped to the grid.
+     * @param minY First row of the rectangle.
+     * @param maxX Last column of the rectangle, inclusive.
+     * @param maxY Last row of the rectangle, inclusive.
+     */
+    void markDirtyRect(int minX, int minY, int maxX, int maxY);
+
+    /**
+     * @brief Marks every tile as changed.
+     */
+    void markAllDirty();
+
+    /**
+     * @brief Marks every tile as unchanged.
+     */
+    void clearDirty();
+
+    /**
+     * @brief Checks whether a tile has changed since clearDirty().
+     *
+     * @param tileX The tile column.
+     * @param tileY The tile row.
+     * @return bool True if the tile changed; false also outside the grid.
+     */
+    bool isTileDirty(int tileX, int tileY) const;
+
+    /**
+     * @brief Lists the tiles that changed since clearDirty().
+     *
+     * Only the words of the dirty bitmap are scanned, one per 64 tiles.
+     *
+     * @param tiles Receives the index tileY * getTileCountX() + tileX of each changed tile.
+     * @return int The number of changed tiles.
+     */
+    int getDirtyTiles(std::vector<int>& tiles) const;
+
+    /**
+     * @brief Gets the version of the map contents.
+     *
+     * The version changes whenever a cell may have changed, and never repeats the
+     * version of another map object, so (map, version) identifies the contents.
+     * The call records that the version was read, so it must not run concurrently
+     * with other calls on the map.
+     *
+     * @return std::uint64_t The version.
+     */
+    std::uint64_t getVersion() const;
+
+    /**
+     * @brief Gets the number of dirty-tracking tile columns.
+     *
+     * @return int The number of tile columns.
+     */
+    int getTileCountX() const;
+
+    /**
+     * @brief Gets the number of dirty-tracking tile rows.
+     *
+     * @return int The number of tile rows.
+     */
+    int getTileCountY() const;
+
+    /**
+     * @brief Saves the map to a binary file.
+     *
+     * The file is a MapFileHeader followed by the cell buffer exactly as it is in
+     * memory, row padding included, so the buffer is written in a single write.
+     *
+     * @param filename The file to create; an existing file is truncated.
+     * @param info World placement stored in the header.
+     * @return bool True if the file was written.
+     */
+    bool saveFile(const std::string& filename, const MapFileInfo& info = MapFileInfo()) const;
+
+    /**
+     * @brief Loads a map saved by saveFile().
+     *
+     * The file is mapped into memory and its cell buffer copied in one block, or one
+     * block per row if the row padding differs, without parsing. The cell type of the
+     * file must match this map's; on failure the map is left unchanged. Files with an
+     * empty grid, or whose padded grid would hold more than INT_MAX cells, are rejected
+     * before anything is allocated. After a load every tile is marked as changed.
+     *
+     * @param filename The file to read.
+     * @param info Receives the world placement stored in the header, or nullptr.
+     * @return bool True if the map was loaded.
+     */
+    bool loadFile(const std::string& filename, MapFileInfo* info = nullptr);
+
+    /**
+     * @brief Exports the map as a binary PGM image for inspection.
+     *
+     * Cells equal to 0 are white, positive cells black and negative cells grey.
+     * The last row is written first, so the y axis points up in image viewers.
+     *
+     * @param filename The file to create; an existing file is truncated.
+     * @return bool True if the file was written.
+     */
+    bool savePGM(const std::string& filename) const;
+
     /**
      * @brief Prints information about the map.
      */
@@ -106,10 +460,12 @@ public:
 
     /**
      * @brief Displays the map.
-     * 
+     *
      * Outputs the grid to the console.
      */
     void showMap() const;
 };
 
-#endif // MAP_H
\ No newline at end of file
+typedef BasicMap<int> Map; ///< Default map type used by the Mapper
+
+#endif // MAP_H
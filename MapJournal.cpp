@@ -0,0 +1,293 @@
+#include "MapJournal.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const char JOURNAL_MAGIC[4] = { 'M', 'J', 'N', 'L' };
+const char SEGMENT_MAGIC[4] = { 'T', 'S', 'E', 'G' };
+const std::uint32_t JOURNAL_VERSION = 1;
+
+/**
+ * @brief Reads the tiles of one segment, or only checks them.
+ *
+ * @param payload The tile data after the segment header.
+ * @param segment The segment header.
+ * @param header The journal header.
+ * @param map Receives the tiles, or nullptr to only check them.
+ * @return bool True if every tile lies on the map and the tiles fill the payload exactly.
+ */
+template <typename Cell>
+bool readSegment(const char* payload, const MapJournalSegment& segment, const MapJournalHeader& header,
+                 BasicMap<Cell>* map) {
+    const int tileSize = header.tileSize;
+    const std::int64_t tilesX = (static_cast<std::int64_t>(header.sizeX) + tileSize - 1) / tileSize;
+    const std::int64_t tilesY = (static_cast<std::int64_t>(header.sizeY) + tileSize - 1) / tileSize;
+    const char* at = payload;
+    const char* end = payload + segment.payloadSize;
+    for (std::uint32_t t = 0; t < segment.tileCount; ++t) {
+        std::int32_t position[2];
+        if (end - at < static_cast<std::ptrdiff_t>(sizeof(position))) {
+            return false;
+        }
+        std::memcpy(position, at, sizeof(position));
+        at += sizeof(position);
+        if (position[0] < 0 || position[0] >= tilesX || position[1] < 0 || position[1] >= tilesY) {
+            return false;
+        }
+        int x0 = position[0] * tileSize;
+        int y0 = position[1] * tileSize;
+        int width = std::min(tileSize, header.sizeX - x0);
+        int height = std::min(tileSize, header.sizeY - y0);
+        if (end - at < static_cast<std::ptrdiff_t>(static_cast<size_t>(width) * height * sizeof(Cell))) {
+            return false;
+        }
+        if (!map) {
+            at += static_cast<size_t>(width) * height * sizeof(Cell);
+            continue;
+        }
+        for (int y = y0; y < y0 + height; ++y) {
+            std::memcpy(map->row(y).data() + x0, at, width * sizeof(Cell));
+            at += width * sizeof(Cell);
+        }
+    }
+    return at == end;
+}
+
+} // namespace
+
+
+template <typename Cell>
+BasicMapJournal<Cell>::BasicMapJournal()
+    : sizeX(0), sizeY(0), fileSize(0), snapshotSize(0), compactFactor(2.0), segmentCount(0), lastTileCount(0),
+      opened(false)
+{
+}
+
+template <typename Cell>
+BasicMapJournal<Cell>::~BasicMapJournal() {
+    close();
+}
+
+template <typename Cell>
+bool BasicMapJournal<Cell>::open(const std::string& filename, BasicMap<Cell>& map, const MapFileInfo& info) {
+    close();
+    fileName = filename;
+    placement = info;
+    return compact(map);
+}
+
+template <typename Cell>
+void BasicMapJournal<Cell>::buildSegment(const BasicMap<Cell>& map) {
+    const int tileSize = BasicMap<Cell>::DIRTY_TILE_SIZE;
+    const int tilesX = map.getTileCountX();
+    MapJournalSegment header;
+    std::memcpy(header.magic, SEGMENT_MAGIC, sizeof(header.magic));
+    header.tileCount = static_cast<std::uint32_t>(tiles.size());
+    header.payloadSize = 0;
+
+    segment.resize(sizeof(header));
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        std::int32_t position[2] = { tiles[i] % tilesX, tiles[i] / tilesX };
+        int x0 = position[0] * tileSize;
+        int y0 = position[1] * tileSize;
+        int width = std::min(tileSize, map.getNumberX() - x0);
+        int height = std::min(tileSize, map.getNumberY() - y0);
+        size_t at = segment.size();
+        segment.resize(at + sizeof(position) + static_cast<size_t>(width) * height * sizeof(Cell));
+        std::memcpy(&segment[at], position, sizeof(position));
+        at += sizeof(position);
+        for (int y = y0; y < y0 + height; ++y) {
+            std::memcpy(&segment[at], map.row(y).data() + x0, width * sizeof(Cell));
+            at += width * sizeof(Cell);
+        }
+    }
+    header.payloadSize = segment.size() - sizeof(header);
+    std::memcpy(segment.data(), &header, sizeof(header));
+}
+
+template <typename Cell>
+bool BasicMapJournal<Cell>::save(BasicMap<Cell>& map) {
+    if (!opened) {
+        return false;
+    }
+    if (map.getNumberX() != sizeX || map.getNumberY() != sizeY) {
+        return compact(map);
+    }
+    map.getDirtyTiles(tiles);
+    lastTileCount = static_cast<int>(tiles.size());
+    if (tiles.empty()) {
+        return true;
+    }
+    buildSegment(map);
+    if (fileSize + segment.size() > compactFactor * snapshotSize) {
+        return compact(map);
+    }
+    if (!file.writeBytes(segment.data(), segment.size()) || !file.flush()) {
+        // The stream stays failed and the journal may end in part of the segment;
+        // a fresh snapshot replaces both.
+        if (compact(map)) {
+            return true;
+        }
+        close();
+        return false;
+    }
+    fileSize += segment.size();
+    ++segmentCount;
+    map.clearDirty();
+    return true;
+}
+
+template <typename Cell>
+bool BasicMapJournal<Cell>::compact(BasicMap<Cell>& map) {
+    if (fileName.empty()) {
+        return false;
+    }
+    MapJournalHeader header;
+    std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    header.cellType = BasicMap<Cell>::getCellTypeCode();
+    header.cellSize = sizeof(Cell);
+    header.sizeX = map.getNumberX();
+    header.sizeY = map.getNumberY();
+    header.tileSize = BasicMap<Cell>::DIRTY_TILE_SIZE;
+    header.reserved = 0;
+    header.resolution = placement.resolution;
+    header.originX = placement.originX;
+    header.originY = placement.originY;
+    header.reserved2 = 0;
+
+    map.markAllDirty();
+    map.getDirtyTiles(tiles);
+    buildSegment(map);
+
+    // Write the snapshot beside the journal, then replace the journal in one rename.
+    std::string temporary = fileName + ".tmp";
+    Record snapshot;
+    if (!snapshot.openFile(temporary, std::ios::out | std::ios::binary | std::ios::trunc)) {
+        return false;
+    }
+    bool ok = snapshot.writeBytes(&header, sizeof(header)) && snapshot.writeBytes(segment.data(), segment.size()) &&
+              snapshot.sync();
+    snapshot.closeFile();
+    if (!ok) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    file.closeFile();
+    opened = false;
+#if defined(_WIN32)
+    std::remove(fileName.c_str());
+#endif
+    if (std::rename(temporary.c_str(), fileName.c_str()) != 0 ||
+        !file.openFile(fileName, std::ios::out | std::ios::binary | std::ios::app)) {
+        return false;
+    }
+    opened = true;
+    sizeX = header.sizeX;
+    sizeY = header.sizeY;
+    fileSize = sizeof(header) + segment.size();
+    snapshotSize = fileSize;
+    segmentCount = 1;
+    lastTileCount = static_cast<int>(tiles.size());
+    map.clearDirty();
+    return true;
+}
+
+template <typename Cell>
+void BasicMapJournal<Cell>::close() {
+    if (opened) {
+        file.closeFile();
+        opened = false;
+    }
+}
+
+template <typename Cell>
+bool BasicMapJournal<Cell>::isOpen() const {
+    return opened;
+}
+
+template <typename Cell>
+void BasicMapJournal<Cell>::setCompactFactor(double factor) {
+    compactFactor = std::max(factor, 1.0);
+}
+
+template <typename Cell>
+std::uint64_t BasicMapJournal<Cell>::getFileSize() const {
+    return fileSize;
+}
+
+template <typename Cell>
+int BasicMapJournal<Cell>::getSegmentCount() const {
+    return segmentCount;
+}
+
+template <typename Cell>
+int BasicMapJournal<Cell>::getLastTileCount() const {
+    return lastTileCount;
+}
+
+template <typename Cell>
+bool BasicMapJournal<Cell>::load(const std::string& filename, BasicMap<Cell>& map, MapFileInfo* info) {
+    Record in;
+    if (!in.mapFile(filename)) {
+        return false;
+    }
+    const char* bytes = in.getMappedData();
+    const size_t size = in.getMappedSize();
+    const MapJournalHeader* header = reinterpret_cast<const MapJournalHeader*>(bytes);
+    if (size < sizeof(MapJournalHeader) || std::memcmp(header->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+        header->version != JOURNAL_VERSION || header->cellType != BasicMap<Cell>::getCellTypeCode() ||
+        header->cellSize != sizeof(Cell) || header->sizeX < 0 || header->sizeY < 0 || header->tileSize <= 0) {
+        return false;
+    }
+    // The first segment holds every cell, so a map larger than the file is corrupt.
+    // Sides are counted as at least 1 so that an empty map cannot claim a huge side.
+    const std::uint64_t cells = static_cast<std::uint64_t>(std::max(header->sizeX, 1)) *
+                                static_cast<std::uint64_t>(std::max(header->sizeY, 1));
+    if (cells * sizeof(Cell) > size - sizeof(MapJournalHeader)) {
+        return false;
+    }
+
+    // Find the intact segments before touching the map. Segments are not padded, so
+    // their headers are copied out rather than read in place.
+    size_t pos = sizeof(MapJournalHeader);
+    size_t end = pos;
+    int segments = 0;
+    MapJournalSegment segment;
+    BasicMap<Cell>* const checkOnly = nullptr;
+    while (size - pos >= sizeof(MapJournalSegment)) {
+        std::memcpy(&segment, bytes + pos, sizeof(segment));
+        if (std::memcmp(segment.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0 ||
+            segment.payloadSize > size - pos - sizeof(MapJournalSegment) ||
+            !readSegment(bytes + pos + sizeof(MapJournalSegment), segment, *header, checkOnly)) {
+            break;
+        }
+        pos += sizeof(MapJournalSegment) + static_cast<size_t>(segment.payloadSize);
+        end = pos;
+        ++segments;
+    }
+    if (segments == 0) {
+        return false;
+    }
+
+    map.setGridSize(header->sizeX, header->sizeY);
+    map.clearMap();
+    for (pos = sizeof(MapJournalHeader); pos < end;) {
+        std::memcpy(&segment, bytes + pos, sizeof(segment));
+        readSegment(bytes + pos + sizeof(MapJournalSegment), segment, *header, &map);
+        pos += sizeof(MapJournalSegment) + static_cast<size_t>(segment.payloadSize);
+    }
+    map.clearDirty();
+    if (info) {
+        *info = MapFileInfo(header->resolution, header->originX, header->originY);
+    }
+    return true;
+}
+
+template class BasicMapJournal<std::int8_t>;
+template class BasicMapJournal<std::uint8_t>;
+template class BasicMapJournal<std::int16_t>;
+template class BasicMapJournal<int>;
+template class BasicMapJournal<float>;
@@ -0,0 +1,189 @@
+/**
+ * @file MapJournal.h
+ * @brief Declaration of the MapJournal class.
+ */
+
+#ifndef MAPJOURNAL_H
+#define MAPJOURNAL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Map.h"
+#include "Record.h"
+
+/**
+ * @struct MapJournalHeader
+ * @brief Header of a map journal file, followed by tile segments.
+ */
+struct MapJournalHeader {
+    char magic[4]; ///< "MJNL"
+    std::uint32_t version; ///< Format version
+    std::uint32_t cellType; ///< Cell type code, see BasicMap::getCellTypeCode()
+    std::uint32_t cellSize; ///< Size of one cell in bytes
+    std::int32_t sizeX; ///< Number of columns of the map
+    std::int32_t sizeY; ///< Number of rows of the map
+    std::int32_t tileSize; ///< Side of a tile in cells
+    std::uint32_t reserved; ///< Zero
+    double resolution; ///< Size of one grid cell in metres
+    double originX; ///< World x-coordinate of the corner of cell (0, 0) in metres
+    double originY; ///< World y-coordinate of the corner of cell (0, 0) in metres
+    std::uint64_t reserved2; ///< Zero
+};
+
+/**
+ * @struct MapJournalSegment
+ * @brief Header of one save: a group of tiles written together.
+ *
+ * Each tile is its column and row as two int32 values, then its cells row by row,
+ * clipped to the map edge.
+ */
+struct MapJournalSegment {
+    char magic[4]; ///< "TSEG"
+    std::uint32_t tileCount; ///< Number of tiles in the segment
+    std::uint64_t payloadSize; ///< Bytes of tile data after this header
+};
+
+/**
+ * @class BasicMapJournal
+ * @brief Saves a map incrementally as an append-only log of changed tiles.
+ *
+ * The journal starts with a segment holding every tile of the map. Each save()
+ * appends one segment with the tiles marked dirty in the map since the previous
+ * save, then clears the map's dirty marks, so a save costs work proportional to
+ * what changed rather than to the map size. When the log grows past a multiple of
+ * the size of a full snapshot, or the map is resized, the journal is compacted:
+ * a fresh journal holding one full segment is written beside it and renamed over
+ * it. Loading replays the segments in order; a segment cut short by a crash or
+ * otherwise damaged is ignored, together with every segment after it.
+ */
+template <typename Cell>
+class BasicMapJournal {
+private:
+    Record file; ///< Journal opened for appending
+    std::string fileName; ///< Name of the journal
+    MapFileInfo placement; ///< World placement stored in the header
+    int sizeX; ///< Number of columns of the journaled map
+    int sizeY; ///< Number of rows of the journaled map
+    std::uint64_t fileSize; ///< Bytes in the journal
+    std::uint64_t snapshotSize; ///< Bytes of the last full snapshot, header included
+    double compactFactor; ///< Compact once fileSize exceeds compactFactor * snapshotSize
+    int segmentCount; ///< Segments in the journal
+    int lastTileCount; ///< Tiles written by the last save
+    bool opened; ///< Whether the journal is open
+    std::vector<int> tiles; ///< Tiles of the segment being written
+    std::vector<char> segment; ///< Segment being written
+
+    /**
+     * @brief Builds a segment in segment from the map tiles listed in tiles.
+     *
+     * @param map The map.
+     */
+    void buildSegment(const BasicMap<Cell>& map);
+
+    BasicMapJournal(const BasicMapJournal&);
+    BasicMapJournal& operator=(const BasicMapJournal&);
+
+public:
+    /**
+     * @brief Constructs a closed journal.
+     */
+    BasicMapJournal();
+
+    /**
+     * @brief Destructor. Closes the journal.
+     */
+    ~BasicMapJournal();
+
+    /**
+     * @brief Starts a journal holding a full snapshot of a map.
+     *
+     * An existing file is replaced; call load() first to continue from it.
+     *
+     * @param filename The journal file.
+     * @param map The map; its dirty marks are cleared.
+     * @param info World placement stored in the header.
+     * @return bool True if the journal was written.
+     */
+    bool open(const std::string& filename, BasicMap<Cell>& map, const MapFileInfo& info = MapFileInfo());
+
+    /**
+     * @brief Appends the tiles changed since the last save.
+     *
+     * Compacts instead when the log has grown too large or the map was resized, or
+     * when the append fails. If that compaction fails too, the journal is closed and
+     * must be opened again; the file still loads as it was before this save.
+     *
+     * @param map The map given to open(); its dirty marks are cleared.
+     * @return bool True if the changes were written.
+     */
+    bool save(BasicMap<Cell>& map);
+
+    /**
+     * @brief Replaces the journal with a single full snapshot of a map.
+     *
+     * @param map The map given to open(); its dirty marks are cleared.
+     * @return bool True if the journal was rewritten.
+     */
+    bool compact(BasicMap<Cell>& map);
+
+    /**
+     * @brief Closes the journal.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether the journal is open.
+     *
+     * @return bool True if open.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Sets when save() compacts the journal.
+     *
+     * @param factor Compact once the journal is larger than this many full snapshots;
+     *               values below 1 are raised to 1.
+     */
+    void setCompactFactor(double factor);
+
+    /**
+     * @brief Gets the size of the journal.
+     *
+     * @return std::uint64_t The size in bytes.
+     */
+    std::uint64_t getFileSize() const;
+
+    /**
+     * @brief Gets the number of segments in the journal.
+     *
+     * @return int The number of segments, 1 right after open() or compact().
+     */
+    int getSegmentCount() const;
+
+    /**
+     * @brief Gets the number of tiles written by the last save.
+     *
+     * @return int The number of tiles.
+     */
+    int getLastTileCount() const;
+
+    /**
+     * @brief Loads a map from a journal by replaying its segments.
+     *
+     * The journal is mapped into memory and each tile is copied into place row by row.
+     * Every segment is checked before the map is touched, and the first damaged one
+     * ends the replay. The cell type must match, the header must fit the file and the
+     * full first segment must be intact; on failure the map is left unchanged.
+     *
+     * @param filename The journal file.
+     * @param map Receives the map; every tile is marked unchanged.
+     * @param info Receives the world placement, or nullptr.
+     * @return bool True if the map was loaded.
+     */
+    static bool load(const std::string& filename, BasicMap<Cell>& map, MapFileInfo* info = nullptr);
+};
+
+typedef BasicMapJournal<int> MapJournal; ///< Journal of the default map type
+
+#endif // MAPJOURNAL_H
@@ -0,0 +1,226 @@
+/**
+ * @file MapJournalTest.cpp
+ * @brief Test file for the MapJournal class.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include "MapJournal.h"
+#if defined(__linux__)
+#include <csignal>
+#include <sys/resource.h>
+#endif
+
+/**
+ * @brief Marks the endpoints of one simulated scan around a robot position.
+ *
+ * @param map The map.
+ * @param robotX Robot column.
+ * @param robotY Robot row.
+ * @param seed Pseudo-random state.
+ */
+void simulateScan(Map& map, int robotX, int robotY, std::uint32_t& seed) {
+    for (int beam = 0; beam < 360; ++beam) {
+        seed = seed * 1664525u + 1013904223u;
+        int dx = static_cast<int>((seed >> 8) % 201) - 100;
+        seed = seed * 1664525u + 1013904223u;
+        int dy = static_cast<int>((seed >> 8) % 201) - 100;
+        map.setGrid(robotX + dx, robotY + dy, 1);
+    }
+}
+
+/**
+ * @brief Main function to test the MapJournal class.
+ *
+ * This function performs various tests on the MapJournal class:
+ * - Journals a map, saves changed tiles and loads the result back.
+ * - Ignores a segment cut short, as after a crash during a save, or holding a damaged
+ *   tile; refuses a header larger than the file; reads unaligned segments of an int8 map.
+ * - Compacts the journal once it grows past its limit or the map is resized.
+ * - Recovers from a failed append by compacting, and closes the journal when that
+ *   fails too, leaving the file as it was before the save (Linux only).
+ * - Compares saving the whole map file every second with saving the journal on a
+ *   4000 x 4000 map where each second touches a few hundred cells.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- MapJournal Test Start -----\n";
+
+    // 1. Journal, save changes, load
+    Map map(300, 200);
+    map.setGrid(5, 5, 1);
+    MapJournal journal;
+    std::cout << "[Test] Open => " << journal.open("testMapJournal.bin", map, MapFileInfo(0.05, 1.0, 2.0))
+              << ", tiles => " << journal.getLastTileCount() << " (20), segments => " << journal.getSegmentCount() << "\n";
+    std::cout << "[Test] Save without changes => " << journal.save(map) << ", tiles => " << journal.getLastTileCount() << "\n";
+    map.setGrid(70, 10, 2);
+    map.setGrid(299, 199, 3);
+    journal.save(map);
+    std::cout << "[Test] Save after two cells => tiles " << journal.getLastTileCount() << ", segments "
+              << journal.getSegmentCount() << "\n";
+    map.setGrid(5, 5, 0);
+    journal.save(map);
+
+    Map restored;
+    MapFileInfo info;
+    std::cout << "[Test] Load => " << MapJournal::load("testMapJournal.bin", restored, &info) << ", size "
+              << restored.getNumberX() << " x " << restored.getNumberY() << ", cells " << restored.getGrid(5, 5) << " "
+              << restored.getGrid(70, 10) << " " << restored.getGrid(299, 199) << " (0 2 3), resolution "
+              << info.resolution << ", origin (" << info.originX << ", " << info.originY << ")\n";
+    std::vector<int> dirty;
+    std::cout << "[Test] Dirty tiles after load => " << restored.getDirtyTiles(dirty) << "\n";
+    BasicMap<float> wrongType;
+    std::cout << "[Test] Load into float map => " << BasicMapJournal<float>::load("testMapJournal.bin", wrongType) << "\n";
+
+    // 2. A save cut short is ignored
+    journal.close();
+    {
+        std::ifstream in("testMapJournal.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out("testMapJournalCut.bin", std::ios::binary);
+        out.write(bytes.data(), bytes.size() - 10);
+    }
+    MapJournal::load("testMapJournalCut.bin", restored);
+    std::cout << "[Test] Truncated journal => cell (5,5) " << restored.getGrid(5, 5) << " (1, last save lost), (70,10) "
+              << restored.getGrid(70, 10) << "\n";
+
+    // A damaged tile drops its whole segment, not just the tiles after it
+    Map damaged(300, 200);
+    MapJournal damagedJournal;
+    damagedJournal.open("testMapJournalBad.bin", damaged);
+    damaged.setGrid(70, 10, 2);
+    damaged.setGrid(299, 199, 3);
+    damagedJournal.save(damaged);
+    damagedJournal.close();
+    {
+        std::fstream io("testMapJournalBad.bin", std::ios::in | std::ios::out | std::ios::binary);
+        io.seekp(-static_cast<std::streamoff>(8 + 44 * 8 * sizeof(int)), std::ios::end); // position of tile (4, 3)
+        std::int32_t outside = 99;
+        io.write(reinterpret_cast<const char*>(&outside), sizeof(outside));
+    }
+    std::cout << "[Test] Damaged tile => load " << MapJournal::load("testMapJournalBad.bin", restored)
+              << ", cells " << restored.getGrid(70, 10) << " " << restored.getGrid(299, 199) << " (0 0)\n";
+
+    // A header claiming more cells than the file holds is refused
+    {
+        std::fstream io("testMapJournalBad.bin", std::ios::in | std::ios::out | std::ios::binary);
+        io.seekp(offsetof(MapJournalHeader, sizeX));
+        std::int32_t sides[2] = { 1 << 30, 1 << 30 };
+        io.write(reinterpret_cast<const char*>(sides), sizeof(sides));
+    }
+    std::cout << "[Test] Oversized header => load " << MapJournal::load("testMapJournalBad.bin", restored)
+              << ", map still " << restored.getNumberX() << " x " << restored.getNumberY() << "\n";
+
+    // Odd-sized tiles leave the next segment header unaligned
+    BasicMap<std::int8_t> bytes(65, 3);
+    BasicMapJournal<std::int8_t> bytesJournal;
+    bytesJournal.open("testMapJournalBytes.bin", bytes);
+    bytes.setGrid(64, 0, 1);
+    bytesJournal.save(bytes);
+    bytes.setGrid(0, 2, 2);
+    bytesJournal.save(bytes);
+    bytesJournal.close();
+    BasicMap<std::int8_t> bytesRestored;
+    std::cout << "[Test] int8 journal => load " << BasicMapJournal<std::int8_t>::load("testMapJournalBytes.bin", bytesRestored)
+              << ", segments " << bytesJournal.getSegmentCount() << ", cells " << int(bytesRestored.getGrid(64, 0))
+              << " " << int(bytesRestored.getGrid(0, 2)) << " (1 2)\n";
+
+    // 3. Compaction
+    journal.open("testMapJournal.bin", map);
+    journal.setCompactFactor(1.5);
+    std::uint64_t snapshot = journal.getFileSize();
+    for (int i = 0; i < 6; ++i) {
+        map.markDirtyRect(0, 0, 63, 199);
+        journal.save(map);
+        std::cout << "[Test] Save " << i << ": segments " << journal.getSegmentCount() << ", size "
+                  << journal.getFileSize() / static_cast<double>(snapshot) << " snapshots\n";
+    }
+    map.setGridSize(400, 200);
+    map.setGrid(399, 0, 4);
+    journal.save(map);
+    MapJournal::load("testMapJournal.bin", restored);
+    std::cout << "[Test] After resize => segments " << journal.getSegmentCount() << ", loaded " << restored.getNumberX()
+              << " x " << restored.getNumberY() << ", cell (399,0) => " << restored.getGrid(399, 0) << "\n";
+    journal.close();
+
+#if defined(__linux__)
+    // 4. Failed saves. A file size limit makes writes past it fail with EFBIG.
+    {
+        std::signal(SIGXFSZ, SIG_IGN);
+        rlimit unlimited;
+        getrlimit(RLIMIT_FSIZE, &unlimited);
+        Map small(300, 200);
+        MapJournal limited;
+        limited.setCompactFactor(10.0);
+        limited.open("testMapJournalLimit.bin", small);
+        std::uint64_t snapshotSize = limited.getFileSize();
+
+        // Room for a snapshot but not for the snapshot plus a segment: the append
+        // fails partway and the journal is compacted instead.
+        rlimit limit = unlimited;
+        limit.rlim_cur = static_cast<rlim_t>(snapshotSize + 100);
+        setrlimit(RLIMIT_FSIZE, &limit);
+        small.setGrid(10, 10, 5);
+        bool saved = limited.save(small);
+        std::cout << "[Test] Append fails => saved " << saved << ", segments " << limited.getSegmentCount()
+                  << ", size " << limited.getFileSize() << " (" << snapshotSize << ")";
+        MapJournal::load("testMapJournalLimit.bin", restored);
+        std::cout << ", loaded cell (10,10) => " << restored.getGrid(10, 10) << " (5)\n";
+
+        // No room for another snapshot: the compaction fails too and the journal is closed.
+        limit.rlim_cur = static_cast<rlim_t>(limited.getFileSize() - 1);
+        setrlimit(RLIMIT_FSIZE, &limit);
+        small.setGrid(20, 20, 6);
+        saved = limited.save(small);
+        bool open = limited.isOpen();
+        setrlimit(RLIMIT_FSIZE, &unlimited);
+        std::cout << "[Test] Append and compaction fail => saved " << saved << ", open " << open
+                  << ", later save => " << limited.save(small);
+        bool loaded = MapJournal::load("testMapJournalLimit.bin", restored);
+        std::cout << ", load => " << loaded << ", cells " << restored.getGrid(10, 10) << " "
+                  << restored.getGrid(20, 20) << " (5 0)\n";
+        std::signal(SIGXFSZ, SIG_DFL);
+    }
+#endif
+
+    // 5. Saving a 4000 x 4000 map every second for a minute
+    using Clock = std::chrono::steady_clock;
+    Map large(4000, 4000);
+    std::uint32_t seed = 7u;
+    double fullMs = 0.0, journalMs = 0.0;
+    int tiles = 0;
+    Clock::time_point t0 = Clock::now();
+    journal.open("testMapJournalLarge.bin", large);
+    double openMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    for (int second = 0; second < 60; ++second) {
+        simulateScan(large, 1000 + second * 20, 2000, seed);
+        t0 = Clock::now();
+        large.saveFile("testMapJournalLarge.map");
+        fullMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        t0 = Clock::now();
+        journal.save(large);
+        journalMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        tiles += journal.getLastTileCount();
+    }
+    t0 = Clock::now();
+    Map largeRestored;
+    MapJournal::load("testMapJournalLarge.bin", largeRestored);
+    double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    bool same = true;
+    for (int y = 0; y < 4000 && same; ++y) {
+        for (int x = 0; x < 4000 && same; ++x) {
+            same = large.getGrid(x, y) == largeRestored.getGrid(x, y);
+        }
+    }
+    std::cout << "[Bench] Per save: full map file " << fullMs / 60 << " ms, journal " << journalMs / 60 << " ms ("
+              << tiles / 60.0 << " tiles); journal open " << openMs << " ms, load " << loadMs << " ms, "
+              << journal.getFileSize() / 1e6 << " MB, same map => " << same << "\n";
+
+    std::cout << "----- MapJournal Test Complete -----\n";
+    return 0;
+}
@@ -4,8 +4,75 @@
  */
 
 #include <iostream>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <string>
 #include "Map.h"
 
+/**
+ * @brief Measures the insert/scan/clear throughput of a grid type.
+ *
+ * The grid is filled with a pseudo-random point pattern, scanned row by row and cleared.
+ *
+ * @param name Label printed with the timings.
+ * @param grid The grid to measure.
+ * @param insert Callable inserting a point at (x, y).
+ * @param scan Callable returning the number of occupied cells.
+ * @param clear Callable clearing the grid.
+ */
+template <typename Grid, typename Insert, typename Scan, typename Clear>
+void benchmarkGrid(const char* name, Grid& grid, Insert insert, Scan scan, Clear clear) {
+    using Clock = std::chrono::steady_clock;
+    const int dim = 2000;
+    const int points = 4000000;
+
+    Clock::time_point t0 = Clock::now();
+    std::uint32_t seed = 12345u;
+    for (int i = 0; i < points; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        int x = static_cast<int>((seed >> 8) % dim);
+        seed = seed * 1664525u + 1013904223u;
+        insert(grid, x, static_cast<int>((seed >> 8) % dim));
+    }
+    Clock::time_point t1 = Clock::now();
+    long long occupied = scan(grid);
+    Clock::time_point t2 = Clock::now();
+    clear(grid);
+    Clock::time_point t3 = Clock::now();
+
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    std::cout << "[Bench] " << name << ": insert " << ms(t0, t1) << " ms, scan " << ms(t1, t2)
+              << " ms (" << occupied << " occupied), clear " << ms(t2, t3) << " ms\n";
+}
+
+/**
+ * @brief Runs the grid benchmark for the flat map with the given cell type.
+ *
+ * @param name Label printed with the timings.
+ */
+template <typename Cell>
+void benchmarkFlatMap(const char* name) {
+    BasicMap<Cell> flat(2000, 2000);
+    benchmarkGrid(name, flat,
+        [](BasicMap<Cell>& m, int x, int y) { m.setGrid(x, y, 1); },
+        [](BasicMap<Cell>& m) {
+            long long count = 0;
+            for (int y = 0; y < m.getNumberY(); ++y) {
+                for (Cell c : m.row(y)) {
+                    count += (c != 0);
+                }
+            }
+            return count;
+        },
+        [](BasicMap<Cell>& m) { m.clearMap(); });
+}
+
 /**
  * @brief Main function to test the Map class.
  * 
@@ -15,6 +82,10 @@
  * - Tests the getGrid and setGrid methods.
  * - Enlarges the grid size and prints the updated map information.
  * - Clears the map and displays the map.
+ * - Saves and loads the binary map file, rejects a file of another cell type and exports a PGM.
+ * - Rejects map files with empty or overflowing dimensions, and grids too large to index.
+ * - Tracks the tiles changed by setGrid() and markDirtyRect(), and the map version.
+ * - Benchmarks insert/scan/clear of a vector-of-vectors grid against the flat map.
  * 
  * @return int Returns 0 upon successful completion.
  */
@@ -47,6 +118,123 @@ int main() {
     defaultMap.clearMap();
     defaultMap.showMap();
 
+    // 6. Resize keeps existing cells
+    defaultMap.setGrid(3, 4, 1);
+    defaultMap.setGridSize(20, 8);
+    std::cout << "[Test] After setGridSize(20,8): Grid(3,4) => " << defaultMap.getGrid(3, 4)
+              << ", Grid(19,7) => " << defaultMap.getGrid(19, 7)
+              << ", Grid(3,9) => " << defaultMap.getGrid(3, 9) << "\n";
+
+    // 7. Binary map file and PGM export
+    defaultMap.setGrid(19, 7, 5);
+    defaultMap.saveFile("testMap.map", MapFileInfo(0.05, -2.0, 1.5));
+    Map loaded;
+    MapFileInfo info;
+    std::cout << "[Test] Load => " << loaded.loadFile("testMap.map", &info) << ", size " << loaded.getNumberX() << " x "
+              << loaded.getNumberY() << ", Grid(3,4) => " << loaded.getGrid(3, 4) << ", Grid(19,7) => "
+              << loaded.getGrid(19, 7) << ", resolution " << info.resolution << ", origin (" << info.originX << ", "
+              << info.originY << ")\n";
+    BasicMap<std::uint8_t> bytes(4, 4);
+    std::cout << "[Test] Load int map into uint8_t map => " << bytes.loadFile("testMap.map")
+              << ", size kept => " << bytes.getNumberX() << "\n";
+    {
+        std::ifstream in("testMap.map", std::ios::binary);
+        MapFileHeader good;
+        in.read(reinterpret_cast<char*>(&good), sizeof(good));
+        // Headers that pass the size checks against the file but describe no cells or too many.
+        const std::int32_t bad[3][3] = { { INT_MAX, 0, INT_MAX }, { 0, 5, 0 }, { -16, 0, 0 } };
+        bool rejected = true;
+        for (int i = 0; i < 3; ++i) {
+            MapFileHeader header = good;
+            header.sizeX = bad[i][0];
+            header.sizeY = bad[i][1];
+            header.stride = bad[i][2];
+            header.dataSize = 0;
+            std::ofstream out("testMapBad.map", std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.close();
+            rejected = rejected && !loaded.loadFile("testMapBad.map");
+        }
+        bool thrown = false;
+        try {
+            Map huge(INT_MAX, 2);
+        } catch (const std::bad_alloc&) {
+            thrown = true;
+        }
+        std::cout << "[Test] Empty or overflowing file dimensions rejected => " << rejected << ", map kept => "
+                  << loaded.getNumberX() << " x " << loaded.getNumberY() << ", INT_MAX x 2 grid throws => " << thrown
+                  << "\n";
+    }
+    loaded.setGrid(0, 0, -1);
+    loaded.savePGM("testMap.pgm");
+    {
+        std::ifstream pgm("testMap.pgm", std::ios::binary);
+        std::string magic;
+        int width = 0, height = 0, maxValue = 0;
+        pgm >> magic >> width >> height >> maxValue;
+        pgm.get();
+        std::vector<unsigned char> pixels(width * height);
+        pgm.read(reinterpret_cast<char*>(pixels.data()), pixels.size());
+        // The last row comes first: cell (x, y) is at pixel (height - 1 - y) * width + x.
+        std::cout << "[Test] PGM " << magic << " " << width << " x " << height << ", pixel of (3,4) => "
+                  << static_cast<int>(pixels[(height - 1 - 4) * width + 3]) << ", of (0,0) => "
+                  << static_cast<int>(pixels[(height - 1) * width]) << ", of (1,1) => "
+                  << static_cast<int>(pixels[(height - 2) * width + 1]) << "\n";
+    }
+
+    // 8. Dirty tiles
+    Map tracked(200, 100);
+    std::vector<int> dirty;
+    std::cout << "[Test] New map: " << tracked.getTileCountX() << " x " << tracked.getTileCountY() << " tiles, dirty => "
+              << tracked.getDirtyTiles(dirty) << "\n";
+    tracked.clearDirty();
+    tracked.setGrid(70, 10, 1);
+    tracked.setGrid(199, 99, 1);
+    tracked.setGrid(500, 10, 1);
+    tracked.getDirtyTiles(dirty);
+    std::cout << "[Test] After three setGrid, dirty tiles =>";
+    for (size_t i = 0; i < dirty.size(); ++i) {
+        std::cout << " " << dirty[i];
+    }
+    std::cout << " (1 7), tile (1,0) => " << tracked.isTileDirty(1, 0) << "\n";
+    tracked.clearDirty();
+    tracked.markDirtyRect(-10, 60, 130, 70);
+    std::cout << "[Test] markDirtyRect over 3 x 2 tiles => " << tracked.getDirtyTiles(dirty) << "\n";
+    std::uint64_t seen = tracked.getVersion();
+    bool unchangedWhileIdle = tracked.getVersion() == seen;
+    tracked.setGrid(70, 65, 2);
+    std::uint64_t afterWrite = tracked.getVersion();
+    tracked.setGrid(71, 65, 2);
+    std::cout << "[Test] Version: unchanged without writes => " << unchangedWhileIdle << ", changed by a write to a dirty tile => "
+              << (afterWrite != seen) << ", again after the next write => " << (tracked.getVersion() != afterWrite) << "\n";
+
+    // 9. Benchmark: vector-of-vectors grid vs flat contiguous map
+    std::vector<std::vector<int> > nested(2000, std::vector<int>(2000, 0));
+    benchmarkGrid("vector<vector<int>>", nested,
+        [](std::vector<std::vector<int> >& g, int x, int y) {
+            if (y >= 0 && y < static_cast<int>(g.size()) && x >= 0 && x < static_cast<int>(g[y].size())) {
+                g[y][x] = 1;
+            }
+        },
+        [](std::vector<std::vector<int> >& g) {
+            long long count = 0;
+            for (size_t y = 0; y < g.size(); ++y) {
+                for (size_t x = 0; x < g[y].size(); ++x) {
+                    count += (g[y][x] != 0);
+                }
+            }
+            return count;
+        },
+        [](std::vector<std::vector<int> >& g) {
+            for (auto& r : g) {
+                std::fill(r.begin(), r.end(), 0);
+            }
+        });
+    benchmarkFlatMap<int>("Map<int>");
+    benchmarkFlatMap<std::int16_t>("Map<int16_t>");
+    benchmarkFlatMap<std::uint8_t>("Map<uint8_t>");
+    benchmarkFlatMap<float>("Map<float>");
+
     std::cout << "----- Map Test Complete -----\n";
     return 0;
 }
\ No newline at end of file
@@ -11,6 +11,33 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+namespace {
+
+// Maximum Lidar range until setMaxRange() is called, that of the simulated Lidar.
+const double DEFAULT_MAX_RANGE = 10.0;
+
+/**
+ * @brief Cosine and sine of every whole degree, built on first use.
+ */
+struct DegreeTable {
+    double cosDeg[360]; ///< Cosine of each degree
+    double sinDeg[360]; ///< Sine of each degree
+
+    DegreeTable() {
+        for (int i = 0; i < 360; ++i) {
+            cosDeg[i] = cos(i * M_PI / 180.0);
+            sinDeg[i] = sin(i * M_PI / 180.0);
+        }
+    }
+};
+
+const DegreeTable& degreeTable() {
+    static const DegreeTable table;
+    return table;
+}
+
+}
+
 /**
  * @brief Constructs a Mapper object with specified grid size and starting coordinates.
  * 
@@ -22,7 +49,9 @@
  * @param startY Initial y-coordinate of the robot.
  */
 Mapper::Mapper(int gridSizeX, int gridSizeY, int startX, int startY)
-    : localMap(gridSizeX, gridSizeY), robotX(startX), robotY(startY)
+    : localMap(gridSizeX, gridSizeY), occupancy(0, 0), mode(MAP_BINARY), gridSizeX(gridSizeX),
+      gridSizeY(gridSizeY), robotX(startX), robotY(startY), resolution(1.0), originX(0.0), originY(0.0),
+      maxRange(DEFAULT_MAX_RANGE)
 {
 }
 
@@ -30,39 +59,377 @@ Mapper::Mapper(int gridSizeX, int gridSizeY, int startX, int startY)
  * @brief Updates the local map with Lidar data.
  * 
  * This function processes Lidar data, calculates the coordinates of detected points,
- * and inserts them into the local map.
+ * and inserts them into the local map. In MAP_LOG_ODDS mode every beam is traced from
+ * the robot to its endpoint, so cells the beam passed through become free again.
+ * In MAP_TILED mode points are kept even when they fall at negative coordinates or
+ * beyond the initial grid size.
  * 
  * @param lidarData Vector of pairs containing distance and angle readings from the Lidar sensor.
  */
 void Mapper::updateMap(const std::vector<std::pair<int, int>>& lidarData) {
-    for (auto& reading : lidarData) {
-        int dist = reading.first;
-        int angleDeg = reading.second;
+    const DegreeTable& table = degreeTable();
+    int count = static_cast<int>(lidarData.size());
+    beamX.resize(count);
+    beamY.resize(count);
+    beamHit.assign(count, 1);
+    for (int i = 0; i < count; ++i) {
+        int dist = lidarData[i].first;
+        int angleDeg = lidarData[i].second % 360;
+        if (angleDeg < 0) {
+            angleDeg += 360;
+        }
 
-        int xCoord = robotX + static_cast<int>(dist * cos(angleDeg * M_PI / 180.0));
-        int yCoord = robotY + static_cast<int>(dist * sin(angleDeg * M_PI / 180.0));
+        beamX[i] = robotX + static_cast<int>(dist * table.cosDeg[angleDeg]);
+        beamY[i] = robotY + static_cast<int>(dist * table.sinDeg[angleDeg]);
+    }
+    applyBeams(robotX, robotY, count);
+}
+
+/**
+ * @brief Updates the map with a full Lidar scan taken at the given pose.
+ * 
+ * The scan is converted to grid coordinates in one batched pass using the map
+ * resolution and origin. The sine and cosine of the first beam direction and of the
+ * beam increment are computed once per scan; the direction of each following beam is
+ * obtained by rotating the previous one. Readings that are zero, negative or NaN
+ * are skipped. Readings at or beyond the maximum range, infinity included, saw no
+ * obstacle: in MAP_LOG_ODDS mode they are traced as free up to the maximum range,
+ * and in the other modes they mark nothing.
+ * 
+ * @param robotPose Pose of the robot in metres, heading in radians as returned by
+ *                  RobotControler::getPose().
+ * @param ranges Range of each beam in metres.
+ * @param count Number of beams in the scan.
+ * @param angleMin Angle of the first beam relative to the heading, in radians.
+ * @param angleIncrement Angle between consecutive beams, in radians.
+ */
+void Mapper::updateMap(Pose robotPose, const float* ranges, int count, double angleMin, double angleIncrement) {
+    if (!ranges || count <= 0) {
+        return;
+    }
+    beamX.resize(count);
+    beamY.resize(count);
+    beamHit.resize(count);
+
+    const double invRes = 1.0 / resolution;
+    const double gx = (robotPose.getX() - originX) * invRes;
+    const double gy = (robotPose.getY() - originY) * invRes;
+    int fromX = static_cast<int>(std::floor(gx));
+    int fromY = static_cast<int>(std::floor(gy));
 
-        if (xCoord >= 0 && xCoord < localMap.getNumberX() &&
-            yCoord >= 0 && yCoord < localMap.getNumberY()) 
-        {
-            localMap.insertPoint(Point(xCoord, yCoord));
+    double start = robotPose.getTh() + angleMin;
+    double dirX = cos(start);
+    double dirY = sin(start);
+    const double incCos = cos(angleIncrement);
+    const double incSin = sin(angleIncrement);
+
+    int valid = 0;
+    for (int i = 0; i < count; ++i) {
+        double r = ranges[i];
+        // NaN fails the comparison too.
+        if (r > 0.0) {
+            bool hit = r < maxRange;
+            double cells = (hit ? r : maxRange) * invRes;
+            beamX[valid] = static_cast<int>(std::floor(gx + cells * dirX));
+            beamY[valid] = static_cast<int>(std::floor(gy + cells * dirY));
+            beamHit[valid] = hit;
+            ++valid;
         }
+        double nextX = dirX * incCos - dirY * incSin;
+        dirY = dirX * incSin + dirY * incCos;
+        dirX = nextX;
+    }
+    applyBeams(fromX, fromY, valid);
+}
+
+/**
+ * @brief Updates the map with a full Lidar scan using precomputed beam directions.
+ * 
+ * The beam directions come from the sensor's tables (LidarSensor::getDirectionX() and
+ * LidarSensor::getDirectionY()); they are rotated by the robot heading, whose sine and
+ * cosine are computed once per scan. Readings are handled as in the overload above:
+ * at or beyond the maximum range they only free the cells along the beam.
+ * 
+ * @param robotPose Pose of the robot in metres, heading in radians.
+ * @param ranges Range of each beam in metres.
+ * @param dirX Cosine of each beam angle in the sensor frame.
+ * @param dirY Sine of each beam angle in the sensor frame.
+ * @param count Number of beams in the scan.
+ */
+void Mapper::updateMap(Pose robotPose, const float* ranges, const float* dirX, const float* dirY, int count) {
+    if (!ranges || !dirX || !dirY || count <= 0) {
+        return;
+    }
+    beamX.resize(count);
+    beamY.resize(count);
+    beamHit.resize(count);
+
+    const double invRes = 1.0 / resolution;
+    const double gx = (robotPose.getX() - originX) * invRes;
+    const double gy = (robotPose.getY() - originY) * invRes;
+    const double c = cos(robotPose.getTh());
+    const double sn = sin(robotPose.getTh());
+
+    int valid = 0;
+    for (int i = 0; i < count; ++i) {
+        double r = ranges[i];
+        if (r > 0.0) {
+            bool hit = r < maxRange;
+            double cells = (hit ? r : maxRange) * invRes;
+            double wx = dirX[i] * c - dirY[i] * sn;
+            double wy = dirX[i] * sn + dirY[i] * c;
+            beamX[valid] = static_cast<int>(std::floor(gx + cells * wx));
+            beamY[valid] = static_cast<int>(std::floor(gy + cells * wy));
+            beamHit[valid] = hit;
+            ++valid;
+        }
+    }
+    applyBeams(static_cast<int>(std::floor(gx)), static_cast<int>(std::floor(gy)), valid);
+}
+
+/**
+ * @brief Writes the endpoints held in beamX/beamY into the map of the current mode.
+ * 
+ * Endpoints whose beamHit flag is clear only free the cells along their beam.
+ * 
+ * @param fromX Grid x-coordinate the beams start from.
+ * @param fromY Grid y-coordinate the beams start from.
+ * @param count Number of endpoints to write.
+ */
+void Mapper::applyBeams(int fromX, int fromY, int count) {
+    changedCells.clear();
+    if (mode == MAP_LOG_ODDS) {
+        for (int i = 0; i < count; ++i) {
+            occupancy.traceRay(fromX, fromY, beamX[i], beamY[i], beamHit[i] != 0);
+        }
+    } else if (mode == MAP_TILED) {
+        for (int i = 0; i < count; ++i) {
+            if (beamHit[i]) {
+                tiledMap.setGrid(beamX[i], beamY[i], 1);
+            }
+        }
+    } else {
+        for (int i = 0; i < count; ++i) {
+            if (!beamHit[i]) {
+                continue;
+            }
+            // getGrid returns -1 outside the grid, where setGrid does nothing.
+            int before = localMap.getGrid(beamX[i], beamY[i]);
+            if (before != 1 && before != -1) {
+                localMap.setGrid(beamX[i], beamY[i], 1);
+                changedCells.push_back(PathCell{ beamX[i], beamY[i] });
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sets the maximum range of the Lidar.
+ * 
+ * Readings at or beyond it are max-range readings: the beam saw no obstacle.
+ * 
+ * @param meters Maximum range in metres; values that are not positive and finite are ignored.
+ */
+void Mapper::setMaxRange(double meters) {
+    if (meters > 0.0 && std::isfinite(meters)) {
+        maxRange = meters;
+    }
+}
+
+/**
+ * @brief Gets the maximum range of the Lidar.
+ * 
+ * @return double Maximum range in metres.
+ */
+double Mapper::getMaxRange() const {
+    return maxRange;
+}
+
+/**
+ * @brief Sets the size of one grid cell.
+ * 
+ * @param metersPerCell Cell size in metres; values that are not positive are ignored.
+ */
+void Mapper::setResolution(double metersPerCell) {
+    if (metersPerCell > 0.0) {
+        resolution = metersPerCell;
+    }
+}
+
+/**
+ * @brief Gets the size of one grid cell.
+ * 
+ * @return double Cell size in metres.
+ */
+double Mapper::getResolution() const {
+    return resolution;
+}
+
+/**
+ * @brief Sets the world position of the map origin.
+ * 
+ * @param worldX World x-coordinate of the corner of cell (0, 0) in metres.
+ * @param worldY World y-coordinate of the corner of cell (0, 0) in metres.
+ */
+void Mapper::setOrigin(double worldX, double worldY) {
+    originX = worldX;
+    originY = worldY;
+}
+
+/**
+ * @brief Converts world coordinates to grid coordinates.
+ * 
+ * @param worldX World x-coordinate in metres.
+ * @param worldY World y-coordinate in metres.
+ * @param gridX Receives the grid column.
+ * @param gridY Receives the grid row.
+ */
+void Mapper::worldToGrid(double worldX, double worldY, int& gridX, int& gridY) const {
+    gridX = static_cast<int>(std::floor((worldX - originX) / resolution));
+    gridY = static_cast<int>(std::floor((worldY - originY) / resolution));
+}
+
+/**
+ * @brief Sets the mapping mode.
+ * 
+ * The log-odds grid is allocated, at the size given to the constructor, the first
+ * time MAP_LOG_ODDS is set, so the other modes do not pay for it.
+ * 
+ * @param newMode The mapping mode to use for subsequent updates.
+ */
+void Mapper::setMode(MAPPING_MODE newMode) {
+    mode = newMode;
+    if (mode == MAP_LOG_ODDS && occupancy.getNumberX() == 0 && occupancy.getNumberY() == 0) {
+        occupancy.getLogOddsMap().setGridSize(gridSizeX, gridSizeY);
+    }
+}
+
+/**
+ * @brief Gets the current mapping mode.
+ * 
+ * @return MAPPING_MODE The mapping mode.
+ */
+MAPPING_MODE Mapper::getMode() const {
+    return mode;
+}
+
+/**
+ * @brief Gets the value of a map cell in the current mode.
+ * 
+ * @param x The x-coordinate.
+ * @param y The y-coordinate.
+ * @return int 1 if occupied, 0 if free, or -1 if out of bounds.
+ */
+int Mapper::getCell(int x, int y) const {
+    if (mode == MAP_LOG_ODDS) {
+        return occupancy.getGrid(x, y);
+    }
+    if (mode == MAP_TILED) {
+        return tiledMap.getGrid(x, y);
     }
+    return localMap.getGrid(x, y);
+}
+
+/**
+ * @brief Gets the local map used in MAP_BINARY mode.
+ * 
+ * @return const Map& The local map.
+ */
+const Map& Mapper::getLocalMap() const {
+    return localMap;
+}
+
+/**
+ * @brief Gets the cells of the local map that changed value in the last update.
+ * 
+ * Feed them to DStarLitePlanner::updateCells() to repair a plan instead of planning
+ * again. Filled in MAP_BINARY mode; empty in the other modes.
+ * 
+ * @return const GridPath& The changed cells.
+ */
+const GridPath& Mapper::getChangedCells() const {
+    return changedCells;
+}
+
+/**
+ * @brief Gets the unbounded tiled map.
+ * 
+ * @return const TiledMap& The tiled map.
+ */
+const TiledMap& Mapper::getTiledMap() const {
+    return tiledMap;
+}
+
+/**
+ * @brief Publishes a snapshot of the tiled map for readers on other threads.
+ * 
+ * Call from the thread running updateMap(), for instance after each scan. The
+ * snapshot shares the tiles with the map, and updateMap() copies a tile only when
+ * it writes into one a snapshot still holds, so readers never block the mapper and
+ * the map is never copied whole. Supported in MAP_TILED mode.
+ * 
+ * The planners read a BasicMap, so a planner thread copies the region it plans in
+ * with TiledMapSnapshot::copyWindow(), reusing the same Map between plans. In
+ * MAP_BINARY mode there is no snapshot: the local map is written in place, so a
+ * reader on another thread must copy getLocalMap() on the mapper's thread.
+ * 
+ * @return bool True if a snapshot was published.
+ */
+bool Mapper::publishSnapshot() {
+    if (mode != MAP_TILED) {
+        return false;
+    }
+    std::shared_ptr<const TiledMapSnapshot> latest = tiledMap.snapshot();
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    // The previous snapshot is released after the lock, when latest goes out of scope.
+    publishedSnapshot.swap(latest);
+    return true;
+}
+
+/**
+ * @brief Gets the latest snapshot published by publishSnapshot().
+ * 
+ * May be called from any thread. The snapshot stays consistent while the mapper keeps
+ * writing, and is released when the last holder drops it.
+ * 
+ * @return std::shared_ptr<const TiledMapSnapshot> The snapshot, or nullptr if none was published.
+ */
+std::shared_ptr<const TiledMapSnapshot> Mapper::getSnapshot() const {
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    return publishedSnapshot;
+}
+
+/**
+ * @brief Gets the log-odds occupancy grid.
+ * 
+ * @return const OccupancyGrid& The occupancy grid, empty until MAP_LOG_ODDS is set.
+ */
+const OccupancyGrid& Mapper::getOccupancyGrid() const {
+    return occupancy;
 }
 
 /**
  * @brief Records the current state of the local map to a file.
  * 
  * This function writes the grid values of the local map to a specified file.
+ * In MAP_TILED mode the bounding box of the allocated tiles is written.
  * 
  * @param filename The name of the file to which the map will be recorded.
  */
 void Mapper::recordMap(const std::string& filename) const {
     std::ofstream outFile(filename);
     if (outFile.is_open()) {
-        for (int i = 0; i < localMap.getNumberY(); ++i) {
-            for (int j = 0; j < localMap.getNumberX(); ++j) {
-                outFile << localMap.getGrid(j, i) << " ";
+        int minX = 0, minY = 0;
+        int sizeX = localMap.getNumberX(), sizeY = localMap.getNumberY();
+        if (mode == MAP_TILED) {
+            minX = tiledMap.getMinX();
+            minY = tiledMap.getMinY();
+            sizeX = tiledMap.getNumberX();
+            sizeY = tiledMap.getNumberY();
+        }
+        for (int i = minY; i < minY + sizeY; ++i) {
+            for (int j = minX; j < minX + sizeX; ++j) {
+                outFile << getCell(j, i) << " ";
             }
             outFile << "\n";
         }
@@ -72,6 +439,186 @@ void Mapper::recordMap(const std::string& filename) const {
     }
 }
 
+/**
+ * @brief Saves the map of the current mode to a binary map file.
+ * 
+ * The file holds the resolution, the origin and the raw cells, so it is written
+ * with a single write per buffer. MAP_BINARY saves the local map and MAP_LOG_ODDS
+ * the log-odds cells. MAP_TILED saves the bounding box of the allocated tiles, with
+ * the origin moved to its corner.
+ * 
+ * @param filename The file to create; an existing file is truncated.
+ * @return bool True if the file was written.
+ */
+bool Mapper::saveMap(const std::string& filename) const {
+    if (mode == MAP_LOG_ODDS) {
+        return occupancy.saveFile(filename, MapFileInfo(resolution, originX, originY));
+    }
+    if (mode == MAP_TILED) {
+        int minX = tiledMap.getMinX();
+        int minY = tiledMap.getMinY();
+        Map box(tiledMap.getNumberX(), tiledMap.getNumberY());
+        for (int y = 0; y < box.getNumberY(); ++y) {
+            MapRowView<int> cells = box.row(y);
+            for (int x = 0; x < cells.size(); ++x) {
+                cells[x] = tiledMap.getGrid(minX + x, minY + y);
+            }
+        }
+        return box.saveFile(filename, MapFileInfo(resolution, originX + minX * resolution, originY + minY * resolution));
+    }
+    return localMap.saveFile(filename, MapFileInfo(resolution, originX, originY));
+}
+
+/**
+ * @brief Loads a map saved by saveMap() into the map of the current mode.
+ * 
+ * The file is mapped into memory and copied without parsing, and the resolution
+ * and origin are taken from it. In MAP_TILED mode the occupied cells are written
+ * into the tiled map at their position relative to the current origin.
+ * 
+ * @param filename The file to read.
+ * @return bool True if the map was loaded; false if the file is missing, corrupt or
+ *         holds a different cell type.
+ */
+bool Mapper::loadMap(const std::string& filename) {
+    MapFileInfo info;
+    if (mode == MAP_TILED) {
+        Map box(0, 0);
+        if (!box.loadFile(filename, &info) || info.resolution <= 0.0) {
+            return false;
+        }
+        resolution = info.resolution;
+        int offsetX = static_cast<int>(std::floor((info.originX - originX) / resolution + 0.5));
+        int offsetY = static_cast<int>(std::floor((info.originY - originY) / resolution + 0.5));
+        for (int y = 0; y < box.getNumberY(); ++y) {
+            MapRowView<const int> cells = static_cast<const Map&>(box).row(y);
+            for (int x = 0; x < cells.size(); ++x) {
+                if (cells[x] != 0) {
+                    tiledMap.setGrid(offsetX + x, offsetY + y, cells[x]);
+                }
+            }
+        }
+        return true;
+    }
+    bool loaded = mode == MAP_LOG_ODDS ? occupancy.loadFile(filename, &info) : localMap.loadFile(filename, &info);
+    if (loaded) {
+        setResolution(info.resolution);
+        setOrigin(info.originX, info.originY);
+    }
+    return loaded;
+}
+
+/**
+ * @brief Starts saving the map of the current mode incrementally to a journal.
+ * 
+ * The journal first receives a full snapshot of the map, with the current
+ * resolution and origin; each saveJournal() then appends only the tiles changed
+ * since the previous save. Supported in MAP_BINARY and MAP_LOG_ODDS modes.
+ * 
+ * @param filename The journal file; an existing file is replaced.
+ * @return bool True if the journal was started.
+ */
+bool Mapper::openJournal(const std::string& filename) {
+    MapFileInfo info(resolution, originX, originY);
+    if (mode == MAP_LOG_ODDS) {
+        return occupancyJournal.open(filename, occupancy.getLogOddsMap(), info);
+    }
+    if (mode == MAP_BINARY) {
+        return journal.open(filename, localMap, info);
+    }
+    return false;
+}
+
+/**
+ * @brief Appends the tiles changed since the last save to the open journals.
+ * 
+ * The cost is proportional to the number of changed tiles, except when the
+ * journal is compacted.
+ * 
+ * @return bool True if every open journal was written; false if none is open.
+ */
+bool Mapper::saveJournal() {
+    if (!journal.isOpen() && !occupancyJournal.isOpen()) {
+        return false;
+    }
+    bool ok = true;
+    if (journal.isOpen()) {
+        ok = journal.save(localMap) && ok;
+    }
+    if (occupancyJournal.isOpen()) {
+        ok = occupancyJournal.save(occupancy.getLogOddsMap()) && ok;
+    }
+    return ok;
+}
+
+/**
+ * @brief Closes the open journals.
+ */
+void Mapper::closeJournal() {
+    journal.close();
+    occupancyJournal.close();
+}
+
+/**
+ * @brief Loads the map of the current mode from a journal.
+ * 
+ * The resolution and origin are taken from the journal. Supported in MAP_BINARY
+ * and MAP_LOG_ODDS modes.
+ * 
+ * @param filename The journal file.
+ * @return bool True if the map was loaded.
+ */
+bool Mapper::loadJournal(const std::string& filename) {
+    MapFileInfo info;
+    bool loaded = false;
+    if (mode == MAP_LOG_ODDS) {
+        loaded = BasicMapJournal<OccupancyGrid::CellType>::load(filename, occupancy.getLogOddsMap(), &info);
+    } else if (mode == MAP_BINARY) {
+        loaded = MapJournal::load(filename, localMap, &info);
+    }
+    if (loaded) {
+        setResolution(info.resolution);
+        setOrigin(info.originX, info.originY);
+    }
+    return loaded;
+}
+
+/**
+ * @brief Exports the map of the current mode as a PGM image.
+ * 
+ * Occupied cells are black, free cells white and cells never observed by the
+ * log-odds grid grey; the y axis points up in image viewers. In MAP_TILED mode the
+ * bounding box of the allocated tiles is exported.
+ * 
+ * @param filename The file to create; an existing file is truncated.
+ * @return bool True if the file was written.
+ */
+bool Mapper::exportPGM(const std::string& filename) const {
+    int minX = 0, minY = 0;
+    int sizeX = localMap.getNumberX(), sizeY = localMap.getNumberY();
+    if (mode == MAP_LOG_ODDS) {
+        sizeX = occupancy.getNumberX();
+        sizeY = occupancy.getNumberY();
+    } else if (mode == MAP_TILED) {
+        minX = tiledMap.getMinX();
+        minY = tiledMap.getMinY();
+        sizeX = tiledMap.getNumberX();
+        sizeY = tiledMap.getNumberY();
+    }
+    BasicMap<std::int8_t> image(sizeX, sizeY);
+    for (int y = 0; y < sizeY; ++y) {
+        MapRowView<std::int8_t> cells = image.row(y);
+        for (int x = 0; x < sizeX; ++x) {
+            if (mode == MAP_LOG_ODDS && occupancy.getLogOdds(x, y) == 0) {
+                cells[x] = -1;
+            } else {
+                cells[x] = getCell(minX + x, minY + y) > 0 ? 1 : 0;
+            }
+        }
+    }
+    return image.savePGM(filename);
+}
+
 /**
  * @brief Displays the local map.
  * 
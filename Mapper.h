@@ -7,9 +7,26 @@
 #define MAPPER_H
 
 #include "Map.h"
+#include "OccupancyGrid.h"
+#include "TiledMap.h"
+#include "MapJournal.h"
+#include "AStarPlanner.h"
+#include "Pose.h"
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 
+/**
+ * @enum MAPPING_MODE
+ * @brief Selects how the Mapper integrates Lidar readings.
+ */
+enum MAPPING_MODE {
+    MAP_BINARY, ///< Mark beam endpoints as occupied in the binary map
+    MAP_LOG_ODDS, ///< Trace each beam through a log-odds occupancy grid
+    MAP_TILED ///< Mark beam endpoints in an unbounded tiled map with signed coordinates
+};
+
 /**
  * @class Mapper
  * @brief Manages the mapping functionality using Lidar data.
@@ -19,8 +36,36 @@
 class Mapper {
 private:
     Map localMap; ///< Local map object to store the grid data
+    OccupancyGrid occupancy; ///< Log-odds grid used in MAP_LOG_ODDS mode, empty until that mode is first set
+    TiledMap tiledMap; ///< Unbounded map used in MAP_TILED mode
+    MAPPING_MODE mode; ///< Current mapping mode
+    int gridSizeX; ///< Number of columns given to the constructor
+    int gridSizeY; ///< Number of rows given to the constructor
     int robotX; ///< X-coordinate of the robot's position
     int robotY; ///< Y-coordinate of the robot's position
+    double resolution; ///< Size of one grid cell in metres
+    double originX; ///< World x-coordinate of the corner of cell (0, 0) in metres
+    double originY; ///< World y-coordinate of the corner of cell (0, 0) in metres
+    std::vector<int> beamX; ///< Grid x-coordinates of the current scan's endpoints
+    std::vector<int> beamY; ///< Grid y-coordinates of the current scan's endpoints
+    std::vector<std::uint8_t> beamHit; ///< Whether each endpoint of the current scan is an obstacle
+    double maxRange; ///< Lidar maximum range in metres; longer readings hit nothing
+    MapJournal journal; ///< Incremental persistence of the local map
+    BasicMapJournal<OccupancyGrid::CellType> occupancyJournal; ///< Incremental persistence of the log-odds cells
+    GridPath changedCells; ///< Cells of the local map that changed value in the last update
+    std::shared_ptr<const TiledMapSnapshot> publishedSnapshot; ///< Latest snapshot handed to readers
+    mutable std::mutex snapshotMutex; ///< Guards publishedSnapshot, held only to copy the pointer
+
+    /**
+     * @brief Writes the endpoints held in beamX/beamY into the map of the current mode.
+     * 
+     * Endpoints whose beamHit flag is clear only free the cells along their beam.
+     * 
+     * @param fromX Grid x-coordinate the beams start from.
+     * @param fromY Grid y-coordinate the beams start from.
+     * @param count Number of endpoints to write.
+     */
+    void applyBeams(int fromX, int fromY, int count);
 
 public:
     /**
@@ -39,21 +84,269 @@ public:
      * @brief Updates the local map with Lidar data.
      * 
      * This function processes Lidar data, calculates the coordinates of detected points,
-     * and inserts them into the local map.
+     * and inserts them into the local map. In MAP_LOG_ODDS mode every beam is traced from
+     * the robot to its endpoint, so cells the beam passed through become free again.
+     * In MAP_TILED mode points are kept even when they fall at negative coordinates or
+     * beyond the initial grid size.
      * 
      * @param lidarData Vector of pairs containing distance and angle readings from the Lidar sensor.
      */
     void updateMap(const std::vector<std::pair<int, int>>& lidarData);
 
+    /**
+     * @brief Updates the map with a full Lidar scan taken at the given pose.
+     * 
+     * The scan is converted to grid coordinates in one batched pass using the map
+     * resolution and origin. The sine and cosine of the first beam direction and of the
+     * beam increment are computed once per scan; the direction of each following beam is
+     * obtained by rotating the previous one. Readings that are zero, negative or NaN
+     * are skipped. Readings at or beyond the maximum range, infinity included, saw no
+     * obstacle: in MAP_LOG_ODDS mode they are traced as free up to the maximum range,
+     * and in the other modes they mark nothing.
+     * 
+     * @param robotPose Pose of the robot in metres, heading in radians as returned by
+     *                  RobotControler::getPose().
+     * @param ranges Range of each beam in metres.
+     * @param count Number of beams in the scan.
+     * @param angleMin Angle of the first beam relative to the heading, in radians.
+     * @param angleIncrement Angle between consecutive beams, in radians.
+     */
+    void updateMap(Pose robotPose, const float* ranges, int count, double angleMin, double angleIncrement);
+
+    /**
+     * @brief Updates the map with a full Lidar scan using precomputed beam directions.
+     * 
+     * The beam directions come from the sensor's tables (LidarSensor::getDirectionX() and
+     * LidarSensor::getDirectionY()); they are rotated by the robot heading, whose sine and
+     * cosine are computed once per scan. Readings are handled as in the overload above:
+     * at or beyond the maximum range they only free the cells along the beam.
+     * 
+     * @param robotPose Pose of the robot in metres, heading in radians.
+     * @param ranges Range of each beam in metres.
+     * @param dirX Cosine of each beam angle in the sensor frame.
+     * @param dirY Sine of each beam angle in the sensor frame.
+     * @param count Number of beams in the scan.
+     */
+    void updateMap(Pose robotPose, const float* ranges, const float* dirX, const float* dirY, int count);
+
+    /**
+     * @brief Sets the maximum range of the Lidar.
+     * 
+     * Readings at or beyond it are max-range readings: the beam saw no obstacle.
+     * 
+     * @param meters Maximum range in metres; values that are not positive and finite are ignored.
+     */
+    void setMaxRange(double meters);
+
+    /**
+     * @brief Gets the maximum range of the Lidar.
+     * 
+     * @return double Maximum range in metres.
+     */
+    double getMaxRange() const;
+
+    /**
+     * @brief Sets the size of one grid cell.
+     * 
+     * @param metersPerCell Cell size in metres; values that are not positive are ignored.
+     */
+    void setResolution(double metersPerCell);
+
+    /**
+     * @brief Gets the size of one grid cell.
+     * 
+     * @return double Cell size in metres.
+     */
+    double getResolution() const;
+
+    /**
+     * @brief Sets the world position of the map origin.
+     * 
+     * @param worldX World x-coordinate of the corner of cell (0, 0) in metres.
+     * @param worldY World y-coordinate of the corner of cell (0, 0) in metres.
+     */
+    void setOrigin(double worldX, double worldY);
+
+    /**
+     * @brief Converts world coordinates to grid coordinates.
+     * 
+     * @param worldX World x-coordinate in metres.
+     * @param worldY World y-coordinate in metres.
+     * @param gridX Receives the grid column.
+     * @param gridY Receives the grid row.
+     */
+    void worldToGrid(double worldX, double worldY, int& gridX, int& gridY) const;
+
+    /**
+     * @brief Sets the mapping mode.
+     * 
+     * The log-odds grid is allocated, at the size given to the constructor, the first
+     * time MAP_LOG_ODDS is set, so the other modes do not pay for it.
+     * 
+     * @param newMode The mapping mode to use for subsequent updates.
+     */
+    void setMode(MAPPING_MODE newMode);
+
+    /**
+     * @brief Gets the current mapping mode.
+     * 
+     * @return MAPPING_MODE The mapping mode.
+     */
+    MAPPING_MODE getMode() const;
+
+    /**
+     * @brief Gets the value of a map cell in the current mode.
+     * 
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return int 1 if occupied, 0 if free, or -1 if out of bounds.
+     */
+    int getCell(int x, int y) const;
+
+    /**
+     * @brief Gets the local map used in MAP_BINARY mode.
+     * 
+     * @return const Map& The local map.
+     */
+    const Map& getLocalMap() const;
+
+    /**
+     * @brief Gets the cells of the local map that changed value in the last update.
+     * 
+     * Feed them to DStarLitePlanner::updateCells() to repair a plan instead of planning
+     * again. Filled in MAP_BINARY mode; empty in the other modes.
+     * 
+     * @return const GridPath& The changed cells.
+     */
+    const GridPath& getChangedCells() const;
+
+    /**
+     * @brief Gets the unbounded tiled map.
+     * 
+     * @return const TiledMap& The tiled map.
+     */
+    const TiledMap& getTiledMap() const;
+
+    /**
+     * @brief Publishes a snapshot of the tiled map for readers on other threads.
+     * 
+     * Call from the thread running updateMap(), for instance after each scan. The
+     * snapshot shares the tiles with the map, and updateMap() copies a tile only when
+     * it writes into one a snapshot still holds, so readers never block the mapper and
+     * the map is never copied whole. Supported in MAP_TILED mode.
+     * 
+     * The planners read a BasicMap, so a planner thread copies the region it plans in
+     * with TiledMapSnapshot::copyWindow(), reusing the same Map between plans. In
+     * MAP_BINARY mode there is no snapshot: the local map is written in place, so a
+     * reader on another thread must copy getLocalMap() on the mapper's thread.
+     * 
+     * @return bool True if a snapshot was published.
+     */
+    bool publishSnapshot();
+
+    /**
+     * @brief Gets the latest snapshot published by publishSnapshot().
+     * 
+     * May be called from any thread. The snapshot stays consistent while the mapper keeps
+     * writing, and is released when the last holder drops it.
+     * 
+     * @return std::shared_ptr<const TiledMapSnapshot> The snapshot, or nullptr if none was published.
+     */
+    std::shared_ptr<const TiledMapSnapshot> getSnapshot() const;
+
+    /**
+     * @brief Gets the log-odds occupancy grid.
+     * 
+     * @return const OccupancyGrid& The occupancy grid, empty until MAP_LOG_ODDS is set.
+     */
+    const OccupancyGrid& getOccupancyGrid() const;
+
     /**
      * @brief Records the current state of the local map to a file.
      * 
      * This function writes the grid values of the local map to a specified file.
+     * In MAP_TILED mode the bounding box of the allocated tiles is written.
      * 
      * @param filename The name of the file to which the map will be recorded.
      */
     void recordMap(const std::string& filename) const;
 
+    /**
+     * @brief Saves the map of the current mode to a binary map file.
+     * 
+     * The file holds the resolution, the origin and the raw cells, so it is written
+     * with a single write per buffer. MAP_BINARY saves the local map and MAP_LOG_ODDS
+     * the log-odds cells. MAP_TILED saves the bounding box of the allocated tiles, with
+     * the origin moved to its corner.
+     * 
+     * @param filename The file to create; an existing file is truncated.
+     * @return bool True if the file was written.
+     */
+    bool saveMap(const std::string& filename) const;
+
+    /**
+     * @brief Loads a map saved by saveMap() into the map of the current mode.
+     * 
+     * The file is mapped into memory and copied without parsing, and the resolution
+     * and origin are taken from it. In MAP_TILED mode the occupied cells are written
+     * into the tiled map at their position relative to the current origin.
+     * 
+     * @param filename The file to read.
+     * @return bool True if the map was loaded; false if the file is missing, corrupt or
+     *         holds a different cell type.
+     */
+    bool loadMap(const std::string& filename);
+
+    /**
+     * @brief Starts saving the map of the current mode incrementally to a journal.
+     * 
+     * The journal first receives a full snapshot of the map, with the current
+     * resolution and origin; each saveJournal() then appends only the tiles changed
+     * since the previous save. Supported in MAP_BINARY and MAP_LOG_ODDS modes.
+     * 
+     * @param filename The journal file; an existing file is replaced.
+     * @return bool True if the journal was started.
+     */
+    bool openJournal(const std::string& filename);
+
+    /**
+     * @brief Appends the tiles changed since the last save to the open journals.
+     * 
+     * The cost is proportional to the number of changed tiles, except when the
+     * journal is compacted.
+     * 
+     * @return bool True if every open journal was written; false if none is open.
+     */
+    bool saveJournal();
+
+    /**
+     * @brief Closes the open journals.
+     */
+    void closeJournal();
+
+    /**
+     * @brief Loads the map of the current mode from a journal.
+     * 
+     * The resolution and origin are taken from the journal. Supported in MAP_BINARY
+     * and MAP_LOG_ODDS modes.
+     * 
+     * @param filename The journal file.
+     * @return bool True if the map was loaded.
+     */
+    bool loadJournal(const std::string& filename);
+
+    /**
+     * @brief Exports the map of the current mode as a PGM image.
+     * 
+     * Occupied cells are black, free cells white and cells never observed by the
+     * log-odds grid grey; the y axis points up in image viewers. In MAP_TILED mode the
+     * bounding box of the allocated tiles is exported.
+     * 
+     * @param filename The file to create; an existing file is truncated.
+     * @return bool True if the file was written.
+     */
+    bool exportPGM(const std::string& filename) const;
+
     /**
      * @brief Displays the local map.
      * 
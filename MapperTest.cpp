@@ -4,6 +4,8 @@
  */
 
 #include <iostream>
+#include <chrono>
+#include <limits>
 #include "mapper.h"
 
 /**
@@ -14,6 +16,16 @@
  * - Simulates Lidar data and updates the map.
  * - Displays the map.
  * - Records the map to a file.
+ * - Switches to log-odds mode, allocating the log-odds grid only then, and checks that
+ *   a moved obstacle is cleared.
+ * - Switches to tiled mode and checks that points at negative coordinates are kept.
+ * - Updates the map from a pose and a metric scan using a resolution and an origin.
+ * - Traces max-range and infinite readings as free without marking an obstacle.
+ * - Saves and loads the binary map file in each mode and exports a PGM.
+ * - Saves the log-odds grid incrementally to a journal and loads it back.
+ * - Publishes tiled map snapshots that keep their cells while the mapper writes, and
+ *   plans through a window of one copied into a Map.
+ * - Compares recordMap() text output with the binary map file on a 4000 x 4000 map.
  * 
  * @return int Returns 0 upon successful completion.
  */
@@ -36,6 +48,137 @@ int main() {
     mapper.recordMap("testMapOutput.txt");
     std::cout << "[Test] Map recorded to testMapOutput.txt\n";
 
+    // 4. Log-odds mode: an obstacle that moves away is cleared by later beams
+    Mapper logOddsMapper(20, 20, 5, 5);
+    const OccupancyGrid& logOdds = logOddsMapper.getOccupancyGrid();
+    std::cout << "[Test] Log-odds grid before the mode is set => " << logOdds.getNumberX() << " x "
+              << logOdds.getNumberY();
+    logOddsMapper.setMode(MAP_LOG_ODDS);
+    std::cout << ", after => " << logOdds.getNumberX() << " x " << logOdds.getNumberY() << "\n";
+    logOddsMapper.updateMap({{4, 0}});
+    std::cout << "[Test] Cell(9,5) after hit => " << logOddsMapper.getCell(9, 5) << "\n";
+    for (int i = 0; i < 5; ++i) {
+        logOddsMapper.updateMap({{8, 0}});
+    }
+    std::cout << "[Test] Cell(9,5) after beams through it => " << logOddsMapper.getCell(9, 5)
+              << ", Cell(13,5) => " << logOddsMapper.getCell(13, 5) << "\n";
+
+    // 5. Tiled mode keeps points outside the initial grid
+    Mapper tiledMapper(10, 10, 0, 0);
+    tiledMapper.setMode(MAP_TILED);
+    tiledMapper.updateMap({{3, 180}, {40, 90}});
+    std::cout << "[Test] Tiled Cell(-3,0) => " << tiledMapper.getCell(-3, 0)
+              << ", Cell(0,40) => " << tiledMapper.getCell(0, 40)
+              << ", tiles => " << tiledMapper.getTiledMap().getTileCount() << "\n";
+
+    // 6. Pose-aware update: 0.1 m cells, origin at (-1, -1), robot facing +y, beams 90 deg apart
+    Mapper poseMapper(20, 20);
+    poseMapper.setResolution(0.1);
+    poseMapper.setOrigin(-1.0, -1.0);
+    const float PI_F = 3.14159265f;
+    float ranges[4] = { 0.5f, 0.0f, 0.3f, 0.2f };
+    poseMapper.updateMap(Pose(0.05, 0.05, PI_F / 2), ranges, 4, 0.0, PI_F / 2);
+    int gx, gy;
+    poseMapper.worldToGrid(0.05, 0.05, gx, gy);
+    std::cout << "[Test] Robot cell => (" << gx << "," << gy << ")"
+              << ", Cell(10,15) => " << poseMapper.getCell(10, 15)
+              << ", Cell(10,7) => " << poseMapper.getCell(10, 7)
+              << ", Cell(12,10) => " << poseMapper.getCell(12, 10) << "\n";
+
+    // 7. Max-range beams: 1 m Lidar, robot at the centre facing +x
+    const float INF_F = std::numeric_limits<float>::infinity();
+    float longRanges[4] = { INF_F, 1.5f, 0.5f, std::numeric_limits<float>::quiet_NaN() };
+    Mapper freeMapper(40, 40);
+    freeMapper.setResolution(0.1);
+    freeMapper.setOrigin(-2.0, -2.0);
+    freeMapper.setMaxRange(1.0);
+    freeMapper.setMode(MAP_LOG_ODDS);
+    freeMapper.updateMap(Pose(0.05, 0.05, 0.0), longRanges, 4, 0.0, PI_F / 2);
+    const OccupancyGrid& freeGrid = freeMapper.getOccupancyGrid();
+    std::cout << "[Test] Infinite beam: LogOdds(25,20) => " << freeGrid.getLogOdds(25, 20) << ", end (30,20) => "
+              << freeGrid.getLogOdds(30, 20) << ", beyond (31,20) => " << freeGrid.getLogOdds(31, 20)
+              << "; 1.5 m beam end (20,30) => " << freeGrid.getLogOdds(20, 30)
+              << "; 0.5 m hit (15,20) => " << freeGrid.getLogOdds(15, 20) << "\n";
+    freeMapper.setMode(MAP_BINARY);
+    freeMapper.updateMap(Pose(0.05, 0.05, 0.0), longRanges, 4, 0.0, PI_F / 2);
+    std::cout << "[Test] Binary mode: Cell(30,20) => " << freeMapper.getCell(30, 20) << ", Cell(20,30) => "
+              << freeMapper.getCell(20, 30) << ", Cell(15,20) => " << freeMapper.getCell(15, 20)
+              << ", changed cells => " << freeMapper.getChangedCells().size() << "\n";
+
+    // 8. Binary map file in each mode
+    poseMapper.saveMap("testMapperPose.map");
+    Mapper restored(1, 1);
+    std::cout << "[Test] Load binary map => " << restored.loadMap("testMapperPose.map") << ", Cell(10,15) => "
+              << restored.getCell(10, 15) << ", resolution " << restored.getResolution() << "\n";
+    restored.worldToGrid(0.05, 0.05, gx, gy);
+    std::cout << "[Test] Restored robot cell => (" << gx << "," << gy << ")\n";
+    logOddsMapper.saveMap("testMapperLogOdds.map");
+    Mapper logOddsRestored(1, 1);
+    logOddsRestored.setMode(MAP_LOG_ODDS);
+    std::cout << "[Test] Load log-odds map => " << logOddsRestored.loadMap("testMapperLogOdds.map")
+              << ", Cell(13,5) => " << logOddsRestored.getCell(13, 5) << ", into binary mode => "
+              << restored.loadMap("testMapperLogOdds.map") << "\n";
+    tiledMapper.saveMap("testMapperTiled.map");
+    Mapper tiledRestored(1, 1);
+    tiledRestored.setMode(MAP_TILED);
+    std::cout << "[Test] Load tiled map => " << tiledRestored.loadMap("testMapperTiled.map") << ", Cell(-3,0) => "
+              << tiledRestored.getCell(-3, 0) << ", Cell(0,40) => " << tiledRestored.getCell(0, 40) << "\n";
+    std::cout << "[Test] Export PGM => " << logOddsMapper.exportPGM("testMapperLogOdds.pgm") << "\n";
+
+    // 9. Journal: only the tiles of the latest scan are appended
+    std::cout << "[Test] Open journal => " << logOddsMapper.openJournal("testMapperJournal.bin");
+    logOddsMapper.updateMap({{6, 90}});
+    std::cout << ", save => " << logOddsMapper.saveJournal() << "\n";
+    logOddsMapper.closeJournal();
+    Mapper journalRestored(1, 1);
+    journalRestored.setMode(MAP_LOG_ODDS);
+    std::cout << "[Test] Load journal => " << journalRestored.loadJournal("testMapperJournal.bin") << ", Cell(5,11) => "
+              << journalRestored.getCell(5, 11) << ", Cell(13,5) => " << journalRestored.getCell(13, 5) << "\n";
+    std::cout << "[Test] Journal in tiled mode => " << tiledMapper.openJournal("testMapperJournalTiled.bin") << "\n";
+
+    // 10. Snapshots
+    std::cout << "[Test] Publish in log-odds mode => " << logOddsMapper.publishSnapshot() << ", snapshot => "
+              << (logOddsMapper.getSnapshot() != nullptr) << "\n";
+    std::cout << "[Test] Publish in tiled mode => " << tiledMapper.publishSnapshot();
+    std::shared_ptr<const TiledMapSnapshot> snapshot = tiledMapper.getSnapshot();
+    tiledMapper.updateMap({{25, 0}});
+    tiledMapper.publishSnapshot();
+    std::cout << "; old snapshot Cell(0,40) => " << snapshot->getGrid(0, 40) << ", Cell(25,0) => "
+              << snapshot->getGrid(25, 0) << "; new snapshot Cell(25,0) => " << tiledMapper.getSnapshot()->getGrid(25, 0)
+              << "\n";
+    Map window;
+    tiledMapper.getSnapshot()->copyWindow(0, 0, 40, 10, window);
+    AStarPlanner planner;
+    GridPath path;
+    bool planned = planner.plan(window, 20, 0, 30, 0, path);
+    bool avoided = true;
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        avoided = avoided && !(path[i].x == 25 && path[i].y == 0);
+    }
+    std::cout << "[Test] Plan on a snapshot window => " << planned << ", avoids Cell(25,0) => " << avoided << "\n";
+
+    // 11. Large map: text vs binary file
+    using Clock = std::chrono::steady_clock;
+    Mapper large(4000, 4000);
+    for (int i = 0; i < 4000; i += 3) {
+        large.updateMap({{i, 0}, {i, 90}});
+    }
+    Clock::time_point t0 = Clock::now();
+    large.recordMap("testMapperLarge.txt");
+    double textMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    t0 = Clock::now();
+    large.saveMap("testMapperLarge.map");
+    double saveMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    Mapper largeRestored(1, 1);
+    t0 = Clock::now();
+    largeRestored.loadMap("testMapperLarge.map");
+    double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    t0 = Clock::now();
+    large.exportPGM("testMapperLarge.pgm");
+    double pgmMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    std::cout << "[Bench] 4000 x 4000 map: recordMap text " << textMs << " ms, saveMap " << saveMs << " ms, loadMap "
+              << loadMs << " ms, exportPGM " << pgmMs << " ms; Cell(2997,0) => " << largeRestored.getCell(2997, 0) << "\n";
+
     std::cout << "----- Mapper Test Complete -----\n";
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "OccupancyGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+
+template <typename Cell>
+BasicOccupancyGrid<Cell>::BasicOccupancyGrid(int sizeX, int sizeY, int hit, int miss, int clampMin, int clampMax)
+    : logOdds(sizeX, sizeY), hitValue(hit), missValue(miss), occupiedThreshold(0)
+{
+    minValue = std::max(clampMin, static_cast<int>(std::numeric_limits<Cell>::min()));
+    maxValue = std::min(clampMax, static_cast<int>(std::numeric_limits<Cell>::max()));
+}
+
+template <typename Cell>
+void BasicOccupancyGrid<Cell>::saturatingAdd(Cell& cell, int delta) const {
+    int value = static_cast<int>(cell) + delta;
+    cell = static_cast<Cell>(value < minValue ? minValue : (value > maxValue ? maxValue : value));
+}
+
+template <typename Cell>
+void BasicOccupancyGrid<Cell>::clearMap() {
+    logOdds.clearMap();
+}
+
+template <typename Cell>
+void BasicOccupancyGrid<Cell>::traceRay(int x0, int y0, int x1, int y1, bool hit) {
+    const int dimX = logOdds.getNumberX();
+    const int dimY = logOdds.getNumberY();
+    const int stride = logOdds.getStride();
+    Cell* cells = logOdds.data();
+    if (!cells) {
+        return;
+    }
+    logOdds.markDirtyRect(std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1));
+
+    int dx = std::abs(x1 - x0);
+    int dy = -std::abs(y1 - y0);
+    int sx = x0 < x1 ? 1 : -1;
+    int sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    int steps = std::max(dx, -dy);
+    int x = x0;
+    int y = y0;
+
+    bool inside0 = x0 >= 0 && x0 < dimX && y0 >= 0 && y0 < dimY;
+    bool inside1 = x1 >= 0 && x1 < dimX && y1 >= 0 && y1 < dimY;
+    if (inside0 && inside1) {
+        // Whole beam inside the grid: walk the buffer with pointer steps only.
+        Cell* p = cells + static_cast<size_t>(y0) * stride + x0;
+        const int stepY = sy * stride;
+        for (int i = 0; i < steps; ++i) {
+            saturatingAdd(*p, -missValue);
+            int e2 = 2 * err;
+            if (e2 >= dy) {
+                err += dy;
+                p += sx;
+            }
+            if (e2 <= dx) {
+                err += dx;
+                p += stepY;
+            }
+        }
+        saturatingAdd(*p, hit ? hitValue : -missValue);
+        return;
+    }
+
+    for (int i = 0; i < steps; ++i) {
+        if (x >= 0 && x < dimX && y >= 0 && y < dimY) {
+            saturatingAdd(cells[static_cast<size_t>(y) * stride + x], -missValue);
+        } else if (inside0) {
+            // The beam started inside and has left the grid; it cannot come back.
+            return;
+        }
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y += sy;
+        }
+    }
+    if (inside1) {
+        saturatingAdd(cells[static_cast<size_t>(y1) * stride + x1], hit ? hitValue : -missValue);
+    }
+}
+
+template <typename Cell>
+void BasicOccupancyGrid<Cell>::updateCell(int x, int y, bool hit) {
+    if (x >= 0 && x < logOdds.getNumberX() && y >= 0 && y < logOdds.getNumberY()) {
+        saturatingAdd(logOdds.row(y)[x], hit ? hitValue : -missValue);
+        logOdds.markDirty(x, y);
+    }
+}
+
+template <typename Cell>
+int BasicOccupancyGrid<Cell>::getLogOdds(int x, int y) const {
+    if (x >= 0 && x < logOdds.getNumberX() && y >= 0 && y < logOdds.getNumberY()) {
+        return logOdds.getGrid(x, y);
+    }
+    return 0;
+}
+
+template <typename Cell>
+double BasicOccupancyGrid<Cell>::getProbability(int x, int y) const {
+    // Cells store log-odds in units of 1/8.
+    double l = getLogOdds(x, y) / 8.0;
+    return 1.0 - 1.0 / (1.0 + std::exp(l));
+}
+
+template <typename Cell>
+int BasicOccupancyGrid<Cell>::getGrid(int x, int y) const {
+    if (x >= 0 && x < logOdds.getNumberX() && y >= 0 && y < logOdds.getNumberY()) {
+        return logOdds.getGrid(x, y) > occupiedThreshold ? 1 : 0;
+    }
+    return -1;
+}
+
+template <typename Cell>
+void BasicOccupancyGrid<Cell>::setOccupiedThreshold(int threshold) {
+    occupiedThreshold = threshold;
+}
+
+template <typename Cell>
+int BasicOccupancyGrid<Cell>::getNumberX() const {
+    return logOdds.getNumberX();
+}
+
+template <typename Cell>
+int BasicOccupancyGrid<Cell>::getNumberY() const {
+    return logOdds.getNumberY();
+}
+
+template <typename Cell>
+const BasicMap<Cell>& BasicOccupancyGrid<Cell>::getLogOddsMap() const {
+    return logOdds;
+}
+
+template <typename Cell>
+BasicMap<Cell>& BasicOccupancyGrid<Cell>::getLogOddsMap() {
+    return logOdds;
+}
+
+template <typename Cell>
+bool BasicOccupancyGrid<Cell>::saveFile(const std::string& filename, const MapFileInfo& info) const {
+    return logOdds.saveFile(filename, info);
+}
+
+template <typename Cell>
+bool BasicOccupancyGrid<Cell>::loadFile(const std::string& filename, MapFileInfo* info) {
+    return logOdds.loadFile(filename, info);
+}
+
+template class BasicOccupancyGrid<std::int8_t>;
+template class BasicOccupancyGrid<std::int16_t>;
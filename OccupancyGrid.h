@@ -0,0 +1,173 @@
+/**
+ * @file OccupancyGrid.h
+ * @brief Declaration of the OccupancyGrid class.
+ */
+
+#ifndef OCCUPANCYGRID_H
+#define OCCUPANCYGRID_H
+
+#include <cstdint>
+#include "Map.h"
+
+/**
+ * @class BasicOccupancyGrid
+ * @brief Probabilistic occupancy grid stored as clamped log-odds.
+ *
+ * Each cell holds the log-odds of being occupied as a small fixed-point integer
+ * (int8_t or int16_t). Lidar beams are traced with an integer Bresenham kernel:
+ * every cell the beam passes through is decremented by the miss value and the cell
+ * at the end of the beam is incremented by the hit value. All updates saturate at
+ * the configured limits so that a cell can always be overturned by later scans.
+ */
+template <typename Cell>
+class BasicOccupancyGrid {
+private:
+    BasicMap<Cell> logOdds; ///< Log-odds value of each cell, 0 meaning unknown
+    int hitValue; ///< Log-odds added to the cell where a beam ends
+    int missValue; ///< Log-odds subtracted from cells a beam passes through
+    int minValue; ///< Lower clamp of the log-odds
+    int maxValue; ///< Upper clamp of the log-odds
+    int occupiedThreshold; ///< Log-odds above which a cell counts as occupied
+
+    /**
+     * @brief Adds a delta to a cell, saturating at the clamp limits.
+     *
+     * @param cell The cell to update.
+     * @param delta The log-odds change.
+     */
+    void saturatingAdd(Cell& cell, int delta) const;
+
+public:
+    typedef Cell CellType; ///< Type stored in each log-odds cell
+
+    /**
+     * @brief Constructs an occupancy grid with all cells unknown.
+     *
+     * The defaults correspond to a hit probability of about 0.7 and a miss probability
+     * of about 0.4, in units of 1/8 log-odds.
+     *
+     * @param sizeX Number of columns in the grid.
+     * @param sizeY Number of rows in the grid.
+     * @param hit Log-odds added for a beam endpoint.
+     * @param miss Log-odds subtracted for a traversed cell.
+     * @param clampMin Lower clamp of the log-odds.
+     * @param clampMax Upper clamp of the log-odds.
+     */
+    BasicOccupancyGrid(int sizeX = 10, int sizeY = 10, int hit = 7, int miss = 3,
+                       int clampMin = -16, int clampMax = 28);
+
+    /**
+     * @brief Resets every cell to unknown.
+     */
+    void clearMap();
+
+    /**
+     * @brief Traces a beam from (x0, y0) to (x1, y1).
+     *
+     * The origin cell and every cell up to, but not including, the end cell are
+     * updated as free: the origin is where the sensor stands. If hit is true the end
+     * cell is updated as occupied, otherwise it is updated as free (max-range beam).
+     * A beam whose ends share a cell only updates that cell, as the end cell. Parts of
+     * the beam outside the grid are skipped.
+     *
+     * @param x0 Column of the beam origin.
+     * @param y0 Row of the beam origin.
+     * @param x1 Column of the beam end.
+     * @param y1 Row of the beam end.
+     * @param hit Whether the beam ended on an obstacle.
+     */
+    void traceRay(int x0, int y0, int x1, int y1, bool hit = true);
+
+    /**
+     * @brief Applies a hit or miss update to a single cell.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @param hit True for an occupied observation, false for a free one.
+     */
+    void updateCell(int x, int y, bool hit);
+
+    /**
+     * @brief Gets the log-odds of a cell.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return int The log-odds value, or 0 if out of bounds.
+     */
+    int getLogOdds(int x, int y) const;
+
+    /**
+     * @brief Gets the occupancy probability of a cell.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return double The probability in [0, 1]; 0.5 for unknown or out-of-bounds cells.
+     */
+    double getProbability(int x, int y) const;
+
+    /**
+     * @brief Gets the thresholded value at the specified grid coordinates.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return int 1 if occupied, 0 if free or unknown, or -1 if out of bounds.
+     */
+    int getGrid(int x, int y) const;
+
+    /**
+     * @brief Sets the log-odds above which a cell counts as occupied.
+     *
+     * @param threshold The new threshold.
+     */
+    void setOccupiedThreshold(int threshold);
+
+    /**
+     * @brief Gets the number of columns in the grid.
+     *
+     * @return int The number of columns.
+     */
+    int getNumberX() const;
+
+    /**
+     * @brief Gets the number of rows in the grid.
+     *
+     * @return int The number of rows.
+     */
+    int getNumberY() const;
+
+    /**
+     * @brief Gets the underlying log-odds map.
+     *
+     * @return const BasicMap<Cell>& The log-odds cells.
+     */
+    const BasicMap<Cell>& getLogOddsMap() const;
+
+    /**
+     * @brief Gets the underlying log-odds map, for persistence of its dirty tiles.
+     *
+     * @return BasicMap<Cell>& The log-odds cells.
+     */
+    BasicMap<Cell>& getLogOddsMap();
+
+    /**
+     * @brief Saves the log-odds cells to a binary map file.
+     *
+     * @param filename The file to create; an existing file is truncated.
+     * @param info World placement stored in the file.
+     * @return bool True if the file was written.
+     */
+    bool saveFile(const std::string& filename, const MapFileInfo& info = MapFileInfo()) const;
+
+    /**
+     * @brief Loads log-odds cells saved by saveFile().
+     *
+     * @param filename The file to read.
+     * @param info Receives the world placement stored in the file, or nullptr.
+     * @return bool True if the grid was loaded; on failure it is left unchanged.
+     */
+    bool loadFile(const std::string& filename, MapFileInfo* info = nullptr);
+};
+
+typedef BasicOccupancyGrid<std::int16_t> OccupancyGrid; ///< Default occupancy grid used by the Mapper
+
+#endif // OCCUPANCYGRID_H
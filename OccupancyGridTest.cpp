@@ -0,0 +1,94 @@
+/**
+ * @file OccupancyGridTest.cpp
+ * @brief Test file for the OccupancyGrid class.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include "OccupancyGrid.h"
+
+/**
+ * @brief Main function to test the OccupancyGrid class.
+ *
+ * This function performs various tests on the OccupancyGrid class:
+ * - Traces a beam and checks the free cells along it and the hit cell at its end.
+ * - Checks that the origin cell is updated once as free, inside the grid and on a
+ *   beam leaving it, and that a zero-length beam only updates its end cell.
+ * - Traces a beam through a previous hit and checks that the obstacle is cleared.
+ * - Checks saturation at the clamp limits with an int8_t grid.
+ * - Traces a beam that leaves the grid.
+ * - Benchmarks tracing a full 360-beam scan.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- OccupancyGrid Test Start -----\n";
+
+    // 1. Free cells along the ray, hit at the end
+    OccupancyGrid grid(20, 20);
+    grid.traceRay(2, 2, 10, 6);
+    std::cout << "[Test] LogOdds(2,2) => " << grid.getLogOdds(2, 2)
+              << ", LogOdds(6,4) => " << grid.getLogOdds(6, 4)
+              << ", LogOdds(10,6) => " << grid.getLogOdds(10, 6)
+              << ", Grid(10,6) => " << grid.getGrid(10, 6) << "\n";
+
+    // 2. The origin cell is free, once per beam
+    OccupancyGrid origin(20, 20);
+    origin.traceRay(3, 3, 9, 3);
+    origin.traceRay(3, 3, 3, 9, false);
+    origin.traceRay(3, 3, 40, 3);
+    std::cout << "[Test] Origin after 3 beams => " << origin.getLogOdds(3, 3) << " (expected -9), next cell => "
+              << origin.getLogOdds(4, 3) << " (expected -6)\n";
+    origin.traceRay(12, 12, 12, 12);
+    std::cout << "[Test] Zero-length beam => " << origin.getLogOdds(12, 12) << " (expected 7)\n";
+
+    // 3. A dynamic obstacle is cleared by later beams passing through it
+    grid.traceRay(2, 6, 8, 6);
+    std::cout << "[Test] Obstacle at (8,6) => " << grid.getGrid(8, 6) << "\n";
+    for (int i = 0; i < 5; ++i) {
+        grid.traceRay(2, 6, 14, 6);
+    }
+    std::cout << "[Test] After beams through (8,6) => " << grid.getGrid(8, 6)
+              << ", p=" << grid.getProbability(8, 6) << "\n";
+
+    // 4. Saturation with int8_t cells
+    BasicOccupancyGrid<std::int8_t> small(5, 5, 60, 60, -100, 100);
+    for (int i = 0; i < 10; ++i) {
+        small.updateCell(1, 1, true);
+        small.updateCell(2, 2, false);
+    }
+    std::cout << "[Test] Saturated hit => " << small.getLogOdds(1, 1)
+              << ", saturated miss => " << small.getLogOdds(2, 2) << "\n";
+
+    // 5. Beam leaving the grid
+    grid.clearMap();
+    grid.traceRay(18, 10, 40, 10);
+    std::cout << "[Test] Beam leaving grid: LogOdds(19,10) => " << grid.getLogOdds(19, 10)
+              << ", Grid(40,10) => " << grid.getGrid(40, 10) << "\n";
+
+    // 6. Full-scan benchmark
+    using Clock = std::chrono::steady_clock;
+    const int beams = 360;
+    const int scans = 1000;
+    OccupancyGrid big(1000, 1000);
+    std::vector<int> endX(beams), endY(beams);
+    for (int i = 0; i < beams; ++i) {
+        double a = i * 3.14159265358979323846 / 180.0;
+        endX[i] = 500 + static_cast<int>(200 * std::cos(a));
+        endY[i] = 500 + static_cast<int>(200 * std::sin(a));
+    }
+    Clock::time_point t0 = Clock::now();
+    for (int s = 0; s < scans; ++s) {
+        for (int i = 0; i < beams; ++i) {
+            big.traceRay(500, 500, endX[i], endY[i]);
+        }
+    }
+    Clock::time_point t1 = Clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count() / scans;
+    std::cout << "[Bench] " << beams << "-beam scan, 200-cell beams: " << us << " us per scan\n";
+
+    std::cout << "----- OccupancyGrid Test Complete -----\n";
+    return 0;
+}
@@ -6,22 +6,35 @@
 #include "Record.h"
 #include <iostream>
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 /**
  * @brief Default constructor for the Record class.
  * 
  * Initializes the Record object with an empty file name.
  */
-Record::Record() : fileName("") {}
+Record::Record() : fileName(""), mappedData(nullptr), mappedSize(0), mappingHandle(nullptr) {}
 
 /**
  * @brief Destructor for the Record class.
  * 
- * Closes the file stream if it is open.
+ * Closes the file stream if it is open and releases the mapping, if any.
  */
 Record::~Record() {
     if (fileStream.is_open()) {
         fileStream.close();
     }
+    unmapFile();
 }
 
 /**
@@ -77,18 +90,173 @@ bool Record::readLine(std::string& line) {
 /**
  * @brief Writes a line to the file stream.
  * 
- * This function writes the provided line to the file stream.
+ * This function writes the provided line to the file stream. The line is
+ * buffered; call flush() or closeFile() to make sure it reaches the file.
  * 
  * @param line The line to write to the file.
  */
 void Record::writeLine(const std::string& line) {
     if (fileStream.is_open()) {
-        fileStream << line << std::endl;
+        fileStream << line << '\n';
     } else {
         std::cerr << "Write failed: file not open.\n";
     }
 }
 
+/**
+ * @brief Flushes buffered writes to the file.
+ * 
+ * @return bool Returns true if the stream is open and the flush succeeded, false otherwise.
+ */
+bool Record::flush() {
+    if (!fileStream.is_open()) {
+        return false;
+    }
+    fileStream.flush();
+    return static_cast<bool>(fileStream);
+}
+
+/**
+ * @brief Writes raw bytes to the file stream.
+ * 
+ * The file should be opened with std::ios::binary.
+ * 
+ * @param data Pointer to the bytes to write.
+ * @param size Number of bytes.
+ * @return bool Returns true if the bytes were written, false otherwise.
+ */
+bool Record::writeBytes(const void* data, std::size_t size) {
+    if (!fileStream.is_open()) {
+        std::cerr << "Write failed: file not open.\n";
+        return false;
+    }
+    fileStream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    return static_cast<bool>(fileStream);
+}
+
+/**
+ * @brief Flushes buffered writes and asks the operating system to write them to disk.
+ * 
+ * @return bool Returns true if the data was synced, false otherwise.
+ */
+bool Record::sync() {
+    if (!flush()) {
+        return false;
+    }
+    // The stream does not expose its handle; syncing any handle of the file is equivalent.
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    bool ok = FlushFileBuffers(file) != 0;
+    CloseHandle(file);
+#else
+    int fd = open(fileName.c_str(), O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = fsync(fd) == 0;
+    close(fd);
+#endif
+    return ok;
+}
+
+/**
+ * @brief Maps a file read-only into memory.
+ * 
+ * Any previous mapping is released first. The mapped bytes stay valid until
+ * unmapFile() is called or the Record is destroyed.
+ * 
+ * @param filename The name of the file to map.
+ * @return bool Returns true if the file is mapped, false otherwise. An empty file cannot be mapped.
+ */
+bool Record::mapFile(const std::string& filename) {
+    unmapFile();
+    fileName = filename;
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    // The mapping keeps the file open.
+    CloseHandle(file);
+    if (!mapping) {
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+    mappingHandle = mapping;
+    mappedData = static_cast<const char*>(view);
+    mappedSize = static_cast<std::size_t>(size.QuadPart);
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping keeps the file open.
+    close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    madvise(view, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+    mappedData = static_cast<const char*>(view);
+    mappedSize = static_cast<std::size_t>(info.st_size);
+#endif
+    return true;
+}
+
+/**
+ * @brief Releases the current mapping, if any.
+ */
+void Record::unmapFile() {
+    if (!mappedData) {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(mappedData);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+#else
+    munmap(const_cast<char*>(mappedData), mappedSize);
+#endif
+    mappedData = nullptr;
+    mappedSize = 0;
+    mappingHandle = nullptr;
+}
+
+/**
+ * @brief Gets the first byte of the mapped file.
+ * 
+ * @return const char* The mapped bytes, or nullptr if no file is mapped.
+ */
+const char* Record::getMappedData() const {
+    return mappedData;
+}
+
+/**
+ * @brief Gets the size of the mapped file.
+ * 
+ * @return std::size_t The size in bytes, or 0 if no file is mapped.
+ */
+std::size_t Record::getMappedSize() const {
+    return mappedSize;
+}
+
 /**
  * @brief Stream insertion operator for the Record class.
  * 
@@ -6,6 +6,7 @@
 #ifndef RECORD_H
 #define RECORD_H
 
+#include <cstddef>
 #include <fstream>
 #include <string>
 
@@ -14,11 +15,19 @@
  * @brief Manages file operations such as reading and writing lines.
  * 
  * This class provides methods to open, close, read from, and write to a file.
+ * A file can also be mapped read-only into memory, so binary logs can be read
+ * in place without copying.
  */
 class Record {
 private:
     std::fstream fileStream; ///< File stream for reading and writing
     std::string fileName; ///< Name of the file
+    const char* mappedData; ///< First byte of the mapped file, or nullptr
+    std::size_t mappedSize; ///< Size of the mapped file in bytes
+    void* mappingHandle; ///< Platform handle of the mapping (Windows only)
+
+    Record(const Record&);
+    Record& operator=(const Record&);
 
 public:
     /**
@@ -31,7 +40,7 @@ public:
     /**
      * @brief Destructor for the Record class.
      * 
-     * Closes the file stream if it is open.
+     * Closes the file stream if it is open and releases the mapping, if any.
      */
     ~Record();
 
@@ -71,12 +80,68 @@ public:
     /**
      * @brief Writes a line to the file stream.
      * 
-     * This function writes the provided line to the file stream.
+     * This function writes the provided line to the file stream. The line is
+     * buffered; call flush() or closeFile() to make sure it reaches the file.
      * 
      * @param line The line to write to the file.
      */
     void writeLine(const std::string& line);
 
+    /**
+     * @brief Flushes buffered writes to the file.
+     * 
+     * @return bool Returns true if the stream is open and the flush succeeded, false otherwise.
+     */
+    bool flush();
+
+    /**
+     * @brief Flushes buffered writes and asks the operating system to write them to disk.
+     * 
+     * @return bool Returns true if the data was synced, false otherwise.
+     */
+    bool sync();
+
+    /**
+     * @brief Writes raw bytes to the file stream.
+     * 
+     * The file should be opened with std::ios::binary.
+     * 
+     * @param data Pointer to the bytes to write.
+     * @param size Number of bytes.
+     * @return bool Returns true if the bytes were written, false otherwise.
+     */
+    bool writeBytes(const void* data, std::size_t size);
+
+    /**
+     * @brief Maps a file read-only into memory.
+     * 
+     * Any previous mapping is released first. The mapped bytes stay valid until
+     * unmapFile() is called or the Record is destroyed.
+     * 
+     * @param filename The name of the file to map.
+     * @return bool Returns true if the file is mapped, false otherwise. An empty file cannot be mapped.
+     */
+    bool mapFile(const std::string& filename);
+
+    /**
+     * @brief Releases the current mapping, if any.
+     */
+    void unmapFile();
+
+    /**
+     * @brief Gets the first byte of the mapped file.
+     * 
+     * @return const char* The mapped bytes, or nullptr if no file is mapped.
+     */
+    const char* getMappedData() const;
+
+    /**
+     * @brief Gets the size of the mapped file.
+     * 
+     * @return std::size_t The size in bytes, or 0 if no file is mapped.
+     */
+    std::size_t getMappedSize() const;
+
     /**
      * @brief Stream insertion operator for the Record class.
      * 
@@ -13,6 +13,7 @@
  * - Opens a file for writing and writes lines to it.
  * - Re-opens the file for reading and reads lines from it.
  * - Attempts to read from an unopened file to test edge cases.
+ * - Writes bytes to a binary file and maps it into memory.
  * 
  * @return int Returns 0 upon successful completion.
  */
@@ -47,6 +48,19 @@ int main() {
     bool readResult = recObj.readLine(dummy);
     std::cout << "[Test] Attempt to read from closed file => " << (readResult ? "Success" : "Fail") << "\n";
 
+    // 4. Binary write and memory mapping
+    if (recObj.openFile("testRecord.bin", std::ios::out | std::ios::binary)) {
+        const char bytes[] = "mapped";
+        recObj.writeBytes(bytes, 6);
+        recObj.closeFile();
+    }
+    if (recObj.mapFile("testRecord.bin")) {
+        std::cout << "[Test] Mapped " << recObj.getMappedSize() << " bytes => "
+                  << std::string(recObj.getMappedData(), recObj.getMappedSize()) << "\n";
+        recObj.unmapFile();
+    }
+    std::cout << "[Test] Map missing file => " << (recObj.mapFile("noSuchRecord.bin") ? "Success" : "Fail") << "\n";
+
     std::cout << "----- Record Test Complete -----\n";
     return 0;
 }
\ No newline at end of file
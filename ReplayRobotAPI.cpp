@@ -0,0 +1,333 @@
+/**
+ * @file ReplayRobotAPI.cpp
+ * @brief Implementation of the ReplayRobotAPI class.
+ */
+
+#include "ReplayRobotAPI.h"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief Constructs a replayer with no log.
+ *
+ * @param replayMode The replay mode.
+ */
+ReplayRobotAPI::ReplayRobotAPI(REPLAY_MODE replayMode) : mode(replayMode), lidarBeams(0), connected(false) {
+    reset();
+}
+
+/**
+ * @brief Constructs a replayer and opens a log.
+ *
+ * @param filename The log to replay.
+ * @param replayMode The replay mode.
+ */
+ReplayRobotAPI::ReplayRobotAPI(const std::string& filename, REPLAY_MODE replayMode)
+    : mode(replayMode), lidarBeams(0), connected(false)
+{
+    reset();
+    open(filename);
+}
+
+/**
+ * @brief Opens a log and moves to its start.
+ *
+ * @param filename The log to replay.
+ * @return bool True if the log was opened.
+ */
+bool ReplayRobotAPI::open(const std::string& filename) {
+    bool ok = log.open(filename);
+    lidarBeams = ok ? log.getLidarBeams() : 0;
+    reset();
+    return ok;
+}
+
+/**
+ * @brief Resets the replay state to before the first record.
+ */
+void ReplayRobotAPI::reset() {
+    for (int i = 0; i < 9; ++i) {
+        irRanges[i] = 0.0;
+    }
+    poseX = poseY = poseTh = 0.0;
+    scan = nullptr;
+    scanCount = 0;
+    currentTimestamp = 0;
+    log.rewind();
+    refill();
+}
+
+/**
+ * @brief Reads the record at the log position and restarts the replay clock from it.
+ */
+void ReplayRobotAPI::refill() {
+    hasPending = log.next(pending);
+    firstTimestamp = hasPending ? pending.timestampNs : 0;
+    startTime = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Sets the replay mode.
+ *
+ * @param replayMode The replay mode.
+ */
+void ReplayRobotAPI::setMode(REPLAY_MODE replayMode) {
+    mode = replayMode;
+}
+
+/**
+ * @brief Gets the replay mode.
+ *
+ * @return REPLAY_MODE The replay mode.
+ */
+REPLAY_MODE ReplayRobotAPI::getMode() const {
+    return mode;
+}
+
+/**
+ * @brief Connects to the replayed robot and starts the replay clock.
+ */
+void ReplayRobotAPI::connect() {
+    connected = true;
+    startTime = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Disconnects from the replayed robot.
+ */
+void ReplayRobotAPI::disconnect() {
+    connected = false;
+}
+
+/**
+ * @brief Ignored; the recorded session cannot be steered.
+ *
+ * @param dir The direction.
+ */
+void ReplayRobotAPI::move(DIRECTION dir) {
+    (void)dir;
+}
+
+/**
+ * @brief Ignored; the recorded session cannot be steered.
+ *
+ * @param dir The direction.
+ */
+void ReplayRobotAPI::rotate(DIRECTION dir) {
+    (void)dir;
+}
+
+/**
+ * @brief Ignored; the recorded session cannot be steered.
+ */
+void ReplayRobotAPI::stop() {
+}
+
+/**
+ * @brief Gets an IR range from the latest IR frame.
+ *
+ * @param i Sensor index from 0 to 8.
+ * @return double The distance in metres, or 0.0 for an invalid index or before the first frame.
+ */
+double ReplayRobotAPI::getIRRange(int i) {
+    sync();
+    if (i < 0 || i > 8) {
+        return 0.0;
+    }
+    return irRanges[i];
+}
+
+/**
+ * @brief Gets the latest recorded pose.
+ *
+ * @param X Receives the x position in metres.
+ * @param Y Receives the y position in metres.
+ * @param TH Receives the heading in radians.
+ */
+void ReplayRobotAPI::getXYTh(double& X, double& Y, double& TH) {
+    sync();
+    X = poseX;
+    Y = poseY;
+    TH = poseTh;
+}
+
+/**
+ * @brief Gets a Lidar scan.
+ *
+ * In REPLAY_FAST mode this first moves to the next recorded scan; at the end of the
+ * log the last scan is returned again. Beams missing from a short scan read as 0.
+ *
+ * @param ranges Output array of getLidarRangeNumber() ranges in metres.
+ */
+void ReplayRobotAPI::getLidarRange(float* ranges) {
+    if (mode == REPLAY_FAST) {
+        nextScan();
+    } else {
+        sync();
+    }
+    int copied = scan ? std::min(scanCount, lidarBeams) : 0;
+    if (copied > 0) {
+        std::memcpy(ranges, scan, copied * sizeof(float));
+    }
+    for (int i = copied; i < lidarBeams; ++i) {
+        ranges[i] = 0.0f;
+    }
+}
+
+/**
+ * @brief Gets the number of Lidar beams.
+ *
+ * @return int The number of beams recorded in the log header.
+ */
+int ReplayRobotAPI::getLidarRangeNumber() {
+    return lidarBeams;
+}
+
+/**
+ * @brief Applies a record to the current state.
+ *
+ * @param record The record.
+ */
+void ReplayRobotAPI::apply(const SensorRecordView& record) {
+    switch (record.type) {
+    case RECORD_IR:
+        if (record.size >= 9 * sizeof(double)) {
+            std::memcpy(irRanges, record.irRanges(), 9 * sizeof(double));
+        }
+        break;
+    case RECORD_LIDAR:
+        scan = record.lidarRanges();
+        scanCount = record.lidarCount();
+        break;
+    case RECORD_POSE:
+        if (record.size >= 3 * sizeof(double)) {
+            const double* pose = record.pose();
+            poseX = pose[0];
+            poseY = pose[1];
+            poseTh = pose[2];
+        }
+        break;
+    default:
+        // Unknown record types are skipped.
+        break;
+    }
+    currentTimestamp = record.timestampNs;
+}
+
+/**
+ * @brief Applies the next record.
+ *
+ * @return bool False at the end of the log.
+ */
+bool ReplayRobotAPI::step() {
+    if (!hasPending) {
+        return false;
+    }
+    apply(pending);
+    hasPending = log.next(pending);
+    return true;
+}
+
+/**
+ * @brief Applies records up to and including the next Lidar scan.
+ *
+ * @return bool False if the log ended before another scan.
+ */
+bool ReplayRobotAPI::nextScan() {
+    while (hasPending) {
+        bool isScan = pending.type == RECORD_LIDAR;
+        step();
+        if (isScan) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Applies every record with a timestamp up to the given time.
+ *
+ * @param timestampNs The time in the log's clock, in nanoseconds.
+ */
+void ReplayRobotAPI::advanceTo(std::uint64_t timestampNs) {
+    while (hasPending && pending.timestampNs <= timestampNs) {
+        step();
+    }
+}
+
+/**
+ * @brief In REPLAY_REALTIME mode, applies every record due at the elapsed wall time.
+ */
+void ReplayRobotAPI::sync() {
+    if (mode != REPLAY_REALTIME) {
+        return;
+    }
+    std::uint64_t elapsed = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime).count());
+    advanceTo(firstTimestamp + elapsed);
+}
+
+/**
+ * @brief Moves back to the start of the log.
+ */
+void ReplayRobotAPI::rewind() {
+    reset();
+}
+
+/**
+ * @brief Moves to the first record at or after a time in the log.
+ *
+ * The IR ranges, pose and scan are cleared and are filled again by the records
+ * that follow.
+ *
+ * @param timestampNs The time in the log's clock, in nanoseconds.
+ * @return bool False if the log ends before that time.
+ */
+bool ReplayRobotAPI::seekTime(std::uint64_t timestampNs) {
+    reset();
+    bool found = log.seekTime(timestampNs);
+    refill();
+    return found;
+}
+
+/**
+ * @brief Moves to a Lidar scan by its number in the log.
+ *
+ * The IR ranges, pose and scan are cleared; the next nextScan() applies the scan.
+ *
+ * @param number The scan number, counting from 0.
+ * @return bool False if the log has fewer scans.
+ */
+bool ReplayRobotAPI::seekScan(std::uint64_t number) {
+    reset();
+    bool found = log.seekScan(number);
+    refill();
+    return found;
+}
+
+/**
+ * @brief Checks whether every record has been applied.
+ *
+ * @return bool True at the end of the log.
+ */
+bool ReplayRobotAPI::isFinished() const {
+    return !hasPending;
+}
+
+/**
+ * @brief Gets the timestamp of the last applied record.
+ *
+ * @return std::uint64_t The time in nanoseconds, or 0 before the first record.
+ */
+std::uint64_t ReplayRobotAPI::getTime() const {
+    return currentTimestamp;
+}
+
+/**
+ * @brief Gets the latest scan without copying it.
+ *
+ * @return const float* The ranges inside the mapping, or nullptr before the first scan.
+ */
+const float* ReplayRobotAPI::getScanData() const {
+    return scan;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file ReplayRobotAPI.h
+ * @brief Declaration of the ReplayRobotAPI class.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "Direction.h"
+#include "SensorLog.h"
+
+/**
+ * @enum REPLAY_MODE
+ * @brief How a ReplayRobotAPI moves through its log.
+ */
+enum REPLAY_MODE {
+    REPLAY_FAST, ///< Every getLidarRange() call moves to the next recorded scan
+    REPLAY_REALTIME ///< Reads return the data recorded at the wall time elapsed since connect()
+};
+
+/**
+ * @class ReplayRobotAPI
+ * @brief Robot backend that plays back a recorded sensor log.
+ *
+ * The class offers the same methods as FestoRobotAPI. The log is memory-mapped when it
+ * is opened, so replay does no file I/O afterwards and scans are served straight from
+ * the mapping. IR, pose and Lidar readings return the most recent record of each type
+ * at the current replay position. Motion commands are accepted and ignored, since the
+ * recorded session cannot react to them.
+ */
+class ReplayRobotAPI {
+private:
+    SensorLogReader log; ///< Mapped log
+    REPLAY_MODE mode; ///< Replay mode
+    double irRanges[9]; ///< Latest IR frame
+    double poseX; ///< Latest x position in metres
+    double poseY; ///< Latest y position in metres
+    double poseTh; ///< Latest heading in radians
+    const float* scan; ///< Latest scan, inside the mapping, or nullptr
+    int scanCount; ///< Number of ranges in the latest scan
+    int lidarBeams; ///< Number of beams in a full scan
+    SensorRecordView pending; ///< Next record, read but not applied yet
+    bool hasPending; ///< Whether pending holds a record
+    std::uint64_t firstTimestamp; ///< Timestamp of the first record
+    std::uint64_t currentTimestamp; ///< Timestamp of the last applied record
+    std::chrono::steady_clock::time_point startTime; ///< Wall time of connect()
+    bool connected; ///< Whether connect() has been called
+
+    /**
+     * @brief Applies a record to the current state.
+     *
+     * @param record The record.
+     */
+    void apply(const SensorRecordView& record);
+
+    /**
+     * @brief In REPLAY_REALTIME mode, applies every record due at the elapsed wall time.
+     */
+    void sync();
+
+    /**
+     * @brief Resets the replay state to before the first record.
+     */
+    void reset();
+
+    /**
+     * @brief Reads the record at the log position and restarts the replay clock from it.
+     */
+    void refill();
+
+public:
+    /**
+     * @brief Constructs a replayer with no log.
+     *
+     * @param replayMode The replay mode.
+     */
+    ReplayRobotAPI(REPLAY_MODE replayMode = REPLAY_FAST);
+
+    /**
+     * @brief Constructs a replayer and opens a log.
+     *
+     * @param filename The log to replay.
+     * @param replayMode The replay mode.
+     */
+    ReplayRobotAPI(const std::string& filename, REPLAY_MODE replayMode = REPLAY_FAST);
+
+    /**
+     * @brief Opens a log and moves to its start.
+     *
+     * @param filename The log to replay.
+     * @return bool True if the log was opened.
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Sets the replay mode.
+     *
+     * @param replayMode The replay mode.
+     */
+    void setMode(REPLAY_MODE replayMode);
+
+    /**
+     * @brief Gets the replay mode.
+     *
+     * @return REPLAY_MODE The replay mode.
+     */
+    REPLAY_MODE getMode() const;
+
+    /**
+     * @brief Connects to the replayed robot and starts the replay clock.
+     */
+    void connect();
+
+    /**
+     * @brief Disconnects from the replayed robot.
+     */
+    void disconnect();
+
+    /**
+     * @brief Ignored; the recorded session cannot be steered.
+     *
+     * @param dir The direction.
+     */
+    void move(DIRECTION dir);
+
+    /**
+     * @brief Ignored; the recorded session cannot be steered.
+     *
+     * @param dir The direction.
+     */
+    void rotate(DIRECTION dir);
+
+    /**
+     * @brief Ignored; the recorded session cannot be steered.
+     */
+    void stop();
+
+    /**
+     * @brief Gets an IR range from the latest IR frame.
+     *
+     * @param i Sensor index from 0 to 8.
+     * @return double The distance in metres, or 0.0 for an invalid index or before the first frame.
+     */
+    double getIRRange(int i);
+
+    /**
+     * @brief Gets the latest recorded pose.
+     *
+     * @param X Receives the x position in metres.
+     * @param Y Receives the y position in metres.
+     * @param TH Receives the heading in radians.
+     */
+    void getXYTh(double& X, double& Y, double& TH);
+
+    /**
+     * @brief Gets a Lidar scan.
+     *
+     * In REPLAY_FAST mode this first moves to the next recorded scan; at the end of the
+     * log the last scan is returned again. Beams missing from a short scan read as 0.
+     *
+     * @param ranges Output array of getLidarRangeNumber() ranges in metres.
+     */
+    void getLidarRange(float* ranges);
+
+    /**
+     * @brief Gets the number of Lidar beams.
+     *
+     * @return int The number of beams recorded in the log header.
+     */
+    int getLidarRangeNumber();
+
+    /**
+     * @brief Applies the next record.
+     *
+     * @return bool False at the end of the log.
+     */
+    bool step();
+
+    /**
+     * @brief Applies records up to and including the next Lidar scan.
+     *
+     * @return bool False if the log ended before another scan.
+     */
+    bool nextScan();
+
+    /**
+     * @brief Applies every record with a timestamp up to the given time.
+     *
+     * @param timestampNs The time in the log's clock, in nanoseconds.
+     */
+    void advanceTo(std::uint64_t timestampNs);
+
+    /**
+     * @brief Moves back to the start of the log.
+     */
+    void rewind();
+
+    /**
+     * @brief Moves to the first record at or after a time in the log.
+     *
+     * @param timestampNs The time in the log's clock, in nanoseconds.
+     * @return bool False if the log ends before that time.
+     */
+    bool seekTime(std::uint64_t timestampNs);
+
+    /**
+     * @brief Moves to a Lidar scan by its number in the log.
+     *
+     * @param number The scan number, counting from 0.
+     * @return bool False if the log has fewer scans.
+     */
+    bool seekScan(std::uint64_t number);
+
+    /**
+     * @brief Checks whether every record has been applied.
+     *
+     * @return bool True at the end of the log.
+     */
+    bool isFinished() const;
+
+    /**
+     * @brief Gets the timestamp of the last applied record.
+     *
+     * @return std::uint64_t The time in nanoseconds, or 0 before the first record.
+     */
+    std::uint64_t getTime() const;
+
+    /**
+     * @brief Gets the latest scan without copying it.
+     *
+     * @return const float* The ranges inside the mapping, or nullptr before the first scan.
+     */
+    const float* getScanData() const;
+};
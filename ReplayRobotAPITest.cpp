@@ -0,0 +1,141 @@
+/**
+ * @file ReplayRobotAPITest.cpp
+ * @brief Test file for the ReplayRobotAPI class.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include "ReplayRobotAPI.h"
+#include "SimulatedRobotAPI.h"
+#include "LidarSensor.h"
+#include "IRSensor.h"
+#include "Mapper.h"
+
+/**
+ * @brief Records a simulated session into a sensor log.
+ *
+ * Steps the simulator at 100 Hz and logs the pose and IR frame at 50 Hz and a
+ * Lidar scan at 10 Hz, stamped with the simulated time.
+ *
+ * @param filename The log to create.
+ * @param seconds Simulated duration.
+ * @return std::uint64_t Number of records written.
+ */
+std::uint64_t recordSession(const std::string& filename, double seconds) {
+    Map room(200, 200);
+    for (int i = 0; i < 200; ++i) {
+        room.setGrid(i, 0, 1);
+        room.setGrid(i, 199, 1);
+        room.setGrid(0, i, 1);
+        room.setGrid(199, i, 1);
+    }
+    SimulatedRobotAPI sim(room, 0.05);
+    sim.setPose(5.0, 5.0, 0.0);
+    SensorLogWriter writer;
+    writer.open(filename, sim.getLidarRangeNumber());
+    std::vector<float> scan(sim.getLidarRangeNumber());
+    double ir[9];
+    int steps = static_cast<int>(seconds * 100.0 + 0.5);
+    for (int s = 0; s < steps; ++s) {
+        if (s % 400 == 0) {
+            sim.rotate(LEFT);
+        } else if (s % 400 == 100) {
+            sim.move(FORWARD);
+        } else if (s % 400 == 250) {
+            sim.move(BACKWARD);
+        }
+        sim.step();
+        std::uint64_t ts = static_cast<std::uint64_t>(std::llround(sim.getSimTime() * 1e9));
+        if (s % 2 == 0) {
+            double x, y, th;
+            sim.getXYTh(x, y, th);
+            writer.writePose(ts, x, y, th);
+            for (int i = 0; i < 9; ++i) {
+                ir[i] = sim.getIRRange(i);
+            }
+            writer.writeIR(ts, ir);
+        }
+        if (s % 10 == 9) {
+            sim.getLidarRange(scan.data());
+            writer.writeLidar(ts, scan.data(), static_cast<int>(scan.size()));
+        }
+    }
+    writer.close();
+    return writer.getRecordCount();
+}
+
+/**
+ * @brief Main function to test the ReplayRobotAPI class.
+ *
+ * This function performs various tests on the ReplayRobotAPI class:
+ * - Records ten simulated minutes and replays them as fast as possible into a Mapper.
+ * - Checks that sensors bound to the replayer see the recorded data.
+ * - Rewinds and replays at recorded speed.
+ * - Seeks to a time and to a scan number.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- ReplayRobotAPI Test Start -----\n";
+    using Clock = std::chrono::steady_clock;
+
+    // 1. Record
+    Clock::time_point t0 = Clock::now();
+    std::uint64_t records = recordSession("testReplay.bin", 600.0);
+    std::cout << "[Test] Recorded " << records << " records in "
+              << std::chrono::duration<double>(Clock::now() - t0).count() << " s\n";
+
+    // 2. Fast replay into the mapper
+    ReplayRobotAPI replay("testReplay.bin", REPLAY_FAST);
+    replay.connect();
+    BasicLidarSensor<ReplayRobotAPI> lidar(&replay);
+    BasicIRSensor<ReplayRobotAPI> ir(&replay);
+    Mapper mapper(200, 200);
+    mapper.setResolution(0.05);
+    mapper.setMode(MAP_LOG_ODDS);
+    const double step = 2.0 * 3.14159265358979323846 / lidar.getRangeNumber();
+    int scans = 0;
+    t0 = Clock::now();
+    while (!replay.isFinished()) {
+        lidar.update();
+        ir.update();
+        double x, y, th;
+        replay.getXYTh(x, y, th);
+        ScanView view = lidar.getScan();
+        mapper.updateMap(Pose(x, y, th), view.data(), view.size(), 0.0, step);
+        ++scans;
+    }
+    double wall = std::chrono::duration<double>(Clock::now() - t0).count();
+    std::cout << "[Test] Replayed " << scans << " scans (6000), log time " << replay.getTime() / 1e9 << " s\n";
+    std::cout << "[Test] Last IR front => " << ir[0] << ", scan zero-copy => "
+              << (replay.getScanData() != nullptr) << "\n";
+    std::cout << "[Test] Wall cell after mapping => " << mapper.getCell(0, 100) << ", free cell => "
+              << mapper.getCell(100, 100) << "\n";
+    std::cout << "[Bench] 600 s of log mapped in " << wall << " s (" << 600.0 / wall << "x real time)\n";
+
+    // 3. Recorded speed: about 0.3 s of log in 0.3 s of wall time
+    replay.rewind();
+    replay.setMode(REPLAY_REALTIME);
+    replay.connect();
+    t0 = Clock::now();
+    while (std::chrono::duration<double>(Clock::now() - t0).count() < 0.3) {
+        lidar.update();
+    }
+    std::cout << "[Test] Real-time replay after 0.3 s wall => log time " << replay.getTime() / 1e9 << " s\n";
+
+    // 4. Jumping into the log
+    replay.setMode(REPLAY_FAST);
+    replay.seekTime(300000000000ULL);
+    replay.nextScan();
+    std::cout << "[Test] Seek to 300 s, next scan at => " << replay.getTime() / 1e9 << " s (300)\n";
+    replay.seekScan(4999);
+    replay.nextScan();
+    std::cout << "[Test] Seek to scan 4999, next scan at => " << replay.getTime() / 1e9 << " s (500)\n";
+    std::cout << "[Test] Seek past the end => " << replay.seekTime(700000000000ULL) << ", finished => "
+              << replay.isFinished() << "\n";
+
+    std::cout << "----- ReplayRobotAPI Test Complete -----\n";
+    return 0;
+}
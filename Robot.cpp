@@ -8,9 +8,9 @@
 /**
  * @brief Constructs a Robot object.
  * 
- * Initializes the Robot object by creating instances of FestoRobotAPI and RobotControler.
+ * Initializes the Robot object by creating the backend selected at compile time (see RobotApi) and a RobotControler.
  */
 Robot::Robot() {
-    robotAPI = new FestoRobotAPI();
+    robotAPI = createRobotApi();
     robotControler = new RobotControler(robotAPI);
 }
\ No newline at end of file
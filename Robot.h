@@ -6,7 +6,7 @@
 #pragma once
 
 #include "RobotControler.h"
-#include "FestoRobotAPI.h"
+#include "RobotBackend.h"
 #include "IRSensor.h"
 #include "LidarSensor.h"
 
@@ -18,13 +18,13 @@
  */
 class Robot {
 public:
-    FestoRobotAPI* robotAPI; ///< Pointer to the robot's API interface
+    RobotApi* robotAPI; ///< Pointer to the robot's API interface
     RobotControler* robotControler; ///< Pointer to the robot's control mechanism
 
     /**
      * @brief Constructs a Robot object.
      * 
-     * Initializes the Robot object by creating instances of FestoRobotAPI and RobotControler.
+     * Initializes the Robot object by creating the backend selected at compile time (see RobotApi) and a RobotControler.
      */
     Robot();
 };
\ No newline at end of file
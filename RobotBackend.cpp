@@ -0,0 +1,24 @@
+/**
+ * @file RobotBackend.cpp
+ * @brief Implementation of the backend factory.
+ */
+
+#include "RobotBackend.h"
+
+/**
+ * @brief Creates the default backend of the selected RobotApi type.
+ *
+ * With ROBOT_BACKEND_DYNAMIC this wraps the platform's default backend in an owning
+ * RobotBackendAdapter.
+ *
+ * @return RobotApi* A new backend owned by the caller.
+ */
+RobotApi* createRobotApi() {
+#if defined(ROBOT_BACKEND_DYNAMIC) && defined(_WIN32)
+    return new RobotBackendAdapter<FestoRobotAPI>(new FestoRobotAPI(), true);
+#elif defined(ROBOT_BACKEND_DYNAMIC)
+    return new RobotBackendAdapter<SimulatedRobotAPI>(new SimulatedRobotAPI(), true);
+#else
+    return new RobotApi();
+#endif
+}
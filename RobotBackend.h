@@ -0,0 +1,159 @@
+/**
+ * @file RobotBackend.h
+ * @brief Declaration of the RobotBackend interface and backend selection.
+ */
+
+#pragma once
+
+#include "SimulatedRobotAPI.h"
+
+/**
+ * @class RobotBackend
+ * @brief Runtime interface of a robot backend.
+ *
+ * Declares the FestoRobotAPI methods as virtual functions so that the real robot, the
+ * simulator, a log replayer or a test stub can be chosen at runtime. Code that knows its
+ * backend at compile time should use the backend class directly as the Api parameter of
+ * the sensor templates instead, which avoids virtual dispatch.
+ */
+class RobotBackend {
+public:
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~RobotBackend() {}
+
+    /**
+     * @brief Connects to the robot.
+     */
+    virtual void connect() = 0;
+
+    /**
+     * @brief Disconnects from the robot.
+     */
+    virtual void disconnect() = 0;
+
+    /**
+     * @brief Moves the robot.
+     *
+     * @param dir One of FORWARD, BACKWARD, LEFT or RIGHT.
+     */
+    virtual void move(DIRECTION dir) = 0;
+
+    /**
+     * @brief Rotates the robot.
+     *
+     * @param dir LEFT or RIGHT.
+     */
+    virtual void rotate(DIRECTION dir) = 0;
+
+    /**
+     * @brief Stops the robot.
+     */
+    virtual void stop() = 0;
+
+    /**
+     * @brief Gets an IR range.
+     *
+     * @param i Sensor index from 0 to 8.
+     * @return double The distance in metres.
+     */
+    virtual double getIRRange(int i) = 0;
+
+    /**
+     * @brief Gets the robot pose.
+     *
+     * @param X Receives the x position in metres.
+     * @param Y Receives the y position in metres.
+     * @param TH Receives the heading in radians.
+     */
+    virtual void getXYTh(double& X, double& Y, double& TH) = 0;
+
+    /**
+     * @brief Gets a full Lidar scan.
+     *
+     * @param ranges Output array of getLidarRangeNumber() ranges.
+     */
+    virtual void getLidarRange(float* ranges) = 0;
+
+    /**
+     * @brief Gets the number of Lidar beams.
+     *
+     * @return int The number of beams.
+     */
+    virtual int getLidarRangeNumber() = 0;
+};
+
+/**
+ * @class RobotBackendAdapter
+ * @brief Exposes any class with the FestoRobotAPI methods as a RobotBackend.
+ */
+template <typename Api>
+class RobotBackendAdapter : public RobotBackend {
+private:
+    Api* api; ///< Wrapped backend
+    bool owned; ///< Whether the adapter deletes the backend
+
+    RobotBackendAdapter(const RobotBackendAdapter&);
+    RobotBackendAdapter& operator=(const RobotBackendAdapter&);
+
+public:
+    /**
+     * @brief Wraps a backend.
+     *
+     * @param backend The backend to forward calls to.
+     * @param takeOwnership Whether the adapter deletes the backend when destroyed.
+     */
+    RobotBackendAdapter(Api* backend, bool takeOwnership = false) : api(backend), owned(takeOwnership) {}
+
+    /**
+     * @brief Destructor. Deletes the backend if owned.
+     */
+    ~RobotBackendAdapter() {
+        if (owned) {
+            delete api;
+        }
+    }
+
+    /**
+     * @brief Gets the wrapped backend.
+     *
+     * @return Api* The backend.
+     */
+    Api* get() const { return api; }
+
+    void connect() { api->connect(); }
+    void disconnect() { api->disconnect(); }
+    void move(DIRECTION dir) { api->move(dir); }
+    void rotate(DIRECTION dir) { api->rotate(dir); }
+    void stop() { api->stop(); }
+    double getIRRange(int i) { return api->getIRRange(i); }
+    void getXYTh(double& X, double& Y, double& TH) { api->getXYTh(X, Y, TH); }
+    void getLidarRange(float* ranges) { api->getLidarRange(ranges); }
+    int getLidarRangeNumber() { return api->getLidarRangeNumber(); }
+};
+
+/*
+ * Compile-time backend selection. RobotApi is the backend type held by RobotControler,
+ * Robot, SensorAcquisition and the default IRSensor/LidarSensor types:
+ *   ROBOT_BACKEND_DYNAMIC   - RobotBackend, chosen at runtime through virtual calls
+ *   ROBOT_BACKEND_SIMULATED - SimulatedRobotAPI
+ *   otherwise               - FestoRobotAPI on Windows, SimulatedRobotAPI elsewhere
+ */
+#if defined(ROBOT_BACKEND_DYNAMIC)
+typedef RobotBackend RobotApi;
+#elif defined(ROBOT_BACKEND_SIMULATED) || !defined(_WIN32)
+typedef SimulatedRobotAPI RobotApi;
+#else
+typedef FestoRobotAPI RobotApi;
+#endif
+
+/**
+ * @brief Creates the default backend of the selected RobotApi type.
+ *
+ * With ROBOT_BACKEND_DYNAMIC this wraps the platform's default backend in an owning
+ * RobotBackendAdapter.
+ *
+ * @return RobotApi* A new backend owned by the caller.
+ */
+RobotApi* createRobotApi();
@@ -0,0 +1,132 @@
+/**
+ * @file RobotBackendTest.cpp
+ * @brief Test file for the RobotBackend interface and the backend-parameterized sensors.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <limits>
+#include "RobotBackend.h"
+#include "IRSensor.h"
+#include "LidarSensor.h"
+
+/**
+ * @class FaultyBackend
+ * @brief Test stub that forwards to another backend and drops every n-th Lidar beam.
+ */
+class FaultyBackend : public RobotBackend {
+private:
+    RobotBackend* inner; ///< Backend the calls are forwarded to
+    int dropEvery; ///< A beam out of every dropEvery reads as NaN
+
+public:
+    FaultyBackend(RobotBackend* backend, int drop) : inner(backend), dropEvery(drop) {}
+
+    void connect() { inner->connect(); }
+    void disconnect() { inner->disconnect(); }
+    void move(DIRECTION dir) { inner->move(dir); }
+    void rotate(DIRECTION dir) { inner->rotate(dir); }
+    void stop() { inner->stop(); }
+    double getIRRange(int i) { return i == 0 ? 0.0 : inner->getIRRange(i); }
+    void getXYTh(double& X, double& Y, double& TH) { inner->getXYTh(X, Y, TH); }
+    int getLidarRangeNumber() { return inner->getLidarRangeNumber(); }
+    void getLidarRange(float* ranges) {
+        inner->getLidarRange(ranges);
+        for (int i = 0; i < getLidarRangeNumber(); i += dropEvery) {
+            ranges[i] = std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+};
+
+/**
+ * @brief Times repeated update() calls of a sensor.
+ *
+ * @param sensor The sensor to update.
+ * @param iterations Number of updates.
+ * @return double Nanoseconds per update.
+ */
+template <typename Sensor>
+double timeUpdates(Sensor& sensor, int iterations) {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sensor.update();
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / iterations;
+}
+
+/**
+ * @brief Main function to test the RobotBackend interface.
+ *
+ * This function performs various tests:
+ * - Reads the same simulated scene through a statically bound and a runtime bound sensor.
+ * - Swaps in a fault-injecting stub without changing the sensor code.
+ * - Compares the cost of static and virtual dispatch on the IR and Lidar read paths.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- RobotBackend Test Start -----\n";
+
+    // 1. Same readings through both bindings
+    Map room(100, 100);
+    for (int i = 0; i < 100; ++i) {
+        room.setGrid(i, 0, 1);
+        room.setGrid(i, 99, 1);
+        room.setGrid(0, i, 1);
+        room.setGrid(99, i, 1);
+    }
+    SimulatedRobotAPI sim(room, 0.05);
+    sim.setPose(2.5, 2.5, 0.0);
+    RobotBackendAdapter<SimulatedRobotAPI> adapter(&sim);
+
+    BasicIRSensor<SimulatedRobotAPI> staticIR(&sim);
+    BasicIRSensor<RobotBackend> dynamicIR(&adapter);
+    staticIR.update();
+    dynamicIR.update();
+    bool same = true;
+    for (int i = 0; i < 9; ++i) {
+        same = same && staticIR[i] == dynamicIR[i];
+    }
+    std::cout << "[Test] IR static == dynamic => " << same << "\n";
+
+    BasicLidarSensor<SimulatedRobotAPI> staticLidar(&sim);
+    BasicLidarSensor<RobotBackend> dynamicLidar(&adapter);
+    staticLidar.update();
+    dynamicLidar.update();
+    same = staticLidar.getRangeNumber() == dynamicLidar.getRangeNumber();
+    for (int i = 0; same && i < staticLidar.getRangeNumber(); ++i) {
+        same = staticLidar[i] == dynamicLidar[i];
+    }
+    std::cout << "[Test] Lidar static == dynamic => " << same << "\n";
+
+    // 2. Fault injection through the runtime interface
+    FaultyBackend faulty(&adapter, 7);
+    BasicLidarSensor<RobotBackend> faultyLidar(&faulty);
+    BasicIRSensor<RobotBackend> faultyIR(&faulty);
+    faultyLidar.update();
+    faultyIR.update();
+    int minIndex;
+    double minRange = faultyLidar.getMin(minIndex);
+    std::cout << "[Test] Faulty beam 0 => " << faultyLidar[0] << ", min => " << minRange
+              << " at " << minIndex << " (2.45)\n";
+    std::cout << "[Test] Faulty IR 0 => " << faultyIR[0] << "\n";
+
+    // 3. Static vs dynamic dispatch. Short maximum ranges keep the simulated ray casts
+    // cheap, so the measurement is dominated by the call path.
+    sim.setMaxRanges(0.05, 0.05);
+    const int iterations = 200000;
+    timeUpdates(staticIR, iterations / 10);
+    timeUpdates(dynamicIR, iterations / 10);
+    double irStatic = timeUpdates(staticIR, iterations);
+    double irDynamic = timeUpdates(dynamicIR, iterations);
+    std::cout << "[Bench] IR update (9 calls): static " << irStatic << " ns, dynamic " << irDynamic << " ns\n";
+
+    double lidarStatic = timeUpdates(staticLidar, iterations / 10);
+    double lidarDynamic = timeUpdates(dynamicLidar, iterations / 10);
+    std::cout << "[Bench] Lidar update (1 bulk call, 360 beams): static " << lidarStatic
+              << " ns, dynamic " << lidarDynamic << " ns\n";
+
+    std::cout << "----- RobotBackend Test Complete -----\n";
+    return 0;
+}
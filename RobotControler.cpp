@@ -19,11 +19,11 @@ RobotControler::RobotControler() : robotAPI(nullptr), position(new Pose()), conn
 /**
  * @brief Constructs a RobotControler object with a given API.
  * 
- * Initializes the RobotControler object with the provided FestoRobotAPI pointer.
+ * Initializes the RobotControler object with the provided backend pointer.
  * 
- * @param api Pointer to the FestoRobotAPI object.
+ * @param api Pointer to the backend object.
  */
-RobotControler::RobotControler(FestoRobotAPI* api)
+RobotControler::RobotControler(RobotApi* api)
     : robotAPI(api), connected(false)
 {
     position = new Pose();
@@ -33,12 +33,12 @@ RobotControler::RobotControler(FestoRobotAPI* api)
 /**
  * @brief Constructs a RobotControler object with a given API and initial pose.
  * 
- * Initializes the RobotControler object with the provided FestoRobotAPI pointer and initial pose.
+ * Initializes the RobotControler object with the provided backend pointer and initial pose.
  * 
- * @param api Pointer to the FestoRobotAPI object.
+ * @param api Pointer to the backend object.
  * @param initialPose The initial pose of the robot.
  */
-RobotControler::RobotControler(FestoRobotAPI* api, const Pose& initialPose)
+RobotControler::RobotControler(RobotApi* api, const Pose& initialPose)
     : robotAPI(api), connected(false)
 {
     position = new Pose(initialPose);
@@ -102,9 +102,37 @@ void RobotControler::moveForward() {
     }
 }
 
+/**
+ * @brief Moves the robot backward.
+ *
+ * This function sends a command to the robot API to move the robot backward.
+ */
+void RobotControler::moveBackward() {
+    if (connected) {
+        robotAPI->move(BACKWARD);
+        cout << "Moving backward.\n";
+    } else {
+        cout << "Not connected.\n";
+    }
+}
+
+/**
+ * @brief Moves the robot left.
+ *
+ * This function sends a command to the robot API to move the robot to the left.
+ */
+void RobotControler::moveLeft() {
+    if (connected) {
+        robotAPI->move(LEFT);
+        cout << "Moving left.\n";
+    } else {
+        cout << "Not connected.\n";
+    }
+}
+
 /**
  * @brief Moves the robot right.
- * 
+ *
  * This function sends a command to the robot API to move the robot to the right.
  */
 void RobotControler::moveRight() {
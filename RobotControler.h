@@ -6,7 +6,7 @@
 #pragma once
 #include <iostream>
 #include "Pose.h"
-#include "FestoRobotAPI.h"
+#include "RobotBackend.h"
 
 /**
  * @class RobotControler
@@ -16,7 +16,7 @@
  */
 class RobotControler {
 private:
-    FestoRobotAPI* robotAPI; ///< Pointer to the robot's API interface
+    RobotApi* robotAPI; ///< Pointer to the robot's API interface
     Pose* position; ///< Pointer to the robot's current position
     bool connected; ///< Connection status of the robot
 
@@ -31,21 +31,21 @@ public:
     /**
      * @brief Constructs a RobotControler object with a given API.
      * 
-     * Initializes the RobotControler object with the provided FestoRobotAPI pointer.
+     * Initializes the RobotControler object with the provided backend pointer.
      * 
-     * @param api Pointer to the FestoRobotAPI object.
+     * @param api Pointer to the backend object.
      */
-    RobotControler(FestoRobotAPI* api);
+    RobotControler(RobotApi* api);
 
     /**
      * @brief Constructs a RobotControler object with a given API and initial pose.
      * 
-     * Initializes the RobotControler object with the provided FestoRobotAPI pointer and initial pose.
+     * Initializes the RobotControler object with the provided backend pointer and initial pose.
      * 
-     * @param api Pointer to the FestoRobotAPI object.
+     * @param api Pointer to the backend object.
      * @param initialPose The initial pose of the robot.
      */
-    RobotControler(FestoRobotAPI* api, const Pose& initialPose);
+    RobotControler(RobotApi* api, const Pose& initialPose);
 
     /**
      * @brief Destructor for the RobotControler class.
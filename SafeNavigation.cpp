@@ -4,9 +4,10 @@
  */
 
 #include "SafeNavigation.h"
+#include <cmath>
 #include <iostream>
 
-#define THRESHOLD_DISTANCE 0.5 ///< Threshold distance for safe navigation
+#define THRESHOLD_DISTANCE 0.5 ///< Default threshold distance for safe navigation
 
 /**
  * @brief Constructs a SafeNavigation object.
@@ -17,18 +18,78 @@
  * @param ctrl Pointer to the RobotControler object.
  */
 SafeNavigation::SafeNavigation(IRSensor* sensor, RobotControler* ctrl)
-    : sensorModule(sensor), robotCtrl(ctrl), navState(NAV_STOP)
+    : sensorModule(sensor), robotCtrl(ctrl), navState(NAV_STOP), thresholdDistance(THRESHOLD_DISTANCE),
+      clearanceField(nullptr), mapFrame(nullptr), robotRadius(0.0)
 {
 }
 
+/**
+ * @brief Sets the distance at which the robot stops.
+ * 
+ * @param meters Distance in metres; values that are not positive are ignored.
+ */
+void SafeNavigation::setThresholdDistance(double meters) {
+    if (meters > 0.0) {
+        thresholdDistance = meters;
+    }
+}
+
+/**
+ * @brief Attaches a distance field of the map to check clearance along the motion.
+ * 
+ * @param field The distance field, or nullptr to detach it.
+ * @param mapper The mapper that converts the robot pose to map cells.
+ * @param radius Clearance the robot needs around its centre, in metres.
+ */
+void SafeNavigation::setClearanceMap(const DistanceField* field, const Mapper* mapper, double radius) {
+    clearanceField = field;
+    mapFrame = mapper;
+    robotRadius = radius > 0.0 ? radius : 0.0;
+}
+
+/**
+ * @brief Checks the map along the direction of motion.
+ * 
+ * Samples the line from the robot to the threshold distance ahead once per cell.
+ * 
+ * @param direction 1 for forward, -1 for backward.
+ * @return bool True if no distance field is attached, or every sampled cell keeps the
+ *         robot radius clear of obstacles.
+ */
+bool SafeNavigation::isMapClear(double direction) {
+    if (!clearanceField || !mapFrame || !robotCtrl) {
+        return true;
+    }
+    Pose pose = robotCtrl->getPose();
+    const double resolution = mapFrame->getResolution();
+    const float clearance = static_cast<float>(robotRadius / resolution);
+    const double stepX = direction * std::cos(pose.getTh()) * resolution;
+    const double stepY = direction * std::sin(pose.getTh()) * resolution;
+    const int steps = static_cast<int>(std::ceil(thresholdDistance / resolution));
+    for (int i = 1; i <= steps; ++i) {
+        int x = 0;
+        int y = 0;
+        mapFrame->worldToGrid(pose.getX() + i * stepX, pose.getY() + i * stepY, x, y);
+        if (!clearanceField->hasClearance(x, y, clearance)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * @brief Moves the robot forward safely.
  * 
  * This function checks the front IR sensor and moves the robot forward if the path is clear.
- * If an obstacle is detected within the threshold distance, the robot stops.
+ * If an obstacle is detected within the threshold distance, or there is no IR sensor,
+ * the robot stops. Without a robot controller nothing is commanded.
  */
 void SafeNavigation::moveForwardSafe() {
-    if (sensorModule->getRange(0) > THRESHOLD_DISTANCE) {
+    navState = NAV_STOP;
+    if (!robotCtrl) {
+        return;
+    }
+    if (sensorModule && sensorModule->getRange(0) > thresholdDistance && isMapClear(1.0)) {
         robotCtrl->moveForward();
         navState = NAV_MOVING;
         std::cout << "Safe forward motion started.\n";
@@ -43,10 +104,15 @@ void SafeNavigation::moveForwardSafe() {
  * @brief Moves the robot backward safely.
  * 
  * This function checks the rear IR sensor and moves the robot backward if the path is clear.
- * If an obstacle is detected within the threshold distance, the robot stops.
+ * If an obstacle is detected within the threshold distance, or there is no IR sensor,
+ * the robot stops. Without a robot controller nothing is commanded.
  */
 void SafeNavigation::moveBackwardSafe() {
-    if (sensorModule->getRange(1) > THRESHOLD_DISTANCE) {
+    navState = NAV_STOP;
+    if (!robotCtrl) {
+        return;
+    }
+    if (sensorModule && sensorModule->getRange(1) > thresholdDistance && isMapClear(-1.0)) {
         robotCtrl->moveBackward();
         navState = NAV_MOVING;
         std::cout << "Safe backward motion.\n";
@@ -55,4 +121,13 @@ void SafeNavigation::moveBackwardSafe() {
         navState = NAV_STOP;
         std::cout << "Obstacle behind, stopping.\n";
     }
+}
+
+/**
+ * @brief Gets the navigation state set by the last safe move.
+ * 
+ * @return SAFE_STATE NAV_MOVING if the last move was started, NAV_STOP otherwise.
+ */
+SAFE_STATE SafeNavigation::getState() const {
+    return navState;
 }
\ No newline at end of file
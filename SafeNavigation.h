@@ -7,6 +7,8 @@
 
 #include "IRSensor.h"
 #include "RobotControler.h"
+#include "DistanceField.h"
+#include "Mapper.h"
 
 /**
  * @enum SAFE_STATE
@@ -22,12 +24,27 @@ enum SAFE_STATE {
  * @brief Manages safe navigation for the robot using IR sensors.
  * 
  * This class provides methods to move the robot forward and backward safely by checking IR sensor readings.
+ * When a distance field of the map is attached, the stretch of map ahead of the robot must also
+ * leave room for the robot radius; each check is a constant-time lookup per cell.
  */
 class SafeNavigation {
 private:
     IRSensor* sensorModule; ///< Pointer to the IR sensor module
     RobotControler* robotCtrl; ///< Pointer to the robot controller
     SAFE_STATE navState; ///< Current navigation state of the robot
+    double thresholdDistance; ///< Distance to an obstacle at which the robot stops, in metres
+    const DistanceField* clearanceField; ///< Distance field of the map, or nullptr
+    const Mapper* mapFrame; ///< Mapper whose resolution and origin the field uses
+    double robotRadius; ///< Clearance the robot needs around its centre, in metres
+
+    /**
+     * @brief Checks the map along the direction of motion.
+     * 
+     * @param direction 1 for forward, -1 for backward.
+     * @return bool True if no distance field is attached, or every cell up to the threshold
+     *         distance along the direction keeps the robot radius clear of obstacles.
+     */
+    bool isMapClear(double direction);
 
 public:
     /**
@@ -40,11 +57,31 @@ public:
      */
     SafeNavigation(IRSensor* sensor, RobotControler* ctrl);
 
+    /**
+     * @brief Sets the distance at which the robot stops.
+     * 
+     * @param meters Distance in metres; values that are not positive are ignored.
+     */
+    void setThresholdDistance(double meters);
+
+    /**
+     * @brief Attaches a distance field of the map to check clearance along the motion.
+     * 
+     * The field must be computed from the local map of the mapper, and both must outlive
+     * this object or be detached with nullptr.
+     * 
+     * @param field The distance field, or nullptr to detach it.
+     * @param mapper The mapper that converts the robot pose to map cells.
+     * @param radius Clearance the robot needs around its centre, in metres.
+     */
+    void setClearanceMap(const DistanceField* field, const Mapper* mapper, double radius);
+
     /**
      * @brief Moves the robot forward safely.
      * 
      * This function checks the front IR sensor and moves the robot forward if the path is clear.
-     * If an obstacle is detected within the threshold distance, the robot stops.
+     * If an obstacle is detected within the threshold distance, or there is no IR sensor,
+     * the robot stops. Without a robot controller nothing is commanded.
      */
     void moveForwardSafe();
 
@@ -52,7 +89,15 @@ public:
      * @brief Moves the robot backward safely.
      * 
      * This function checks the rear IR sensor and moves the robot backward if the path is clear.
-     * If an obstacle is detected within the threshold distance, the robot stops.
+     * If an obstacle is detected within the threshold distance, or there is no IR sensor,
+     * the robot stops. Without a robot controller nothing is commanded.
      */
     void moveBackwardSafe();
+
+    /**
+     * @brief Gets the navigation state set by the last safe move.
+     * 
+     * @return SAFE_STATE NAV_MOVING if the last move was started, NAV_STOP otherwise.
+     */
+    SAFE_STATE getState() const;
 };
\ No newline at end of file
@@ -4,24 +4,34 @@
  */
 
 #include <iostream>
+#include <cmath>
 #include "SafeNavigation.h"
-#include "FestoRobotAPI.h"
+#include "DistanceField.h"
+#include "Mapper.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
 
 /**
  * @brief Main function to test the SafeNavigation class.
- * 
- * This function performs various tests on the SafeNavigation class:
+ *
+ * This function performs various tests on the SafeNavigation class, on the default
+ * backend of createRobotApi() (the simulator outside Windows):
  * - Sets up the necessary components (API, controller, IR sensor).
  * - Tests safe forward and backward movement.
+ * - Checks the map ahead through a distance field of the local map: the robot starts
+ *   moving while the map is clear, and does not start once an obstacle is mapped
+ *   ahead of it or behind it.
  * - Tests edge cases with missing IR sensor and robot controller.
- * 
+ *
  * @return int Returns 0 upon successful completion.
  */
 int main() {
     std::cout << "----- SafeNavigation Test Start -----\n";
 
     // 1. Setup
-    FestoRobotAPI* api = new FestoRobotAPI();
+    RobotApi* api = createRobotApi();
     RobotControler* ctrl = new RobotControler(api);
     IRSensor* ir = new IRSensor(api);
     SafeNavigation safeNav(ir, ctrl);
@@ -29,16 +39,59 @@ int main() {
     ctrl->connectRobot();
 
     // 2. Attempt safe forward/backward
+    ir->update();
+    safeNav.moveForwardSafe();
+    safeNav.moveBackwardSafe();
+    ctrl->stop();
+    ctrl->disconnectRobot();
+
+    // 3. Clearance from the local map: 2 m x 2 m around the robot, obstacles 0.3 m away
+    ctrl->connectRobot();
+    ir->update();
+    Pose pose = ctrl->getPose();
+    Mapper mapper(40, 40);
+    mapper.setResolution(0.05);
+    mapper.setOrigin(pose.getX() - 1.0, pose.getY() - 1.0);
+    DistanceField field;
+    field.compute(mapper.getLocalMap());
+    safeNav.setThresholdDistance(0.5);
+    safeNav.setClearanceMap(&field, &mapper, 0.1);
     safeNav.moveForwardSafe();
+    SAFE_STATE clearForward = safeNav.getState();
     safeNav.moveBackwardSafe();
+    SAFE_STATE clearBackward = safeNav.getState();
+    ctrl->stop();
+    std::cout << "[Test] Clear map: forward moving => " << (clearForward == NAV_MOVING) << ", backward moving => "
+              << (clearBackward == NAV_MOVING) << "\n";
+
+    const float obstacle = 0.3f;
+    mapper.updateMap(pose, &obstacle, 1, 0.0, 0.0);
+    field.compute(mapper.getLocalMap());
+    safeNav.moveForwardSafe();
+    SAFE_STATE blockedForward = safeNav.getState();
+    safeNav.moveBackwardSafe();
+    SAFE_STATE stillBackward = safeNav.getState();
+    ctrl->stop();
+    std::cout << "[Test] Obstacle ahead: forward stopped => " << (blockedForward == NAV_STOP)
+              << ", backward moving => " << (stillBackward == NAV_MOVING) << "\n";
+
+    mapper.updateMap(pose, &obstacle, 1, M_PI, 0.0);
+    field.compute(mapper.getLocalMap());
+    safeNav.moveBackwardSafe();
+    SAFE_STATE blockedBackward = safeNav.getState();
+    safeNav.moveForwardSafe();
+    std::cout << "[Test] Obstacle behind: backward stopped => " << (blockedBackward == NAV_STOP)
+              << ", forward stopped => " << (safeNav.getState() == NAV_STOP) << "\n";
     ctrl->stop();
     ctrl->disconnectRobot();
+    safeNav.setClearanceMap(nullptr, nullptr, 0.0);
 
-    // 3. Edge cases: 
+    // 4. Edge cases:
     // - No IRSensor
     SafeNavigation safeNav2(nullptr, ctrl);
     safeNav2.moveForwardSafe();
     safeNav2.moveBackwardSafe();
+    std::cout << "[Test] No IR sensor: stopped => " << (safeNav2.getState() == NAV_STOP) << "\n";
     ctrl->stop();
     ctrl->disconnectRobot();
 
@@ -46,9 +99,13 @@ int main() {
     SafeNavigation safeNav3(ir, nullptr);
     safeNav3.moveForwardSafe();
     safeNav3.moveBackwardSafe();
+    std::cout << "[Test] No controller: stopped => " << (safeNav3.getState() == NAV_STOP) << "\n";
     ctrl->stop();
     ctrl->disconnectRobot();
 
+    delete ir;
+    delete ctrl;
+    delete api;
     std::cout << "----- SafeNavigation Test Complete -----\n";
     return 0;
-}
\ No newline at end of file
+}
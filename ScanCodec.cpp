@@ -0,0 +1,532 @@
+/**
+ * @file ScanCodec.cpp
+ * @brief Implementation of the ScanEncoder and ScanDecoder classes.
+ *
+ * A frame is a flags byte, the varint size of the stored residual bytes, the varint
+ * size before the LZ stage when FRAME_LZ is set, and the residual bytes.
+ */
+
+#include "ScanCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const unsigned char FRAME_INTER = 1; ///< Residuals against the previous scan
+const unsigned char FRAME_BITPACK = 2; ///< Residuals bit-packed rather than varints
+const unsigned char FRAME_LZ = 4; ///< Residual bytes went through the LZ stage
+const unsigned char FRAME_KNOWN = FRAME_INTER | FRAME_BITPACK | FRAME_LZ;
+
+const int BLOCK_SIZE = 32; ///< Values per bit-packed block
+const std::int32_t MAX_MILLIMETRES = (1 << 30) - 1; ///< Keeps every residual inside 31 bits
+
+const int HASH_BITS = 12; ///< log2 of the LZ match finder size
+const int MIN_MATCH = 4; ///< Shortest LZ match
+const std::size_t MAX_OFFSET = 65535; ///< Farthest LZ match
+
+/**
+ * @brief Maps a signed residual to an unsigned one, small magnitudes first.
+ */
+inline std::uint32_t zigzag(std::int32_t value) {
+    return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+}
+
+/**
+ * @brief Inverse of zigzag().
+ */
+inline std::int32_t unzigzag(std::uint32_t value) {
+    return static_cast<std::int32_t>(value >> 1) ^ -static_cast<std::int32_t>(value & 1);
+}
+
+/**
+ * @brief Gets the number of bytes of a value written as a varint.
+ */
+inline std::size_t varintSize(std::uint32_t value) {
+    std::size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+/**
+ * @brief Gets the number of bits needed to hold a value.
+ */
+inline int bitWidth(std::uint32_t value) {
+    int width = 0;
+    while (value) {
+        value >>= 1;
+        ++width;
+    }
+    return width;
+}
+
+/**
+ * @brief Appends a value as a little-endian base-128 varint.
+ */
+template<typename Byte>
+void putVarint(std::vector<Byte>& out, std::uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<Byte>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<Byte>(value));
+}
+
+/**
+ * @brief Reads a varint.
+ *
+ * @param data The bytes.
+ * @param size Number of bytes.
+ * @param pos Position of the varint; moved past it.
+ * @param value Receives the value.
+ * @return bool False if the varint is truncated or longer than 32 bits.
+ */
+bool getVarint(const unsigned char* data, std::size_t size, std::size_t& pos, std::uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35 && pos < size; shift += 7) {
+        unsigned char byte = data[pos++];
+        value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return shift < 28 || (byte >> 4) == 0;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Gets the size of residuals written as varints.
+ */
+std::size_t varintCost(const std::vector<std::uint32_t>& residuals) {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < residuals.size(); ++i) {
+        size += varintSize(residuals[i]);
+    }
+    return size;
+}
+
+/**
+ * @brief Gets the size of residuals bit-packed in blocks, one width byte per block.
+ */
+std::size_t bitpackCost(const std::vector<std::uint32_t>& residuals) {
+    std::size_t size = 0;
+    for (std::size_t start = 0; start < residuals.size(); start += BLOCK_SIZE) {
+        std::size_t count = std::min<std::size_t>(BLOCK_SIZE, residuals.size() - start);
+        std::uint32_t bits = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            bits |= residuals[start + i];
+        }
+        size += 1 + (count * bitWidth(bits) + 7) / 8;
+    }
+    return size;
+}
+
+/**
+ * @brief Appends residuals bit-packed in blocks of BLOCK_SIZE values.
+ *
+ * Each block is its bit width in one byte, then the values least significant bit first.
+ */
+void bitpack(const std::vector<std::uint32_t>& residuals, std::vector<unsigned char>& out) {
+    for (std::size_t start = 0; start < residuals.size(); start += BLOCK_SIZE) {
+        std::size_t count = std::min<std::size_t>(BLOCK_SIZE, residuals.size() - start);
+        std::uint32_t bits = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            bits |= residuals[start + i];
+        }
+        int width = bitWidth(bits);
+        out.push_back(static_cast<unsigned char>(width));
+        std::uint64_t buffer = 0;
+        int filled = 0;
+        for (std::size_t i = 0; i < count && width > 0; ++i) {
+            buffer |= static_cast<std::uint64_t>(residuals[start + i]) << filled;
+            filled += width;
+            while (filled >= 8) {
+                out.push_back(static_cast<unsigned char>(buffer));
+                buffer >>= 8;
+                filled -= 8;
+            }
+        }
+        if (filled > 0) {
+            out.push_back(static_cast<unsigned char>(buffer));
+        }
+    }
+}
+
+/**
+ * @brief Reads bit-packed residuals.
+ *
+ * @param data The bytes.
+ * @param size Number of bytes; all of them must be used.
+ * @param residuals Receives the values; its size gives the number to read.
+ * @return bool False if the bytes do not hold exactly that many values.
+ */
+bool bitunpack(const unsigned char* data, std::size_t size, std::vector<std::uint32_t>& residuals) {
+    std::size_t pos = 0;
+    for (std::size_t start = 0; start < residuals.size(); start += BLOCK_SIZE) {
+        std::size_t count = std::min<std::size_t>(BLOCK_SIZE, residuals.size() - start);
+        if (pos >= size || data[pos] > 32) {
+            return false;
+        }
+        int width = data[pos++];
+        std::size_t bytes = (count * width + 7) / 8;
+        if (bytes > size - pos) {
+            return false;
+        }
+        std::uint32_t mask = width == 32 ? 0xFFFFFFFFu : (1u << width) - 1;
+        std::uint64_t buffer = 0;
+        int filled = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            while (filled < width) {
+                buffer |= static_cast<std::uint64_t>(data[pos++]) << filled;
+                filled += 8;
+            }
+            residuals[start + i] = static_cast<std::uint32_t>(buffer) & mask;
+            buffer >>= width;
+            filled -= width;
+        }
+    }
+    return pos == size;
+}
+
+/**
+ * @brief Appends a length to an LZ sequence: 255 bytes while it does not fit, then the rest.
+ */
+void putLength(std::vector<unsigned char>& out, std::size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<unsigned char>(length));
+}
+
+/**
+ * @brief Reads a length written by putLength().
+ */
+bool getLength(const unsigned char* data, std::size_t size, std::size_t& pos, std::size_t& length) {
+    unsigned char byte;
+    do {
+        if (pos >= size) {
+            return false;
+        }
+        byte = data[pos++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+/**
+ * @brief Reads four bytes as one word for match finding.
+ */
+inline std::uint32_t read32(const unsigned char* at) {
+    std::uint32_t value;
+    std::memcpy(&value, at, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Compresses bytes with a greedy single-probe LZ77.
+ *
+ * The output is a series of sequences: a token whose high nibble is the literal count
+ * and low nibble the match length minus MIN_MATCH (15 meaning more length bytes
+ * follow), the literals, then a two-byte little-endian match offset. The last
+ * sequence has literals only.
+ *
+ * @param in The bytes.
+ * @param out Receives the compressed bytes.
+ * @param table Match finder, reused between calls.
+ */
+void lzCompress(const std::vector<unsigned char>& in, std::vector<unsigned char>& out, std::vector<int>& table) {
+    out.clear();
+    table.assign(std::size_t(1) << HASH_BITS, -1);
+    const unsigned char* src = in.data();
+    const std::size_t size = in.size();
+    std::size_t anchor = 0;
+    std::size_t pos = 0;
+    while (pos + MIN_MATCH <= size) {
+        std::uint32_t word = read32(src + pos);
+        std::uint32_t hash = (word * 2654435761u) >> (32 - HASH_BITS);
+        int candidate = table[hash];
+        table[hash] = static_cast<int>(pos);
+        if (candidate < 0 || pos - candidate > MAX_OFFSET || read32(src + candidate) != word) {
+            ++pos;
+            continue;
+        }
+        std::size_t length = MIN_MATCH;
+        while (pos + length < size && src[candidate + length] == src[pos + length]) {
+            ++length;
+        }
+        std::size_t literals = pos - anchor;
+        std::size_t extra = length - MIN_MATCH;
+        out.push_back(static_cast<unsigned char>((std::min<std::size_t>(literals, 15) << 4) | std::min<std::size_t>(extra, 15)));
+        if (literals >= 15) {
+            putLength(out, literals - 15);
+        }
+        out.insert(out.end(), src + anchor, src + pos);
+        std::size_t offset = pos - candidate;
+        out.push_back(static_cast<unsigned char>(offset));
+        out.push_back(static_cast<unsigned char>(offset >> 8));
+        if (extra >= 15) {
+            putLength(out, extra - 15);
+        }
+        pos += length;
+        anchor = pos;
+    }
+    std::size_t literals = size - anchor;
+    out.push_back(static_cast<unsigned char>(std::min<std::size_t>(literals, 15) << 4));
+    if (literals >= 15) {
+        putLength(out, literals - 15);
+    }
+    out.insert(out.end(), src + anchor, src + size);
+}
+
+/**
+ * @brief Decompresses bytes written by lzCompress().
+ *
+ * @param data The compressed bytes.
+ * @param size Number of compressed bytes.
+ * @param rawSize Expected size after decompression.
+ * @param out Receives the bytes.
+ * @return bool False if the data is corrupt or does not decompress to rawSize bytes.
+ */
+bool lzDecompress(const unsigned char* data, std::size_t size, std::size_t rawSize, std::vector<unsigned char>& out) {
+    out.resize(rawSize);
+    std::size_t pos = 0;
+    std::size_t at = 0;
+    while (pos < size) {
+        unsigned char token = data[pos++];
+        std::size_t literals = token >> 4;
+        if (literals == 15 && !getLength(data, size, pos, literals)) {
+            return false;
+        }
+        if (literals > size - pos || literals > rawSize - at) {
+            return false;
+        }
+        std::memcpy(out.data() + at, data + pos, literals);
+        pos += literals;
+        at += literals;
+        if (pos == size) {
+            break;
+        }
+        if (size - pos < 2) {
+            return false;
+        }
+        std::size_t offset = data[pos] | (static_cast<std::size_t>(data[pos + 1]) << 8);
+        pos += 2;
+        std::size_t length = token & 0x0F;
+        if (length == 15 && !getLength(data, size, pos, length)) {
+            return false;
+        }
+        length += MIN_MATCH;
+        if (offset == 0 || offset > at || length > rawSize - at) {
+            return false;
+        }
+        // Byte by byte: a match may overlap the bytes it produces.
+        for (std::size_t i = 0; i < length; ++i, ++at) {
+            out[at] = out[at - offset];
+        }
+    }
+    return at == rawSize;
+}
+
+} // namespace
+
+/**
+ * @brief Constructs an encoder at the start of a stream.
+ *
+ * @param beamCount Ranges per scan.
+ * @param lz Whether to try the LZ stage on each frame.
+ * @param keyframeFrames Maximum frames between intra frames, 0 for no limit.
+ */
+ScanEncoder::ScanEncoder(int beamCount, bool lz, int keyframeFrames)
+    : beams(beamCount > 0 ? beamCount : 0), useLz(lz), keyframeInterval(keyframeFrames > 0 ? keyframeFrames : 0),
+      sinceKeyframe(0), hasPrevious(false), previous(beams), current(beams), intra(beams), inter(beams) {}
+
+/**
+ * @brief Encodes one scan and appends its frame.
+ *
+ * @param ranges The ranges in metres, getBeams() values.
+ * @param out Receives the frame, appended to its current contents.
+ * @return std::size_t Size of the frame in bytes.
+ */
+std::size_t ScanEncoder::encode(const float* ranges, std::vector<char>& out) {
+    std::int32_t last = 0;
+    for (int i = 0; i < beams; ++i) {
+        float r = ranges[i];
+        std::int32_t mm = 0;
+        if (r > 0.0f && r < std::numeric_limits<float>::infinity()) {
+            double scaled = std::floor(static_cast<double>(r) * 1000.0 + 0.5);
+            mm = scaled > MAX_MILLIMETRES ? MAX_MILLIMETRES : static_cast<std::int32_t>(scaled);
+        }
+        current[i] = mm;
+        intra[i] = zigzag(mm - last);
+        last = mm;
+    }
+
+    unsigned char flags = 0;
+    const std::vector<std::uint32_t>* residuals = &intra;
+    std::size_t varintBytes = varintCost(intra);
+    std::size_t packBytes = bitpackCost(intra);
+    if (hasPrevious && (keyframeInterval == 0 || sinceKeyframe < keyframeInterval)) {
+        for (int i = 0; i < beams; ++i) {
+            inter[i] = zigzag(current[i] - previous[i]);
+        }
+        std::size_t interVarint = varintCost(inter);
+        std::size_t interPack = bitpackCost(inter);
+        if (std::min(interVarint, interPack) < std::min(varintBytes, packBytes)) {
+            flags |= FRAME_INTER;
+            residuals = &inter;
+            varintBytes = interVarint;
+            packBytes = interPack;
+        }
+    }
+
+    packed.clear();
+    if (packBytes < varintBytes) {
+        flags |= FRAME_BITPACK;
+        bitpack(*residuals, packed);
+    } else {
+        for (int i = 0; i < beams; ++i) {
+            putVarint(packed, (*residuals)[i]);
+        }
+    }
+
+    const std::vector<unsigned char>* stored = &packed;
+    if (useLz) {
+        lzCompress(packed, compressed, hashTable);
+        if (compressed.size() + varintSize(static_cast<std::uint32_t>(packed.size())) < packed.size()) {
+            flags |= FRAME_LZ;
+            stored = &compressed;
+        }
+    }
+
+    std::size_t start = out.size();
+    out.push_back(static_cast<char>(flags));
+    putVarint(out, static_cast<std::uint32_t>(stored->size()));
+    if (flags & FRAME_LZ) {
+        putVarint(out, static_cast<std::uint32_t>(packed.size()));
+    }
+    out.insert(out.end(), stored->begin(), stored->end());
+
+    previous.swap(current);
+    hasPrevious = true;
+    sinceKeyframe = (flags & FRAME_INTER) ? sinceKeyframe + 1 : 1;
+    return out.size() - start;
+}
+
+/**
+ * @brief Restarts the stream; the next frame is an intra frame.
+ */
+void ScanEncoder::reset() {
+    hasPrevious = false;
+    sinceKeyframe = 0;
+}
+
+/**
+ * @brief Gets the number of ranges per scan.
+ *
+ * @return int The number of ranges.
+ */
+int ScanEncoder::getBeams() const {
+    return beams;
+}
+
+/**
+ * @brief Constructs a decoder at the start of a stream.
+ *
+ * @param beamCount Ranges per scan.
+ */
+ScanDecoder::ScanDecoder(int beamCount)
+    : beams(beamCount > 0 ? beamCount : 0), hasPrevious(false), values(beams), residuals(beams) {}
+
+/**
+ * @brief Decodes one frame.
+ *
+ * @param data The frame, possibly followed by further frames.
+ * @param size Bytes available at data.
+ * @param ranges Receives the ranges in metres, getBeams() values.
+ * @return std::size_t Size of the frame, or 0 if it is corrupt, truncated, or an inter
+ * frame with no previous scan.
+ */
+std::size_t ScanDecoder::decode(const char* data, std::size_t size, float* ranges) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    if (size == 0 || (bytes[0] & ~FRAME_KNOWN)) {
+        return 0;
+    }
+    unsigned char flags = bytes[0];
+    if ((flags & FRAME_INTER) && !hasPrevious) {
+        return 0;
+    }
+    std::size_t pos = 1;
+    std::uint32_t storedSize = 0;
+    std::uint32_t rawSize = 0;
+    if (!getVarint(bytes, size, pos, storedSize) || ((flags & FRAME_LZ) && !getVarint(bytes, size, pos, rawSize)) ||
+        storedSize > size - pos) {
+        return 0;
+    }
+    const unsigned char* payload = bytes + pos;
+    std::size_t payloadSize = storedSize;
+    if (flags & FRAME_LZ) {
+        if (!lzDecompress(payload, storedSize, rawSize, unpacked)) {
+            return 0;
+        }
+        payload = unpacked.data();
+        payloadSize = unpacked.size();
+    }
+
+    if (flags & FRAME_BITPACK) {
+        if (!bitunpack(payload, payloadSize, residuals)) {
+            return 0;
+        }
+    } else {
+        std::size_t at = 0;
+        for (int i = 0; i < beams; ++i) {
+            if (!getVarint(payload, payloadSize, at, residuals[i])) {
+                return 0;
+            }
+        }
+        if (at != payloadSize) {
+            return 0;
+        }
+    }
+
+    std::int32_t last = 0;
+    for (int i = 0; i < beams; ++i) {
+        std::int32_t base = (flags & FRAME_INTER) ? values[i] : last;
+        // Wraps instead of overflowing on corrupt input.
+        last = values[i] = static_cast<std::int32_t>(static_cast<std::uint32_t>(base) +
+                                                     static_cast<std::uint32_t>(unzigzag(residuals[i])));
+        ranges[i] = last > 0 ? static_cast<float>(last * 0.001) : std::numeric_limits<float>::infinity();
+    }
+    hasPrevious = true;
+    return pos + storedSize;
+}
+
+/**
+ * @brief Checks whether a frame is an intra frame, where decoding can start.
+ *
+ * @param data The frame.
+ * @param size Bytes available at data.
+ * @return bool True for an intra frame.
+ */
+bool ScanDecoder::isKeyframe(const char* data, std::size_t size) {
+    return size > 0 && !(static_cast<unsigned char>(data[0]) & FRAME_INTER);
+}
+
+/**
+ * @brief Restarts the stream; the next frame must be an intra frame.
+ */
+void ScanDecoder::reset() {
+    hasPrevious = false;
+}
+
+/**
+ * @brief Gets the number of ranges per scan.
+ *
+ * @return int The number of ranges.
+ */
+int ScanDecoder::getBeams() const {
+    return beams;
+}
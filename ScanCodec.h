@@ -0,0 +1,126 @@
+/**
+ * @file ScanCodec.h
+ * @brief Declaration of the ScanEncoder and ScanDecoder classes.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ScanEncoder
+ * @brief Compresses a stream of Lidar scans into self-delimiting frames.
+ *
+ * Each range is quantized to millimetres; invalid readings (zero, negative, infinite
+ * or NaN) are stored as 0. The millimetre values are then delta-coded, either against
+ * the previous beam of the same scan (intra frame) or against the same beam of the
+ * previous scan (inter frame), whichever is smaller. The zigzagged residuals are
+ * written as varints or bit-packed in blocks of 32 values, again whichever is smaller,
+ * and the result can optionally go through a fast LZ stage that is kept only when it
+ * saves bytes. An intra frame is forced at a fixed interval so a decoder can start
+ * at it.
+ */
+class ScanEncoder {
+private:
+    int beams; ///< Ranges per scan
+    bool useLz; ///< Whether to try the LZ stage
+    int keyframeInterval; ///< Maximum frames between intra frames, 0 for no limit
+    int sinceKeyframe; ///< Frames written since the last intra frame
+    bool hasPrevious; ///< Whether previous holds a scan
+    std::vector<std::int32_t> previous; ///< Millimetre values of the previous scan
+    std::vector<std::int32_t> current; ///< Millimetre values of the scan being encoded
+    std::vector<std::uint32_t> intra; ///< Zigzagged residuals against the previous beam
+    std::vector<std::uint32_t> inter; ///< Zigzagged residuals against the previous scan
+    std::vector<unsigned char> packed; ///< Residual bytes before the LZ stage
+    std::vector<unsigned char> compressed; ///< Residual bytes after the LZ stage
+    std::vector<int> hashTable; ///< Match finder of the LZ stage
+
+public:
+    /**
+     * @brief Constructs an encoder at the start of a stream.
+     *
+     * @param beamCount Ranges per scan.
+     * @param lz Whether to try the LZ stage on each frame.
+     * @param keyframeFrames Maximum frames between intra frames, 0 for no limit.
+     */
+    ScanEncoder(int beamCount, bool lz = false, int keyframeFrames = 100);
+
+    /**
+     * @brief Encodes one scan and appends its frame.
+     *
+     * @param ranges The ranges in metres, getBeams() values.
+     * @param out Receives the frame, appended to its current contents.
+     * @return std::size_t Size of the frame in bytes.
+     */
+    std::size_t encode(const float* ranges, std::vector<char>& out);
+
+    /**
+     * @brief Restarts the stream; the next frame is an intra frame.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the number of ranges per scan.
+     *
+     * @return int The number of ranges.
+     */
+    int getBeams() const;
+};
+
+/**
+ * @class ScanDecoder
+ * @brief Decodes the frames written by ScanEncoder.
+ *
+ * Frames must be decoded in the order they were encoded, starting at the first frame
+ * of the stream or at any intra frame. Invalid readings are decoded as infinity.
+ */
+class ScanDecoder {
+private:
+    int beams; ///< Ranges per scan
+    bool hasPrevious; ///< Whether values holds a scan
+    std::vector<std::int32_t> values; ///< Millimetre values of the last decoded scan
+    std::vector<std::uint32_t> residuals; ///< Zigzagged residuals of the frame being decoded
+    std::vector<unsigned char> unpacked; ///< Residual bytes after undoing the LZ stage
+
+public:
+    /**
+     * @brief Constructs a decoder at the start of a stream.
+     *
+     * @param beamCount Ranges per scan.
+     */
+    explicit ScanDecoder(int beamCount);
+
+    /**
+     * @brief Decodes one frame.
+     *
+     * @param data The frame, possibly followed by further frames.
+     * @param size Bytes available at data.
+     * @param ranges Receives the ranges in metres, getBeams() values.
+     * @return std::size_t Size of the frame, or 0 if it is corrupt, truncated, or an inter
+     * frame with no previous scan.
+     */
+    std::size_t decode(const char* data, std::size_t size, float* ranges);
+
+    /**
+     * @brief Checks whether a frame is an intra frame, where decoding can start.
+     *
+     * @param data The frame.
+     * @param size Bytes available at data.
+     * @return bool True for an intra frame.
+     */
+    static bool isKeyframe(const char* data, std::size_t size);
+
+    /**
+     * @brief Restarts the stream; the next frame must be an intra frame.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the number of ranges per scan.
+     *
+     * @return int The number of ranges.
+     */
+    int getBeams() const;
+};
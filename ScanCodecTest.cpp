@@ -0,0 +1,177 @@
+/**
+ * @file ScanCodecTest.cpp
+ * @brief Test file for the ScanEncoder and ScanDecoder classes.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <vector>
+#include "ScanCodec.h"
+#include "SimulatedRobotAPI.h"
+
+/**
+ * @brief Records scans of a robot driving around a walled room with a few pillars.
+ *
+ * @param count Number of scans, one every 100 ms.
+ * @param noise Standard deviation of the range noise in metres.
+ * @return std::vector<std::vector<float> > The scans.
+ */
+std::vector<std::vector<float> > simulateScans(int count, double noise) {
+    Map room(200, 200);
+    for (int i = 0; i < 200; ++i) {
+        room.setGrid(i, 0, 1);
+        room.setGrid(i, 199, 1);
+        room.setGrid(0, i, 1);
+        room.setGrid(199, i, 1);
+    }
+    for (int p = 0; p < 6; ++p) {
+        for (int i = 0; i < 6; ++i) {
+            for (int j = 0; j < 6; ++j) {
+                room.setGrid(30 + p * 25 + i, 60 + (p % 3) * 40 + j, 1);
+            }
+        }
+    }
+    SimulatedRobotAPI sim(room, 0.05);
+    sim.setPose(2.0, 2.0, 0.3);
+    sim.setNoise(noise);
+    std::vector<std::vector<float> > scans(count, std::vector<float>(sim.getLidarRangeNumber()));
+    for (int s = 0; s < count; ++s) {
+        if (s % 40 == 0) {
+            sim.rotate(LEFT);
+        } else if (s % 40 == 10) {
+            sim.move(FORWARD);
+        } else if (s % 40 == 30) {
+            sim.move(BACKWARD);
+        }
+        for (int k = 0; k < 10; ++k) {
+            sim.step();
+        }
+        sim.getLidarRange(scans[s].data());
+    }
+    return scans;
+}
+
+/**
+ * @brief Encodes and decodes scans and prints the compression ratio and throughput.
+ *
+ * @param label Name of the data set.
+ * @param scans The scans.
+ * @param lz Whether to enable the LZ stage.
+ */
+void benchmark(const char* label, const std::vector<std::vector<float> >& scans, bool lz) {
+    using Clock = std::chrono::steady_clock;
+    const int beams = static_cast<int>(scans[0].size());
+    const double rawBytes = static_cast<double>(scans.size()) * beams * sizeof(float);
+    const int repeats = 5;
+
+    std::vector<char> stream;
+    Clock::time_point t0 = Clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        ScanEncoder encoder(beams, lz);
+        stream.clear();
+        for (std::size_t s = 0; s < scans.size(); ++s) {
+            encoder.encode(scans[s].data(), stream);
+        }
+    }
+    double encodeSeconds = std::chrono::duration<double>(Clock::now() - t0).count() / repeats;
+
+    std::vector<float> ranges(beams);
+    double maxError = 0.0;
+    t0 = Clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        ScanDecoder decoder(beams);
+        std::size_t at = 0;
+        for (std::size_t s = 0; s < scans.size(); ++s) {
+            at += decoder.decode(stream.data() + at, stream.size() - at, ranges.data());
+            if (r == 0) {
+                for (int i = 0; i < beams; ++i) {
+                    maxError = std::fmax(maxError, std::fabs(ranges[i] - scans[s][i]));
+                }
+            }
+        }
+    }
+    double decodeSeconds = std::chrono::duration<double>(Clock::now() - t0).count() / repeats;
+
+    std::cout << "[Bench] " << label << (lz ? " + LZ" : "") << ": " << stream.size() / static_cast<double>(scans.size())
+              << " bytes/scan, ratio " << rawBytes / stream.size() << "x vs float32, encode "
+              << rawBytes / encodeSeconds / 1e6 << " MB/s, decode " << rawBytes / decodeSeconds / 1e6
+              << " MB/s, max error " << maxError * 1000.0 << " mm\n";
+}
+
+/**
+ * @brief Main function to test the scan codec.
+ *
+ * This function performs various tests on the scan codec:
+ * - Round trips scans within half a millimetre, with invalid readings as infinity.
+ * - Checks that inter frames need their previous scan and that corrupt frames are rejected.
+ * - Forces intra frames at the keyframe interval.
+ * - Measures the compression ratio and throughput on simulated scans, with and without
+ *   noise and the LZ stage, against float32 and decimal text.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- ScanCodec Test Start -----\n";
+
+    // 1. Round trip
+    const float inf = std::numeric_limits<float>::infinity();
+    float first[8] = { 1.0f, 1.0014f, 1.0026f, 0.0f, inf, -1.0f, 9.9996f, 2.5f };
+    float second[8] = { 1.0f, 1.0014f, 1.0026f, 0.0f, inf, -1.0f, 9.9996f, 2.501f };
+    float decoded[8];
+    ScanEncoder encoder(8, true, 3);
+    ScanDecoder decoder(8);
+    std::vector<char> stream;
+    std::size_t firstSize = encoder.encode(first, stream);
+    std::size_t secondSize = encoder.encode(second, stream);
+    std::cout << "[Test] Frame sizes => " << firstSize << ", " << secondSize << "; second is keyframe => "
+              << ScanDecoder::isKeyframe(stream.data() + firstSize, secondSize) << "\n";
+    std::size_t used = decoder.decode(stream.data(), stream.size(), decoded);
+    std::cout << "[Test] Decoded first => " << used << " bytes:";
+    for (int i = 0; i < 8; ++i) {
+        std::cout << " " << decoded[i];
+    }
+    std::cout << "\n";
+    decoder.decode(stream.data() + used, stream.size() - used, decoded);
+    std::cout << "[Test] Decoded second, last => " << decoded[7] << " (2.501)\n";
+
+    // 2. Inter frame without its previous scan, corrupt and truncated frames
+    ScanDecoder late(8);
+    std::cout << "[Test] Inter frame first => " << late.decode(stream.data() + firstSize, secondSize, decoded) << " (0)\n";
+    std::cout << "[Test] Truncated frame => " << late.decode(stream.data(), firstSize - 1, decoded) << " (0)\n";
+    std::vector<char> bad(stream.begin(), stream.begin() + firstSize);
+    bad[0] = static_cast<char>(0x40);
+    std::cout << "[Test] Unknown flags => " << late.decode(bad.data(), bad.size(), decoded) << " (0)\n";
+
+    // 3. Keyframe interval of 3: two frames since the last intra frame so far
+    std::cout << "[Test] Keyframes =>";
+    for (int s = 0; s < 6; ++s) {
+        std::size_t at = stream.size();
+        encoder.encode(second, stream);
+        std::cout << " " << ScanDecoder::isKeyframe(stream.data() + at, stream.size() - at);
+    }
+    std::cout << " (0 1 0 0 1 0)\n";
+
+    // 4. Simulated scans, 600 of 360 beams (one minute at 10 Hz)
+    std::vector<std::vector<float> > clean = simulateScans(600, 0.0);
+    std::vector<std::vector<float> > noisy = simulateScans(600, 0.01);
+    std::size_t textBytes = 0;
+    for (std::size_t s = 0; s < noisy.size(); ++s) {
+        std::ostringstream line;
+        for (std::size_t i = 0; i < noisy[s].size(); ++i) {
+            line << noisy[s][i] << ' ';
+        }
+        textBytes += line.str().size();
+    }
+    std::cout << "[Bench] Decimal text: " << textBytes / static_cast<double>(noisy.size()) << " bytes/scan, float32: "
+              << noisy[0].size() * sizeof(float) << " bytes/scan\n";
+    benchmark("Noise-free scans", clean, false);
+    benchmark("Noise-free scans", clean, true);
+    benchmark("Scans with 1 cm noise", noisy, false);
+    benchmark("Scans with 1 cm noise", noisy, true);
+
+    std::cout << "----- ScanCodec Test Complete -----\n";
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "ScanRing.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+
+ScanRing::ScanRing(int slotCount, int beams) : slots(nullptr), ranges(nullptr), capacity(1), maxBeams(std::max(beams, 0)), head(0)
+{
+    while (capacity < slotCount) {
+        capacity <<= 1;
+    }
+    slots = new Slot[capacity];
+    for (int i = 0; i < capacity; ++i) {
+        slots[i].sequence.store(0, std::memory_order_relaxed);
+        slots[i].timestampNs.store(0, std::memory_order_relaxed);
+        slots[i].count.store(0, std::memory_order_relaxed);
+    }
+    ranges = new float[static_cast<size_t>(capacity) * std::max(maxBeams, 1)];
+}
+
+ScanRing::~ScanRing() {
+    delete[] slots;
+    delete[] ranges;
+}
+
+std::uint64_t ScanRing::publish(const float* scanRanges, int count, std::int64_t timestampNs) {
+    std::uint64_t sequence = head.load(std::memory_order_relaxed) + 1;
+    size_t index = static_cast<size_t>(sequence & (capacity - 1));
+    Slot& slot = slots[index];
+    count = std::min(std::max(count, 0), maxBeams);
+
+    slot.sequence.store(BUSY, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    if (count > 0) {
+        std::memcpy(ranges + index * maxBeams, scanRanges, count * sizeof(float));
+    }
+    slot.timestampNs.store(timestampNs, std::memory_order_relaxed);
+    slot.count.store(count, std::memory_order_relaxed);
+    slot.sequence.store(sequence, std::memory_order_release);
+    head.store(sequence, std::memory_order_release);
+    return sequence;
+}
+
+std::uint64_t ScanRing::publish(const float* scanRanges, int count) {
+    return publish(scanRanges, count, now());
+}
+
+bool ScanRing::readSlot(std::uint64_t sequence, StampedScan& out) const {
+    size_t index = static_cast<size_t>(sequence & (capacity - 1));
+    const Slot& slot = slots[index];
+    if (slot.sequence.load(std::memory_order_acquire) != sequence) {
+        return false;
+    }
+    out.sequence = sequence;
+    out.timestampNs = slot.timestampNs.load(std::memory_order_relaxed);
+    out.count = slot.count.load(std::memory_order_relaxed);
+    out.ranges = ranges + index * maxBeams;
+    return isValid(out);
+}
+
+std::uint64_t ScanRing::oldestSafe(std::uint64_t newest) const {
+    std::uint64_t slotCount = static_cast<std::uint64_t>(capacity);
+    return newest >= slotCount ? std::min(newest - slotCount + 2, newest) : 1;
+}
+
+bool ScanRing::latest(StampedScan& out) const {
+    for (;;) {
+        std::uint64_t sequence = head.load(std::memory_order_acquire);
+        if (sequence == 0) {
+            return false;
+        }
+        if (readSlot(sequence, out)) {
+            return true;
+        }
+    }
+}
+
+bool ScanRing::since(std::uint64_t sequence, StampedScan& out) const {
+    for (;;) {
+        std::uint64_t newest = head.load(std::memory_order_acquire);
+        if (newest <= sequence) {
+            return false;
+        }
+        std::uint64_t wanted = std::max(sequence + 1, oldestSafe(newest));
+        if (readSlot(wanted, out)) {
+            return true;
+        }
+    }
+}
+
+bool ScanRing::nearest(std::int64_t timestampNs, StampedScan& out) const {
+    for (;;) {
+        std::uint64_t newest = head.load(std::memory_order_acquire);
+        if (newest == 0) {
+            return false;
+        }
+        std::uint64_t oldest = oldestSafe(newest);
+
+        // Timestamps grow with the sequence, so binary search for the first scan at or after the time.
+        std::uint64_t lo = oldest;
+        std::uint64_t hi = newest;
+        bool consistent = true;
+        while (lo < hi && consistent) {
+            std::uint64_t mid = lo + (hi - lo) / 2;
+            StampedScan probe;
+            if (!readSlot(mid, probe)) {
+                consistent = false;
+            } else if (probe.timestampNs < timestampNs) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (!consistent) {
+            continue;
+        }
+
+        StampedScan after;
+        if (!readSlot(lo, after)) {
+            continue;
+        }
+        out = after;
+        if (lo > oldest && after.timestampNs > timestampNs) {
+            StampedScan before;
+            if (!readSlot(lo - 1, before)) {
+                continue;
+            }
+            if (timestampNs - before.timestampNs <= after.timestampNs - timestampNs) {
+                out = before;
+            }
+        }
+        return true;
+    }
+}
+
+bool ScanRing::isValid(const StampedScan& scan) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    size_t index = static_cast<size_t>(scan.sequence & (capacity - 1));
+    return slots[index].sequence.load(std::memory_order_relaxed) == scan.sequence;
+}
+
+bool ScanRing::copy(const StampedScan& scan, float* out) const {
+    if (scan.count > 0) {
+        std::memcpy(out, scan.ranges, scan.count * sizeof(float));
+    }
+    return isValid(scan);
+}
+
+std::uint64_t ScanRing::getLatestSequence() const {
+    return head.load(std::memory_order_acquire);
+}
+
+int ScanRing::getCapacity() const {
+    return capacity;
+}
+
+std::int64_t ScanRing::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
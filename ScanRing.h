@@ -0,0 +1,185 @@
+/**
+ * @file ScanRing.h
+ * @brief Declaration of the ScanRing class.
+ */
+
+#ifndef SCANRING_H
+#define SCANRING_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @struct StampedScan
+ * @brief View of one scan stored in a ScanRing.
+ *
+ * The ranges point directly into the ring. The ring may overwrite the slot at any time,
+ * so a reader must call ScanRing::isValid() after it has finished using the ranges and
+ * discard its result if the scan is no longer valid.
+ */
+struct StampedScan {
+    std::uint64_t sequence; ///< Sequence number of the scan, starting at 1
+    std::int64_t timestampNs; ///< Monotonic acquisition time in nanoseconds
+    const float* ranges; ///< Ranges of the scan
+    int count; ///< Number of ranges
+};
+
+/**
+ * @class ScanRing
+ * @brief Fixed-capacity ring of timestamped Lidar scans.
+ *
+ * One acquisition thread publishes scans; any number of consumer threads read them
+ * without locks. Each slot carries a sequence word used as a seqlock: the producer marks
+ * the slot busy, writes the ranges and then stores the new sequence number, and readers
+ * check that the sequence is unchanged after reading. Readers never block the producer,
+ * and the producer never waits for readers; a slow reader simply sees its scan become
+ * invalid once the ring has wrapped around.
+ */
+class ScanRing {
+private:
+    /**
+     * @struct Slot
+     * @brief Metadata of one ring slot.
+     */
+    struct Slot {
+        std::atomic<std::uint64_t> sequence; ///< Sequence of the stored scan, 0 if empty, BUSY while written
+        std::atomic<std::int64_t> timestampNs; ///< Timestamp of the stored scan
+        std::atomic<int> count; ///< Number of ranges of the stored scan
+    };
+
+    static const std::uint64_t BUSY = ~0ULL; ///< Sequence value of a slot being written
+
+    Slot* slots; ///< Slot metadata
+    float* ranges; ///< Range storage, maxBeams floats per slot
+    int capacity; ///< Number of slots, a power of two
+    int maxBeams; ///< Maximum number of ranges per scan
+    std::atomic<std::uint64_t> head; ///< Sequence of the latest published scan, 0 if none
+
+    /**
+     * @brief Reads the scan with the given sequence if it is still stored.
+     *
+     * @param sequence The sequence to read.
+     * @param out Receives the scan.
+     * @return bool True if the slot held the scan.
+     */
+    bool readSlot(std::uint64_t sequence, StampedScan& out) const;
+
+    /**
+     * @brief Gets the oldest scan a reader can rely on.
+     *
+     * The slot of the oldest stored scan is the next one the producer overwrites, so
+     * only the last capacity - 1 scans are safe to read.
+     *
+     * @param newest Sequence of the latest published scan, at least 1.
+     * @return std::uint64_t The sequence of the oldest safe scan.
+     */
+    std::uint64_t oldestSafe(std::uint64_t newest) const;
+
+    ScanRing(const ScanRing&);
+    ScanRing& operator=(const ScanRing&);
+
+public:
+    /**
+     * @brief Constructs an empty ring.
+     *
+     * @param slotCount Number of scans kept; rounded up to a power of two.
+     * @param beams Maximum number of ranges per scan.
+     */
+    ScanRing(int slotCount, int beams);
+
+    /**
+     * @brief Destructor. Releases the slots.
+     */
+    ~ScanRing();
+
+    /**
+     * @brief Publishes a scan. Must only be called from the producer thread.
+     *
+     * Ranges beyond the maximum number of beams are dropped.
+     *
+     * @param scanRanges The ranges to publish.
+     * @param count Number of ranges.
+     * @param timestampNs Monotonic acquisition time in nanoseconds.
+     * @return std::uint64_t The sequence number assigned to the scan.
+     */
+    std::uint64_t publish(const float* scanRanges, int count, std::int64_t timestampNs);
+
+    /**
+     * @brief Publishes a scan stamped with the current monotonic time.
+     *
+     * @param scanRanges The ranges to publish.
+     * @param count Number of ranges.
+     * @return std::uint64_t The sequence number assigned to the scan.
+     */
+    std::uint64_t publish(const float* scanRanges, int count);
+
+    /**
+     * @brief Gets the latest scan.
+     *
+     * @param out Receives the scan.
+     * @return bool False if nothing has been published yet.
+     */
+    bool latest(StampedScan& out) const;
+
+    /**
+     * @brief Gets the oldest stored scan published after the given sequence.
+     *
+     * Call repeatedly with the sequence of the returned scan to walk every scan in order;
+     * scans overwritten before they were read are skipped, and so is the oldest stored
+     * scan, which the next publish overwrites.
+     *
+     * @param sequence The last sequence already consumed, 0 to start from the oldest scan.
+     * @param out Receives the scan.
+     * @return bool False if no newer scan is available.
+     */
+    bool since(std::uint64_t sequence, StampedScan& out) const;
+
+    /**
+     * @brief Gets the stored scan whose timestamp is closest to the given time.
+     *
+     * @param timestampNs The time in nanoseconds on the same clock as the scans.
+     * @param out Receives the scan.
+     * @return bool False if nothing has been published yet.
+     */
+    bool nearest(std::int64_t timestampNs, StampedScan& out) const;
+
+    /**
+     * @brief Checks that a scan obtained from this ring has not been overwritten.
+     *
+     * @param scan The scan to check.
+     * @return bool True if the ranges read since the scan was obtained are consistent.
+     */
+    bool isValid(const StampedScan& scan) const;
+
+    /**
+     * @brief Copies the ranges of a scan into a caller buffer.
+     *
+     * @param scan The scan to copy.
+     * @param out Buffer of at least scan.count floats.
+     * @return bool True if the copy is consistent, false if the scan was overwritten.
+     */
+    bool copy(const StampedScan& scan, float* out) const;
+
+    /**
+     * @brief Gets the sequence of the latest published scan.
+     *
+     * @return std::uint64_t The sequence, 0 if nothing has been published.
+     */
+    std::uint64_t getLatestSequence() const;
+
+    /**
+     * @brief Gets the number of slots.
+     *
+     * @return int The capacity of the ring.
+     */
+    int getCapacity() const;
+
+    /**
+     * @brief Gets the current monotonic time.
+     *
+     * @return std::int64_t Nanoseconds on the steady clock.
+     */
+    static std::int64_t now();
+};
+
+#endif // SCANRING_H
@@ -0,0 +1,115 @@
+/**
+ * @file ScanRingTest.cpp
+ * @brief Test file for the ScanRing class.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "ScanRing.h"
+
+/**
+ * @brief Main function to test the ScanRing class.
+ *
+ * This function performs various tests on the ScanRing class:
+ * - Publishes scans and reads the latest one.
+ * - Walks scans in order with since(), including after the ring wrapped, starting at
+ *   the same oldest scan as nearest().
+ * - Looks up the scan nearest to a timestamp.
+ * - Runs one producer and several consumer threads and checks that every scan a
+ *   consumer accepted was consistent.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- ScanRing Test Start -----\n";
+
+    // 1. Latest
+    const int beams = 360;
+    ScanRing ring(8, beams);
+    std::vector<float> scan(beams);
+    StampedScan view;
+    std::cout << "[Test] Latest on empty ring => " << (ring.latest(view) ? "found" : "none") << "\n";
+    for (int s = 1; s <= 5; ++s) {
+        std::fill(scan.begin(), scan.end(), static_cast<float>(s));
+        ring.publish(scan.data(), beams, s * 1000);
+    }
+    ring.latest(view);
+    std::cout << "[Test] Latest => seq " << view.sequence << ", t " << view.timestampNs
+              << ", range " << view.ranges[0] << ", valid " << ring.isValid(view) << "\n";
+
+    // 2. since() after wrap-around
+    for (int s = 6; s <= 20; ++s) {
+        std::fill(scan.begin(), scan.end(), static_cast<float>(s));
+        ring.publish(scan.data(), beams, s * 1000);
+    }
+    std::cout << "[Test] since(0) =>";
+    std::uint64_t last = 0;
+    while (ring.since(last, view)) {
+        std::cout << " " << view.sequence;
+        last = view.sequence;
+    }
+    std::cout << " (14..20)\n";
+
+    // 3. nearest()
+    ring.nearest(15400, view);
+    std::cout << "[Test] nearest(15400) => seq " << view.sequence << "\n";
+    ring.nearest(15600, view);
+    std::cout << "[Test] nearest(15600) => seq " << view.sequence << "\n";
+    ring.nearest(0, view);
+    std::cout << "[Test] nearest(0) => seq " << view.sequence << " (14, the oldest since() returns)\n";
+
+    // 4. One producer, three lock-free consumers
+    ScanRing shared(16, beams);
+    std::atomic<bool> done(false);
+    std::atomic<long long> torn(0);
+    std::atomic<long long> accepted(0);
+    const int scans = 200000;
+
+    auto consumer = [&](int kind) {
+        std::vector<float> local(beams);
+        std::uint64_t seen = 0;
+        while (!done.load()) {
+            StampedScan s;
+            bool got = false;
+            if (kind == 0) {
+                got = shared.latest(s);
+            } else if (kind == 1) {
+                got = shared.since(seen, s);
+            } else {
+                got = shared.nearest(ScanRing::now() - 1000, s);
+            }
+            if (!got || !shared.copy(s, local.data())) {
+                continue;
+            }
+            seen = s.sequence;
+            for (int i = 0; i < s.count; ++i) {
+                if (local[i] != static_cast<float>(s.sequence)) {
+                    ++torn;
+                    break;
+                }
+            }
+            ++accepted;
+        }
+    };
+
+    std::vector<std::thread> readers;
+    for (int k = 0; k < 3; ++k) {
+        readers.push_back(std::thread(consumer, k));
+    }
+    std::vector<float> produced(beams);
+    for (int s = 1; s <= scans; ++s) {
+        std::fill(produced.begin(), produced.end(), static_cast<float>(s));
+        shared.publish(produced.data(), beams);
+    }
+    done.store(true);
+    for (auto& t : readers) {
+        t.join();
+    }
+    std::cout << "[Test] Concurrent: published " << shared.getLatestSequence() << ", accepted reads "
+              << (accepted.load() > 0 ? "> 0" : "0") << ", torn reads " << torn.load() << "\n";
+
+    std::cout << "----- ScanRing Test Complete -----\n";
+    return 0;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file SensorAcquisition.cpp
+ * @brief Implementation of the SensorAcquisition class.
+ */
+
+#include "SensorAcquisition.h"
+#include <chrono>
+
+/**
+ * @brief Constructs a stopped acquisition service.
+ *
+ * By default IR is polled at 50 Hz, Lidar at 10 Hz and odometry at 50 Hz. Channels
+ * whose source is nullptr are never polled.
+ *
+ * @param api Pointer to the backend object, used for odometry.
+ * @param ir Pointer to the IR sensor.
+ * @param lidar Pointer to the Lidar sensor.
+ */
+SensorAcquisition::SensorAcquisition(RobotApi* api, IRSensor* ir, LidarSensor* lidar)
+    : robotInterface(api), irSensor(ir), lidarSensor(lidar), running(false)
+{
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        periodNs[c] = 0;
+        activePeriodNs[c] = 0;
+        sampleCount[c].store(0);
+    }
+    setRate(CHANNEL_IR, 50.0);
+    setRate(CHANNEL_LIDAR, 10.0);
+    setRate(CHANNEL_ODOMETRY, 50.0);
+}
+
+/**
+ * @brief Destructor. Stops the acquisition thread.
+ */
+SensorAcquisition::~SensorAcquisition() {
+    stop();
+}
+
+/**
+ * @brief Sets the polling rate of a channel.
+ *
+ * Takes effect at the next start(); the running thread keeps its own copy of the
+ * rates, so this may be called while it runs.
+ *
+ * @param channel The channel.
+ * @param hz Polling rate in Hz; 0 or less disables the channel.
+ */
+void SensorAcquisition::setRate(SENSOR_CHANNEL channel, double hz) {
+    if (channel < 0 || channel >= CHANNEL_COUNT) {
+        return;
+    }
+    periodNs[channel] = hz > 0.0 ? static_cast<std::int64_t>(1e9 / hz) : 0;
+}
+
+/**
+ * @brief Adds an IR subscriber.
+ *
+ * @param callback Function called with every IR sample.
+ */
+void SensorAcquisition::subscribeIR(const IRCallback& callback) {
+    std::lock_guard<std::mutex> lock(subscriberMutex);
+    irSubscribers.push_back(callback);
+}
+
+/**
+ * @brief Adds a Lidar subscriber.
+ *
+ * @param callback Function called with every scan. The scan view is only valid during the call.
+ */
+void SensorAcquisition::subscribeLidar(const LidarCallback& callback) {
+    std::lock_guard<std::mutex> lock(subscriberMutex);
+    lidarSubscribers.push_back(callback);
+}
+
+/**
+ * @brief Adds an odometry subscriber.
+ *
+ * @param callback Function called with every pose sample.
+ */
+void SensorAcquisition::subscribeOdometry(const OdometryCallback& callback) {
+    std::lock_guard<std::mutex> lock(subscriberMutex);
+    odometrySubscribers.push_back(callback);
+}
+
+/**
+ * @brief Starts the acquisition thread.
+ *
+ * @return bool True if the thread was started, false if it was already running.
+ */
+bool SensorAcquisition::start() {
+    if (running.exchange(true)) {
+        return false;
+    }
+    // Starting the thread publishes the copy to it; setRate() never touches it.
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        activePeriodNs[c] = periodNs[c];
+    }
+    worker = std::thread(&SensorAcquisition::run, this);
+    return true;
+}
+
+/**
+ * @brief Stops the acquisition thread and waits for it to finish.
+ */
+void SensorAcquisition::stop() {
+    running.store(false);
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Checks whether the acquisition thread is running.
+ *
+ * @return bool True if running.
+ */
+bool SensorAcquisition::isRunning() const {
+    return running.load();
+}
+
+/**
+ * @brief Gets the number of samples acquired on a channel.
+ *
+ * @param channel The channel.
+ * @return long long The number of samples since construction.
+ */
+long long SensorAcquisition::getSampleCount(SENSOR_CHANNEL channel) const {
+    if (channel < 0 || channel >= CHANNEL_COUNT) {
+        return 0;
+    }
+    return sampleCount[channel].load();
+}
+
+/**
+ * @brief Main loop of the acquisition thread.
+ *
+ * Each channel has its own deadline. The thread polls every channel that is due, then
+ * sleeps until the earliest next deadline. A channel that falls behind is rescheduled
+ * from the current time instead of trying to catch up with a burst of samples.
+ */
+void SensorAcquisition::run() {
+    const bool available[CHANNEL_COUNT] = { irSensor != nullptr, lidarSensor != nullptr, robotInterface != nullptr };
+    std::int64_t nextDue[CHANNEL_COUNT];
+    std::int64_t start = ScanRing::now();
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        nextDue[c] = start;
+    }
+
+    while (running.load()) {
+        std::int64_t now = ScanRing::now();
+        std::int64_t earliest = now + 100000000; // Wake up at least every 100 ms to check for stop().
+        for (int c = 0; c < CHANNEL_COUNT; ++c) {
+            if (!available[c] || activePeriodNs[c] <= 0) {
+                continue;
+            }
+            if (nextDue[c] <= now) {
+                poll(static_cast<SENSOR_CHANNEL>(c));
+                nextDue[c] += activePeriodNs[c];
+                if (nextDue[c] <= now) {
+                    nextDue[c] = now + activePeriodNs[c];
+                }
+            }
+            if (nextDue[c] < earliest) {
+                earliest = nextDue[c];
+            }
+        }
+        std::int64_t wait = earliest - ScanRing::now();
+        if (wait > 0) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(wait));
+        }
+    }
+}
+
+/**
+ * @brief Acquires one sample on a channel and notifies its subscribers.
+ *
+ * @param channel The channel to poll.
+ */
+void SensorAcquisition::poll(SENSOR_CHANNEL channel) {
+    if (channel == CHANNEL_IR) {
+        irSensor->update();
+        IRSample sample;
+        sample.timestampNs = ScanRing::now();
+        for (int i = 0; i < 9; ++i) {
+            sample.ranges[i] = irSensor->getRange(i);
+        }
+        std::lock_guard<std::mutex> lock(subscriberMutex);
+        for (size_t i = 0; i < irSubscribers.size(); ++i) {
+            irSubscribers[i](sample);
+        }
+    } else if (channel == CHANNEL_LIDAR) {
+        lidarSensor->update();
+        ScanView view = lidarSensor->getScan();
+        StampedScan scan;
+        scan.sequence = static_cast<std::uint64_t>(sampleCount[CHANNEL_LIDAR].load() + 1);
+        scan.timestampNs = ScanRing::now();
+        scan.ranges = view.data();
+        scan.count = view.size();
+        std::lock_guard<std::mutex> lock(subscriberMutex);
+        for (size_t i = 0; i < lidarSubscribers.size(); ++i) {
+            lidarSubscribers[i](scan);
+        }
+    } else if (channel == CHANNEL_ODOMETRY) {
+        OdometrySample sample;
+        robotInterface->getXYTh(sample.x, sample.y, sample.th);
+        sample.timestampNs = ScanRing::now();
+        std::lock_guard<std::mutex> lock(subscriberMutex);
+        for (size_t i = 0; i < odometrySubscribers.size(); ++i) {
+            odometrySubscribers[i](sample);
+        }
+    }
+    ++sampleCount[channel];
+}
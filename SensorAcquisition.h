@@ -0,0 +1,178 @@
+/**
+ * @file SensorAcquisition.h
+ * @brief Declaration of the SensorAcquisition class.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "RobotBackend.h"
+#include "IRSensor.h"
+#include "LidarSensor.h"
+
+/**
+ * @enum SENSOR_CHANNEL
+ * @brief Identifies a data source polled by SensorAcquisition.
+ */
+enum SENSOR_CHANNEL {
+    CHANNEL_IR, ///< IR range sensors
+    CHANNEL_LIDAR, ///< Lidar scans
+    CHANNEL_ODOMETRY, ///< getXYTh pose
+    CHANNEL_COUNT ///< Number of channels
+};
+
+/**
+ * @struct IRSample
+ * @brief IR readings stamped with their acquisition time.
+ */
+struct IRSample {
+    std::int64_t timestampNs; ///< Monotonic acquisition time in nanoseconds
+    double ranges[9]; ///< Range of each IR sensor in metres
+};
+
+/**
+ * @struct OdometrySample
+ * @brief Robot pose stamped with its acquisition time.
+ */
+struct OdometrySample {
+    std::int64_t timestampNs; ///< Monotonic acquisition time in nanoseconds
+    double x; ///< X position in metres
+    double y; ///< Y position in metres
+    double th; ///< Heading in radians
+};
+
+/**
+ * @class SensorAcquisition
+ * @brief Polls the robot sensors on a background thread at configurable rates.
+ *
+ * The service owns one acquisition thread that updates the IR sensor, the Lidar sensor
+ * and the odometry, each at its own rate, so sensor latency no longer depends on how
+ * fast the menu or control loop runs. Every sample is stamped with the steady clock
+ * (the same clock as ScanRing::now()) and handed to the subscribers of its channel.
+ * Lidar scans are also published to the sensor's ScanRing if one is set.
+ *
+ * The service makes its own API calls from the acquisition thread only, but it does
+ * not serialise them with anyone else's. A RobotControler driving the same API from
+ * the menu thread calls it concurrently with the acquisition thread, so while the
+ * service runs the API must tolerate calls from two threads, or the other users must
+ * leave it alone.
+ *
+ * Subscriber callbacks run on the acquisition thread and should return quickly.
+ */
+class SensorAcquisition {
+public:
+    typedef std::function<void(const IRSample&)> IRCallback; ///< IR subscriber
+    typedef std::function<void(const StampedScan&)> LidarCallback; ///< Lidar subscriber
+    typedef std::function<void(const OdometrySample&)> OdometryCallback; ///< Odometry subscriber
+
+private:
+    RobotApi* robotInterface; ///< API used for odometry
+    IRSensor* irSensor; ///< IR sensor to update, or nullptr
+    LidarSensor* lidarSensor; ///< Lidar sensor to update, or nullptr
+    std::int64_t periodNs[CHANNEL_COUNT]; ///< Polling period of each channel, 0 if disabled
+    std::int64_t activePeriodNs[CHANNEL_COUNT]; ///< Periods used by the acquisition thread, copied by start()
+    std::atomic<long long> sampleCount[CHANNEL_COUNT]; ///< Samples acquired on each channel
+    std::vector<IRCallback> irSubscribers; ///< IR subscribers
+    std::vector<LidarCallback> lidarSubscribers; ///< Lidar subscribers
+    std::vector<OdometryCallback> odometrySubscribers; ///< Odometry subscribers
+    std::mutex subscriberMutex; ///< Guards the subscriber lists
+    std::atomic<bool> running; ///< Whether the acquisition thread should keep running
+    std::thread worker; ///< Acquisition thread
+
+    /**
+     * @brief Main loop of the acquisition thread.
+     */
+    void run();
+
+    /**
+     * @brief Acquires one sample on a channel and notifies its subscribers.
+     *
+     * @param channel The channel to poll.
+     */
+    void poll(SENSOR_CHANNEL channel);
+
+    SensorAcquisition(const SensorAcquisition&);
+    SensorAcquisition& operator=(const SensorAcquisition&);
+
+public:
+    /**
+     * @brief Constructs a stopped acquisition service.
+     *
+     * By default IR is polled at 50 Hz, Lidar at 10 Hz and odometry at 50 Hz. Channels
+     * whose source is nullptr are never polled.
+     *
+     * @param api Pointer to the backend object, used for odometry.
+     * @param ir Pointer to the IR sensor.
+     * @param lidar Pointer to the Lidar sensor.
+     */
+    SensorAcquisition(RobotApi* api, IRSensor* ir, LidarSensor* lidar);
+
+    /**
+     * @brief Destructor. Stops the acquisition thread.
+     */
+    ~SensorAcquisition();
+
+    /**
+     * @brief Sets the polling rate of a channel.
+     *
+     * Takes effect at the next start(); the running thread keeps its own copy of the
+     * rates, so this may be called while it runs.
+     *
+     * @param channel The channel.
+     * @param hz Polling rate in Hz; 0 or less disables the channel.
+     */
+    void setRate(SENSOR_CHANNEL channel, double hz);
+
+    /**
+     * @brief Adds an IR subscriber.
+     *
+     * @param callback Function called with every IR sample.
+     */
+    void subscribeIR(const IRCallback& callback);
+
+    /**
+     * @brief Adds a Lidar subscriber.
+     *
+     * @param callback Function called with every scan. The scan view is only valid during the call.
+     */
+    void subscribeLidar(const LidarCallback& callback);
+
+    /**
+     * @brief Adds an odometry subscriber.
+     *
+     * @param callback Function called with every pose sample.
+     */
+    void subscribeOdometry(const OdometryCallback& callback);
+
+    /**
+     * @brief Starts the acquisition thread.
+     *
+     * @return bool True if the thread was started, false if it was already running.
+     */
+    bool start();
+
+    /**
+     * @brief Stops the acquisition thread and waits for it to finish.
+     */
+    void stop();
+
+    /**
+     * @brief Checks whether the acquisition thread is running.
+     *
+     * @return bool True if running.
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Gets the number of samples acquired on a channel.
+     *
+     * @param channel The channel.
+     * @return long long The number of samples since construction.
+     */
+    long long getSampleCount(SENSOR_CHANNEL channel) const;
+};
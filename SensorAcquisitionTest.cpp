@@ -0,0 +1,101 @@
+/**
+ * @file SensorAcquisitionTest.cpp
+ * @brief Test file for the SensorAcquisition class.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "SensorAcquisition.h"
+
+/**
+ * @brief Main function to test the SensorAcquisition class.
+ *
+ * This function performs various tests on the SensorAcquisition class, on the default
+ * backend of createRobotApi() (the simulator outside Windows):
+ * - Subscribes to IR, Lidar and odometry samples.
+ * - Runs the acquisition thread for half a second at different rates per channel.
+ * - Checks that samples arrive with increasing timestamps while the main thread is busy
+ *   and that Lidar scans carry consecutive sequence numbers.
+ * - Changes a rate while running, which only applies from the next start().
+ * - Stops the service and checks that no more samples arrive.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- SensorAcquisition Test Start -----\n";
+
+    RobotApi* api = createRobotApi();
+    api->connect();
+    IRSensor ir(api);
+    LidarSensor lidar(api);
+    ScanRing ring(16, lidar.getRangeNumber());
+    lidar.setScanRing(&ring);
+
+    // 1. Subscribers
+    SensorAcquisition acquisition(api, &ir, &lidar);
+    acquisition.setRate(CHANNEL_IR, 100.0);
+    acquisition.setRate(CHANNEL_LIDAR, 20.0);
+    acquisition.setRate(CHANNEL_ODOMETRY, 50.0);
+
+    std::atomic<int> irCount(0), lidarCount(0), poseCount(0);
+    std::atomic<bool> ordered(true), consecutive(true);
+    std::int64_t lastPose = 0;
+    std::uint64_t lastSequence = 0;
+    acquisition.subscribeIR([&](const IRSample& s) {
+        if (s.ranges[0] >= 0.0) {
+            ++irCount;
+        }
+    });
+    acquisition.subscribeLidar([&](const StampedScan& s) {
+        if (s.sequence != lastSequence + 1) {
+            consecutive = false;
+        }
+        lastSequence = s.sequence;
+        if (s.count == lidar.getRangeNumber()) {
+            ++lidarCount;
+        }
+    });
+    acquisition.subscribeOdometry([&](const OdometrySample& s) {
+        if (s.timestampNs <= lastPose) {
+            ordered = false;
+        }
+        lastPose = s.timestampNs;
+        ++poseCount;
+    });
+
+    // 2. Run while the main thread is busy; the new IR rate waits for the next start()
+    std::cout << "[Test] start() => " << acquisition.start() << ", second start() => " << acquisition.start() << "\n";
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    acquisition.setRate(CHANNEL_IR, 0.0);
+    int irBefore = irCount.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    acquisition.stop();
+    std::cout << "[Test] After 0.5 s: IR " << irCount.load() << " (~50), Lidar " << lidarCount.load()
+              << " (~10), odometry " << poseCount.load() << " (~25), ring seq " << ring.getLatestSequence() << "\n";
+    std::cout << "[Test] IR kept polling after setRate(0) while running => " << (irCount.load() > irBefore) << "\n";
+    std::cout << "[Test] Odometry timestamps increasing => " << ordered.load() << ", Lidar sequences consecutive => "
+              << consecutive.load() << ", match the ring => "
+              << (ring.getLatestSequence() == static_cast<std::uint64_t>(lidarCount.load())) << "\n";
+
+    // 3. Stopped service delivers nothing
+    int before = irCount.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::cout << "[Test] Running => " << acquisition.isRunning() << ", samples after stop => "
+              << (irCount.load() - before) << "\n";
+
+    // 4. The IR rate of 0 applies from the restart
+    before = irCount.load();
+    int lidarBefore = lidarCount.load();
+    acquisition.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    acquisition.stop();
+    std::cout << "[Test] After restart: IR samples => " << (irCount.load() - before) << " (0), Lidar samples => "
+              << (lidarCount.load() - lidarBefore) << " (~4), sequences consecutive => " << consecutive.load() << "\n";
+
+    api->disconnect();
+    delete api;
+    std::cout << "----- SensorAcquisition Test Complete -----\n";
+    return 0;
+}
@@ -0,0 +1,740 @@
+/**
+ * @file SensorLog.cpp
+ * @brief Implementation of the binary sensor log writer and reader.
+ */
+
+#include "SensorLog.h"
+#include <cstring>
+
+namespace {
+
+const char LOG_MAGIC[4] = { 'S', 'L', 'O', 'G' };
+const char CHUNK_MAGIC[4] = { 'C', 'H', 'N', 'K' };
+const char INDEX_MAGIC[4] = { 'S', 'I', 'D', 'X' };
+const std::uint32_t LOG_VERSION = 3;
+
+/**
+ * @brief Rounds a size up to the 8-byte record alignment.
+ *
+ * @param size The size in bytes.
+ * @return std::size_t The padded size.
+ */
+inline std::size_t paddedSize(std::size_t size) {
+    return (size + 7) & ~static_cast<std::size_t>(7);
+}
+
+/**
+ * @brief Gets the records of a chunk.
+ *
+ * @param header The chunk header.
+ * @return const char* The first record.
+ */
+inline const char* chunkRecords(const SensorChunkHeader* header) {
+    return reinterpret_cast<const char*>(header) + sizeof(SensorChunkHeader);
+}
+
+/**
+ * @brief Gets the record index of a chunk.
+ *
+ * @param header The chunk header.
+ * @return const std::uint32_t* The offset of each record from the first one.
+ */
+inline const std::uint32_t* chunkIndexOf(const SensorChunkHeader* header) {
+    return reinterpret_cast<const std::uint32_t*>(chunkRecords(header) + header->dataSize);
+}
+
+/**
+ * @brief Fills a view from a record inside a chunk.
+ *
+ * @param header The chunk header.
+ * @param offset Offset of the record from the first record of the chunk.
+ * @param view Receives the view.
+ * @return bool False if the record does not fit in the chunk.
+ */
+bool viewRecord(const SensorChunkHeader* header, std::uint64_t offset, SensorRecordView& view) {
+    if (offset + sizeof(SensorRecordHeader) > header->dataSize) {
+        return false;
+    }
+    const char* at = chunkRecords(header) + offset;
+    const SensorRecordHeader* record = reinterpret_cast<const SensorRecordHeader*>(at);
+    if (offset + sizeof(SensorRecordHeader) + record->size > header->dataSize) {
+        return false;
+    }
+    view.type = static_cast<SENSOR_RECORD_TYPE>(record->type);
+    view.timestampNs = record->timestampNs;
+    view.payload = at + sizeof(SensorRecordHeader);
+    view.size = record->size;
+    return true;
+}
+
+/**
+ * @brief Gets the size of a whole chunk: header, records and padded record index.
+ *
+ * @param header The chunk header.
+ * @return std::uint64_t The size in bytes.
+ */
+inline std::uint64_t chunkSize(const SensorChunkHeader* header) {
+    return sizeof(SensorChunkHeader) + header->dataSize + paddedSize(header->recordCount * sizeof(std::uint32_t));
+}
+
+/**
+ * @brief Gets the header of a record of a chunk through the chunk's record index.
+ *
+ * @param header The chunk header.
+ * @param index The record index, below recordCount.
+ * @return const SensorRecordHeader* The record header, or nullptr if its offset lies
+ *         outside the records of the chunk.
+ */
+inline const SensorRecordHeader* recordHeaderAt(const SensorChunkHeader* header, std::uint32_t index) {
+    std::uint64_t offset = chunkIndexOf(header)[index];
+    if (offset + sizeof(SensorRecordHeader) > header->dataSize) {
+        return nullptr;
+    }
+    return reinterpret_cast<const SensorRecordHeader*>(chunkRecords(header) + offset);
+}
+
+} // namespace
+
+/**
+ * @brief Constructs a writer with no open log.
+ */
+SensorLogWriter::SensorLogWriter()
+    : chunkBytes(0), chunkFirstTimestamp(0), chunkLastTimestamp(0), chunkLidarCount(0), fileOffset(0),
+      recordCount(0), scanCount(0), opened(false), failed(false) {}
+
+/**
+ * @brief Destructor. Writes any buffered records and closes the log.
+ */
+SensorLogWriter::~SensorLogWriter() {
+    close();
+}
+
+/**
+ * @brief Creates a log file and writes its header.
+ *
+ * @param filename The file to create; an existing file is truncated.
+ * @param lidarBeams Number of beams in a full Lidar scan.
+ * @param chunkSize Buffered record bytes that trigger a chunk write.
+ * @return bool True if the file was created.
+ */
+bool SensorLogWriter::open(const std::string& filename, int lidarBeams, std::size_t chunkSize) {
+    close();
+    if (!file.openFile(filename, std::ios::out | std::ios::binary | std::ios::trunc)) {
+        return false;
+    }
+    SensorLogHeader header;
+    std::memcpy(header.magic, LOG_MAGIC, sizeof(header.magic));
+    header.version = LOG_VERSION;
+    header.lidarBeams = lidarBeams > 0 ? static_cast<std::uint32_t>(lidarBeams) : 0;
+    header.reserved = 0;
+    opened = file.writeBytes(&header, sizeof(header));
+    failed = false;
+    chunkBytes = chunkSize > 0 ? chunkSize : 1;
+    chunkData.clear();
+    chunkData.reserve(chunkBytes + (64 << 10));
+    chunkIndex.clear();
+    chunkLidarCount = 0;
+    logIndex.clear();
+    fileOffset = sizeof(header);
+    recordCount = 0;
+    scanCount = 0;
+    return opened;
+}
+
+/**
+ * @brief Writes any buffered records, the chunk index and the trailer, and closes the log file.
+ */
+void SensorLogWriter::close() {
+    if (!opened) {
+        return;
+    }
+    if (flush()) {
+        SensorLogTrailer trailer;
+        trailer.indexOffset = fileOffset;
+        trailer.entryCount = logIndex.size();
+        std::memcpy(trailer.magic, INDEX_MAGIC, sizeof(trailer.magic));
+        trailer.reserved = 0;
+        if (!logIndex.empty()) {
+            file.writeBytes(logIndex.data(), logIndex.size() * sizeof(SensorIndexEntry));
+        }
+        file.writeBytes(&trailer, sizeof(trailer));
+    }
+    file.closeFile();
+    opened = false;
+}
+
+/**
+ * @brief Writes the buffered records as a chunk and flushes the file.
+ *
+ * After a failed write the file ends with an incomplete chunk; the writer then
+ * refuses every further record and writes no trailer, so readers rebuild the
+ * index and stop at the last complete chunk.
+ *
+ * @return bool True if the chunk was written or the buffer was empty.
+ */
+bool SensorLogWriter::flush() {
+    if (!opened || failed) {
+        return false;
+    }
+    if (chunkIndex.empty()) {
+        return true;
+    }
+    SensorChunkHeader header;
+    std::memcpy(header.magic, CHUNK_MAGIC, sizeof(header.magic));
+    header.recordCount = static_cast<std::uint32_t>(chunkIndex.size());
+    header.dataSize = chunkData.size();
+    header.firstTimestampNs = chunkFirstTimestamp;
+    header.lastTimestampNs = chunkLastTimestamp;
+    header.lidarCount = chunkLidarCount;
+    header.reserved = 0;
+
+    SensorIndexEntry entry;
+    entry.offset = fileOffset;
+    entry.firstRecord = recordCount - header.recordCount;
+    entry.firstScan = scanCount - chunkLidarCount;
+    entry.firstTimestampNs = chunkFirstTimestamp;
+    entry.lastTimestampNs = chunkLastTimestamp;
+
+    if (chunkIndex.size() % 2) {
+        chunkIndex.push_back(0); // pads the index to 8 bytes
+    }
+    std::size_t indexBytes = chunkIndex.size() * sizeof(std::uint32_t);
+    bool ok = file.writeBytes(&header, sizeof(header)) && file.writeBytes(chunkData.data(), chunkData.size()) &&
+              file.writeBytes(chunkIndex.data(), indexBytes) && file.flush();
+    chunkData.clear();
+    chunkIndex.clear();
+    chunkLidarCount = 0;
+    if (!ok) {
+        // The file now ends somewhere inside this chunk, so no later offset would be right.
+        failed = true;
+        return false;
+    }
+    fileOffset += sizeof(header) + header.dataSize + indexBytes;
+    logIndex.push_back(entry);
+    return true;
+}
+
+/**
+ * @brief Appends one record header and its padded payload to the current chunk.
+ *
+ * @param type The record type.
+ * @param timestampNs Time the data was read, in nanoseconds.
+ * @param payload The payload bytes.
+ * @param size The payload size in bytes.
+ * @return bool True if the record was added.
+ */
+bool SensorLogWriter::writeRecord(SENSOR_RECORD_TYPE type, std::uint64_t timestampNs, const void* payload, std::uint32_t size) {
+    if (!opened || failed) {
+        return false;
+    }
+    SensorRecordHeader header;
+    header.type = static_cast<std::uint16_t>(type);
+    header.reserved = 0;
+    header.size = size;
+    header.timestampNs = timestampNs;
+
+    if (chunkIndex.empty()) {
+        chunkFirstTimestamp = timestampNs;
+    }
+    chunkLastTimestamp = timestampNs;
+    std::size_t offset = chunkData.size();
+    chunkIndex.push_back(static_cast<std::uint32_t>(offset));
+    chunkData.resize(offset + sizeof(header) + paddedSize(size), 0);
+    std::memcpy(&chunkData[offset], &header, sizeof(header));
+    if (size > 0) {
+        std::memcpy(&chunkData[offset + sizeof(header)], payload, size);
+    }
+    ++recordCount;
+    if (type == RECORD_LIDAR) {
+        ++chunkLidarCount;
+        ++scanCount;
+    }
+
+    if (chunkData.size() >= chunkBytes) {
+        return flush();
+    }
+    return true;
+}
+
+/**
+ * @brief Appends an IR frame.
+ *
+ * @param timestampNs Time the ranges were read, in nanoseconds.
+ * @param ranges The nine IR ranges in metres.
+ * @return bool True if the record was added.
+ */
+bool SensorLogWriter::writeIR(std::uint64_t timestampNs, const double* ranges) {
+    return writeRecord(RECORD_IR, timestampNs, ranges, 9 * sizeof(double));
+}
+
+/**
+ * @brief Appends a Lidar scan.
+ *
+ * @param timestampNs Time the scan was read, in nanoseconds.
+ * @param ranges The ranges in metres.
+ * @param count Number of ranges.
+ * @return bool True if the record was added.
+ */
+bool SensorLogWriter::writeLidar(std::uint64_t timestampNs, const float* ranges, int count) {
+    if (count < 0) {
+        return false;
+    }
+    return writeRecord(RECORD_LIDAR, timestampNs, ranges, static_cast<std::uint32_t>(count * sizeof(float)));
+}
+
+/**
+ * @brief Appends a pose.
+ *
+ * @param timestampNs Time the pose was read, in nanoseconds.
+ * @param x X position in metres.
+ * @param y Y position in metres.
+ * @param th Heading in radians.
+ * @return bool True if the record was added.
+ */
+bool SensorLogWriter::writePose(std::uint64_t timestampNs, double x, double y, double th) {
+    const double pose[3] = { x, y, th };
+    return writeRecord(RECORD_POSE, timestampNs, pose, sizeof(pose));
+}
+
+/**
+ * @brief Appends a motion command.
+ *
+ * @param timestampNs Time the command was sent, in nanoseconds.
+ * @param command The command.
+ * @param direction The DIRECTION value; ignored for COMMAND_STOP.
+ * @return bool True if the record was added.
+ */
+bool SensorLogWriter::writeCommand(std::uint64_t timestampNs, ROBOT_COMMAND command, int direction) {
+    const std::uint32_t payload[2] = { static_cast<std::uint32_t>(command), static_cast<std::uint32_t>(direction) };
+    return writeRecord(RECORD_COMMAND, timestampNs, payload, sizeof(payload));
+}
+
+/**
+ * @brief Gets the number of records added since open().
+ *
+ * @return std::uint64_t The number of records.
+ */
+std::uint64_t SensorLogWriter::getRecordCount() const {
+    return recordCount;
+}
+
+/**
+ * @brief Gets the number of chunks written since open().
+ *
+ * @return std::uint64_t The number of chunks.
+ */
+std::uint64_t SensorLogWriter::getChunkCount() const {
+    return logIndex.size();
+}
+
+/**
+ * @brief Constructs a reader with no open log.
+ */
+SensorLogReader::SensorLogReader()
+    : chunkIndex(nullptr), chunkCount(0), trailerIndex(false), recordCount(0), scanCount(0), chunk(0), record(0),
+      lidarBeams(0) {}
+
+/**
+ * @brief Maps a log file, checks its header and loads or rebuilds its chunk index.
+ *
+ * @param filename The file to read.
+ * @return bool True if the file is a sensor log of a supported version.
+ */
+bool SensorLogReader::open(const std::string& filename) {
+    close();
+    if (!file.mapFile(filename)) {
+        return false;
+    }
+    const char* data = file.getMappedData();
+    const std::size_t size = file.getMappedSize();
+    const SensorLogHeader* header = reinterpret_cast<const SensorLogHeader*>(data);
+    if (size < sizeof(SensorLogHeader) ||
+        std::memcmp(header->magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 || header->version != LOG_VERSION) {
+        file.unmapFile();
+        return false;
+    }
+    lidarBeams = static_cast<int>(header->lidarBeams);
+
+    // A cleanly closed log ends with the chunk index and the trailer, and like every
+    // part of the log its size is a multiple of 8 bytes.
+    if (size >= sizeof(SensorLogHeader) + sizeof(SensorLogTrailer) && size % 8 == 0) {
+        const SensorLogTrailer* trailer = reinterpret_cast<const SensorLogTrailer*>(data + size - sizeof(SensorLogTrailer));
+        std::uint64_t indexEnd = size - sizeof(SensorLogTrailer);
+        if (std::memcmp(trailer->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 &&
+            trailer->indexOffset >= sizeof(SensorLogHeader) && trailer->indexOffset <= indexEnd &&
+            trailer->indexOffset % 8 == 0 &&
+            trailer->entryCount == (indexEnd - trailer->indexOffset) / sizeof(SensorIndexEntry) &&
+            (indexEnd - trailer->indexOffset) % sizeof(SensorIndexEntry) == 0 &&
+            isValidIndex(reinterpret_cast<const SensorIndexEntry*>(data + trailer->indexOffset), trailer->entryCount,
+                         trailer->indexOffset)) {
+            chunkIndex = reinterpret_cast<const SensorIndexEntry*>(data + trailer->indexOffset);
+            chunkCount = static_cast<std::size_t>(trailer->entryCount);
+            trailerIndex = true;
+        }
+    }
+    if (!trailerIndex) {
+        rebuildIndex();
+    }
+    if (chunkCount > 0) {
+        const SensorChunkHeader* last = chunkAt(chunkCount - 1);
+        recordCount = chunkIndex[chunkCount - 1].firstRecord + last->recordCount;
+        scanCount = chunkIndex[chunkCount - 1].firstScan + last->lidarCount;
+    }
+    return true;
+}
+
+/**
+ * @brief Rebuilds the chunk index by walking the chunk headers.
+ *
+ * The walk stops at the first chunk that is damaged, cut short or whose records
+ * are not a multiple of 8 bytes.
+ */
+void SensorLogReader::rebuildIndex() {
+    const char* data = file.getMappedData();
+    const std::size_t size = file.getMappedSize();
+    std::uint64_t records = 0;
+    std::uint64_t scans = 0;
+    std::size_t at = sizeof(SensorLogHeader);
+    while (size - at >= sizeof(SensorChunkHeader)) {
+        const SensorChunkHeader* header = reinterpret_cast<const SensorChunkHeader*>(data + at);
+        if (std::memcmp(header->magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) != 0 ||
+            header->dataSize > size - at - sizeof(SensorChunkHeader) || header->dataSize % 8 != 0) {
+            break;
+        }
+        std::uint64_t total = chunkSize(header);
+        if (total > size - at) {
+            break;
+        }
+        SensorIndexEntry entry;
+        entry.offset = at;
+        entry.firstRecord = records;
+        entry.firstScan = scans;
+        entry.firstTimestampNs = header->firstTimestampNs;
+        entry.lastTimestampNs = header->lastTimestampNs;
+        rebuiltIndex.push_back(entry);
+        records += header->recordCount;
+        scans += header->lidarCount;
+        at += static_cast<std::size_t>(total);
+    }
+    chunkIndex = rebuiltIndex.empty() ? nullptr : rebuiltIndex.data();
+    chunkCount = rebuiltIndex.size();
+}
+
+/**
+ * @brief Checks the chunk index of a trailer against the file.
+ *
+ * The entries must point at complete chunks that follow each other from the log
+ * header up to the index, with the timestamps of their chunk headers and record and
+ * scan numbers that follow from the earlier chunks.
+ *
+ * @param entries The index entries, inside the mapping.
+ * @param count Number of entries.
+ * @param indexOffset File offset of the first entry.
+ * @return bool True if the index can be used.
+ */
+bool SensorLogReader::isValidIndex(const SensorIndexEntry* entries, std::uint64_t count, std::uint64_t indexOffset) const {
+    const char* data = file.getMappedData();
+    std::uint64_t end = sizeof(SensorLogHeader);
+    std::uint64_t records = 0;
+    std::uint64_t scans = 0;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        const SensorIndexEntry& entry = entries[i];
+        if (entry.offset != end || indexOffset - entry.offset < sizeof(SensorChunkHeader) ||
+            entry.firstRecord != records || entry.firstScan != scans) {
+            return false;
+        }
+        const SensorChunkHeader* header = reinterpret_cast<const SensorChunkHeader*>(data + entry.offset);
+        if (std::memcmp(header->magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) != 0 ||
+            header->dataSize > indexOffset - entry.offset - sizeof(SensorChunkHeader) || header->dataSize % 8 != 0 ||
+            chunkSize(header) > indexOffset - entry.offset || entry.firstTimestampNs != header->firstTimestampNs ||
+            entry.lastTimestampNs != header->lastTimestampNs) {
+            return false;
+        }
+        end = entry.offset + chunkSize(header);
+        records += header->recordCount;
+        scans += header->lidarCount;
+    }
+    return end == indexOffset;
+}
+
+/**
+ * @brief Releases the mapping. Views returned earlier become invalid.
+ */
+void SensorLogReader::close() {
+    file.unmapFile();
+    chunkIndex = nullptr;
+    chunkCount = 0;
+    rebuiltIndex.clear();
+    trailerIndex = false;
+    recordCount = 0;
+    scanCount = 0;
+    chunk = 0;
+    record = 0;
+    lidarBeams = 0;
+}
+
+/**
+ * @brief Checks whether a log is open.
+ *
+ * @return bool True if open.
+ */
+bool SensorLogReader::isOpen() const {
+    return file.getMappedData() != nullptr;
+}
+
+/**
+ * @brief Gets the header of a chunk.
+ *
+ * @param index The chunk index.
+ * @return const SensorChunkHeader* The header, inside the mapping.
+ */
+const SensorChunkHeader* SensorLogReader::chunkAt(std::size_t index) const {
+    return reinterpret_cast<const SensorChunkHeader*>(file.getMappedData() + chunkIndex[index].offset);
+}
+
+/**
+ * @brief Reads the next record.
+ *
+ * @param view Receives a view of the record.
+ * @return bool True if a record was read, false at the end of the log.
+ */
+bool SensorLogReader::next(SensorRecordView& view) {
+    while (chunk < chunkCount) {
+        if (record < chunkAt(chunk)->recordCount && getRecord(chunk, record, view)) {
+            ++record;
+            return true;
+        }
+        ++chunk;
+        record = 0;
+    }
+    return false;
+}
+
+/**
+ * @brief Moves back to the first record.
+ */
+void SensorLogReader::rewind() {
+    seekChunk(0);
+}
+
+/**
+ * @brief Moves to the first record of a chunk.
+ *
+ * @param index The chunk index; past the last chunk moves to the end of the log.
+ */
+void SensorLogReader::seekChunk(std::size_t index) {
+    chunk = index < chunkCount ? index : chunkCount;
+    record = 0;
+}
+
+/**
+ * @brief Moves to the first record with a timestamp at or after the given time.
+ *
+ * Assumes the records were written in time order.
+ *
+ * @param timestampNs The time in nanoseconds.
+ * @return bool False if every record is earlier; the reader is then at the end of the log.
+ */
+bool SensorLogReader::seekTime(std::uint64_t timestampNs) {
+    // First chunk that ends at or after the time.
+    std::size_t lo = 0, hi = chunkCount;
+    while (lo < hi) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (chunkIndex[mid].lastTimestampNs < timestampNs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    seekChunk(lo);
+    if (lo == chunkCount) {
+        return false;
+    }
+    // First record of that chunk at or after the time.
+    // A record whose offset lies outside its chunk sorts last; next() skips it.
+    const SensorChunkHeader* header = chunkAt(lo);
+    std::uint32_t first = 0, last = header->recordCount;
+    while (first < last) {
+        std::uint32_t mid = first + (last - first) / 2;
+        const SensorRecordHeader* at = recordHeaderAt(header, mid);
+        if (at && at->timestampNs < timestampNs) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    record = first;
+    return true;
+}
+
+/**
+ * @brief Moves to a record by its position in the log.
+ *
+ * @param number The record number, counting from 0.
+ * @return bool False if the log has fewer records; the reader is then at the end of the log.
+ */
+bool SensorLogReader::seekRecord(std::uint64_t number) {
+    if (number >= recordCount) {
+        seekChunk(chunkCount);
+        return false;
+    }
+    // Last chunk starting at or before the record.
+    std::size_t lo = 0, hi = chunkCount;
+    while (hi - lo > 1) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (chunkIndex[mid].firstRecord <= number) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    chunk = lo;
+    record = static_cast<std::uint32_t>(number - chunkIndex[lo].firstRecord);
+    return true;
+}
+
+/**
+ * @brief Moves to a Lidar scan by its position among the scans of the log.
+ *
+ * The chunk is found by binary search; the scan is then found among the record
+ * headers of that chunk.
+ *
+ * @param number The scan number, counting from 0.
+ * @return bool False if the log has fewer scans; the reader is then at the end of the log.
+ */
+bool SensorLogReader::seekScan(std::uint64_t number) {
+    if (number >= scanCount) {
+        seekChunk(chunkCount);
+        return false;
+    }
+    // Last chunk whose first scan is at or before the scan; chunks without scans are skipped.
+    std::size_t lo = 0, hi = chunkCount;
+    while (hi - lo > 1) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (chunkIndex[mid].firstScan <= number) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    while (chunkAt(lo)->lidarCount == 0) {
+        --lo;
+    }
+    const SensorChunkHeader* header = chunkAt(lo);
+    std::uint64_t remaining = number - chunkIndex[lo].firstScan;
+    for (std::uint32_t r = 0; r < header->recordCount; ++r) {
+        const SensorRecordHeader* at = recordHeaderAt(header, r);
+        if (at && at->type == RECORD_LIDAR) {
+            if (remaining == 0) {
+                chunk = lo;
+                record = r;
+                return true;
+            }
+            --remaining;
+        }
+    }
+    seekChunk(chunkCount);
+    return false;
+}
+
+/**
+ * @brief Gets a record by chunk and position, using the chunk index.
+ *
+ * @param chunkNumber The chunk index.
+ * @param recordIndex The record index within the chunk.
+ * @param view Receives a view of the record.
+ * @return bool True if the record exists.
+ */
+bool SensorLogReader::getRecord(std::size_t chunkNumber, std::uint32_t recordIndex, SensorRecordView& view) const {
+    if (chunkNumber >= chunkCount) {
+        return false;
+    }
+    const SensorChunkHeader* header = chunkAt(chunkNumber);
+    if (recordIndex >= header->recordCount) {
+        return false;
+    }
+    return viewRecord(header, chunkIndexOf(header)[recordIndex], view);
+}
+
+/**
+ * @brief Gets the number of complete chunks.
+ *
+ * @return std::size_t The number of chunks.
+ */
+std::size_t SensorLogReader::getChunkCount() const {
+    return chunkCount;
+}
+
+/**
+ * @brief Gets the header of a chunk.
+ *
+ * @param index The chunk index, below getChunkCount().
+ * @return const SensorChunkHeader& The header, inside the mapping.
+ */
+const SensorChunkHeader& SensorLogReader::getChunkHeader(std::size_t index) const {
+    return *chunkAt(index);
+}
+
+/**
+ * @brief Gets the index entry of a chunk.
+ *
+ * @param index The chunk index, below getChunkCount().
+ * @return const SensorIndexEntry& The entry.
+ */
+const SensorIndexEntry& SensorLogReader::getIndexEntry(std::size_t index) const {
+    return chunkIndex[index];
+}
+
+/**
+ * @brief Checks whether the chunk index was read from the trailer.
+ *
+ * @return bool True if read from the trailer, false if it was rebuilt on open.
+ */
+bool SensorLogReader::hasTrailerIndex() const {
+    return trailerIndex;
+}
+
+/**
+ * @brief Gets the number of records in all complete chunks.
+ *
+ * @return std::uint64_t The number of records.
+ */
+std::uint64_t SensorLogReader::getRecordCount() const {
+    return recordCount;
+}
+
+/**
+ * @brief Gets the number of Lidar scans in all complete chunks.
+ *
+ * @return std::uint64_t The number of scans.
+ */
+std::uint64_t SensorLogReader::getScanCount() const {
+    return scanCount;
+}
+
+/**
+ * @brief Gets the timestamp of the first record.
+ *
+ * @return std::uint64_t The time in nanoseconds, or 0 for an empty log.
+ */
+std::uint64_t SensorLogReader::getStartTime() const {
+    return chunkCount > 0 ? chunkIndex[0].firstTimestampNs : 0;
+}
+
+/**
+ * @brief Gets the timestamp of the last record.
+ *
+ * @return std::uint64_t The time in nanoseconds, or 0 for an empty log.
+ */
+std::uint64_t SensorLogReader::getEndTime() const {
+    return chunkCount > 0 ? chunkIndex[chunkCount - 1].lastTimestampNs : 0;
+}
+
+/**
+ * @brief Gets the number of beams in a full Lidar scan.
+ *
+ * @return int The number of beams, as given to SensorLogWriter::open().
+ */
+int SensorLogReader::getLidarBeams() const {
+    return lidarBeams;
+}
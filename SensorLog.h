@@ -0,0 +1,497 @@
+/**
+ * @file SensorLog.h
+ * @brief Declaration of the binary sensor log writer and reader.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Record.h"
+
+/**
+ * @enum SENSOR_RECORD_TYPE
+ * @brief Type of a record in a sensor log.
+ */
+enum SENSOR_RECORD_TYPE {
+    RECORD_IR = 1, ///< Nine IR ranges as doubles, in metres
+    RECORD_LIDAR = 2, ///< One Lidar scan as floats, in metres
+    RECORD_POSE = 3, ///< x, y and heading as doubles, in metres and radians
+    RECORD_COMMAND = 4 ///< A ROBOT_COMMAND and a DIRECTION as two 32-bit integers
+};
+
+/**
+ * @enum ROBOT_COMMAND
+ * @brief Motion command stored in a RECORD_COMMAND record.
+ */
+enum ROBOT_COMMAND {
+    COMMAND_MOVE = 1, ///< move(direction)
+    COMMAND_ROTATE = 2, ///< rotate(direction)
+    COMMAND_STOP = 3 ///< stop()
+};
+
+/**
+ * @struct SensorLogHeader
+ * @brief Fixed header at the start of a sensor log.
+ */
+struct SensorLogHeader {
+    char magic[4]; ///< "SLOG"
+    std::uint32_t version; ///< Format version
+    std::uint32_t lidarBeams; ///< Number of beams in a full Lidar scan
+    std::uint32_t reserved; ///< Zero
+};
+
+/**
+ * @struct SensorChunkHeader
+ * @brief Header of a chunk of records.
+ *
+ * A chunk is the header, dataSize bytes of records, then an index of recordCount
+ * 32-bit offsets of each record from the first one, padded to 8 bytes.
+ */
+struct SensorChunkHeader {
+    char magic[4]; ///< "CHNK"
+    std::uint32_t recordCount; ///< Number of records in the chunk
+    std::uint64_t dataSize; ///< Size of the records in bytes
+    std::uint64_t firstTimestampNs; ///< Timestamp of the first record
+    std::uint64_t lastTimestampNs; ///< Timestamp of the last record
+    std::uint32_t lidarCount; ///< Number of RECORD_LIDAR records in the chunk
+    std::uint32_t reserved; ///< Zero
+};
+
+/**
+ * @struct SensorIndexEntry
+ * @brief Entry of the log-wide chunk index.
+ *
+ * The entries of a log are sorted by file offset, record number and scan number, and
+ * by timestamp as long as the records were written in time order.
+ */
+struct SensorIndexEntry {
+    std::uint64_t offset; ///< File offset of the chunk header
+    std::uint64_t firstRecord; ///< Number of records in all earlier chunks
+    std::uint64_t firstScan; ///< Number of Lidar scans in all earlier chunks
+    std::uint64_t firstTimestampNs; ///< Timestamp of the first record of the chunk
+    std::uint64_t lastTimestampNs; ///< Timestamp of the last record of the chunk
+};
+
+/**
+ * @struct SensorLogTrailer
+ * @brief Footer at the very end of a cleanly closed log.
+ *
+ * The chunk index, one SensorIndexEntry per chunk, sits right before the trailer, so
+ * a reader can find every chunk without touching them.
+ */
+struct SensorLogTrailer {
+    std::uint64_t indexOffset; ///< File offset of the first index entry
+    std::uint64_t entryCount; ///< Number of index entries
+    char magic[4]; ///< "SIDX"
+    std::uint32_t reserved; ///< Zero
+};
+
+/**
+ * @struct SensorRecordHeader
+ * @brief Header in front of every record payload.
+ *
+ * Payloads are padded to a multiple of 8 bytes, so every header and payload in the
+ * file stays 8-byte aligned.
+ */
+struct SensorRecordHeader {
+    std::uint16_t type; ///< A SENSOR_RECORD_TYPE
+    std::uint16_t reserved; ///< Zero
+    std::uint32_t size; ///< Payload size in bytes, before padding
+    std::uint64_t timestampNs; ///< Time the data was read, in nanoseconds
+};
+
+/**
+ * @struct SensorRecordView
+ * @brief Non-owning view of one record inside a mapped sensor log.
+ *
+ * The payload pointers stay valid while the reader that produced the view is open.
+ */
+struct SensorRecordView {
+    SENSOR_RECORD_TYPE type; ///< Record type
+    std::uint64_t timestampNs; ///< Time the data was read, in nanoseconds
+    const void* payload; ///< First payload byte
+    std::uint32_t size; ///< Payload size in bytes
+
+    /**
+     * @brief Gets the IR ranges of a RECORD_IR record.
+     *
+     * @return const double* Nine ranges in metres.
+     */
+    const double* irRanges() const { return static_cast<const double*>(payload); }
+
+    /**
+     * @brief Gets the ranges of a RECORD_LIDAR record.
+     *
+     * @return const float* lidarCount() ranges in metres.
+     */
+    const float* lidarRanges() const { return static_cast<const float*>(payload); }
+
+    /**
+     * @brief Gets the number of ranges of a RECORD_LIDAR record.
+     *
+     * @return int The number of ranges.
+     */
+    int lidarCount() const { return static_cast<int>(size / sizeof(float)); }
+
+    /**
+     * @brief Gets the pose of a RECORD_POSE record.
+     *
+     * @return const double* x and y in metres, heading in radians.
+     */
+    const double* pose() const { return static_cast<const double*>(payload); }
+
+    /**
+     * @brief Gets the command of a RECORD_COMMAND record.
+     *
+     * @return ROBOT_COMMAND The command.
+     */
+    ROBOT_COMMAND command() const { return static_cast<ROBOT_COMMAND>(static_cast<const std::uint32_t*>(payload)[0]); }
+
+    /**
+     * @brief Gets the direction of a RECORD_COMMAND record.
+     *
+     * @return int The DIRECTION value; unused for COMMAND_STOP.
+     */
+    int direction() const { return static_cast<int>(static_cast<const std::uint32_t*>(payload)[1]); }
+};
+
+/**
+ * @class SensorLogWriter
+ * @brief Appends typed sensor records to a binary log file.
+ *
+ * Records are collected in a memory buffer and written one chunk at a time, together
+ * with the chunk's index, so the file sees a few large writes instead of one per
+ * record. Records still in the buffer are written by flush(), close() and the
+ * destructor. close() also appends the log-wide chunk index and trailer; a log
+ * that was never closed can still be read, its index is then rebuilt on open.
+ */
+class SensorLogWriter {
+private:
+    Record file; ///< Output file
+    std::vector<char> chunkData; ///< Records of the current chunk
+    std::vector<std::uint32_t> chunkIndex; ///< Offset of each record in chunkData
+    std::size_t chunkBytes; ///< Chunk size that triggers a write
+    std::uint64_t chunkFirstTimestamp; ///< Timestamp of the first record in the chunk
+    std::uint64_t chunkLastTimestamp; ///< Timestamp of the last record in the chunk
+    std::uint32_t chunkLidarCount; ///< Number of scans in the chunk
+    std::vector<SensorIndexEntry> logIndex; ///< One entry per chunk written
+    std::uint64_t fileOffset; ///< Bytes written to the file
+    std::uint64_t recordCount; ///< Number of records written
+    std::uint64_t scanCount; ///< Number of scans written
+    bool opened; ///< Whether a log is open
+    bool failed; ///< Whether a chunk write failed; nothing more is written to the file
+
+    SensorLogWriter(const SensorLogWriter&);
+    SensorLogWriter& operator=(const SensorLogWriter&);
+
+    /**
+     * @brief Appends one record header and its padded payload to the current chunk.
+     *
+     * @param type The record type.
+     * @param timestampNs Time the data was read, in nanoseconds.
+     * @param payload The payload bytes.
+     * @param size The payload size in bytes.
+     * @return bool True if the record was added.
+     */
+    bool writeRecord(SENSOR_RECORD_TYPE type, std::uint64_t timestampNs, const void* payload, std::uint32_t size);
+
+public:
+    /**
+     * @brief Constructs a writer with no open log.
+     */
+    SensorLogWriter();
+
+    /**
+     * @brief Destructor. Writes any buffered records and closes the log.
+     */
+    ~SensorLogWriter();
+
+    /**
+     * @brief Creates a log file and writes its header.
+     *
+     * @param filename The file to create; an existing file is truncated.
+     * @param lidarBeams Number of beams in a full Lidar scan.
+     * @param chunkSize Buffered record bytes that trigger a chunk write.
+     * @return bool True if the file was created.
+     */
+    bool open(const std::string& filename, int lidarBeams, std::size_t chunkSize = 1 << 20);
+
+    /**
+     * @brief Writes any buffered records, the chunk index and the trailer, and closes the log file.
+     */
+    void close();
+
+    /**
+     * @brief Writes the buffered records as a chunk and flushes the file.
+     *
+     * After a failed write the file ends with an incomplete chunk; the writer then
+     * refuses every further record and writes no trailer, so readers rebuild the
+     * index and stop at the last complete chunk.
+     *
+     * @return bool True if the chunk was written or the buffer was empty.
+     */
+    bool flush();
+
+    /**
+     * @brief Appends an IR frame.
+     *
+     * @param timestampNs Time the ranges were read, in nanoseconds.
+     * @param ranges The nine IR ranges in metres.
+     * @return bool True if the record was added.
+     */
+    bool writeIR(std::uint64_t timestampNs, const double* ranges);
+
+    /**
+     * @brief Appends a Lidar scan.
+     *
+     * @param timestampNs Time the scan was read, in nanoseconds.
+     * @param ranges The ranges in metres.
+     * @param count Number of ranges.
+     * @return bool True if the record was added.
+     */
+    bool writeLidar(std::uint64_t timestampNs, const float* ranges, int count);
+
+    /**
+     * @brief Appends a pose.
+     *
+     * @param timestampNs Time the pose was read, in nanoseconds.
+     * @param x X position in metres.
+     * @param y Y position in metres.
+     * @param th Heading in radians.
+     * @return bool True if the record was added.
+     */
+    bool writePose(std::uint64_t timestampNs, double x, double y, double th);
+
+    /**
+     * @brief Appends a motion command.
+     *
+     * @param timestampNs Time the command was sent, in nanoseconds.
+     * @param command The command.
+     * @param direction The DIRECTION value; ignored for COMMAND_STOP.
+     * @return bool True if the record was added.
+     */
+    bool writeCommand(std::uint64_t timestampNs, ROBOT_COMMAND command, int direction = 0);
+
+    /**
+     * @brief Gets the number of records added since open().
+     *
+     * @return std::uint64_t The number of records.
+     */
+    std::uint64_t getRecordCount() const;
+
+    /**
+     * @brief Gets the number of chunks written since open().
+     *
+     * @return std::uint64_t The number of chunks.
+     */
+    std::uint64_t getChunkCount() const;
+};
+
+/**
+ * @class SensorLogReader
+ * @brief Reads a sensor log in place through a read-only memory mapping.
+ *
+ * Records are returned as views into the mapping, so reading does no I/O, no parsing
+ * and no copying once the file is open. The chunk index is taken from the trailer of
+ * a cleanly closed log, so opening does not depend on the size of the file;
+ * otherwise it is rebuilt from the chunk headers. With the chunk index and the
+ * per-chunk record index, seeking by time, record number or scan number is a pair
+ * of binary searches. A chunk cut short at the end of the file, as left by a writer
+ * that did not finish, ends the log.
+ */
+class SensorLogReader {
+private:
+    Record file; ///< Mapped input file
+    const SensorIndexEntry* chunkIndex; ///< Chunk index, in the trailer or in rebuiltIndex
+    std::size_t chunkCount; ///< Number of complete chunks
+    std::vector<SensorIndexEntry> rebuiltIndex; ///< Chunk index of a log without trailer
+    bool trailerIndex; ///< Whether the index comes from the trailer
+    std::uint64_t recordCount; ///< Number of records in all chunks
+    std::uint64_t scanCount; ///< Number of scans in all chunks
+    std::size_t chunk; ///< Chunk of the next record
+    std::uint32_t record; ///< Index of the next record in its chunk
+    int lidarBeams; ///< Number of beams in a full Lidar scan
+
+    /**
+     * @brief Rebuilds the chunk index by walking the chunk headers.
+     *
+     * The walk stops at the first chunk that is damaged, cut short or whose records
+     * are not a multiple of 8 bytes.
+     */
+    void rebuildIndex();
+
+    /**
+     * @brief Checks the chunk index of a trailer against the file.
+     *
+     * The entries must point at complete chunks that follow each other from the log
+     * header up to the index, with the timestamps of their chunk headers and record and
+     * scan numbers that follow from the earlier chunks.
+     *
+     * @param entries The index entries, inside the mapping.
+     * @param count Number of entries.
+     * @param indexOffset File offset of the first entry.
+     * @return bool True if the index can be used.
+     */
+    bool isValidIndex(const SensorIndexEntry* entries, std::uint64_t count, std::uint64_t indexOffset) const;
+
+    /**
+     * @brief Gets the header of a chunk.
+     *
+     * @param index The chunk index.
+     * @return const SensorChunkHeader* The header, inside the mapping.
+     */
+    const SensorChunkHeader* chunkAt(std::size_t index) const;
+
+public:
+    /**
+     * @brief Constructs a reader with no open log.
+     */
+    SensorLogReader();
+
+    /**
+     * @brief Maps a log file, checks its header and loads or rebuilds its chunk index.
+     *
+     * @param filename The file to read.
+     * @return bool True if the file is a sensor log of a supported version.
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Releases the mapping. Views returned earlier become invalid.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether a log is open.
+     *
+     * @return bool True if open.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Reads the next record.
+     *
+     * @param view Receives a view of the record.
+     * @return bool True if a record was read, false at the end of the log.
+     */
+    bool next(SensorRecordView& view);
+
+    /**
+     * @brief Moves back to the first record.
+     */
+    void rewind();
+
+    /**
+     * @brief Moves to the first record of a chunk.
+     *
+     * @param index The chunk index; past the last chunk moves to the end of the log.
+     */
+    void seekChunk(std::size_t index);
+
+    /**
+     * @brief Moves to the first record with a timestamp at or after the given time.
+     *
+     * Assumes the records were written in time order.
+     *
+     * @param timestampNs The time in nanoseconds.
+     * @return bool False if every record is earlier; the reader is then at the end of the log.
+     */
+    bool seekTime(std::uint64_t timestampNs);
+
+    /**
+     * @brief Moves to a record by its position in the log.
+     *
+     * @param number The record number, counting from 0.
+     * @return bool False if the log has fewer records; the reader is then at the end of the log.
+     */
+    bool seekRecord(std::uint64_t number);
+
+    /**
+     * @brief Moves to a Lidar scan by its position among the scans of the log.
+     *
+     * The chunk is found by binary search; the scan is then found among the record
+     * headers of that chunk.
+     *
+     * @param number The scan number, counting from 0.
+     * @return bool False if the log has fewer scans; the reader is then at the end of the log.
+     */
+    bool seekScan(std::uint64_t number);
+
+    /**
+     * @brief Gets a record by chunk and position, using the chunk index.
+     *
+     * @param chunkNumber The chunk index.
+     * @param recordIndex The record index within the chunk.
+     * @param view Receives a view of the record.
+     * @return bool True if the record exists.
+     */
+    bool getRecord(std::size_t chunkNumber, std::uint32_t recordIndex, SensorRecordView& view) const;
+
+    /**
+     * @brief Gets the number of complete chunks.
+     *
+     * @return std::size_t The number of chunks.
+     */
+    std::size_t getChunkCount() const;
+
+    /**
+     * @brief Gets the header of a chunk.
+     *
+     * @param index The chunk index, below getChunkCount().
+     * @return const SensorChunkHeader& The header, inside the mapping.
+     */
+    const SensorChunkHeader& getChunkHeader(std::size_t index) const;
+
+    /**
+     * @brief Gets the index entry of a chunk.
+     *
+     * @param index The chunk index, below getChunkCount().
+     * @return const SensorIndexEntry& The entry.
+     */
+    const SensorIndexEntry& getIndexEntry(std::size_t index) const;
+
+    /**
+     * @brief Checks whether the chunk index was read from the trailer.
+     *
+     * @return bool True if read from the trailer, false if it was rebuilt on open.
+     */
+    bool hasTrailerIndex() const;
+
+    /**
+     * @brief Gets the number of records in all complete chunks.
+     *
+     * @return std::uint64_t The number of records.
+     */
+    std::uint64_t getRecordCount() const;
+
+    /**
+     * @brief Gets the number of Lidar scans in all complete chunks.
+     *
+     * @return std::uint64_t The number of scans.
+     */
+    std::uint64_t getScanCount() const;
+
+    /**
+     * @brief Gets the timestamp of the first record.
+     *
+     * @return std::uint64_t The time in nanoseconds, or 0 for an empty log.
+     */
+    std::uint64_t getStartTime() const;
+
+    /**
+     * @brief Gets the timestamp of the last record.
+     *
+     * @return std::uint64_t The time in nanoseconds, or 0 for an empty log.
+     */
+    std::uint64_t getEndTime() const;
+
+    /**
+     * @brief Gets the number of beams in a full Lidar scan.
+     *
+     * @return int The number of beams, as given to SensorLogWriter::open().
+     */
+    int getLidarBeams() const;
+};
@@ -0,0 +1,377 @@
+/**
+ * @file SensorLogTest.cpp
+ * @brief Test file for the SensorLogWriter and SensorLogReader classes.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "SensorLog.h"
+
+/**
+ * @brief Writes and reads scans as text lines through Record, the old log format.
+ *
+ * @param scans Number of scans.
+ * @param beams Ranges per scan.
+ * @param writeSeconds Receives the write time.
+ * @param readSeconds Receives the read time.
+ * @return double Sum of the ranges read back.
+ */
+double textRoundTrip(int scans, int beams, double& writeSeconds, double& readSeconds) {
+    using Clock = std::chrono::steady_clock;
+    Record record;
+    Clock::time_point t0 = Clock::now();
+    record.openFile("testSensorLog.txt", std::ios::out | std::ios::trunc);
+    for (int s = 0; s < scans; ++s) {
+        std::ostringstream line;
+        line << s;
+        for (int i = 0; i < beams; ++i) {
+            line << ' ' << (1.0f + (i % 97) * 0.01f);
+        }
+        record.writeLine(line.str());
+    }
+    record.closeFile();
+    writeSeconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    t0 = Clock::now();
+    double sum = 0.0;
+    record.openFile("testSensorLog.txt", std::ios::in);
+    std::string line;
+    std::vector<float> ranges(beams);
+    for (int s = 0; s < scans && record.readLine(line); ++s) {
+        const char* p = line.c_str();
+        char* endPtr;
+        std::strtol(p, &endPtr, 10);
+        for (int i = 0; i < beams; ++i) {
+            ranges[i] = std::strtof(endPtr, &endPtr);
+            sum += ranges[i];
+        }
+    }
+    record.closeFile();
+    readSeconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    return sum;
+}
+
+/**
+ * @brief Writes and reads scans through the binary sensor log.
+ *
+ * @param scans Number of scans.
+ * @param beams Ranges per scan.
+ * @param writeSeconds Receives the write time.
+ * @param readSeconds Receives the read time, mapping included.
+ * @return double Sum of the ranges read back.
+ */
+double binaryRoundTrip(int scans, int beams, double& writeSeconds, double& readSeconds) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<float> ranges(beams);
+    for (int i = 0; i < beams; ++i) {
+        ranges[i] = 1.0f + (i % 97) * 0.01f;
+    }
+    Clock::time_point t0 = Clock::now();
+    SensorLogWriter writer;
+    writer.open("testSensorLogBench.bin", beams);
+    for (int s = 0; s < scans; ++s) {
+        writer.writeLidar(static_cast<std::uint64_t>(s) * 100000000ULL, ranges.data(), beams);
+    }
+    writer.close();
+    writeSeconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    t0 = Clock::now();
+    double sum = 0.0;
+    SensorLogReader reader;
+    reader.open("testSensorLogBench.bin");
+    SensorRecordView view;
+    while (reader.next(view)) {
+        const float* r = view.lidarRanges();
+        for (int i = 0; i < view.lidarCount(); ++i) {
+            sum += r[i];
+        }
+    }
+    readSeconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    return sum;
+}
+
+/**
+ * @brief Times opening a long log and seeking in it.
+ *
+ * The log holds a pose and a scan every 100 ms. It is opened once with the index
+ * from the trailer and once as a copy without the trailer, whose index is rebuilt;
+ * both seeks are compared with reading records until the target.
+ *
+ * @param scans Number of scans.
+ * @param beams Ranges per scan.
+ */
+void seekBenchmark(int scans, int beams) {
+    using Clock = std::chrono::steady_clock;
+    const std::uint64_t period = 100000000ULL;
+    std::vector<float> ranges(beams, 2.0f);
+    SensorLogWriter writer;
+    writer.open("testSensorLogLong.bin", beams);
+    for (int s = 0; s < scans; ++s) {
+        std::uint64_t t = static_cast<std::uint64_t>(s) * period;
+        writer.writePose(t, s * 0.01, 0.0, 0.0);
+        writer.writeLidar(t + period / 2, ranges.data(), beams);
+    }
+    writer.close();
+    std::size_t indexBytes = writer.getChunkCount() * sizeof(SensorIndexEntry) + sizeof(SensorLogTrailer);
+    {
+        std::ifstream in("testSensorLogLong.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out("testSensorLogLongCut.bin", std::ios::binary);
+        out.write(bytes.data(), bytes.size() - indexBytes);
+    }
+
+    const std::uint64_t target = (3600ULL + 32 * 60) * 1000000000ULL; // 1h32m
+    const std::uint64_t scanTarget = static_cast<std::uint64_t>(scans) * 3 / 4;
+    const char* files[2] = { "testSensorLogLong.bin", "testSensorLogLongCut.bin" };
+    const char* labels[2] = { "trailer index", "rebuilt index" };
+    SensorRecordView view;
+    for (int f = 0; f < 2; ++f) {
+        SensorLogReader reader;
+        Clock::time_point t0 = Clock::now();
+        reader.open(files[f]);
+        double openMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        t0 = Clock::now();
+        reader.seekTime(target);
+        reader.next(view);
+        double seekUs = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+        std::uint64_t foundTime = view.timestampNs;
+        t0 = Clock::now();
+        reader.seekScan(scanTarget);
+        reader.next(view);
+        double scanUs = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+        std::cout << "[Bench] Open " << labels[f] << " (" << reader.getChunkCount() << " chunks, "
+                  << reader.getScanCount() << " scans): " << openMs << " ms; seek 1h32m " << seekUs
+                  << " us => " << (foundTime == target) << ", seek scan " << scanTarget << " " << scanUs
+                  << " us => " << (view.timestampNs == scanTarget * period + period / 2) << "\n";
+    }
+
+    SensorLogReader reader;
+    reader.open("testSensorLogLong.bin");
+    Clock::time_point t0 = Clock::now();
+    while (reader.next(view) && view.timestampNs < target) {
+    }
+    double linearMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    std::cout << "[Bench] Linear read to 1h32m: " << linearMs << " ms => " << (view.timestampNs == target) << "\n";
+}
+
+/**
+ * @brief Main function to test the sensor log.
+ *
+ * This function performs various tests on the sensor log:
+ * - Writes IR, pose, command and Lidar records and reads them back in order.
+ * - Splits a log into small chunks and reads records through the chunk index.
+ * - Loads the chunk index from the trailer, and rebuilds it for a log cut short mid-chunk.
+ * - Seeks by time, record number and scan number.
+ * - Rejects a file that is not a sensor log.
+ * - Falls back to a rebuilt index when the trailer points outside the file, disagrees
+ *   with the chunk timestamps or leaves out the last chunk, and skips records whose
+ *   offsets lie outside their chunk.
+ * - Stops rebuilding the index at a chunk whose records are not a multiple of 8 bytes.
+ * - Stops writing after a failed chunk write, where the platform can make one fail.
+ * - Compares text lines through Record with the binary log for 360-beam scans.
+ * - Times opening a two-hour log and seeking to 1h32m and to a scan number.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- SensorLog Test Start -----\n";
+
+    // 1. Round trip
+    SensorLogWriter writer;
+    writer.open("testSensorLog.bin", 5);
+    double ir[9] = { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9 };
+    float scan[5] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+    writer.writeIR(1000, ir);
+    writer.writePose(2000, 1.5, -2.5, 0.25);
+    writer.writeCommand(2500, COMMAND_ROTATE, 3);
+    writer.writeLidar(3000, scan, 5);
+    writer.close();
+    std::cout << "[Test] Records written => " << writer.getRecordCount() << " (4) in "
+              << writer.getChunkCount() << " chunk\n";
+
+    SensorLogReader reader;
+    std::cout << "[Test] Open => " << reader.open("testSensorLog.bin") << ", beams => " << reader.getLidarBeams() << "\n";
+    SensorRecordView record;
+    while (reader.next(record)) {
+        std::cout << "[Read] type " << record.type << " at " << record.timestampNs << ": ";
+        if (record.type == RECORD_IR) {
+            std::cout << "ir[8] = " << record.irRanges()[8] << "\n";
+        } else if (record.type == RECORD_POSE) {
+            std::cout << "pose = (" << record.pose()[0] << ", " << record.pose()[1] << ", " << record.pose()[2] << ")\n";
+        } else if (record.type == RECORD_COMMAND) {
+            std::cout << "command " << record.command() << ", direction " << record.direction() << "\n";
+        } else if (record.type == RECORD_LIDAR) {
+            std::cout << record.lidarCount() << " ranges, last = " << record.lidarRanges()[4] << "\n";
+        }
+    }
+    reader.rewind();
+    std::cout << "[Test] After rewind, first timestamp => " << (reader.next(record) ? record.timestampNs : 0) << "\n";
+
+    // 2. Small chunks and the chunk index
+    writer.open("testSensorLogChunks.bin", 5, 256);
+    for (int i = 0; i < 100; ++i) {
+        writer.writeLidar(static_cast<std::uint64_t>(i) * 10, scan, 5);
+    }
+    writer.close();
+    reader.open("testSensorLogChunks.bin");
+    std::cout << "[Test] Chunks => " << reader.getChunkCount() << ", records => " << reader.getRecordCount() << " (100)\n";
+    const SensorChunkHeader& second = reader.getChunkHeader(1);
+    std::cout << "[Test] Chunk 1 covers " << second.firstTimestampNs << ".." << second.lastTimestampNs << "\n";
+    reader.getRecord(1, 2, record);
+    std::cout << "[Test] Chunk 1, record 2 => t = " << record.timestampNs << " ("
+              << second.firstTimestampNs + 20 << ")\n";
+    reader.seekChunk(2);
+    reader.next(record);
+    std::cout << "[Test] Seek chunk 2 => t = " << record.timestampNs << " ("
+              << reader.getChunkHeader(2).firstTimestampNs << ")\n";
+
+    // 3. Index from the trailer, rebuilt index of a log cut short while writing
+    std::cout << "[Test] Trailer index => " << reader.hasTrailerIndex() << "\n";
+    std::size_t fullChunks = reader.getChunkCount();
+    std::size_t indexBytes = fullChunks * sizeof(SensorIndexEntry) + sizeof(SensorLogTrailer);
+    {
+        std::ifstream in("testSensorLogChunks.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out("testSensorLogCut.bin", std::ios::binary);
+        out.write(bytes.data(), bytes.size() - indexBytes - 4);
+    }
+    reader.open("testSensorLogCut.bin");
+    int count = 0;
+    while (reader.next(record)) {
+        ++count;
+    }
+    std::cout << "[Test] Truncated log => trailer index " << reader.hasTrailerIndex() << ", "
+              << reader.getChunkCount() << " chunks (" << fullChunks - 1 << "), " << count << " records\n";
+
+    // 4. Seeking by time, record and scan
+    reader.open("testSensorLogChunks.bin");
+    reader.seekTime(455);
+    reader.next(record);
+    std::cout << "[Test] Seek t = 455 => t = " << record.timestampNs << " (460)\n";
+    reader.seekRecord(73);
+    reader.next(record);
+    std::cout << "[Test] Seek record 73 => t = " << record.timestampNs << " (730)\n";
+    reader.seekScan(99);
+    reader.next(record);
+    std::cout << "[Test] Seek scan 99 => t = " << record.timestampNs << " (990)\n";
+    std::cout << "[Test] Seek past the end => " << reader.seekTime(1000) << ", " << reader.seekScan(100)
+              << ", then next => " << reader.next(record) << "\n";
+    std::cout << "[Test] Log covers " << reader.getStartTime() << ".." << reader.getEndTime() << "\n";
+
+    // 5. Not a log
+    {
+        std::ofstream out("testSensorLogBad.bin", std::ios::binary);
+        out << "this is not a sensor log";
+    }
+    std::cout << "[Test] Open bad file => " << reader.open("testSensorLogBad.bin") << "\n";
+    {
+        std::ifstream in("testSensorLogChunks.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        // Index entry 3 points far past the end of the file.
+        std::size_t entry = bytes.size() - indexBytes + 3 * sizeof(SensorIndexEntry);
+        std::uint64_t offset = 1ULL << 40;
+        bytes.replace(entry, sizeof(offset), reinterpret_cast<const char*>(&offset), sizeof(offset));
+        std::ofstream out("testSensorLogBadIndex.bin", std::ios::binary);
+        out.write(bytes.data(), bytes.size());
+    }
+    reader.open("testSensorLogBadIndex.bin");
+    reader.seekTime(455);
+    reader.next(record);
+    std::cout << "[Test] Bad trailer entry => trailer index " << reader.hasTrailerIndex() << ", "
+              << reader.getChunkCount() << " chunks, seek t = 455 => t = " << record.timestampNs << " (460)\n";
+    {
+        std::ifstream in("testSensorLogChunks.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        // Index entry 3 claims timestamps its chunk header does not have.
+        std::string shifted = bytes;
+        std::size_t entry = bytes.size() - indexBytes + 3 * sizeof(SensorIndexEntry);
+        std::uint64_t timestamp = 5000;
+        shifted.replace(entry + offsetof(SensorIndexEntry, firstTimestampNs), sizeof(timestamp),
+                        reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+        std::ofstream("testSensorLogBadTime.bin", std::ios::binary).write(shifted.data(), shifted.size());
+        // The index leaves out the last chunk, so it starts after the end of the chunk before.
+        SensorLogTrailer trailer;
+        std::memcpy(&trailer, bytes.data() + bytes.size() - sizeof(trailer), sizeof(trailer));
+        trailer.indexOffset += sizeof(SensorIndexEntry);
+        trailer.entryCount -= 1;
+        std::string shortened = bytes;
+        shortened.replace(shortened.size() - sizeof(trailer), sizeof(trailer), reinterpret_cast<const char*>(&trailer),
+                          sizeof(trailer));
+        std::ofstream("testSensorLogShortIndex.bin", std::ios::binary).write(shortened.data(), shortened.size());
+        // Chunk 0 of a log without trailer claims records that are not a multiple of 8 bytes.
+        std::uint64_t dataSize = 0;
+        std::memcpy(&dataSize, bytes.data() + sizeof(SensorLogHeader) + offsetof(SensorChunkHeader, dataSize),
+                    sizeof(dataSize));
+        dataSize -= 4;
+        std::string odd = bytes.substr(0, bytes.size() - indexBytes);
+        odd.replace(sizeof(SensorLogHeader) + offsetof(SensorChunkHeader, dataSize), sizeof(dataSize),
+                    reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+        std::ofstream("testSensorLogOddChunk.bin", std::ios::binary).write(odd.data(), odd.size());
+    }
+    reader.open("testSensorLogBadTime.bin");
+    reader.seekTime(455);
+    reader.next(record);
+    std::cout << "[Test] Trailer timestamps differ from the chunk => trailer index " << reader.hasTrailerIndex()
+              << ", seek t = 455 => t = " << record.timestampNs << " (460)\n";
+    reader.open("testSensorLogShortIndex.bin");
+    std::cout << "[Test] Trailer misses the last chunk => trailer index " << reader.hasTrailerIndex() << ", "
+              << reader.getChunkCount() << " chunks (" << fullChunks << ")\n";
+    reader.open("testSensorLogOddChunk.bin");
+    std::cout << "[Test] Chunk records not a multiple of 8 bytes => " << reader.getChunkCount() << " chunks\n";
+    {
+        std::ifstream in("testSensorLogChunks.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        // Every record offset of chunk 1 points past its records.
+        reader.open("testSensorLogChunks.bin");
+        const SensorIndexEntry& entry = reader.getIndexEntry(1);
+        const SensorChunkHeader& header = reader.getChunkHeader(1);
+        std::size_t offsets = static_cast<std::size_t>(entry.offset + sizeof(SensorChunkHeader) + header.dataSize);
+        std::uint32_t records = header.recordCount;
+        std::uint32_t bad = 0xFFFFFFF0u;
+        for (std::uint32_t r = 0; r < records; ++r) {
+            bytes.replace(offsets + r * sizeof(bad), sizeof(bad), reinterpret_cast<const char*>(&bad), sizeof(bad));
+        }
+        std::ofstream out("testSensorLogBadRecords.bin", std::ios::binary);
+        out.write(bytes.data(), bytes.size());
+        reader.open("testSensorLogBadRecords.bin");
+        reader.seekTime(reader.getIndexEntry(1).firstTimestampNs);
+        reader.next(record);
+        std::cout << "[Test] Bad record offsets => seek into chunk 1 lands on t = " << record.timestampNs << " ("
+                  << reader.getIndexEntry(2).firstTimestampNs << "), scan 99 => " << reader.seekScan(99) << "\n";
+    }
+#if defined(__linux__)
+    // Every write to /dev/full fails once the stream buffer is flushed.
+    SensorLogWriter full;
+    full.open("/dev/full", 5, 256);
+    bool accepted = true;
+    int written = 0;
+    for (; written < 100 && accepted; ++written) {
+        accepted = full.writeLidar(static_cast<std::uint64_t>(written), scan, 5);
+    }
+    std::cout << "[Test] Write to a full device => refused after " << written << " records, chunks "
+              << full.getChunkCount() << ", later writes => " << full.writeLidar(1000, scan, 5) << ", flush => "
+              << full.flush() << "\n";
+    full.close();
+#endif
+    reader.close();
+
+    // 6. Text lines vs binary log, 6000 scans of 360 beams (10 minutes at 10 Hz)
+    double textWrite, textRead, binaryWrite, binaryRead;
+    double textSum = textRoundTrip(6000, 360, textWrite, textRead);
+    double binarySum = binaryRoundTrip(6000, 360, binaryWrite, binaryRead);
+    std::cout << "[Bench] Text:   write " << textWrite * 1000.0 << " ms, read " << textRead * 1000.0 << " ms\n";
+    std::cout << "[Bench] Binary: write " << binaryWrite * 1000.0 << " ms, read " << binaryRead * 1000.0 << " ms\n";
+    std::cout << "[Bench] Same data read back => " << (static_cast<long long>(textSum) == static_cast<long long>(binarySum)) << "\n";
+
+    // 7. Two hours at 10 Hz: open and seek with the trailer index, the rebuilt index and a linear scan
+    seekBenchmark(72000, 90);
+
+    std::cout << "----- SensorLog Test Complete -----\n";
+    return 0;
+}
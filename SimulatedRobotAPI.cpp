@@ -0,0 +1,359 @@
+/**
+ * @file SimulatedRobotAPI.cpp
+ * @brief Implementation of the SimulatedRobotAPI class.
+ */
+
+#include "SimulatedRobotAPI.h"
+#include <cmath>
+#include <limits>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * @brief Constructs a simulator over an obstacle map.
+ *
+ * The robot starts at the world origin facing +x, with a 0.01 s time step,
+ * 360 Lidar beams and no range noise.
+ *
+ * @param obstacles Occupancy map of the world; non-zero cells are obstacles.
+ * @param metersPerCell Size of one map cell in metres.
+ * @param mapOriginX World x-coordinate of the corner of cell (0, 0).
+ * @param mapOriginY World y-coordinate of the corner of cell (0, 0).
+ */
+SimulatedRobotAPI::SimulatedRobotAPI(const Map& obstacles, double metersPerCell, double mapOriginX, double mapOriginY)
+    : world(obstacles), resolution(metersPerCell > 0.0 ? metersPerCell : 0.05), originX(mapOriginX), originY(mapOriginY),
+      poseX(0.0), poseY(0.0), poseTh(0.0), velForward(0.0), velLeft(0.0), velTurn(0.0),
+      linearSpeed(0.2), turnSpeed(0.5), timeStep(0.01), simTime(0.0),
+      irMaxRange(0.8), lidarMaxRange(10.0), lidarBeams(360), noiseStdDev(0.0), noiseState(1),
+      connected(false), collided(false)
+{
+}
+
+/**
+ * @brief Connects to the simulated robot.
+ */
+void SimulatedRobotAPI::connect() {
+    connected = true;
+}
+
+/**
+ * @brief Disconnects from the simulated robot and stops it.
+ */
+void SimulatedRobotAPI::disconnect() {
+    stop();
+    connected = false;
+}
+
+/**
+ * @brief Moves the robot in a direction relative to its heading.
+ *
+ * @param dir One of FORWARD, BACKWARD, LEFT or RIGHT.
+ */
+void SimulatedRobotAPI::move(DIRECTION dir) {
+    velForward = 0.0;
+    velLeft = 0.0;
+    velTurn = 0.0;
+    switch (dir) {
+    case FORWARD: velForward = linearSpeed; break;
+    case BACKWARD: velForward = -linearSpeed; break;
+    case LEFT: velLeft = linearSpeed; break;
+    case RIGHT: velLeft = -linearSpeed; break;
+    }
+}
+
+/**
+ * @brief Rotates the robot in place.
+ *
+ * @param dir LEFT (counter-clockwise) or RIGHT (clockwise).
+ */
+void SimulatedRobotAPI::rotate(DIRECTION dir) {
+    velForward = 0.0;
+    velLeft = 0.0;
+    velTurn = (dir == RIGHT) ? -turnSpeed : turnSpeed;
+}
+
+/**
+ * @brief Stops the robot.
+ */
+void SimulatedRobotAPI::stop() {
+    velForward = 0.0;
+    velLeft = 0.0;
+    velTurn = 0.0;
+}
+
+/**
+ * @brief Gets an IR range.
+ *
+ * The nine sensors are spread 40 degrees apart, sensor 0 facing forward.
+ *
+ * @param i Sensor index from 0 to 8.
+ * @return double The distance in metres, or the maximum IR range if nothing is seen.
+ */
+double SimulatedRobotAPI::getIRRange(int i) {
+    if (i < 0 || i > 8) {
+        return irMaxRange;
+    }
+    double range = castRay(poseX, poseY, poseTh + i * 40.0 * M_PI / 180.0, irMaxRange);
+    if (noiseStdDev > 0.0) {
+        range = std::fmax(0.0, std::fmin(irMaxRange, range + noise()));
+    }
+    return range;
+}
+
+/**
+ * @brief Gets the robot pose.
+ *
+ * @param X Receives the x position in metres.
+ * @param Y Receives the y position in metres.
+ * @param TH Receives the heading in radians.
+ */
+void SimulatedRobotAPI::getXYTh(double& X, double& Y, double& TH) {
+    X = poseX;
+    Y = poseY;
+    TH = poseTh;
+}
+
+/**
+ * @brief Gets a full Lidar scan.
+ *
+ * Beam i points at i * 360 / getLidarRangeNumber() degrees from the heading.
+ *
+ * @param ranges Output array of getLidarRangeNumber() ranges in metres.
+ */
+void SimulatedRobotAPI::getLidarRange(float* ranges) {
+    const double step = 2.0 * M_PI / lidarBeams;
+    for (int i = 0; i < lidarBeams; ++i) {
+        double range = castRay(poseX, poseY, poseTh + i * step, lidarMaxRange);
+        if (noiseStdDev > 0.0) {
+            range = std::fmax(0.0, std::fmin(lidarMaxRange, range + noise()));
+        }
+        ranges[i] = static_cast<float>(range);
+    }
+}
+
+/**
+ * @brief Gets the number of Lidar beams.
+ *
+ * @return int The number of beams.
+ */
+int SimulatedRobotAPI::getLidarRangeNumber() {
+    return lidarBeams;
+}
+
+/**
+ * @brief Advances the simulation by one time step.
+ *
+ * Integrates the commanded velocities. If the new position is inside an obstacle the
+ * robot stays where it was and the step counts as a collision.
+ */
+void SimulatedRobotAPI::step() {
+    double c = std::cos(poseTh);
+    double s = std::sin(poseTh);
+    double nextX = poseX + (velForward * c - velLeft * s) * timeStep;
+    double nextY = poseY + (velForward * s + velLeft * c) * timeStep;
+    collided = isOccupied(nextX, nextY);
+    if (!collided) {
+        poseX = nextX;
+        poseY = nextY;
+    }
+    poseTh = std::remainder(poseTh + velTurn * timeStep, 2.0 * M_PI);
+    simTime += timeStep;
+}
+
+/**
+ * @brief Advances the simulation by a duration, in whole time steps.
+ *
+ * @param seconds Simulated time to advance.
+ */
+void SimulatedRobotAPI::advance(double seconds) {
+    long long steps = static_cast<long long>(std::floor(seconds / timeStep + 0.5));
+    for (long long i = 0; i < steps; ++i) {
+        step();
+    }
+}
+
+/**
+ * @brief Checks whether a world position lies in an obstacle cell.
+ *
+ * @param x World x-coordinate in metres.
+ * @param y World y-coordinate in metres.
+ * @return bool True if the cell is occupied.
+ */
+bool SimulatedRobotAPI::isOccupied(double x, double y) const {
+    int gx = static_cast<int>(std::floor((x - originX) / resolution));
+    int gy = static_cast<int>(std::floor((y - originY) / resolution));
+    return world.getGrid(gx, gy) > 0;
+}
+
+/**
+ * @brief Casts a ray from a world position.
+ *
+ * Walks the map cells along the ray (Amanatides-Woo traversal) until an obstacle is hit.
+ *
+ * @param x World x-coordinate of the ray origin.
+ * @param y World y-coordinate of the ray origin.
+ * @param angle Ray direction in radians.
+ * @param maxRange Maximum range in metres.
+ * @return double Distance to the first obstacle, or maxRange if none is hit.
+ */
+double SimulatedRobotAPI::castRay(double x, double y, double angle, double maxRange) const {
+    const double inf = std::numeric_limits<double>::infinity();
+    double dx = std::cos(angle);
+    double dy = std::sin(angle);
+    double gx = (x - originX) / resolution;
+    double gy = (y - originY) / resolution;
+    int cx = static_cast<int>(std::floor(gx));
+    int cy = static_cast<int>(std::floor(gy));
+    const int dimX = world.getNumberX();
+    const int dimY = world.getNumberY();
+
+    int stepX = dx > 0 ? 1 : -1;
+    int stepY = dy > 0 ? 1 : -1;
+    // Distances (in cells) along the ray to cross one cell and to reach the next boundary.
+    double deltaX = dx != 0.0 ? std::fabs(1.0 / dx) : inf;
+    double deltaY = dy != 0.0 ? std::fabs(1.0 / dy) : inf;
+    double nextX = dx != 0.0 ? ((dx > 0 ? (cx + 1 - gx) : (gx - cx)) * deltaX) : inf;
+    double nextY = dy != 0.0 ? ((dy > 0 ? (cy + 1 - gy) : (gy - cy)) * deltaY) : inf;
+    double limit = maxRange / resolution;
+
+    double t = 0.0;
+    while (t <= limit) {
+        if (cx >= 0 && cx < dimX && cy >= 0 && cy < dimY) {
+            if (world.row(cy)[cx] > 0) {
+                return std::fmin(t * resolution, maxRange);
+            }
+        } else if ((cx < 0 && stepX < 0) || (cx >= dimX && stepX > 0) ||
+                   (cy < 0 && stepY < 0) || (cy >= dimY && stepY > 0)) {
+            // Outside the map and moving away from it: nothing left to hit.
+            break;
+        }
+        if (nextX < nextY) {
+            t = nextX;
+            nextX += deltaX;
+            cx += stepX;
+        } else {
+            t = nextY;
+            nextY += deltaY;
+            cy += stepY;
+        }
+    }
+    return maxRange;
+}
+
+/**
+ * @brief Places the robot.
+ *
+ * @param x X position in metres.
+ * @param y Y position in metres.
+ * @param th Heading in radians.
+ */
+void SimulatedRobotAPI::setPose(double x, double y, double th) {
+    poseX = x;
+    poseY = y;
+    poseTh = th;
+}
+
+/**
+ * @brief Sets the speeds used by move() and rotate().
+ *
+ * @param metersPerSecond Linear speed.
+ * @param radiansPerSecond Turn rate.
+ */
+void SimulatedRobotAPI::setSpeeds(double metersPerSecond, double radiansPerSecond) {
+    linearSpeed = metersPerSecond;
+    turnSpeed = radiansPerSecond;
+}
+
+/**
+ * @brief Sets the duration of one step().
+ *
+ * @param seconds The time step; values that are not positive are ignored.
+ */
+void SimulatedRobotAPI::setTimeStep(double seconds) {
+    if (seconds > 0.0) {
+        timeStep = seconds;
+    }
+}
+
+/**
+ * @brief Sets the number of Lidar beams.
+ *
+ * @param beams The number of beams; values that are not positive are ignored.
+ */
+void SimulatedRobotAPI::setLidarRangeNumber(int beams) {
+    if (beams > 0) {
+        lidarBeams = beams;
+    }
+}
+
+/**
+ * @brief Sets the maximum IR and Lidar ranges.
+ *
+ * @param irRange Maximum IR range in metres.
+ * @param lidarRange Maximum Lidar range in metres.
+ */
+void SimulatedRobotAPI::setMaxRanges(double irRange, double lidarRange) {
+    irMaxRange = irRange;
+    lidarMaxRange = lidarRange;
+}
+
+/**
+ * @brief Enables deterministic Gaussian range noise.
+ *
+ * @param stdDev Standard deviation in metres, 0 to disable.
+ * @param seed Seed of the noise generator.
+ */
+void SimulatedRobotAPI::setNoise(double stdDev, std::uint64_t seed) {
+    noiseStdDev = stdDev;
+    noiseState = seed ? seed : 1;
+}
+
+/**
+ * @brief Returns a zero-mean noise sample from the seeded generator.
+ *
+ * Uses xorshift64* and the sum of four uniforms as a cheap, portable approximation
+ * of a normal distribution, so runs are identical on every platform.
+ *
+ * @return double The noise in metres.
+ */
+double SimulatedRobotAPI::noise() {
+    double sum = 0.0;
+    for (int k = 0; k < 4; ++k) {
+        noiseState ^= noiseState >> 12;
+        noiseState ^= noiseState << 25;
+        noiseState ^= noiseState >> 27;
+        std::uint64_t r = noiseState * 0x2545F4914F6CDD1DULL;
+        sum += static_cast<double>(r >> 11) / 9007199254740992.0;
+    }
+    // Four U(0,1) have mean 2 and variance 1/3.
+    return (sum - 2.0) * std::sqrt(3.0) * noiseStdDev;
+}
+
+/**
+ * @brief Gets the simulated time.
+ *
+ * @return double Seconds since construction.
+ */
+double SimulatedRobotAPI::getSimTime() const {
+    return simTime;
+}
+
+/**
+ * @brief Checks whether the last step was blocked by an obstacle.
+ *
+ * @return bool True if the robot collided.
+ */
+bool SimulatedRobotAPI::hasCollided() const {
+    return collided;
+}
+
+/**
+ * @brief Checks whether connect() has been called.
+ *
+ * @return bool True if connected.
+ */
+bool SimulatedRobotAPI::isConnected() const {
+    return connected;
+}
@@ -0,0 +1,237 @@
+/**
+ * @file SimulatedRobotAPI.h
+ * @brief Declaration of the SimulatedRobotAPI class.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "Direction.h"
+#include "Map.h"
+
+/**
+ * @class SimulatedRobotAPI
+ * @brief Headless, deterministic stand-in for FestoRobotAPI.
+ *
+ * The class offers the same methods as FestoRobotAPI so that control and mapping code
+ * can run without the Windows simulator. The robot moves in a fixed-step world: motion
+ * commands set a velocity and the pose only changes when step() or advance() is called,
+ * so a run is fully reproducible and can go as fast as the CPU allows. IR and Lidar
+ * readings are ray-cast against an occupancy Map, where any non-zero cell is an obstacle.
+ * Cells outside the map are free. Poses are in metres and radians, like getXYTh().
+ */
+class SimulatedRobotAPI {
+private:
+    Map world; ///< Obstacle map
+    double resolution; ///< Size of one map cell in metres
+    double originX; ///< World x-coordinate of the corner of cell (0, 0)
+    double originY; ///< World y-coordinate of the corner of cell (0, 0)
+    double poseX; ///< Robot x position in metres
+    double poseY; ///< Robot y position in metres
+    double poseTh; ///< Robot heading in radians
+    double velForward; ///< Commanded speed along the heading in m/s
+    double velLeft; ///< Commanded sideways speed in m/s
+    double velTurn; ///< Commanded turn rate in rad/s
+    double linearSpeed; ///< Speed used by move() in m/s
+    double turnSpeed; ///< Turn rate used by rotate() in rad/s
+    double timeStep; ///< Duration of one step() in seconds
+    double simTime; ///< Simulated time in seconds
+    double irMaxRange; ///< Maximum IR range in metres
+    double lidarMaxRange; ///< Maximum Lidar range in metres
+    int lidarBeams; ///< Number of Lidar beams over 360 degrees
+    double noiseStdDev; ///< Standard deviation of range noise in metres
+    std::uint64_t noiseState; ///< State of the deterministic noise generator
+    bool connected; ///< Whether connect() has been called
+    bool collided; ///< Whether the last step was blocked by an obstacle
+
+    /**
+     * @brief Checks whether a world position lies in an obstacle cell.
+     *
+     * @param x World x-coordinate in metres.
+     * @param y World y-coordinate in metres.
+     * @return bool True if the cell is occupied.
+     */
+    bool isOccupied(double x, double y) const;
+
+    /**
+     * @brief Returns a zero-mean noise sample from the seeded generator.
+     *
+     * @return double The noise in metres.
+     */
+    double noise();
+
+public:
+    /**
+     * @brief Constructs a simulator over an obstacle map.
+     *
+     * The robot starts at the world origin facing +x, with a 0.01 s time step,
+     * 360 Lidar beams and no range noise.
+     *
+     * @param obstacles Occupancy map of the world; non-zero cells are obstacles.
+     * @param metersPerCell Size of one map cell in metres.
+     * @param mapOriginX World x-coordinate of the corner of cell (0, 0).
+     * @param mapOriginY World y-coordinate of the corner of cell (0, 0).
+     */
+    SimulatedRobotAPI(const Map& obstacles = Map(), double metersPerCell = 0.05,
+                      double mapOriginX = 0.0, double mapOriginY = 0.0);
+
+    /**
+     * @brief Connects to the simulated robot.
+     */
+    void connect();
+
+    /**
+     * @brief Disconnects from the simulated robot and stops it.
+     */
+    void disconnect();
+
+    /**
+     * @brief Moves the robot in a direction relative to its heading.
+     *
+     * @param dir One of FORWARD, BACKWARD, LEFT or RIGHT.
+     */
+    void move(DIRECTION dir);
+
+    /**
+     * @brief Rotates the robot in place.
+     *
+     * @param dir LEFT (counter-clockwise) or RIGHT (clockwise).
+     */
+    void rotate(DIRECTION dir);
+
+    /**
+     * @brief Stops the robot.
+     */
+    void stop();
+
+    /**
+     * @brief Gets an IR range.
+     *
+     * The nine sensors are spread 40 degrees apart, sensor 0 facing forward.
+     *
+     * @param i Sensor index from 0 to 8.
+     * @return double The distance in metres, or the maximum IR range if nothing is seen.
+     */
+    double getIRRange(int i);
+
+    /**
+     * @brief Gets the robot pose.
+     *
+     * @param X Receives the x position in metres.
+     * @param Y Receives the y position in metres.
+     * @param TH Receives the heading in radians.
+     */
+    void getXYTh(double& X, double& Y, double& TH);
+
+    /**
+     * @brief Gets a full Lidar scan.
+     *
+     * Beam i points at i * 360 / getLidarRangeNumber() degrees from the heading.
+     *
+     * @param ranges Output array of getLidarRangeNumber() ranges in metres.
+     */
+    void getLidarRange(float* ranges);
+
+    /**
+     * @brief Gets the number of Lidar beams.
+     *
+     * @return int The number of beams.
+     */
+    int getLidarRangeNumber();
+
+    /**
+     * @brief Advances the simulation by one time step.
+     *
+     * Integrates the commanded velocities. If the new position is inside an obstacle the
+     * robot stays where it was and the step counts as a collision.
+     */
+    void step();
+
+    /**
+     * @brief Advances the simulation by a duration, in whole time steps.
+     *
+     * @param seconds Simulated time to advance.
+     */
+    void advance(double seconds);
+
+    /**
+     * @brief Casts a ray from a world position.
+     *
+     * Walks the map cells along the ray (Amanatides-Woo traversal) until an obstacle is hit.
+     *
+     * @param x World x-coordinate of the ray origin.
+     * @param y World y-coordinate of the ray origin.
+     * @param angle Ray direction in radians.
+     * @param maxRange Maximum range in metres.
+     * @return double Distance to the first obstacle, or maxRange if none is hit.
+     */
+    double castRay(double x, double y, double angle, double maxRange) const;
+
+    /**
+     * @brief Places the robot.
+     *
+     * @param x X position in metres.
+     * @param y Y position in metres.
+     * @param th Heading in radians.
+     */
+    void setPose(double x, double y, double th);
+
+    /**
+     * @brief Sets the speeds used by move() and rotate().
+     *
+     * @param metersPerSecond Linear speed.
+     * @param radiansPerSecond Turn rate.
+     */
+    void setSpeeds(double metersPerSecond, double radiansPerSecond);
+
+    /**
+     * @brief Sets the duration of one step().
+     *
+     * @param seconds The time step; values that are not positive are ignored.
+     */
+    void setTimeStep(double seconds);
+
+    /**
+     * @brief Sets the number of Lidar beams.
+     *
+     * @param beams The number of beams; values that are not positive are ignored.
+     */
+    void setLidarRangeNumber(int beams);
+
+    /**
+     * @brief Sets the maximum IR and Lidar ranges.
+     *
+     * @param irRange Maximum IR range in metres.
+     * @param lidarRange Maximum Lidar range in metres.
+     */
+    void setMaxRanges(double irRange, double lidarRange);
+
+    /**
+     * @brief Enables deterministic Gaussian range noise.
+     *
+     * @param stdDev Standard deviation in metres, 0 to disable.
+     * @param seed Seed of the noise generator.
+     */
+    void setNoise(double stdDev, std::uint64_t seed = 1);
+
+    /**
+     * @brief Gets the simulated time.
+     *
+     * @return double Seconds since construction.
+     */
+    double getSimTime() const;
+
+    /**
+     * @brief Checks whether the last step was blocked by an obstacle.
+     *
+     * @return bool True if the robot collided.
+     */
+    bool hasCollided() const;
+
+    /**
+     * @brief Checks whether connect() has been called.
+     *
+     * @return bool True if connected.
+     */
+    bool isConnected() const;
+};
@@ -0,0 +1,117 @@
+/**
+ * @file SimulatedRobotAPITest.cpp
+ * @brief Test file for the SimulatedRobotAPI class.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include "SimulatedRobotAPI.h"
+
+/**
+ * @brief Builds a 10 m x 10 m room with 0.05 m cells and a pillar.
+ *
+ * @return Map The obstacle map.
+ */
+Map buildRoom() {
+    Map room(200, 200);
+    for (int i = 0; i < 200; ++i) {
+        room.setGrid(i, 0, 1);
+        room.setGrid(i, 199, 1);
+        room.setGrid(0, i, 1);
+        room.setGrid(199, i, 1);
+    }
+    for (int y = 90; y < 110; ++y) {
+        for (int x = 140; x < 160; ++x) {
+            room.setGrid(x, y, 1);
+        }
+    }
+    return room;
+}
+
+/**
+ * @brief Main function to test the SimulatedRobotAPI class.
+ *
+ * This function performs various tests on the SimulatedRobotAPI class:
+ * - Reads IR and Lidar ranges against known walls.
+ * - Moves and rotates the robot with fixed time steps.
+ * - Drives into the pillar and checks the collision.
+ * - Runs two identical noisy sessions and checks they match.
+ * - Measures how much faster than real time an hour of simulation runs.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- SimulatedRobotAPI Test Start -----\n";
+
+    // 1. Ranges against the walls
+    SimulatedRobotAPI sim(buildRoom(), 0.05);
+    sim.connect();
+    sim.setPose(5.0, 5.0, 0.0);
+    std::cout << "[Test] Connected => " << sim.isConnected() << "\n";
+    std::cout << "[Test] IR front (pillar at 7.0 m, max 0.8) => " << sim.getIRRange(0) << "\n";
+    std::vector<float> scan(sim.getLidarRangeNumber());
+    sim.getLidarRange(scan.data());
+    std::cout << "[Test] Lidar 0 deg => " << scan[0] << " (2.0), 90 deg => " << scan[90]
+              << " (4.95), 180 deg => " << scan[180] << " (4.95)\n";
+
+    // 2. Motion
+    sim.move(FORWARD);
+    sim.advance(2.0);
+    double x, y, th;
+    sim.getXYTh(x, y, th);
+    std::cout << "[Test] After 2 s forward: (" << x << ", " << y << ", " << th << "), t = " << sim.getSimTime() << "\n";
+    sim.rotate(LEFT);
+    sim.advance(3.14159265358979 / 0.5 / 2.0);
+    sim.stop();
+    sim.getXYTh(x, y, th);
+    std::cout << "[Test] After quarter turn: th => " << th << "\n";
+
+    // 3. Collision
+    sim.setPose(6.5, 5.0, 0.0);
+    sim.move(FORWARD);
+    sim.advance(4.0);
+    sim.getXYTh(x, y, th);
+    std::cout << "[Test] Drive into pillar: x => " << x << ", collided => " << sim.hasCollided() << "\n";
+
+    // 4. Determinism with noise
+    SimulatedRobotAPI a(buildRoom(), 0.05), b(buildRoom(), 0.05);
+    a.setNoise(0.01, 42);
+    b.setNoise(0.01, 42);
+    a.setPose(2.0, 3.0, 0.3);
+    b.setPose(2.0, 3.0, 0.3);
+    std::vector<float> sa(360), sb(360);
+    bool same = true;
+    for (int i = 0; i < 100; ++i) {
+        a.move(i % 2 ? FORWARD : LEFT);
+        b.move(i % 2 ? FORWARD : LEFT);
+        a.advance(0.1);
+        b.advance(0.1);
+        a.getLidarRange(sa.data());
+        b.getLidarRange(sb.data());
+        same = same && sa == sb;
+    }
+    std::cout << "[Test] Identical noisy runs => " << same << "\n";
+
+    // 5. Faster than real time: one simulated hour, 100 Hz steps, 10 Hz Lidar
+    using Clock = std::chrono::steady_clock;
+    SimulatedRobotAPI fast(buildRoom(), 0.05);
+    fast.setPose(3.0, 3.0, 0.0);
+    Clock::time_point t0 = Clock::now();
+    for (int s = 0; s < 360000; ++s) {
+        if (s % 500 == 0) {
+            fast.rotate(LEFT);
+        } else if (s % 500 == 100) {
+            fast.move(FORWARD);
+        }
+        fast.step();
+        if (s % 10 == 0) {
+            fast.getLidarRange(sa.data());
+        }
+    }
+    double wall = std::chrono::duration<double>(Clock::now() - t0).count();
+    std::cout << "[Bench] 1 h simulated in " << wall << " s (" << fast.getSimTime() / wall << "x real time)\n";
+
+    std::cout << "----- SimulatedRobotAPI Test Complete -----\n";
+    return 0;
+}
@@ -0,0 +1,336 @@
+#include "TiledMap.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+
+template <typename Tile>
+TilePool<Tile>::TilePool(int blockSize) : tilesPerBlock(std::max(blockSize, 1))
+{
+}
+
+template <typename Tile>
+TilePool<Tile>::~TilePool() {
+    for (Tile* block : blocks) {
+        delete[] block;
+    }
+}
+
+template <typename Tile>
+Tile* TilePool<Tile>::acquire() {
+    if (freeTiles.empty()) {
+        std::lock_guard<std::mutex> lock(releaseMutex);
+        freeTiles.swap(releasedTiles);
+    }
+    if (freeTiles.empty()) {
+        Tile* block = new Tile[tilesPerBlock];
+        blocks.push_back(block);
+        for (int i = tilesPerBlock - 1; i >= 0; --i) {
+            freeTiles.push_back(block + i);
+        }
+    }
+    Tile* tile = freeTiles.back();
+    freeTiles.pop_back();
+    return tile;
+}
+
+template <typename Tile>
+void TilePool<Tile>::release(Tile* tile) {
+    std::lock_guard<std::mutex> lock(releaseMutex);
+    releasedTiles.push_back(tile);
+}
+
+namespace {
+
+// Drops one reference; the last holder, map or snapshot, returns the tile to the pool.
+template <typename Tile>
+void releaseTile(TilePool<Tile>& pool, Tile* tile) {
+    if (tile->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        pool.release(tile);
+    }
+}
+
+} // namespace
+
+
+template <typename Cell>
+std::uint64_t BasicTiledMap<Cell>::tileKey(int tileX, int tileY) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(tileY)) << 32) |
+           static_cast<std::uint32_t>(tileX);
+}
+
+template <typename Cell>
+BasicTiledMap<Cell>::BasicTiledMap()
+    : pool(std::make_shared<TilePool<Tile> >()), cachedKey(0), cachedTile(nullptr), minTileX(INT_MAX),
+      minTileY(INT_MAX), maxTileX(INT_MIN), maxTileY(INT_MIN), modified(true), copiedTiles(0)
+{
+}
+
+template <typename Cell>
+BasicTiledMap<Cell>::~BasicTiledMap() {
+    clearMap();
+}
+
+template <typename Cell>
+typename BasicTiledMap<Cell>::Tile* BasicTiledMap<Cell>::findTile(int x, int y, bool create) {
+    // Arithmetic shifts floor negative coordinates onto the right tile.
+    int tileX = x >> TILE_SHIFT;
+    int tileY = y >> TILE_SHIFT;
+    std::uint64_t key = tileKey(tileX, tileY);
+    if (cachedTile && cachedKey == key) {
+        return cachedTile;
+    }
+    typename std::unordered_map<std::uint64_t, Tile*>::iterator it = tiles.find(key);
+    Tile* tile = nullptr;
+    if (it != tiles.end()) {
+        tile = it->second;
+        // Only snapshot() adds references, on this thread, so a count of 1 cannot grow
+        // behind our back; the acquire pairs with the release of the last reader.
+        if (tile->refCount.load(std::memory_order_acquire) > 1) {
+            Tile* copy = pool->acquire();
+            std::memcpy(copy->cells, tile->cells, sizeof(copy->cells));
+            copy->refCount.store(1, std::memory_order_relaxed);
+            releaseTile(*pool, tile);
+            it->second = copy;
+            tile = copy;
+            ++copiedTiles;
+        }
+    } else if (create) {
+        tile = pool->acquire();
+        std::memset(tile->cells, 0, sizeof(tile->cells));
+        tile->refCount.store(1, std::memory_order_relaxed);
+        tiles[key] = tile;
+        minTileX = std::min(minTileX, tileX);
+        minTileY = std::min(minTileY, tileY);
+        maxTileX = std::max(maxTileX, tileX);
+        maxTileY = std::max(maxTileY, tileY);
+    } else {
+        return nullptr;
+    }
+    cachedKey = key;
+    cachedTile = tile;
+    modified = true;
+    return tile;
+}
+
+template <typename Cell>
+const typename BasicTiledMap<Cell>::Tile* BasicTiledMap<Cell>::findTile(int x, int y) const {
+    std::uint64_t key = tileKey(x >> TILE_SHIFT, y >> TILE_SHIFT);
+    if (cachedTile && cachedKey == key) {
+        return cachedTile;
+    }
+    typename std::unordered_map<std::uint64_t, Tile*>::const_iterator it = tiles.find(key);
+    return it != tiles.end() ? it->second : nullptr;
+}
+
+template <typename Cell>
+void BasicTiledMap<Cell>::clearMap() {
+    for (typename std::unordered_map<std::uint64_t, Tile*>::iterator it = tiles.begin(); it != tiles.end(); ++it) {
+        releaseTile(*pool, it->second);
+    }
+    tiles.clear();
+    cachedTile = nullptr;
+    modified = true;
+    minTileX = INT_MAX;
+    minTileY = INT_MAX;
+    maxTileX = INT_MIN;
+    maxTileY = INT_MIN;
+}
+
+template <typename Cell>
+void BasicTiledMap<Cell>::insertPoint(const Point& point) {
+    setGrid(static_cast<int>(std::floor(point.getX())), static_cast<int>(std::floor(point.getY())), 1);
+}
+
+template <typename Cell>
+int BasicTiledMap<Cell>::getGrid(int x, int y) const {
+    const Tile* tile = findTile(x, y);
+    if (!tile) {
+        return 0;
+    }
+    return static_cast<int>(tile->cells[((y & TILE_MASK) << TILE_SHIFT) + (x & TILE_MASK)]);
+}
+
+template <typename Cell>
+void BasicTiledMap<Cell>::setGrid(int x, int y, int value) {
+    Tile* tile = findTile(x, y, value != 0);
+    if (tile) {
+        tile->cells[((y & TILE_MASK) << TILE_SHIFT) + (x & TILE_MASK)] = static_cast<Cell>(value);
+    }
+}
+
+template <typename Cell>
+int BasicTiledMap<Cell>::getMinX() const {
+    return tiles.empty() ? 0 : minTileX * TILE_SIZE;
+}
+
+template <typename Cell>
+int BasicTiledMap<Cell>::getMinY() const {
+    return tiles.empty() ? 0 : minTileY * TILE_SIZE;
+}
+
+template <typename Cell>
+int BasicTiledMap<Cell>::getNumberX() const {
+    return tiles.empty() ? 0 : (maxTileX - minTileX + 1) * TILE_SIZE;
+}
+
+template <typename Cell>
+int BasicTiledMap<Cell>::getNumberY() const {
+    return tiles.empty() ? 0 : (maxTileY - minTileY + 1) * TILE_SIZE;
+}
+
+template <typename Cell>
+int BasicTiledMap<Cell>::getTileCount() const {
+    return static_cast<int>(tiles.size());
+}
+
+template <typename Cell>
+std::shared_ptr<const BasicTiledMapSnapshot<Cell> > BasicTiledMap<Cell>::snapshot() {
+    if (!modified) {
+        std::shared_ptr<const BasicTiledMapSnapshot<Cell> > last = lastSnapshot.lock();
+        if (last) {
+            return last;
+        }
+    }
+    BasicTiledMapSnapshot<Cell>* view = new BasicTiledMapSnapshot<Cell>(pool);
+    if (!tiles.empty()) {
+        view->minTileX = minTileX;
+        view->minTileY = minTileY;
+        view->tilesX = maxTileX - minTileX + 1;
+        view->tilesY = maxTileY - minTileY + 1;
+        view->grid.assign(static_cast<std::size_t>(view->tilesX) * view->tilesY, nullptr);
+        for (typename std::unordered_map<std::uint64_t, Tile*>::iterator it = tiles.begin(); it != tiles.end(); ++it) {
+            int tileX = static_cast<std::int32_t>(static_cast<std::uint32_t>(it->first));
+            int tileY = static_cast<std::int32_t>(static_cast<std::uint32_t>(it->first >> 32));
+            it->second->refCount.fetch_add(1, std::memory_order_relaxed);
+            view->grid[static_cast<std::size_t>(tileY - minTileY) * view->tilesX + (tileX - minTileX)] = it->second;
+        }
+        view->tileCount = static_cast<int>(tiles.size());
+    }
+    // The cached tile is now shared; the next write must go through the copy check.
+    cachedTile = nullptr;
+    modified = false;
+    std::shared_ptr<const BasicTiledMapSnapshot<Cell> > result(view);
+    lastSnapshot = result;
+    return result;
+}
+
+template <typename Cell>
+int BasicTiledMap<Cell>::getCopiedTileCount() const {
+    return copiedTiles;
+}
+
+template <typename Cell>
+void BasicTiledMap<Cell>::printInfo() const {
+    std::cout << "Grid bounds: (" << getMinX() << ", " << getMinY() << ") "
+              << getNumberX() << " x " << getNumberY() << ", " << getTileCount() << " tiles" << std::endl;
+}
+
+template <typename Cell>
+void BasicTiledMap<Cell>::showMap() const {
+    for (int y = getMinY(); y < getMinY() + getNumberY(); ++y) {
+        for (int x = getMinX(); x < getMinX() + getNumberX(); ++x) {
+            std::cout << (getGrid(x, y) == 0 ? '.' : 'x') << " ";
+        }
+        std::cout << std::endl;
+    }
+}
+
+
+template <typename Cell>
+BasicTiledMapSnapshot<Cell>::BasicTiledMapSnapshot(const std::shared_ptr<TilePool<Tile> >& tilePool)
+    : pool(tilePool), minTileX(0), minTileY(0), tilesX(0), tilesY(0), tileCount(0)
+{
+}
+
+template <typename Cell>
+BasicTiledMapSnapshot<Cell>::~BasicTiledMapSnapshot() {
+    for (Tile* tile : grid) {
+        if (tile) {
+            releaseTile(*pool, tile);
+        }
+    }
+}
+
+template <typename Cell>
+int BasicTiledMapSnapshot<Cell>::getGrid(int x, int y) const {
+    int tileX = (x >> BasicTiledMap<Cell>::TILE_SHIFT) - minTileX;
+    int tileY = (y >> BasicTiledMap<Cell>::TILE_SHIFT) - minTileY;
+    if (tileX < 0 || tileY < 0 || tileX >= tilesX || tileY >= tilesY) {
+        return 0;
+    }
+    const Tile* tile = grid[static_cast<std::size_t>(tileY) * tilesX + tileX];
+    if (!tile) {
+        return 0;
+    }
+    const int mask = BasicTiledMap<Cell>::TILE_MASK;
+    return static_cast<int>(tile->cells[((y & mask) << BasicTiledMap<Cell>::TILE_SHIFT) + (x & mask)]);
+}
+
+template <typename Cell>
+int BasicTiledMapSnapshot<Cell>::getMinX() const {
+    return minTileX * BasicTiledMap<Cell>::TILE_SIZE;
+}
+
+template <typename Cell>
+int BasicTiledMapSnapshot<Cell>::getMinY() const {
+    return minTileY * BasicTiledMap<Cell>::TILE_SIZE;
+}
+
+template <typename Cell>
+int BasicTiledMapSnapshot<Cell>::getNumberX() const {
+    return tilesX * BasicTiledMap<Cell>::TILE_SIZE;
+}
+
+template <typename Cell>
+int BasicTiledMapSnapshot<Cell>::getNumberY() const {
+    return tilesY * BasicTiledMap<Cell>::TILE_SIZE;
+}
+
+template <typename Cell>
+int BasicTiledMapSnapshot<Cell>::getTileCount() const {
+    return tileCount;
+}
+
+template <typename Cell>
+void BasicTiledMapSnapshot<Cell>::copyWindow(int minX, int minY, int sizeX, int sizeY, BasicMap<Cell>& window) const {
+    sizeX = std::max(sizeX, 0);
+    sizeY = std::max(sizeY, 0);
+    if (window.getNumberX() != sizeX || window.getNumberY() != sizeY) {
+        window.setGridSize(sizeX, sizeY);
+    }
+    const int shift = BasicTiledMap<Cell>::TILE_SHIFT;
+    const int mask = BasicTiledMap<Cell>::TILE_MASK;
+    for (int y = 0; y < sizeY; ++y) {
+        Cell* out = window.row(y).data();
+        int worldY = minY + y;
+        int tileY = (worldY >> shift) - minTileY;
+        int x = 0;
+        while (x < sizeX) {
+            int worldX = minX + x;
+            int tileX = (worldX >> shift) - minTileX;
+            int span = std::min(BasicTiledMap<Cell>::TILE_SIZE - (worldX & mask), sizeX - x);
+            const Tile* tile = nullptr;
+            if (tileX >= 0 && tileY >= 0 && tileX < tilesX && tileY < tilesY) {
+                tile = grid[static_cast<std::size_t>(tileY) * tilesX + tileX];
+            }
+            if (tile) {
+                std::memcpy(out + x, tile->cells + ((worldY & mask) << shift) + (worldX & mask), span * sizeof(Cell));
+            } else {
+                std::fill(out + x, out + x + span, static_cast<Cell>(0));
+            }
+            x += span;
+        }
+    }
+    window.markAllDirty();
+}
+
+template class BasicTiledMap<std::uint8_t>;
+template class BasicTiledMap<std::int16_t>;
+template class BasicTiledMap<int>;
+template class BasicTiledMap<float>;
+template class BasicTiledMapSnapshot<std::uint8_t>;
+template class BasicTiledMapSnapshot<std::int16_t>;
+template class BasicTiledMapSnapshot<int>;
+template class BasicTiledMapSnapshot<float>;
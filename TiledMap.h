@@ -0,0 +1,360 @@
+/**
+ * @file TiledMap.h
+ * @brief Declaration of the TiledMap class.
+ */
+
+#ifndef TILEDMAP_H
+#define TILEDMAP_H
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Point.h"
+#include "Map.h"
+
+/**
+ * @class TilePool
+ * @brief Pool allocator handing out fixed-size tiles.
+ *
+ * Tiles are carved from large blocks and recycled through a free list, so touching a
+ * new tile never goes to the general-purpose heap once the pool has warmed up.
+ * acquire() belongs to the thread writing the map; release() may be called from any
+ * thread, since the last reader of a snapshot returns the tiles it held.
+ */
+template <typename Tile>
+class TilePool {
+private:
+    std::vector<Tile*> blocks; ///< Blocks of tiles owned by the pool
+    std::vector<Tile*> freeTiles; ///< Tiles available for reuse, used by acquire() only
+    std::vector<Tile*> releasedTiles; ///< Tiles returned by release(), moved to freeTiles when it runs out
+    std::mutex releaseMutex; ///< Guards releasedTiles
+    int tilesPerBlock; ///< Number of tiles allocated per block
+
+public:
+    /**
+     * @brief Constructs an empty pool.
+     *
+     * @param blockSize Number of tiles allocated at once when the pool runs out.
+     */
+    explicit TilePool(int blockSize = 16);
+
+    /**
+     * @brief Destructor. Releases every block.
+     */
+    ~TilePool();
+
+    /**
+     * @brief Takes a tile from the pool. The tile contents are unspecified.
+     *
+     * @return Tile* The tile.
+     */
+    Tile* acquire();
+
+    /**
+     * @brief Returns a tile to the pool. Safe to call from any thread.
+     *
+     * @param tile The tile to return.
+     */
+    void release(Tile* tile);
+
+private:
+    TilePool(const TilePool&);
+    TilePool& operator=(const TilePool&);
+};
+
+template <typename Cell>
+class BasicTiledMapSnapshot;
+
+/**
+ * @class BasicTiledMap
+ * @brief Unbounded 2D grid map built from fixed-size tiles.
+ *
+ * The map offers the same cell interface as Map, but accepts signed coordinates and
+ * has no fixed size. The world is split into TILE_SIZE x TILE_SIZE tiles that are
+ * allocated from a pool the first time a non-zero value is written into them and kept
+ * in a hash keyed by tile coordinates. Cells of tiles that were never written read as 0,
+ * so growing in any direction costs one tile allocation and never copies existing cells.
+ *
+ * snapshot() hands out a read-only view that shares the tiles by reference count
+ * instead of copying them. A tile still referenced by a snapshot is copied the first
+ * time the map writes into it, so readers on other threads keep a consistent map while
+ * the writer pays only for the tiles it touches. The map itself must be used from one
+ * thread.
+ */
+template <typename Cell>
+class BasicTiledMap {
+public:
+    static const int TILE_SHIFT = 6; ///< log2 of the tile edge length
+    static const int TILE_SIZE = 1 << TILE_SHIFT; ///< Tile edge length in cells
+    static const int TILE_MASK = TILE_SIZE - 1; ///< Mask extracting the in-tile coordinate
+
+    /**
+     * @struct Tile
+     * @brief Row-major block of TILE_SIZE x TILE_SIZE cells.
+     */
+    struct Tile {
+        Cell cells[TILE_SIZE * TILE_SIZE]; ///< Cell values, row-major
+        std::atomic<int> refCount; ///< Number of maps and snapshots holding the tile
+    };
+
+private:
+    std::unordered_map<std::uint64_t, Tile*> tiles; ///< Allocated tiles keyed by packed tile coordinates
+    std::shared_ptr<TilePool<Tile> > pool; ///< Allocator for the tiles, shared with the snapshots
+    std::uint64_t cachedKey; ///< Key of the most recently written tile
+    Tile* cachedTile; ///< Most recently written tile, held by this map only, or nullptr
+    int minTileX; ///< Smallest tile column allocated so far
+    int minTileY; ///< Smallest tile row allocated so far
+    int maxTileX; ///< Largest tile column allocated so far
+    int maxTileY; ///< Largest tile row allocated so far
+    bool modified; ///< Whether the map was written since the last snapshot
+    std::weak_ptr<const BasicTiledMapSnapshot<Cell> > lastSnapshot; ///< Snapshot returned again while the map is unchanged
+    int copiedTiles; ///< Tiles copied because a snapshot held them
+
+    /**
+     * @brief Packs tile coordinates into a hash key.
+     *
+     * @param tileX Tile column.
+     * @param tileY Tile row.
+     * @return std::uint64_t The key.
+     */
+    static std::uint64_t tileKey(int tileX, int tileY);
+
+    /**
+     * @brief Finds the tile containing a cell in order to write into it.
+     *
+     * A tile shared with a snapshot is replaced by a private copy first.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @param create Whether to allocate the tile if it does not exist.
+     * @return Tile* The tile, or nullptr if it does not exist and create is false.
+     */
+    Tile* findTile(int x, int y, bool create);
+
+    /**
+     * @brief Finds the tile containing a cell without allocating.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return const Tile* The tile, or nullptr if it does not exist.
+     */
+    const Tile* findTile(int x, int y) const;
+
+    BasicTiledMap(const BasicTiledMap&);
+    BasicTiledMap& operator=(const BasicTiledMap&);
+
+public:
+    /**
+     * @brief Constructs an empty tiled map.
+     */
+    BasicTiledMap();
+
+    /**
+     * @brief Destructor. Returns every tile to the pool.
+     */
+    ~BasicTiledMap();
+
+    /**
+     * @brief Clears the map by releasing all tiles.
+     */
+    void clearMap();
+
+    /**
+     * @brief Inserts a point into the map.
+     *
+     * Sets the cell containing the point to 1. Negative coordinates are allowed.
+     *
+     * @param point The point to be inserted.
+     */
+    void insertPoint(const Point& point);
+
+    /**
+     * @brief Gets the value at the specified grid coordinates.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return int The value at the specified coordinates, 0 for cells never written.
+     */
+    int getGrid(int x, int y) const;
+
+    /**
+     * @brief Sets the value at the specified grid coordinates.
+     *
+     * Allocates the tile on first touch, unless the value is 0.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @param value The value to set at the specified coordinates.
+     */
+    void setGrid(int x, int y, int value);
+
+    /**
+     * @brief Gets the smallest x-coordinate covered by an allocated tile.
+     *
+     * @return int The first column of the bounding box, 0 for an empty map.
+     */
+    int getMinX() const;
+
+    /**
+     * @brief Gets the smallest y-coordinate covered by an allocated tile.
+     *
+     * @return int The first row of the bounding box, 0 for an empty map.
+     */
+    int getMinY() const;
+
+    /**
+     * @brief Gets the number of columns covered by allocated tiles.
+     *
+     * @return int The width of the bounding box, 0 for an empty map.
+     */
+    int getNumberX() const;
+
+    /**
+     * @brief Gets the number of rows covered by allocated tiles.
+     *
+     * @return int The height of the bounding box, 0 for an empty map.
+     */
+    int getNumberY() const;
+
+    /**
+     * @brief Gets the number of allocated tiles.
+     *
+     * @return int The number of tiles.
+     */
+    int getTileCount() const;
+
+    /**
+     * @brief Takes a read-only snapshot of the map.
+     *
+     * The snapshot shares the tiles with the map, so no cell is copied; the cost is
+     * one reference count per tile. While the map is unchanged the previous snapshot is
+     * returned again if a reader still holds it. The snapshot may be read and released
+     * on any thread and stays valid after the map is destroyed.
+     *
+     * @return std::shared_ptr<const BasicTiledMapSnapshot<Cell> > The snapshot.
+     */
+    std::shared_ptr<const BasicTiledMapSnapshot<Cell> > snapshot();
+
+    /**
+     * @brief Gets the number of tiles copied because a snapshot still held them.
+     *
+     * @return int The number of copies since the map was constructed.
+     */
+    int getCopiedTileCount() const;
+
+    /**
+     * @brief Prints information about the map.
+     */
+    void printInfo() const;
+
+    /**
+     * @brief Displays the bounding box of the map.
+     *
+     * Outputs the grid to the console.
+     */
+    void showMap() const;
+};
+
+/**
+ * @class BasicTiledMapSnapshot
+ * @brief Read-only view of a BasicTiledMap at the time snapshot() was called.
+ *
+ * The tiles of the bounding box are held in a dense table, so a read is an index
+ * computation and no hash lookup. Every method may be called from any thread.
+ * copyWindow() turns a region of the snapshot into a BasicMap for the planners.
+ */
+template <typename Cell>
+class BasicTiledMapSnapshot {
+private:
+    typedef typename BasicTiledMap<Cell>::Tile Tile;
+
+    std::shared_ptr<TilePool<Tile> > pool; ///< Allocator the tiles return to
+    std::vector<Tile*> grid; ///< Tiles of the bounding box, row-major, nullptr where none was allocated
+    int minTileX; ///< First tile column of the bounding box
+    int minTileY; ///< First tile row of the bounding box
+    int tilesX; ///< Tile columns of the bounding box
+    int tilesY; ///< Tile rows of the bounding box
+    int tileCount; ///< Number of tiles held
+
+    explicit BasicTiledMapSnapshot(const std::shared_ptr<TilePool<Tile> >& tilePool);
+    BasicTiledMapSnapshot(const BasicTiledMapSnapshot&);
+    BasicTiledMapSnapshot& operator=(const BasicTiledMapSnapshot&);
+
+    friend class BasicTiledMap<Cell>;
+
+public:
+    /**
+     * @brief Destructor. Releases the tiles no longer held by the map.
+     */
+    ~BasicTiledMapSnapshot();
+
+    /**
+     * @brief Gets the value at the specified grid coordinates.
+     *
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return int The value at the specified coordinates, 0 for cells never written.
+     */
+    int getGrid(int x, int y) const;
+
+    /**
+     * @brief Gets the smallest x-coordinate covered by a tile.
+     *
+     * @return int The first column of the bounding box, 0 for an empty map.
+     */
+    int getMinX() const;
+
+    /**
+     * @brief Gets the smallest y-coordinate covered by a tile.
+     *
+     * @return int The first row of the bounding box, 0 for an empty map.
+     */
+    int getMinY() const;
+
+    /**
+     * @brief Gets the number of columns covered by tiles.
+     *
+     * @return int The width of the bounding box, 0 for an empty map.
+     */
+    int getNumberX() const;
+
+    /**
+     * @brief Gets the number of rows covered by tiles.
+     *
+     * @return int The height of the bounding box, 0 for an empty map.
+     */
+    int getNumberY() const;
+
+    /**
+     * @brief Gets the number of tiles held.
+     *
+     * @return int The number of tiles.
+     */
+    int getTileCount() const;
+
+    /**
+     * @brief Copies a window of the snapshot into a map, for the planners.
+     *
+     * Cell (x, y) of the map receives cell (minX + x, minY + y) of the snapshot; cells
+     * outside the tiles are copied as 0. Each tile row is copied in one block, so the
+     * cost is proportional to the window, not to the snapshot. The map is resized only
+     * if its size differs, so reusing it between calls does not allocate, and every
+     * tile of it is marked as changed.
+     *
+     * @param minX Snapshot x-coordinate of the first column of the window.
+     * @param minY Snapshot y-coordinate of the first row of the window.
+     * @param sizeX Number of columns of the window.
+     * @param sizeY Number of rows of the window.
+     * @param window Receives the window.
+     */
+    void copyWindow(int minX, int minY, int sizeX, int sizeY, BasicMap<Cell>& window) const;
+};
+
+typedef BasicTiledMap<int> TiledMap; ///< Default tiled map type used by the Mapper
+typedef BasicTiledMapSnapshot<int> TiledMapSnapshot; ///< Snapshot of the default tiled map
+
+#endif // TILEDMAP_H
@@ -0,0 +1,182 @@
+/**
+ * @file TiledMapTest.cpp
+ * @brief Test file for the TiledMap class.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "TiledMap.h"
+
+/**
+ * @brief Main function to test the TiledMap class.
+ *
+ * This function performs various tests on the TiledMap class:
+ * - Inserts points at positive and negative coordinates.
+ * - Checks that unwritten cells read as 0 without allocating tiles.
+ * - Checks the bounding box as the map grows in every direction.
+ * - Clears the map and reuses pooled tiles.
+ * - Measures the cost of growing the map far from the origin.
+ * - Takes snapshots that stay unchanged while the map is written, copying only the
+ *   tiles written after the snapshot, including with a reader on another thread.
+ * - Copies a window of a snapshot that spans several tiles into a Map for the planners.
+ * - Measures the cost of a snapshot and of the writes that follow it on a
+ *   4000 x 4000 map.
+ *
+ * @return int Returns 0 upon successful completion.
+ */
+int main() {
+    std::cout << "----- TiledMap Test Start -----\n";
+
+    // 1. Signed coordinates
+    TiledMap tiled;
+    tiled.insertPoint(Point(3.0, 4.0));
+    tiled.insertPoint(Point(-1.0, -1.0));
+    tiled.setGrid(-65, 10, 7);
+    std::cout << "[Test] Grid(3,4) => " << tiled.getGrid(3, 4)
+              << ", Grid(-1,-1) => " << tiled.getGrid(-1, -1)
+              << ", Grid(-65,10) => " << tiled.getGrid(-65, 10) << "\n";
+
+    // 2. Reads and zero writes do not allocate
+    int before = tiled.getTileCount();
+    int unknown = tiled.getGrid(100000, -100000);
+    tiled.setGrid(5000, 5000, 0);
+    std::cout << "[Test] Unwritten cell => " << unknown << ", tiles before/after => "
+              << before << "/" << tiled.getTileCount() << "\n";
+
+    // 3. Bounding box
+    tiled.printInfo();
+    tiled.setGrid(200, -300, 1);
+    tiled.printInfo();
+
+    // 4. Clear and reuse
+    tiled.clearMap();
+    tiled.printInfo();
+    tiled.setGrid(0, 0, 1);
+    std::cout << "[Test] After clear and write: Grid(0,0) => " << tiled.getGrid(0, 0)
+              << ", Grid(3,4) => " << tiled.getGrid(3, 4) << "\n";
+
+    // 5. Growth benchmark
+    using Clock = std::chrono::steady_clock;
+    TiledMap world;
+    Clock::time_point t0 = Clock::now();
+    for (int i = -20000; i < 20000; ++i) {
+        world.setGrid(i, i / 2, 1);
+        world.setGrid(-i / 3, i, 1);
+    }
+    Clock::time_point t1 = Clock::now();
+    std::cout << "[Bench] 80000 writes over a 40000-cell span: "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, "
+              << world.getTileCount() << " tiles\n";
+
+    // 6. Snapshots
+    TiledMap live;
+    live.setGrid(10, 10, 1);
+    live.setGrid(-100, 300, 2);
+    std::shared_ptr<const TiledMapSnapshot> view = live.snapshot();
+    live.setGrid(10, 10, 5);
+    live.setGrid(11, 10, 6);
+    live.setGrid(1000, 1000, 7);
+    std::cout << "[Test] Snapshot Grid(10,10) => " << view->getGrid(10, 10) << ", Grid(-100,300) => "
+              << view->getGrid(-100, 300) << ", Grid(1000,1000) => " << view->getGrid(1000, 1000)
+              << "; map Grid(10,10) => " << live.getGrid(10, 10) << ", copied tiles => " << live.getCopiedTileCount()
+              << " (1)\n";
+    std::cout << "[Test] Snapshot bounds (" << view->getMinX() << ", " << view->getMinY() << ") " << view->getNumberX()
+              << " x " << view->getNumberY() << ", tiles " << view->getTileCount() << "\n";
+    Map window;
+    std::uint64_t windowVersion = window.getVersion();
+    view->copyWindow(-130, 250, 150, 70, window);
+    bool windowMatches = true;
+    for (int y = 0; y < window.getNumberY(); ++y) {
+        for (int x = 0; x < window.getNumberX(); ++x) {
+            windowMatches = windowMatches && window.getGrid(x, y) == view->getGrid(-130 + x, 250 + y);
+        }
+    }
+    int obstacle = window.getGrid(30, 50);
+    view->copyWindow(-5, -5, 20, 20, window);
+    std::cout << "[Test] Window matches the snapshot => " << windowMatches << ", Grid(30,50) => "
+              << obstacle << " (2), after a second copy " << window.getNumberX() << " x "
+              << window.getNumberY() << ", Grid(15,15) => " << window.getGrid(15, 15) << " (1), version changed => "
+              << (window.getVersion() != windowVersion) << "\n";
+    std::shared_ptr<const TiledMapSnapshot> again = live.snapshot();
+    std::cout << "[Test] Unchanged map returns the same snapshot => " << (again == live.snapshot()) << "\n";
+    view.reset();
+    again.reset();
+    live.setGrid(10, 10, 8);
+    live.clearMap();
+    std::cout << "[Test] Copied tiles after writing with the snapshots released => " << live.getCopiedTileCount() << " (still 1)\n";
+
+    // 7. A reader thread checks that every snapshot it gets is consistent
+    TiledMap shared;
+    std::shared_ptr<const TiledMapSnapshot> published = shared.snapshot();
+    std::mutex publishMutex;
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0), reads(0);
+    std::thread reader([&]() {
+        while (!done.load()) {
+            std::shared_ptr<const TiledMapSnapshot> current;
+            {
+                std::lock_guard<std::mutex> lock(publishMutex);
+                current = published;
+            }
+            // The writer sets every cell of row 0 to the same round number.
+            int first = current->getGrid(0, 0);
+            for (int x = 0; x < 640; ++x) {
+                if (current->getGrid(x, 0) != first) {
+                    ++torn;
+                }
+            }
+            ++reads;
+        }
+    });
+    for (int round = 1; round <= 2000; ++round) {
+        for (int x = 0; x < 640; ++x) {
+            shared.setGrid(x, 0, round);
+        }
+        std::shared_ptr<const TiledMapSnapshot> latest = shared.snapshot();
+        std::lock_guard<std::mutex> lock(publishMutex);
+        published.swap(latest);
+    }
+    done.store(true);
+    reader.join();
+    std::cout << "[Test] Reader thread: " << (reads.load() > 0) << ", torn reads => " << torn.load() << "\n";
+
+    // 8. Snapshot benchmark: 4000 x 4000 map, a few hundred cells written between snapshots
+    TiledMap large;
+    for (int y = 0; y < 4000; y += 8) {
+        for (int x = 0; x < 4000; x += 8) {
+            large.setGrid(x, y, 1);
+        }
+    }
+    double snapshotMs = 0.0, writeMs = 0.0;
+    int copiesBefore = large.getCopiedTileCount();
+    std::uint32_t seed = 1u;
+    std::shared_ptr<const TiledMapSnapshot> held;
+    for (int round = 0; round < 100; ++round) {
+        t0 = Clock::now();
+        held = large.snapshot();
+        t1 = Clock::now();
+        snapshotMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+        for (int i = 0; i < 360; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            large.setGrid(1000 + round * 20 + static_cast<int>((seed >> 8) % 200), 2000 + static_cast<int>((seed >> 20) % 200), 1);
+        }
+        writeMs += std::chrono::duration<double, std::milli>(Clock::now() - t1).count();
+    }
+    Clock::time_point c0 = Clock::now();
+    std::vector<int> fullCopy(static_cast<std::size_t>(4000) * 4000);
+    for (int y = 0; y < 4000; ++y) {
+        for (int x = 0; x < 4000; ++x) {
+            fullCopy[static_cast<std::size_t>(y) * 4000 + x] = large.getGrid(x, y);
+        }
+    }
+    double copyMs = std::chrono::duration<double, std::milli>(Clock::now() - c0).count();
+    std::cout << "[Bench] " << large.getTileCount() << " tiles: snapshot " << snapshotMs * 10.0
+              << " us, 360 writes after it " << writeMs * 10.0 << " us ("
+              << (large.getCopiedTileCount() - copiesBefore) / 100.0 << " tiles copied); cell-by-cell copy of the map " << copyMs << " ms\n";
+
+    std::cout << "----- TiledMap Test Complete -----\n";
+    return 0;
+}